@@ -244,6 +244,9 @@ namespace Louron {
 
 		ProcessNode(scene, scene->mRootNode, model_prefab, entt::null, asset_map, asset_reg, handle, meta_data, path);
 
+		// Materials, hierarchy links and transforms were written through GetComponent
+		model_prefab->MarkTemplateDirty();
+
 		return model_prefab;
 	}
 
@@ -244,8 +244,8 @@ namespace Louron {
 		if (!asset_meta_data.IsComposite)
 			return;
 
-		// Launch a detached thread to update children file path meta data
-		std::thread([this, asset_handle, asset_meta_data]() {
+		// Hand updating the children file path meta data to the job system
+		Engine::Get().GetJobSystem().Schedule([this, asset_handle, asset_meta_data]() {
 
 			for (auto& [handle, meta_data] : m_AssetRegistry)
 			{
@@ -255,7 +255,7 @@ namespace Louron {
 				}
 			}
 
-		}).detach();
+		});
 	}
 
 	void EditorAssetManager::AddCustomAsset(std::shared_ptr<Asset> asset, const AssetHandle& asset_handle, const AssetMetaData& asset_meta_data)
@@ -415,8 +415,8 @@ namespace Louron {
 		if (GetAssetType(asset_handle) != AssetType::Shader)
 			return asset;
 
-		// Launch a detached thread to update all PBR Materials
-		std::thread([this, project_asset_directory]() {
+		// Hand queuing every PBR Material for reimport to the job system
+		Engine::Get().GetJobSystem().Schedule([this, project_asset_directory]() {
 
 			AssetRegistry registry_copy = m_AssetRegistry;
 			for (auto& [handle, meta_data] : registry_copy)
@@ -429,7 +429,7 @@ namespace Louron {
 				}
 			}
 
-		}).detach();
+		});
 
 		return asset;
 	}
@@ -513,8 +513,8 @@ namespace Louron {
 		if (!is_composite)
 			return;
 
-		// Launch a detached thread to unload children
-		std::thread([this, asset_handle]() {
+		// Hand unloading the children to the job system
+		Engine::Get().GetJobSystem().Schedule([this, asset_handle]() {
 
 			for (const auto& [handle, meta_data] : m_AssetRegistry) 
 			{
@@ -524,7 +524,7 @@ namespace Louron {
 				}
 			}
 
-		}).detach();
+		});
 	}
 
 	void EditorAssetManager::RemoveAsset(const AssetHandle& asset_handle)
@@ -543,8 +543,8 @@ namespace Louron {
 		if (!is_composite)
 			return;
 
-		// Launch a detached thread to remove children
-		std::thread([this, asset_handle]() {
+		// Hand removing the children to the job system
+		Engine::Get().GetJobSystem().Schedule([this, asset_handle]() {
 
 			for (auto it = m_AssetRegistry.begin(); it != m_AssetRegistry.end();)
 			{
@@ -559,7 +559,7 @@ namespace Louron {
 				}
 			}
 
-		}).detach();
+		});
 
 	}
 
@@ -4,11 +4,16 @@
 #include "Logging.h"
 #include "Time.h"
 #include "Physics.h"
+#include "../Debug/Assert.h"
 #include "../Debug/Profiler.h"
 
 #include "../OpenGL/Vertex Array.h"
 
 #include "../Renderer/Renderer.h"
+#include "../Renderer/Geometry Range Allocator.h"
+#include "../Renderer/Indirect Draw List.h"
+
+#include "../Scene/Bounds SIMD.h"
 
 #include "../Scripting/Script Manager.h"
 
@@ -31,6 +36,15 @@ namespace Louron {
         if (!m_Specification.WorkingDirectory.empty())
             std::filesystem::current_path(m_Specification.WorkingDirectory);
 
+        // Worker threads are created once here and shared by every system
+        m_JobSystem = std::make_unique<JobSystem>();
+
+        // Debug builds check the SIMD culling kernels against the scalar tests they must match,
+        // and the CPU side bookkeeping of the indirect renderer
+        L_CORE_ASSERT(BoundsSIMD::ValidateAgainstScalar(), "Bounds SIMD Kernels Do Not Match the Scalar Tests.");
+        L_CORE_ASSERT(GeometryRangeAllocator::RunSelfTest(), "Geometry Range Allocator Self Test Failed.");
+        L_CORE_ASSERT(IndirectDrawList::RunSelfTest(), "Indirect Draw List Self Test Failed.");
+
         m_Window = Window::Create(WindowProps(m_Specification.Name));
 
         m_GuiLayer = new GuiLayer();
@@ -6,6 +6,7 @@
 #include "LayerStack.h"
 #include "Audio.h"
 #include "Logging.h"
+#include "Job System.h"
 
 #include "../OpenGL/Shader.h"
 #include "../OpenGL/Texture.h"
@@ -53,6 +54,7 @@ namespace Louron {
 		GuiLayer* GetImGuiLayer() { return m_GuiLayer; }
 
 		InputManager& GetInput() { return *m_Input; }
+		JobSystem& GetJobSystem() { return *m_JobSystem; }
 		TextureLibrary& GetTextureLibrary() { return *m_TextureLibrary; }
 
 		static Engine& Get() { return *s_Instance; }
@@ -85,6 +87,7 @@ namespace Louron {
 		EngineConfig m_Specification;
 
 		// Resource Management Systems
+		std::unique_ptr<JobSystem> m_JobSystem;
 		std::unique_ptr<InputManager> m_Input;
 		std::unique_ptr<TextureLibrary> m_TextureLibrary;
 
@@ -0,0 +1,269 @@
+#include "Job System.h"
+
+// Louron Core Headers
+#include "Logging.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	struct JobHandle::Job {
+
+		JobFunction Function;
+
+		// Dependencies still running, plus one held by Schedule until the job is fully set up
+		std::atomic<uint32_t> PendingDependencies = 1;
+
+		// Set before the handle is returned, so Wait can finish them first instead of sleeping on a job that is not queued yet
+		std::vector<std::shared_ptr<Job>> Dependencies;
+
+		// Queued once every dependency has finished, Started by whichever thread claims it first
+		std::atomic<bool> Queued = false;
+		std::atomic<bool> Started = false;
+
+		// Guards Continuations and wakes threads waiting for the job to be queued or finished
+		std::mutex ContinuationMutex;
+		std::condition_variable StateCondition;
+		std::vector<std::shared_ptr<Job>> Continuations;
+		std::atomic<bool> Finished = false;
+	};
+
+	// Index of the worker the current thread is, UINT32_MAX for threads outside the pool
+	static thread_local uint32_t s_WorkerIndex = UINT32_MAX;
+
+	bool JobHandle::IsFinished() const {
+		return !m_Job || m_Job->Finished.load(std::memory_order_acquire);
+	}
+
+	JobSystem::JobSystem(uint32_t worker_count) {
+
+		if (worker_count == 0)
+			worker_count = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+		m_Queues.reserve(worker_count);
+		for (uint32_t i = 0; i < worker_count; i++)
+			m_Queues.push_back(std::make_unique<WorkerQueue>());
+
+		m_Workers.reserve(worker_count);
+		for (uint32_t i = 0; i < worker_count; i++)
+			m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+		L_CORE_INFO("Job System Started With {0} Workers", worker_count);
+	}
+
+	JobSystem::~JobSystem() {
+
+		{
+			std::lock_guard lock(m_SleepMutex);
+			m_Running = false;
+		}
+		m_SleepCondition.notify_all();
+
+		for (auto& worker : m_Workers)
+			worker.join();
+	}
+
+	JobHandle JobSystem::Schedule(JobFunction function) {
+		return Schedule(std::move(function), {});
+	}
+
+	JobHandle JobSystem::Schedule(JobFunction function, const std::vector<JobHandle>& dependencies) {
+
+		auto job = std::make_shared<JobHandle::Job>();
+		job->Function = std::move(function);
+
+		for (const JobHandle& dependency : dependencies) {
+
+			if (!dependency.m_Job)
+				continue;
+
+			std::lock_guard lock(dependency.m_Job->ContinuationMutex);
+			if (dependency.m_Job->Finished.load(std::memory_order_acquire))
+				continue;
+
+			job->PendingDependencies.fetch_add(1, std::memory_order_relaxed);
+			job->Dependencies.push_back(dependency.m_Job);
+			dependency.m_Job->Continuations.push_back(job);
+		}
+
+		// Release the hold taken at construction, whoever brings the count to zero queues the job
+		if (job->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			Enqueue(job);
+
+		return JobHandle(job);
+	}
+
+	void JobSystem::Wait(const JobHandle& handle) {
+
+		if (handle.m_Job)
+			WaitForJob(handle.m_Job);
+	}
+
+	void JobSystem::WaitForJob(const std::shared_ptr<JobHandle::Job>& job) {
+
+		// Only this job and what it depends on are ever run here, so a caller holding
+		// a lock never ends up holding it through some unrelated job
+		for (const auto& dependency : job->Dependencies)
+			WaitForJob(dependency);
+
+		std::unique_lock lock(job->ContinuationMutex);
+
+		while (!job->Finished.load(std::memory_order_acquire)) {
+
+			// No worker has picked it up yet, run it here rather than waiting for one to be free
+			if (job->Queued.load(std::memory_order_acquire) && !job->Started.exchange(true, std::memory_order_acq_rel)) {
+				lock.unlock();
+				Execute(job);
+				return;
+			}
+
+			job->StateCondition.wait(lock, [&job]() {
+				return job->Finished.load(std::memory_order_acquire) || (job->Queued.load(std::memory_order_acquire) && !job->Started.load(std::memory_order_acquire));
+			});
+		}
+	}
+
+	void JobSystem::ParallelFor(size_t count, size_t min_batch_size, const std::function<void(size_t, size_t)>& function) {
+
+		if (count == 0)
+			return;
+
+		min_batch_size = std::max<size_t>(min_batch_size, 1);
+
+		const size_t max_batches = static_cast<size_t>(GetWorkerCount()) + 1;
+		const size_t batch_count = std::clamp<size_t>(count / min_batch_size, 1, max_batches);
+
+		if (batch_count == 1) {
+			function(0, count);
+			return;
+		}
+
+		const size_t batch_size = (count + batch_count - 1) / batch_count;
+
+		std::vector<JobHandle> batches;
+		batches.reserve(batch_count - 1);
+
+		for (size_t begin = batch_size; begin < count; begin += batch_size) {
+			size_t end = std::min(begin + batch_size, count);
+			batches.push_back(Schedule([&function, begin, end]() { function(begin, end); }));
+		}
+
+		// The calling thread takes the first batch
+		function(0, std::min(batch_size, count));
+
+		for (const JobHandle& batch : batches)
+			Wait(batch);
+	}
+
+	void JobSystem::WorkerLoop(uint32_t worker_index) {
+
+		s_WorkerIndex = worker_index;
+
+		while (true) {
+
+			if (auto job = TryTakeJob()) {
+
+				// A thread waiting on the job may have already claimed it
+				if (!job->Started.exchange(true, std::memory_order_acq_rel))
+					Execute(job);
+				continue;
+			}
+
+			std::unique_lock lock(m_SleepMutex);
+
+			// Only stop once nothing is left queued, so shutdown never drops work
+			if (!m_Running && m_QueuedJobCount.load(std::memory_order_acquire) == 0)
+				break;
+
+			m_SleepCondition.wait(lock, [this]() { return !m_Running || m_QueuedJobCount.load(std::memory_order_acquire) > 0; });
+		}
+	}
+
+	void JobSystem::Enqueue(std::shared_ptr<JobHandle::Job> job) {
+
+		// Workers push to their own queue, other threads spread jobs across the workers
+		uint32_t queue_index = (s_WorkerIndex < m_Queues.size()) ? s_WorkerIndex : m_NextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(m_Queues.size());
+
+		// Counted before it is pushed, so a worker taking it straight away never sees the count go below zero
+		{
+			std::lock_guard lock(m_SleepMutex);
+			m_QueuedJobCount.fetch_add(1, std::memory_order_release);
+		}
+
+		// Marked before it is pushed, so a waiter can claim it even before a worker sees it
+		{
+			std::lock_guard lock(job->ContinuationMutex);
+			job->Queued.store(true, std::memory_order_release);
+		}
+		job->StateCondition.notify_all();
+
+		{
+			std::lock_guard lock(m_Queues[queue_index]->Mutex);
+			m_Queues[queue_index]->Jobs.push_back(std::move(job));
+		}
+
+		m_SleepCondition.notify_one();
+	}
+
+	std::shared_ptr<JobHandle::Job> JobSystem::TryTakeJob() {
+
+		const uint32_t queue_count = static_cast<uint32_t>(m_Queues.size());
+
+		// Newest job first from our own queue, it is the most likely to still be in cache
+		if (s_WorkerIndex < queue_count) {
+
+			WorkerQueue& own_queue = *m_Queues[s_WorkerIndex];
+
+			std::lock_guard lock(own_queue.Mutex);
+			if (!own_queue.Jobs.empty()) {
+				auto job = std::move(own_queue.Jobs.back());
+				own_queue.Jobs.pop_back();
+				m_QueuedJobCount.fetch_sub(1, std::memory_order_acq_rel);
+				return job;
+			}
+		}
+
+		// Otherwise steal the oldest job from another queue
+		const uint32_t start = (s_WorkerIndex < queue_count) ? s_WorkerIndex + 1 : m_NextQueue.load(std::memory_order_relaxed);
+		for (uint32_t i = 0; i < queue_count; i++) {
+
+			WorkerQueue& queue = *m_Queues[(start + i) % queue_count];
+
+			std::lock_guard lock(queue.Mutex);
+			if (!queue.Jobs.empty()) {
+				auto job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				m_QueuedJobCount.fetch_sub(1, std::memory_order_acq_rel);
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void JobSystem::Execute(const std::shared_ptr<JobHandle::Job>& job) {
+
+		if (job->Function)
+			job->Function();
+
+		// Release the closure now, handles can outlive the job by a long way
+		job->Function = nullptr;
+
+		std::vector<std::shared_ptr<JobHandle::Job>> continuations;
+		{
+			std::lock_guard lock(job->ContinuationMutex);
+			job->Finished.store(true, std::memory_order_release);
+			continuations.swap(job->Continuations);
+		}
+		job->StateCondition.notify_all();
+
+		for (auto& continuation : continuations) {
+			if (continuation->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Enqueue(std::move(continuation));
+		}
+	}
+
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+// Louron Core Headers
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	using JobFunction = std::function<void()>;
+
+	class JobSystem;
+
+	/// <summary>
+	/// Refers to a job scheduled on the JobSystem. Handles are cheap to copy and
+	/// stay valid after the job has finished, a default constructed handle counts
+	/// as already finished.
+	/// </summary>
+	class JobHandle {
+
+	public:
+
+		JobHandle() = default;
+
+		bool IsValid() const { return m_Job != nullptr; }
+		bool IsFinished() const;
+
+	private:
+
+		struct Job;
+
+		explicit JobHandle(std::shared_ptr<Job> job) : m_Job(std::move(job)) { }
+
+		std::shared_ptr<Job> m_Job;
+
+		friend class JobSystem;
+	};
+
+	/// <summary>
+	/// Fixed pool of worker threads, created once with the Engine and kept for its
+	/// lifetime, so systems can hand work off every frame without paying for thread
+	/// creation. Each worker has its own queue and takes jobs from the back of it,
+	/// idle workers steal from the front of the others.
+	///
+	/// A thread that waits on a job runs it itself if no worker has started it yet,
+	/// otherwise it sleeps until the job finishes, so jobs may schedule and wait on
+	/// other jobs without deadlocking the pool or spinning on a core.
+	/// </summary>
+	class JobSystem {
+
+	public:
+
+		/// <summary>
+		/// Start the worker threads. A worker count of zero uses one less than the
+		/// number of hardware threads, leaving a core for the main thread.
+		/// </summary>
+		explicit JobSystem(uint32_t worker_count = 0);
+
+		/// <summary>
+		/// Runs every job still queued, then joins the worker threads.
+		/// </summary>
+		~JobSystem();
+
+		// Delete copy assignment and move assignment constructors
+		JobSystem(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+
+		// Delete copy assignment and move assignment operators
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+		/// <summary>
+		/// Queue a job to run on a worker. Safe to call from any thread.
+		/// </summary>
+		JobHandle Schedule(JobFunction function);
+
+		/// <summary>
+		/// Queue a job that only starts once every dependency has finished.
+		/// </summary>
+		JobHandle Schedule(JobFunction function, const std::vector<JobHandle>& dependencies);
+
+		/// <summary>
+		/// Block until the job has finished. The job and any dependencies no worker has
+		/// started yet are run on the calling thread, no other queued job ever is.
+		/// </summary>
+		void Wait(const JobHandle& handle);
+
+		/// <summary>
+		/// Split [0, count) into batches of at least min_batch_size and run function(begin, end)
+		/// for each across the workers and the calling thread. Returns once every batch is done.
+		/// </summary>
+		void ParallelFor(size_t count, size_t min_batch_size, const std::function<void(size_t, size_t)>& function);
+
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+	private:
+
+		struct WorkerQueue {
+			std::mutex Mutex;
+			std::deque<std::shared_ptr<JobHandle::Job>> Jobs;
+		};
+
+		void WorkerLoop(uint32_t worker_index);
+
+		void WaitForJob(const std::shared_ptr<JobHandle::Job>& job);
+
+		void Enqueue(std::shared_ptr<JobHandle::Job> job);
+		std::shared_ptr<JobHandle::Job> TryTakeJob();
+		void Execute(const std::shared_ptr<JobHandle::Job>& job);
+
+	private:
+
+		std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+		std::vector<std::thread> m_Workers;
+
+		std::atomic<uint32_t> m_NextQueue = 0;
+
+		// Guards the sleep condition, so a job queued while a worker is deciding to sleep still wakes it
+		std::mutex m_SleepMutex;
+		std::condition_variable m_SleepCondition;
+		std::atomic<size_t> m_QueuedJobCount = 0;
+		bool m_Running = true;
+	};
+
+}
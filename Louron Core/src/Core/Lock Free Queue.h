@@ -0,0 +1,100 @@
+#pragma once
+
+// Louron Core Headers
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <vector>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	/// <summary>
+	/// Multi-producer single-consumer queue. Any thread may Push without
+	/// locking, while a single consumer drains everything pushed so far
+	/// with PopAll. Items are returned in the order they were pushed.
+	/// </summary>
+	template<typename T>
+	class LockFreeQueue {
+
+	public:
+
+		LockFreeQueue() = default;
+		~LockFreeQueue() { Clear(); }
+
+		// Delete copy assignment and move assignment constructors
+		LockFreeQueue(const LockFreeQueue&) = delete;
+		LockFreeQueue(LockFreeQueue&&) = delete;
+
+		// Delete copy assignment and move assignment operators
+		LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+		LockFreeQueue& operator=(LockFreeQueue&&) = delete;
+
+		/// <summary>
+		/// Push a value onto the queue. Safe to call from any thread.
+		/// </summary>
+		void Push(const T& value) {
+
+			QueueNode* node = new QueueNode{ value, m_Head.load(std::memory_order_relaxed) };
+			while (!m_Head.compare_exchange_weak(node->Next, node, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		/// <summary>
+		/// Append every value pushed so far to out_values, oldest first.
+		/// Only one thread may consume at a time.
+		/// </summary>
+		/// <returns>The number of values appended.</returns>
+		size_t PopAll(std::vector<T>& out_values) {
+
+			QueueNode* head = m_Head.exchange(nullptr, std::memory_order_acquire);
+
+			size_t count = 0;
+			for (QueueNode* node = head; node; node = node->Next)
+				count++;
+
+			if (count == 0)
+				return 0;
+
+			// Nodes are linked newest first, so fill the output back to front
+			size_t start = out_values.size();
+			out_values.resize(start + count);
+
+			size_t index = start + count;
+			while (head) {
+				QueueNode* next = head->Next;
+				out_values[--index] = std::move(head->Value);
+				delete head;
+				head = next;
+			}
+
+			return count;
+		}
+
+		bool IsEmpty() const { return m_Head.load(std::memory_order_acquire) == nullptr; }
+
+		/// <summary>
+		/// Discard every value currently in the queue.
+		/// </summary>
+		void Clear() {
+
+			QueueNode* head = m_Head.exchange(nullptr, std::memory_order_acquire);
+			while (head) {
+				QueueNode* next = head->Next;
+				delete head;
+				head = next;
+			}
+		}
+
+	private:
+
+		struct QueueNode {
+			T Value;
+			QueueNode* Next = nullptr;
+		};
+
+		std::atomic<QueueNode*> m_Head{ nullptr };
+
+	};
+
+}
@@ -31,8 +31,13 @@
 #include "Scene/Bounds.h"
 #include "Scene/Frustum.h"
 #include "Scene/OctreeBounds.h"
+#include "Scene/BVHBounds.h"
+#include "Scene/Spatial Index.h"
 #include "Scene/Scene Serializer.h"
 
+#include "Scene/Scene Systems/Bounds System.h"
+#include "Scene/Scene Systems/Transform System.h"
+
 #include "Scene/Components/Components.h"
 #include "Scene/Components/Light.h"
 #include "Scene/Components/Mesh.h"
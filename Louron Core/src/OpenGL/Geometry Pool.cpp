@@ -0,0 +1,222 @@
+#include "Geometry Pool.h"
+
+// Louron Core Headers
+#include "../Core/Logging.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+// External Vendor Library Headers
+#include <glm/glm.hpp>
+
+namespace Louron {
+
+	// Binding points of the pool's vertex array
+	static constexpr GLuint s_VertexBinding = 0;
+	static constexpr GLuint s_InstanceBinding = 1;
+
+	// Attribute locations the instanced transform columns are read from, as in Renderer::DrawInstancedSubMesh
+	static constexpr GLuint s_InstanceAttribute = 5;
+
+#pragma region Geometry Pool Allocation
+
+	GeometryPoolAllocation::~GeometryPoolAllocation() {
+		Release();
+	}
+
+	GeometryPoolAllocation::GeometryPoolAllocation(GeometryPoolAllocation&& other) noexcept {
+		m_Pool = std::move(other.m_Pool); other.m_Pool.reset();
+		m_Vertices = other.m_Vertices; other.m_Vertices = {};
+		m_Indices = other.m_Indices; other.m_Indices = {};
+	}
+
+	GeometryPoolAllocation& GeometryPoolAllocation::operator=(GeometryPoolAllocation&& other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		Release();
+
+		m_Pool = std::move(other.m_Pool); other.m_Pool.reset();
+		m_Vertices = other.m_Vertices; other.m_Vertices = {};
+		m_Indices = other.m_Indices; other.m_Indices = {};
+
+		return *this;
+	}
+
+	GeometryDrawRange GeometryPoolAllocation::GetDrawRange() const {
+
+		GeometryDrawRange range;
+		range.FirstIndex = m_Indices.Offset;
+		range.IndexCount = m_Indices.Count;
+		range.BaseVertex = static_cast<int32_t>(m_Vertices.Offset);
+		return range;
+	}
+
+	bool GeometryPoolAllocation::BelongsTo(const std::shared_ptr<GeometryPool>& pool) const {
+		return pool && IsValid() && m_Pool.lock() == pool;
+	}
+
+	void GeometryPoolAllocation::Release() {
+
+		// The pool may already be gone when sub meshes are destroyed at shutdown
+		if (auto pool = m_Pool.lock(); pool && IsValid())
+			pool->Free(m_Vertices, m_Indices);
+
+		m_Pool.reset();
+		m_Vertices = {};
+		m_Indices = {};
+	}
+
+#pragma endregion
+
+#pragma region Geometry Pool
+
+	GeometryPool::GeometryPool(uint32_t vertex_capacity, uint32_t index_capacity) {
+
+		glCreateVertexArrays(1, &m_VAO);
+
+		// Same layout as the Vertex struct, aPos through aBitangent
+		struct PoolAttribute { GLint ComponentCount; GLuint Offset; };
+		const PoolAttribute attributes[] = {
+			{ 3, static_cast<GLuint>(offsetof(Vertex, position)) },
+			{ 3, static_cast<GLuint>(offsetof(Vertex, normal)) },
+			{ 2, static_cast<GLuint>(offsetof(Vertex, texCoords)) },
+			{ 3, static_cast<GLuint>(offsetof(Vertex, tangent)) },
+			{ 3, static_cast<GLuint>(offsetof(Vertex, bitangent)) }
+		};
+
+		for (GLuint i = 0; i < static_cast<GLuint>(std::size(attributes)); i++) {
+			glEnableVertexArrayAttrib(m_VAO, i);
+			glVertexArrayAttribFormat(m_VAO, i, attributes[i].ComponentCount, GL_FLOAT, GL_FALSE, attributes[i].Offset);
+			glVertexArrayAttribBinding(m_VAO, i, s_VertexBinding);
+		}
+
+		// One mat4 per instance, read as four vec4 columns, enabled by SetInstanceBuffer
+		for (GLuint column = 0; column < 4; column++) {
+			glVertexArrayAttribFormat(m_VAO, s_InstanceAttribute + column, 4, GL_FLOAT, GL_FALSE, static_cast<GLuint>(column * sizeof(glm::vec4)));
+			glVertexArrayAttribBinding(m_VAO, s_InstanceAttribute + column, s_InstanceBinding);
+		}
+		glVertexArrayBindingDivisor(m_VAO, s_InstanceBinding, 1);
+
+		GrowVertexBuffer(vertex_capacity);
+		GrowIndexBuffer(index_capacity);
+	}
+
+	GeometryPool::~GeometryPool() {
+
+		glDeleteVertexArrays(1, &m_VAO);
+		glDeleteBuffers(1, &m_VertexBuffer);
+		glDeleteBuffers(1, &m_IndexBuffer);
+	}
+
+	GeometryPoolAllocation GeometryPool::Upload(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices) {
+
+		GeometryPoolAllocation allocation;
+
+		if (vertices.empty() || indices.empty())
+			return allocation;
+
+		const uint32_t vertex_count = static_cast<uint32_t>(vertices.size());
+		const uint32_t index_count = static_cast<uint32_t>(indices.size());
+
+		std::lock_guard lock(m_AllocatorMutex);
+
+		if (!m_VertexAllocator.Allocate(vertex_count, allocation.m_Vertices)) {
+
+			GrowVertexBuffer(std::max(m_VertexAllocator.GetCapacity() * 2, m_VertexAllocator.GetCapacity() + vertex_count));
+
+			if (!m_VertexAllocator.Allocate(vertex_count, allocation.m_Vertices)) {
+				L_CORE_ERROR("Geometry Pool - Could Not Allocate {0} Vertices", vertex_count);
+				return allocation;
+			}
+		}
+
+		if (!m_IndexAllocator.Allocate(index_count, allocation.m_Indices)) {
+
+			GrowIndexBuffer(std::max(m_IndexAllocator.GetCapacity() * 2, m_IndexAllocator.GetCapacity() + index_count));
+
+			if (!m_IndexAllocator.Allocate(index_count, allocation.m_Indices)) {
+				L_CORE_ERROR("Geometry Pool - Could Not Allocate {0} Indices", index_count);
+				m_VertexAllocator.Free(allocation.m_Vertices);
+				allocation.m_Vertices = {};
+				return allocation;
+			}
+		}
+
+		// Indices stay relative to the sub mesh, each draw offsets them by its base vertex
+		glNamedBufferSubData(m_VertexBuffer, static_cast<GLintptr>(allocation.m_Vertices.Offset) * sizeof(Vertex), vertices.size() * sizeof(Vertex), vertices.data());
+		glNamedBufferSubData(m_IndexBuffer, static_cast<GLintptr>(allocation.m_Indices.Offset) * sizeof(GLuint), indices.size() * sizeof(GLuint), indices.data());
+
+		allocation.m_Pool = weak_from_this();
+		return allocation;
+	}
+
+	void GeometryPool::Bind() const {
+		glBindVertexArray(m_VAO);
+	}
+
+	void GeometryPool::UnBind() const {
+		glBindVertexArray(0);
+	}
+
+	void GeometryPool::SetInstanceBuffer(GLuint buffer) const {
+
+		glVertexArrayVertexBuffer(m_VAO, s_InstanceBinding, buffer, 0, sizeof(glm::mat4));
+
+		for (GLuint column = 0; column < 4; column++) {
+			if (buffer)
+				glEnableVertexArrayAttrib(m_VAO, s_InstanceAttribute + column);
+			else
+				glDisableVertexArrayAttrib(m_VAO, s_InstanceAttribute + column);
+		}
+	}
+
+	void GeometryPool::Free(const GeometryRange& vertices, const GeometryRange& indices) {
+
+		std::lock_guard lock(m_AllocatorMutex);
+
+		m_VertexAllocator.Free(vertices);
+		m_IndexAllocator.Free(indices);
+	}
+
+	void GeometryPool::GrowVertexBuffer(uint32_t vertex_capacity) {
+
+		GLuint buffer = 0;
+		glCreateBuffers(1, &buffer);
+		glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(vertex_capacity) * sizeof(Vertex), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		// Draws already submitted keep reading the old buffer until the GPU is done with it
+		if (m_VertexBuffer) {
+			glCopyNamedBufferSubData(m_VertexBuffer, buffer, 0, 0, static_cast<GLsizeiptr>(m_VertexAllocator.GetCapacity()) * sizeof(Vertex));
+			glDeleteBuffers(1, &m_VertexBuffer);
+		}
+
+		m_VertexBuffer = buffer;
+		m_VertexAllocator.Grow(vertex_capacity);
+
+		glVertexArrayVertexBuffer(m_VAO, s_VertexBinding, m_VertexBuffer, 0, sizeof(Vertex));
+	}
+
+	void GeometryPool::GrowIndexBuffer(uint32_t index_capacity) {
+
+		GLuint buffer = 0;
+		glCreateBuffers(1, &buffer);
+		glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(index_capacity) * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		if (m_IndexBuffer) {
+			glCopyNamedBufferSubData(m_IndexBuffer, buffer, 0, 0, static_cast<GLsizeiptr>(m_IndexAllocator.GetCapacity()) * sizeof(GLuint));
+			glDeleteBuffers(1, &m_IndexBuffer);
+		}
+
+		m_IndexBuffer = buffer;
+		m_IndexAllocator.Grow(index_capacity);
+
+		glVertexArrayElementBuffer(m_VAO, m_IndexBuffer);
+	}
+
+#pragma endregion
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+// Louron Core Headers
+#include "Buffer.h"
+
+#include "../Renderer/Geometry Range Allocator.h"
+#include "../Renderer/Indirect Draw List.h"
+
+// C++ Standard Library Headers
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// External Vendor Library Headers
+#include <glad/glad.h>
+
+namespace Louron {
+
+	class GeometryPool;
+
+	/// <summary>
+	/// The vertices and indices of one sub mesh in the geometry pool. Gives
+	/// its ranges back to the pool when destroyed, which is safe from any thread.
+	/// </summary>
+	class GeometryPoolAllocation {
+
+	public:
+
+		GeometryPoolAllocation() = default;
+		~GeometryPoolAllocation();
+
+		GeometryPoolAllocation(const GeometryPoolAllocation&) = delete;
+		GeometryPoolAllocation& operator=(const GeometryPoolAllocation&) = delete;
+
+		GeometryPoolAllocation(GeometryPoolAllocation&& other) noexcept;
+		GeometryPoolAllocation& operator=(GeometryPoolAllocation&& other) noexcept;
+
+		bool IsValid() const { return m_Indices.Count > 0; }
+
+		GeometryDrawRange GetDrawRange() const;
+
+		/// <summary>
+		/// Whether this allocation was made from the given pool, which it will not
+		/// be once the pool it came from has been destroyed.
+		/// </summary>
+		bool BelongsTo(const std::shared_ptr<GeometryPool>& pool) const;
+
+	private:
+
+		void Release();
+
+		std::weak_ptr<GeometryPool> m_Pool;
+		GeometryRange m_Vertices{};
+		GeometryRange m_Indices{};
+
+		friend class GeometryPool;
+	};
+
+	/// <summary>
+	/// Every sub mesh's vertices and indices suballocated from one shared vertex
+	/// buffer and one shared index buffer, drawn through a single vertex array.
+	/// With all geometry behind the same bindings, any mix of meshes can be drawn
+	/// with one glMultiDrawElementsIndirect call instead of one draw per vertex array.
+	///
+	/// The buffers grow by copying into larger ones when a sub mesh does not fit.
+	/// Owned by the Renderer, see Renderer::GetGeometryPool.
+	/// </summary>
+	class GeometryPool : public std::enable_shared_from_this<GeometryPool> {
+
+	public:
+
+		GeometryPool(uint32_t vertex_capacity, uint32_t index_capacity);
+		~GeometryPool();
+
+		// Delete copy assignment and move assignment constructors
+		GeometryPool(const GeometryPool&) = delete;
+		GeometryPool(GeometryPool&&) = delete;
+
+		// Delete copy assignment and move assignment operators
+		GeometryPool& operator=(const GeometryPool&) = delete;
+		GeometryPool& operator=(GeometryPool&&) = delete;
+
+		/// <summary>
+		/// Copy a sub mesh into the pool. Must be called from the thread that owns
+		/// the OpenGL context. Returns an invalid allocation if the mesh is empty.
+		/// </summary>
+		GeometryPoolAllocation Upload(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices);
+
+		void Bind() const;
+		void UnBind() const;
+
+		/// <summary>
+		/// Source the per instance transform attributes from the given buffer. They
+		/// stay disabled until a buffer is set, and are disabled again by passing 0
+		/// for draws that do not read instance data.
+		/// </summary>
+		void SetInstanceBuffer(GLuint buffer) const;
+
+		GLuint GetVAO() const { return m_VAO; }
+
+	private:
+
+		void Free(const GeometryRange& vertices, const GeometryRange& indices);
+
+		void GrowVertexBuffer(uint32_t vertex_capacity);
+		void GrowIndexBuffer(uint32_t index_capacity);
+
+	private:
+
+		GLuint m_VAO = 0;
+		GLuint m_VertexBuffer = 0;
+		GLuint m_IndexBuffer = 0;
+
+		// Ranges can be freed from whichever thread drops the last reference to a sub mesh
+		std::mutex m_AllocatorMutex;
+		GeometryRangeAllocator m_VertexAllocator;
+		GeometryRangeAllocator m_IndexAllocator;
+
+		friend class GeometryPoolAllocation;
+	};
+
+}
@@ -0,0 +1,159 @@
+#include "Instance Buffer Ring.h"
+
+// Louron Core Headers
+#include "../Core/Logging.h"
+#include "../Debug/Profiler.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	// Regions start on this boundary so any alignment a caller asks for lines up within a region
+	static constexpr GLsizeiptr s_RegionAlignment = 256;
+
+	static GLsizeiptr AlignUp(GLsizeiptr value, GLsizeiptr alignment) {
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+
+	InstanceBufferRing::InstanceBufferRing(GLenum target, GLsizeiptr initial_region_size) : m_Target(target), m_RegionSize(AlignUp(std::max<GLsizeiptr>(initial_region_size, s_RegionAlignment), s_RegionAlignment)) {
+
+	}
+
+	InstanceBufferRing::~InstanceBufferRing() {
+		Release();
+	}
+
+	void InstanceBufferRing::BeginFrame() {
+
+		if (!m_Buffer)
+			Create(m_RegionSize);
+		else
+			m_Region = (m_Region + 1) % FramesInFlight;
+
+		m_RegionOffset = 0;
+		m_FrameActive = true;
+
+		GLsync& fence = m_Fences[m_Region];
+		if (!fence)
+			return;
+
+		L_PROFILE_SCOPE("Instance Buffer Ring - Fence Wait");
+
+		// Only blocks if the CPU has got a full ring of frames ahead of the GPU
+		while (true) {
+
+			GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+				break;
+
+			if (result == GL_WAIT_FAILED) {
+				L_CORE_ERROR("Instance Buffer Ring - Failed Waiting On Region Fence");
+				break;
+			}
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	void InstanceBufferRing::EndFrame() {
+
+		if (!m_Buffer || !m_FrameActive)
+			return;
+
+		// Nothing was written, the region is still free to use
+		if (m_RegionOffset != 0) {
+
+			if (m_Fences[m_Region])
+				glDeleteSync(m_Fences[m_Region]);
+
+			m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		m_FrameActive = false;
+	}
+
+	void* InstanceBufferRing::Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& out_offset) {
+
+		if (!m_FrameActive)
+			BeginFrame();
+
+		if (!m_MappedData)
+			return nullptr;
+
+		alignment = std::max<GLsizeiptr>(alignment, 1);
+
+		const GLsizeiptr region_start = static_cast<GLsizeiptr>(m_Region) * m_RegionSize;
+		GLsizeiptr offset = AlignUp(region_start + m_RegionOffset, alignment);
+
+		if (offset + size > region_start + m_RegionSize) {
+
+			// Grow to fit the whole frame so far plus this allocation, the regions already
+			// in flight stay alive in the old buffer until the GPU is done with them
+			GLsizeiptr region_size = AlignUp(std::max(m_RegionSize * 2, m_RegionOffset + size + alignment), s_RegionAlignment);
+
+			L_CORE_INFO("Instance Buffer Ring - Growing Regions From {0} To {1} Bytes", m_RegionSize, region_size);
+
+			Release();
+			Create(region_size);
+
+			if (!m_MappedData)
+				return nullptr;
+
+			m_FrameActive = true;
+			offset = 0;
+		}
+
+		m_RegionOffset = offset + size - static_cast<GLsizeiptr>(m_Region) * m_RegionSize;
+
+		out_offset = static_cast<GLintptr>(offset);
+		return m_MappedData + offset;
+	}
+
+	void InstanceBufferRing::Release() {
+
+		for (GLsync& fence : m_Fences) {
+			if (fence) {
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		if (m_Buffer) {
+
+			glBindBuffer(m_Target, m_Buffer);
+			glUnmapBuffer(m_Target);
+			glBindBuffer(m_Target, 0);
+
+			glDeleteBuffers(1, &m_Buffer);
+			m_Buffer = 0;
+		}
+
+		m_MappedData = nullptr;
+		m_Region = 0;
+		m_RegionOffset = 0;
+		m_FrameActive = false;
+	}
+
+	void InstanceBufferRing::Create(GLsizeiptr region_size) {
+
+		m_RegionSize = region_size;
+		m_Region = 0;
+		m_RegionOffset = 0;
+
+		constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glGenBuffers(1, &m_Buffer);
+		glBindBuffer(m_Target, m_Buffer);
+		glBufferStorage(m_Target, m_RegionSize * FramesInFlight, nullptr, flags);
+		m_MappedData = static_cast<uint8_t*>(glMapBufferRange(m_Target, 0, m_RegionSize * FramesInFlight, flags));
+		glBindBuffer(m_Target, 0);
+
+		if (!m_MappedData)
+			L_CORE_ERROR("Instance Buffer Ring - Could Not Persistently Map Buffer");
+	}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// Louron Core Headers
+
+// C++ Standard Library Headers
+#include <array>
+#include <cstdint>
+
+// External Vendor Library Headers
+#include <glad/glad.h>
+
+namespace Louron {
+
+	/// <summary>
+	/// A persistently mapped buffer split into one region per frame in flight.
+	/// The CPU writes straight into the mapped memory of the current region while
+	/// the GPU is still reading the regions of the previous frames, so streaming
+	/// per frame data never stalls on the driver or orphans the buffer.
+	///
+	/// Each region is fenced at the end of its frame, and the fence is waited on
+	/// before the region is written again. If a frame needs more space than a
+	/// region holds, the buffer is recreated larger and the frame carries on in
+	/// the new buffer, draws already submitted keep reading the old one.
+	/// </summary>
+	class InstanceBufferRing {
+
+	public:
+
+		static constexpr uint32_t FramesInFlight = 3;
+
+		InstanceBufferRing(GLenum target = GL_ARRAY_BUFFER, GLsizeiptr initial_region_size = 64 * 1024);
+		~InstanceBufferRing();
+
+		// Delete copy assignment and move assignment constructors
+		InstanceBufferRing(const InstanceBufferRing&) = delete;
+		InstanceBufferRing(InstanceBufferRing&&) = delete;
+
+		// Delete copy assignment and move assignment operators
+		InstanceBufferRing& operator=(const InstanceBufferRing&) = delete;
+		InstanceBufferRing& operator=(InstanceBufferRing&&) = delete;
+
+		/// <summary>
+		/// Move on to the next region, waiting for the GPU to finish with it first.
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// Fence the current region so it is not written again until the GPU has read it.
+		/// </summary>
+		void EndFrame();
+
+		/// <summary>
+		/// Reserve size bytes in the current region, aligned to alignment from the start
+		/// of the buffer. Returns the mapped pointer to write to and sets out_offset to
+		/// the byte offset of the allocation in the buffer. The returned pointer is only
+		/// valid until the next call to Allocate, as the buffer may be recreated. Returns
+		/// nullptr if the buffer could not be mapped.
+		/// </summary>
+		void* Allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& out_offset);
+
+		GLuint GetBuffer() const { return m_Buffer; }
+		GLenum GetTarget() const { return m_Target; }
+
+		void Release();
+
+	private:
+
+		void Create(GLsizeiptr region_size);
+
+	private:
+
+		GLenum m_Target = GL_ARRAY_BUFFER;
+		GLuint m_Buffer = 0;
+		uint8_t* m_MappedData = nullptr;
+
+		GLsizeiptr m_RegionSize = 0;
+		GLsizeiptr m_RegionOffset = 0;
+		uint32_t m_Region = 0;
+		bool m_FrameActive = false;
+
+		std::array<GLsync, FramesInFlight> m_Fences{};
+	};
+
+}
@@ -266,7 +266,7 @@ namespace Louron {
 		scnConfig.AssetDirectory = m_ProjectDirectory / "Assets";
 		m_ActiveScene->SetConfig(scnConfig);
 
-		m_ActiveScene->m_Octree = std::make_shared<OctreeBounds<Entity>>();
+		m_ActiveScene->BuildSpatialIndex();
 
 		SaveScene();
 
@@ -328,8 +328,8 @@ namespace Louron {
 		scnConfig.AssetDirectory = m_ProjectDirectory / "Assets";
 		m_ActiveScene->SetConfig(scnConfig);
 
-		if(!m_ActiveScene->m_Octree)
-			m_ActiveScene->m_Octree = std::make_shared<OctreeBounds<Entity>>();
+		if(!m_ActiveScene->m_SpatialIndex)
+			m_ActiveScene->BuildSpatialIndex();
 		
 		L_CORE_INFO("Scene Loaded: {0}", scene_file_path.filename().string());
 		return scene;
@@ -0,0 +1,180 @@
+#include "Geometry Range Allocator.h"
+
+// Louron Core Headers
+#include "../Core/Logging.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <iterator>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	GeometryRangeAllocator::GeometryRangeAllocator(uint32_t capacity) {
+		Grow(capacity);
+	}
+
+	bool GeometryRangeAllocator::Allocate(uint32_t count, GeometryRange& out_range) {
+
+		if (count == 0)
+			return false;
+
+		for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it) {
+
+			auto [offset, free_count] = *it;
+			if (free_count < count)
+				continue;
+
+			m_FreeRanges.erase(it);
+
+			// Keep whatever is left of the range free
+			if (free_count > count)
+				m_FreeRanges.emplace(offset + count, free_count - count);
+
+			out_range = { offset, count };
+			m_UsedCount += count;
+			return true;
+		}
+
+		return false;
+	}
+
+	void GeometryRangeAllocator::Free(const GeometryRange& range) {
+
+		if (range.Count == 0 || range.Offset + range.Count > m_Capacity)
+			return;
+
+		InsertFreeRange(range.Offset, range.Count);
+		m_UsedCount -= std::min(m_UsedCount, range.Count);
+	}
+
+	void GeometryRangeAllocator::Grow(uint32_t new_capacity) {
+
+		if (new_capacity <= m_Capacity)
+			return;
+
+		const uint32_t old_capacity = m_Capacity;
+		m_Capacity = new_capacity;
+
+		InsertFreeRange(old_capacity, new_capacity - old_capacity);
+	}
+
+	uint32_t GeometryRangeAllocator::GetLargestFreeRange() const {
+
+		uint32_t largest = 0;
+		for (const auto& [offset, count] : m_FreeRanges)
+			largest = std::max(largest, count);
+
+		return largest;
+	}
+
+	void GeometryRangeAllocator::InsertFreeRange(uint32_t offset, uint32_t count) {
+
+		auto next = m_FreeRanges.lower_bound(offset);
+
+		// Merge with the free range that ends where this one starts
+		if (next != m_FreeRanges.begin()) {
+
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset) {
+				offset = previous->first;
+				count += previous->second;
+				m_FreeRanges.erase(previous);
+			}
+		}
+
+		// Merge with the free range that starts where this one ends
+		if (next != m_FreeRanges.end() && offset + count == next->first) {
+			count += next->second;
+			m_FreeRanges.erase(next);
+		}
+
+		m_FreeRanges.emplace(offset, count);
+	}
+
+	bool GeometryRangeAllocator::RunSelfTest() {
+
+		auto check = [](bool condition, const char* message) -> bool {
+			if (!condition)
+				L_CORE_ERROR("Geometry Range Allocator Self Test - {0}", message);
+			return condition;
+		};
+
+		GeometryRange a{}, b{}, c{}, d{};
+
+		// 1. First fit hands out ranges front to back and fails once full
+		{
+			GeometryRangeAllocator allocator(100);
+
+			if (!check(allocator.Allocate(10, a) && a.Offset == 0 && a.Count == 10, "First Allocation Not at the Start."))
+				return false;
+			if (!check(allocator.Allocate(20, b) && b.Offset == 10, "Second Allocation Not After the First."))
+				return false;
+			if (!check(allocator.Allocate(70, c) && c.Offset == 30 && allocator.GetUsedCount() == 100, "Allocation Filling the Capacity Failed."))
+				return false;
+			if (!check(!allocator.Allocate(1, d) && !allocator.Allocate(0, d), "Allocation Succeeded With No Free Space or No Count."))
+				return false;
+
+			// A freed hole is reused by the first allocation that fits, even with a larger hole after it
+			allocator.Free(a);
+			allocator.Free(c);
+			if (!check(allocator.Allocate(5, d) && d.Offset == 0, "First Fit Did Not Take the First Free Range."))
+				return false;
+			if (!check(allocator.Allocate(10, d) && d.Offset == 30, "First Fit Did Not Skip a Range Too Small."))
+				return false;
+		}
+
+		// 2. Freed ranges merge with the free range before and after them
+		{
+			GeometryRangeAllocator allocator(30);
+			allocator.Allocate(10, a);
+			allocator.Allocate(10, b);
+			allocator.Allocate(10, c);
+
+			allocator.Free(a);
+			allocator.Free(b);
+			if (!check(allocator.GetLargestFreeRange() == 20, "Freed Range Did Not Merge With the Range Before It."))
+				return false;
+
+			allocator.Allocate(20, a);
+			allocator.Free(c);
+			allocator.Free(a);
+			if (!check(allocator.GetLargestFreeRange() == 30 && allocator.GetUsedCount() == 0, "Freed Range Did Not Merge With the Range After It."))
+				return false;
+
+			// Freeing the middle range last joins both neighbours into one
+			allocator.Allocate(10, a);
+			allocator.Allocate(10, b);
+			allocator.Allocate(10, c);
+			allocator.Free(a);
+			allocator.Free(c);
+			allocator.Free(b);
+			if (!check(allocator.GetLargestFreeRange() == 30 && allocator.Allocate(30, d) && d.Offset == 0, "Freed Range Did Not Merge With Both Neighbours."))
+				return false;
+		}
+
+		// 3. Grow appends to the free list, merging with free space at the end
+		{
+			GeometryRangeAllocator allocator(20);
+			allocator.Allocate(10, a);
+
+			allocator.Grow(10);
+			if (!check(allocator.GetCapacity() == 20, "Grow Shrank the Capacity."))
+				return false;
+
+			allocator.Grow(50);
+			if (!check(allocator.GetCapacity() == 50 && allocator.GetLargestFreeRange() == 40, "Grow Did Not Merge With the Free Range at the End."))
+				return false;
+			if (!check(allocator.Allocate(40, b) && b.Offset == 10 && allocator.GetUsedCount() == 50, "Allocation Into Grown Space Failed."))
+				return false;
+
+			allocator.Grow(60);
+			if (!check(allocator.Allocate(10, c) && c.Offset == 50, "Grow on a Full Allocator Did Not Add a Free Range."))
+				return false;
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+// Louron Core Headers
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <map>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	/// <summary>
+	/// A contiguous run of elements within a pooled buffer.
+	/// </summary>
+	struct GeometryRange {
+		uint32_t Offset = 0;
+		uint32_t Count = 0;
+	};
+
+	/// <summary>
+	/// Hands out ranges of a fixed capacity of elements, first fit from a free list
+	/// that merges neighbouring ranges as they are freed. Only does the bookkeeping,
+	/// the buffer the ranges refer to belongs to the caller, so this has no GPU
+	/// dependency at all.
+	/// </summary>
+	class GeometryRangeAllocator {
+
+	public:
+
+		GeometryRangeAllocator() = default;
+		explicit GeometryRangeAllocator(uint32_t capacity);
+
+		/// <summary>
+		/// Reserve count elements. Returns false, leaving out_range untouched,
+		/// if no free range is large enough.
+		/// </summary>
+		bool Allocate(uint32_t count, GeometryRange& out_range);
+
+		/// <summary>
+		/// Return a range handed out by Allocate so it can be reused.
+		/// </summary>
+		void Free(const GeometryRange& range);
+
+		/// <summary>
+		/// Extend the capacity, the new elements are added to the end of the free list.
+		/// </summary>
+		void Grow(uint32_t new_capacity);
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		uint32_t GetUsedCount() const { return m_UsedCount; }
+		uint32_t GetLargestFreeRange() const;
+
+		/// <summary>
+		/// Check first fit allocation, merging freed ranges with the range before and
+		/// after them, and Grow, on allocators of its own. The first failed check is
+		/// logged. Debug builds run this at start up.
+		/// </summary>
+		/// <returns>True if every check passed.</returns>
+		static bool RunSelfTest();
+
+	private:
+
+		void InsertFreeRange(uint32_t offset, uint32_t count);
+
+	private:
+
+		uint32_t m_Capacity = 0;
+		uint32_t m_UsedCount = 0;
+
+		// Free ranges keyed by offset, never touching one another
+		std::map<uint32_t, uint32_t> m_FreeRanges;
+	};
+
+}
@@ -0,0 +1,138 @@
+#include "Indirect Draw List.h"
+
+// Louron Core Headers
+#include "../Core/Logging.h"
+#include "../Debug/Profiler.h"
+
+// C++ Standard Library Headers
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	void IndirectDrawList::Build(const std::vector<DrawItem>& draw_items, const std::vector<GeometryDrawRange>& geometry_ranges) {
+
+		L_PROFILE_SCOPE("Indirect Draw List - Build");
+
+		Clear();
+
+		size_t bucket_begin = 0;
+		while (bucket_begin < draw_items.size()) {
+
+			const DrawItem& bucket_item = draw_items[bucket_begin];
+
+			size_t bucket_end = bucket_begin + 1;
+			while (bucket_end < draw_items.size() && draw_items[bucket_end].MaterialID == bucket_item.MaterialID && draw_items[bucket_end].UniformBlockID == bucket_item.UniformBlockID)
+				bucket_end++;
+
+			IndirectDrawBucket& bucket = m_Buckets.emplace_back();
+			bucket.MaterialID = bucket_item.MaterialID;
+			bucket.UniformBlockID = bucket_item.UniformBlockID;
+			bucket.FirstCommand = static_cast<uint32_t>(m_Commands.size());
+			bucket.FirstFallback = static_cast<uint32_t>(m_Fallbacks.size());
+
+			// Each run of the same sub mesh becomes one command
+			for (size_t run_begin = bucket_begin; run_begin < bucket_end;) {
+
+				const uint32_t sub_mesh_id = draw_items[run_begin].SubMeshID;
+
+				size_t run_end = run_begin + 1;
+				while (run_end < bucket_end && draw_items[run_end].SubMeshID == sub_mesh_id)
+					run_end++;
+
+				const uint32_t first_instance = static_cast<uint32_t>(run_begin);
+				const uint32_t instance_count = static_cast<uint32_t>(run_end - run_begin);
+
+				run_begin = run_end;
+
+				const bool pooled = sub_mesh_id < geometry_ranges.size() && geometry_ranges[sub_mesh_id].IndexCount > 0;
+				if (!pooled) {
+					m_Fallbacks.push_back({ sub_mesh_id, first_instance, instance_count });
+					continue;
+				}
+
+				const GeometryDrawRange& range = geometry_ranges[sub_mesh_id];
+
+				DrawElementsIndirectCommand& command = m_Commands.emplace_back();
+				command.Count = range.IndexCount;
+				command.InstanceCount = instance_count;
+				command.FirstIndex = range.FirstIndex;
+				command.BaseVertex = range.BaseVertex;
+				command.BaseInstance = first_instance;
+			}
+
+			bucket.CommandCount = static_cast<uint32_t>(m_Commands.size()) - bucket.FirstCommand;
+			bucket.FallbackCount = static_cast<uint32_t>(m_Fallbacks.size()) - bucket.FirstFallback;
+
+			bucket_begin = bucket_end;
+		}
+	}
+
+	void IndirectDrawList::Clear() {
+		m_Buckets.clear();
+		m_Commands.clear();
+		m_Fallbacks.clear();
+	}
+
+	bool IndirectDrawList::RunSelfTest() {
+
+		auto check = [](bool condition, const char* message) -> bool {
+			if (!condition)
+				L_CORE_ERROR("Indirect Draw List Self Test - {0}", message);
+			return condition;
+		};
+
+		// Sub meshes 0 and 2 are pooled, 1 is not and 3 is past the end of the ranges
+		std::vector<GeometryDrawRange> geometry_ranges = {
+			{ 0, 36, 0 },
+			{ 0, 0, 0 },
+			{ 36, 12, 24 }
+		};
+
+		// Material 1 block 0 holds a run of 3, a fallback run of 2 and a run of 1. Material 1 
+		// block 1 splits off a bucket of its own, and material 2 holds only fallbacks
+		std::vector<DrawItem> draw_items = {
+			{ 0, 0, 1, 0, 0 }, { 0, 1, 1, 0, 0 }, { 0, 2, 1, 0, 0 },
+			{ 0, 3, 1, 0, 1 }, { 0, 4, 1, 0, 1 },
+			{ 0, 5, 1, 0, 2 },
+			{ 0, 6, 1, 1, 2 }, { 0, 7, 1, 1, 2 },
+			{ 0, 8, 2, 0, 3 }
+		};
+
+		IndirectDrawList draw_list;
+		draw_list.Build(draw_items, geometry_ranges);
+
+		const auto& buckets = draw_list.GetBuckets();
+		const auto& commands = draw_list.GetCommands();
+		const auto& fallbacks = draw_list.GetFallbacks();
+
+		if (!check(buckets.size() == 3 && commands.size() == 3 && fallbacks.size() == 2, "Wrong Number of Buckets, Commands or Fallbacks."))
+			return false;
+
+		if (!check(buckets[0].MaterialID == 1 && buckets[0].UniformBlockID == 0 && buckets[0].FirstCommand == 0 && buckets[0].CommandCount == 2 && buckets[0].FirstFallback == 0 && buckets[0].FallbackCount == 1, "First Bucket Does Not Hold Its Runs."))
+			return false;
+		if (!check(buckets[1].MaterialID == 1 && buckets[1].UniformBlockID == 1 && buckets[1].FirstCommand == 2 && buckets[1].CommandCount == 1 && buckets[1].FallbackCount == 0, "Uniform Block Change Did Not Start a New Bucket."))
+			return false;
+		if (!check(buckets[2].MaterialID == 2 && buckets[2].CommandCount == 0 && buckets[2].FirstFallback == 1 && buckets[2].FallbackCount == 1, "Material Change Did Not Start a New Bucket."))
+			return false;
+
+		if (!check(commands[0].Count == 36 && commands[0].InstanceCount == 3 && commands[0].FirstIndex == 0 && commands[0].BaseVertex == 0 && commands[0].BaseInstance == 0, "Run of One Sub Mesh Did Not Become One Command."))
+			return false;
+		if (!check(commands[1].Count == 12 && commands[1].InstanceCount == 1 && commands[1].FirstIndex == 36 && commands[1].BaseVertex == 24 && commands[1].BaseInstance == 5, "Command Does Not Use the Pooled Range and Draw Item Index."))
+			return false;
+		if (!check(commands[2].InstanceCount == 2 && commands[2].BaseInstance == 6, "Run Split Across Buckets Not Drawn Separately."))
+			return false;
+
+		if (!check(fallbacks[0].SubMeshID == 1 && fallbacks[0].FirstInstance == 3 && fallbacks[0].InstanceCount == 2, "Sub Mesh Missing From the Pool Not Kept as a Fallback."))
+			return false;
+		if (!check(fallbacks[1].SubMeshID == 3 && fallbacks[1].FirstInstance == 8 && fallbacks[1].InstanceCount == 1, "Sub Mesh Past the Geometry Ranges Not Kept as a Fallback."))
+			return false;
+
+		draw_list.Build({}, geometry_ranges);
+		if (!check(draw_list.IsEmpty() && draw_list.GetCommands().empty() && draw_list.GetFallbacks().empty(), "Building an Empty Draw List Left Draws Behind."))
+			return false;
+
+		return true;
+	}
+
+}
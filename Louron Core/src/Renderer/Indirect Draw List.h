@@ -0,0 +1,106 @@
+#pragma once
+
+// Louron Core Headers
+#include "Render Queue.h"
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <vector>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	/// <summary>
+	/// Matches the layout glMultiDrawElementsIndirect reads from the indirect buffer.
+	/// </summary>
+	struct DrawElementsIndirectCommand {
+		uint32_t Count = 0;
+		uint32_t InstanceCount = 0;
+		uint32_t FirstIndex = 0;
+		int32_t BaseVertex = 0;
+		uint32_t BaseInstance = 0;
+	};
+
+	static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand must match the GL indirect command layout.");
+
+	/// <summary>
+	/// Where a sub mesh's indices and vertices sit in the geometry pool.
+	/// An index count of zero means the sub mesh is not in the pool.
+	/// </summary>
+	struct GeometryDrawRange {
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+		int32_t BaseVertex = 0;
+	};
+
+	/// <summary>
+	/// A run of draws sharing a material and uniform block, so it can be submitted
+	/// with one material bind and one multi draw. Draws of sub meshes missing from
+	/// the pool are kept as fallbacks to be drawn one at a time.
+	/// </summary>
+	struct IndirectDrawBucket {
+		uint32_t MaterialID = RENDER_RESOURCE_NULL_ID;
+		uint32_t UniformBlockID = RENDER_RESOURCE_NULL_ID;
+
+		uint32_t FirstCommand = 0;
+		uint32_t CommandCount = 0;
+
+		uint32_t FirstFallback = 0;
+		uint32_t FallbackCount = 0;
+	};
+
+	/// <summary>
+	/// Instances of one sub mesh that could not be drawn through the pool.
+	/// </summary>
+	struct IndirectDrawFallback {
+		uint32_t SubMeshID = RENDER_RESOURCE_NULL_ID;
+		uint32_t FirstInstance = 0;
+		uint32_t InstanceCount = 0;
+	};
+
+	/// <summary>
+	/// Turns a sorted draw list into indirect draw commands, one per run of the same
+	/// sub mesh, grouped into buckets per material and uniform block.
+	///
+	/// Instance i of the draw list is expected at instance i of the instance data, so
+	/// BaseInstance is the index of a run's first item. The caller offsets it by
+	/// wherever the instance data was written this frame.
+	///
+	/// Only reads the draw items and geometry ranges, so it can be built on any
+	/// thread and has no GPU dependency.
+	/// </summary>
+	class IndirectDrawList {
+
+	public:
+
+		/// <summary>
+		/// Rebuild from draw items sorted so equal material, uniform block and sub mesh
+		/// ids are next to each other. geometry_ranges is indexed by sub mesh id.
+		/// </summary>
+		void Build(const std::vector<DrawItem>& draw_items, const std::vector<GeometryDrawRange>& geometry_ranges);
+
+		void Clear();
+
+		bool IsEmpty() const { return m_Buckets.empty(); }
+
+		const std::vector<IndirectDrawBucket>& GetBuckets() const { return m_Buckets; }
+		const std::vector<DrawElementsIndirectCommand>& GetCommands() const { return m_Commands; }
+		const std::vector<IndirectDrawFallback>& GetFallbacks() const { return m_Fallbacks; }
+
+		/// <summary>
+		/// Check Build against a small hand made draw list with pooled and unpooled sub
+		/// meshes, covering bucket splits, runs and fallbacks. The first failed check
+		/// is logged. Debug builds run this at start up.
+		/// </summary>
+		/// <returns>True if every check passed.</returns>
+		static bool RunSelfTest();
+
+	private:
+
+		std::vector<IndirectDrawBucket> m_Buckets;
+		std::vector<DrawElementsIndirectCommand> m_Commands;
+		std::vector<IndirectDrawFallback> m_Fallbacks;
+	};
+
+}
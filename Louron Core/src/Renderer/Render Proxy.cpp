@@ -0,0 +1,325 @@
+#include "Render Proxy.h"
+
+// Louron Core Headers
+#include "../Asset/Asset Manager API.h"
+
+#include "../OpenGL/Material.h"
+#include "../OpenGL/Shader.h"
+
+#include "../Scene/Scene.h"
+#include "../Scene/Components/Components.h"
+#include "../Scene/Components/Mesh.h"
+#include "../Scene/Scene Systems/Bounds System.h"
+
+#include "../Debug/Profiler.h"
+
+// C++ Standard Library Headers
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	static uint32_t GetEntityNumber(entt::entity entity_handle) {
+		return static_cast<uint32_t>(entt::to_integral(entity_handle) & entt::entt_traits<entt::entity>::entity_mask);
+	}
+
+	void RenderProxyStore::Sync(Scene* scene) {
+
+		L_PROFILE_SCOPE("Render Proxy Store - Sync");
+
+		if (!scene)
+			return;
+
+		entt::registry* registry = scene->GetRegistry();
+
+		m_DirtyEntities.clear();
+
+		if (scene != m_Scene) {
+
+			Clear();
+			m_Scene = scene;
+
+			// Everything queued so far is covered by rebuilding every proxy
+			scene->GetRenderProxyDirtyQueue().PopAll(m_DirtyEntities);
+			m_DirtyEntities.clear();
+
+			auto view = registry->view<MeshFilterComponent, MeshRendererComponent>(entt::exclude<DespawnedComponent>);
+			for (auto entity_handle : view)
+				m_DirtyEntities.push_back(entity_handle);
+		}
+		else {
+
+			scene->GetRenderProxyDirtyQueue().PopAll(m_DirtyEntities);
+
+			m_DirtyEntities.insert(m_DirtyEntities.end(), m_StaleEntities.begin(), m_StaleEntities.end());
+			m_StaleEntities.clear();
+		}
+
+		if (m_DirtyEntities.empty()) {
+			ReclaimResourceIDs();
+			return;
+		}
+
+		// Cleared first so a change made from here on queues the entity again
+		for (auto entity_handle : m_DirtyEntities) {
+			if (registry->valid(entity_handle) && registry->has<MeshFilterComponent>(entity_handle))
+				registry->get<MeshFilterComponent>(entity_handle).RenderProxyNeedsUpdate.store(false, std::memory_order_release);
+		}
+
+		// The proxy bounds need to be current this frame, so compute them now rather than waiting for the octree update
+		BoundsSystem::UpdateTransformedAABBs(scene, m_DirtyEntities);
+
+		for (auto entity_handle : m_DirtyEntities) {
+
+			if (!registry->valid(entity_handle) || !registry->has<MeshFilterComponent, MeshRendererComponent>(entity_handle) || registry->has<DespawnedComponent>(entity_handle)) {
+				RemoveProxy(entity_handle);
+				continue;
+			}
+
+			UpdateProxy(scene, entity_handle);
+		}
+
+		m_DirtyEntities.clear();
+
+		ReclaimResourceIDs();
+	}
+
+	void RenderProxyStore::ReclaimResourceIDs() {
+
+		// Shaders are only referenced by the material states, which are resolved again every frame
+		Shaders.ReclaimExpired([](uint32_t) { return false; });
+
+		const size_t expired_count = Materials.GetExpiredCount() + UniformBlocks.GetExpiredCount() + SubMeshes.GetExpiredCount();
+
+		// Nothing to reclaim unless something expired or a proxy let go of an expired id since the last pass
+		if (expired_count == 0 || (expired_count == m_ReferencedExpiredCount && !m_DrawsChanged))
+			return;
+
+		L_PROFILE_SCOPE("Render Proxy Store - Reclaim Resource IDs");
+
+		std::vector<bool> materials_referenced(Materials.Size(), false);
+		std::vector<bool> uniform_blocks_referenced(UniformBlocks.Size(), false);
+		std::vector<bool> sub_meshes_referenced(SubMeshes.Size(), false);
+
+		for (const auto& draws : Draws) {
+			for (const RenderProxyDraw& draw : draws) {
+				if (draw.MaterialID < materials_referenced.size())			materials_referenced[draw.MaterialID] = true;
+				if (draw.UniformBlockID < uniform_blocks_referenced.size())	uniform_blocks_referenced[draw.UniformBlockID] = true;
+				if (draw.SubMeshID < sub_meshes_referenced.size())			sub_meshes_referenced[draw.SubMeshID] = true;
+			}
+		}
+
+		// Ids still held by a proxy wait until that proxy is rebuilt or removed, so it never draws another resource
+		Materials.ReclaimExpired([&](uint32_t id) { return materials_referenced[id]; });
+		UniformBlocks.ReclaimExpired([&](uint32_t id) { return uniform_blocks_referenced[id]; });
+		SubMeshes.ReclaimExpired([&](uint32_t id) { return sub_meshes_referenced[id]; });
+
+		m_ReferencedExpiredCount = Materials.GetExpiredCount() + UniformBlocks.GetExpiredCount() + SubMeshes.GetExpiredCount();
+		m_DrawsChanged = false;
+	}
+
+	void RenderProxyStore::RefreshMaterialStates() {
+
+		L_PROFILE_SCOPE("Render Proxy Store - Refresh Material States");
+
+		MaterialStates.resize(Materials.Size());
+
+		for (uint32_t material_id = 0; material_id < static_cast<uint32_t>(MaterialStates.size()); material_id++) {
+
+			RenderMaterialState& state = MaterialStates[material_id];
+			state = {};
+
+			auto material_asset = Materials.Get(material_id);
+			if (!material_asset)
+				continue;
+
+			state.ShaderID = Shaders.GetID(material_asset->GetShader());
+
+			switch (material_asset->GetRenderType()) {
+
+				case RenderType::L_MATERIAL_OPAQUE:
+					state.Pass = DrawPass_Opaque;
+					state.Drawable = true;
+					break;
+
+				case RenderType::L_MATERIAL_TRANSPARENT:
+				case RenderType::L_MATERIAL_TRANSPARENT_WRITE_DEPTH:
+					state.Pass = material_asset->IsTransparencyWriteDepth() ? DrawPass_TransparentWriteDepth : DrawPass_Transparent;
+					state.Drawable = true;
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+
+	void RenderProxyStore::RefreshSubMeshRanges() {
+
+		L_PROFILE_SCOPE("Render Proxy Store - Refresh Sub Mesh Ranges");
+
+		SubMeshRanges.resize(SubMeshes.Size());
+
+		for (uint32_t sub_mesh_id = 0; sub_mesh_id < static_cast<uint32_t>(SubMeshRanges.size()); sub_mesh_id++) {
+
+			auto sub_mesh = SubMeshes.Get(sub_mesh_id);
+			SubMeshRanges[sub_mesh_id] = sub_mesh ? sub_mesh->GetPoolDrawRange() : GeometryDrawRange{};
+		}
+	}
+
+	uint32_t RenderProxyStore::GetProxyIndex(entt::entity entity_handle) const {
+
+		if (entity_handle == entt::null)
+			return RENDER_PROXY_NULL_INDEX;
+
+		const uint32_t entity_number = GetEntityNumber(entity_handle);
+		if (entity_number >= m_ProxyIndices.size())
+			return RENDER_PROXY_NULL_INDEX;
+
+		const uint32_t proxy_index = m_ProxyIndices[entity_number];
+
+		// The entity number may belong to an older version of this entity
+		if (proxy_index == RENDER_PROXY_NULL_INDEX || EntityHandles[proxy_index] != entity_handle)
+			return RENDER_PROXY_NULL_INDEX;
+
+		return proxy_index;
+	}
+
+	void RenderProxyStore::Clear() {
+
+		EntityHandles.clear();
+		EntityUUIDs.clear();
+		WorldMatrices.clear();
+		Bounds.clear();
+		Flags.clear();
+		Draws.clear();
+		MeshAssets.clear();
+
+		Shaders.Clear();
+		Materials.Clear();
+		UniformBlocks.Clear();
+		SubMeshes.Clear();
+		MaterialStates.clear();
+		SubMeshRanges.clear();
+
+		m_ProxyIndices.clear();
+		m_StaleEntities.clear();
+
+		m_ReferencedExpiredCount = 0;
+		m_DrawsChanged = false;
+
+		m_Scene = nullptr;
+	}
+
+	void RenderProxyStore::UpdateProxy(Scene* scene, entt::entity entity_handle) {
+
+		entt::registry* registry = scene->GetRegistry();
+
+		const uint32_t entity_number = GetEntityNumber(entity_handle);
+		if (entity_number >= m_ProxyIndices.size())
+			m_ProxyIndices.resize(entity_number + 1, RENDER_PROXY_NULL_INDEX);
+
+		uint32_t proxy_index = m_ProxyIndices[entity_number];
+
+		// A destroyed entity's number may have been reused before its proxy was removed
+		if (proxy_index != RENDER_PROXY_NULL_INDEX && EntityHandles[proxy_index] != entity_handle) {
+			RemoveProxy(EntityHandles[proxy_index]);
+			proxy_index = RENDER_PROXY_NULL_INDEX;
+		}
+
+		if (proxy_index == RENDER_PROXY_NULL_INDEX) {
+
+			proxy_index = static_cast<uint32_t>(EntityHandles.size());
+			m_ProxyIndices[entity_number] = proxy_index;
+
+			EntityHandles.push_back(entity_handle);
+			EntityUUIDs.emplace_back(NULL_UUID);
+			WorldMatrices.emplace_back(1.0f);
+			Bounds.emplace_back();
+			Flags.push_back(RenderProxyFlag_None);
+			Draws.emplace_back();
+			MeshAssets.emplace_back();
+		}
+
+		const auto& mesh_filter = registry->get<MeshFilterComponent>(entity_handle);
+		const auto& mesh_renderer = registry->get<MeshRendererComponent>(entity_handle);
+
+		EntityUUIDs[proxy_index] = registry->get<IDComponent>(entity_handle).ID;
+		WorldMatrices[proxy_index] = registry->get<TransformComponent>(entity_handle).GetGlobalTransform();
+		Bounds[proxy_index] = mesh_filter.TransformedAABB;
+
+		uint8_t flags = RenderProxyFlag_None;
+		if (mesh_renderer.Active)						flags |= RenderProxyFlag_Active;
+		if (mesh_renderer.CastShadows)					flags |= RenderProxyFlag_CastShadows;
+		if (mesh_filter.GetShouldDisplayDebugLines())	flags |= RenderProxyFlag_DisplayDebugBounds;
+		Flags[proxy_index] = flags;
+
+		auto& draws = Draws[proxy_index];
+		draws.clear();
+		m_DrawsChanged = true;
+
+		std::shared_ptr<AssetMesh> mesh_asset = AssetManager::IsAssetHandleValid(mesh_filter.MeshFilterAssetHandle) ? AssetManager::GetAsset<AssetMesh>(mesh_filter.MeshFilterAssetHandle) : nullptr;
+		MeshAssets[proxy_index] = mesh_asset;
+
+		const auto& material_handles = mesh_renderer.MeshRendererMaterialHandles;
+		if (!mesh_asset || material_handles.empty())
+			return;
+
+		draws.reserve(mesh_asset->SubMeshes.size());
+
+		size_t material_index = 0;
+		for (const auto& sub_mesh : mesh_asset->SubMeshes) {
+
+			// Nullptr means there is no custom uniform block
+			const auto& [material_handle, custom_uniform_block] = material_handles[material_index];
+
+			auto material_asset = AssetManager::GetAsset<Material>(material_handle);
+			if (!material_asset)
+				continue;
+
+			RenderProxyDraw& draw = draws.emplace_back();
+			draw.SubMeshID = SubMeshes.GetID(sub_mesh);
+			draw.MaterialID = Materials.GetID(material_asset);
+			draw.UniformBlockID = UniformBlocks.GetID(custom_uniform_block ? custom_uniform_block : material_asset->GetUniformBlock());
+
+			// Sub meshes past the last material keep using the last material
+			if (material_index < material_handles.size() - 1)
+				material_index++;
+		}
+	}
+
+	void RenderProxyStore::RemoveProxy(entt::entity entity_handle) {
+
+		const uint32_t proxy_index = GetProxyIndex(entity_handle);
+		if (proxy_index == RENDER_PROXY_NULL_INDEX)
+			return;
+
+		const uint32_t last_index = static_cast<uint32_t>(EntityHandles.size() - 1);
+		m_DrawsChanged = true;
+
+		// Swap the last proxy into the removed slot
+		if (proxy_index != last_index) {
+
+			EntityHandles[proxy_index] = EntityHandles[last_index];
+			EntityUUIDs[proxy_index] = EntityUUIDs[last_index];
+			WorldMatrices[proxy_index] = WorldMatrices[last_index];
+			Bounds[proxy_index] = Bounds[last_index];
+			Flags[proxy_index] = Flags[last_index];
+			Draws[proxy_index].swap(Draws[last_index]);
+			MeshAssets[proxy_index] = std::move(MeshAssets[last_index]);
+
+			m_ProxyIndices[GetEntityNumber(EntityHandles[proxy_index])] = proxy_index;
+		}
+
+		EntityHandles.pop_back();
+		EntityUUIDs.pop_back();
+		WorldMatrices.pop_back();
+		Bounds.pop_back();
+		Flags.pop_back();
+		Draws.pop_back();
+		MeshAssets.pop_back();
+
+		m_ProxyIndices[GetEntityNumber(entity_handle)] = RENDER_PROXY_NULL_INDEX;
+	}
+
+}
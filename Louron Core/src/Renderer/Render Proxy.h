@@ -0,0 +1,150 @@
+#pragma once
+
+// Louron Core Headers
+#include "Render Queue.h"
+#include "Indirect Draw List.h"
+#include "../Scene/Bounds.h"
+#include "../Scene/Components/UUID.h"
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// External Vendor Library Headers
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+namespace Louron {
+
+	class Scene;
+	class Shader;
+	class Material;
+	class MaterialUniformBlock;
+
+	struct SubMesh;
+	struct AssetMesh;
+
+	enum RenderProxyFlags : uint8_t {
+		RenderProxyFlag_None				= 0,
+		RenderProxyFlag_Active				= 1 << 0,
+		RenderProxyFlag_CastShadows			= 1 << 1,
+		RenderProxyFlag_DisplayDebugBounds	= 1 << 2
+	};
+
+	/// <summary>
+	/// One sub mesh of a proxy and the material it is drawn with, as render resource ids.
+	/// </summary>
+	struct RenderProxyDraw {
+		uint32_t SubMeshID = RENDER_RESOURCE_NULL_ID;
+		uint32_t MaterialID = RENDER_RESOURCE_NULL_ID;
+		uint32_t UniformBlockID = RENDER_RESOURCE_NULL_ID;
+	};
+
+	/// <summary>
+	/// What the draw lists need to know about a material, resolved once per frame
+	/// so building the lists never has to lock a material.
+	/// </summary>
+	struct RenderMaterialState {
+		uint32_t ShaderID = RENDER_RESOURCE_NULL_ID;
+		DrawPass Pass = DrawPass_Opaque;
+		bool Drawable = false;
+	};
+
+	/// <summary>
+	/// Everything the renderer needs to cull, sort and draw each mesh entity, kept
+	/// in flat columns outside of the ECS. A proxy is only rebuilt when its scene
+	/// queues it through Scene::MarkRenderProxyDirty, which happens when its
+	/// transform, mesh filter or mesh renderer changes, so a frame only touches
+	/// the registry and the asset manager for the entities that changed.
+	///
+	/// Index i of every column belongs to the same proxy. Proxies are swap removed,
+	/// so an index is only valid until the next Sync.
+	/// </summary>
+	struct RenderProxyStore {
+
+		std::vector<entt::entity> EntityHandles;
+		std::vector<UUID> EntityUUIDs;
+		std::vector<glm::mat4> WorldMatrices;
+		std::vector<Bounds_AABB> Bounds;
+		std::vector<uint8_t> Flags;
+		std::vector<std::vector<RenderProxyDraw>> Draws;
+
+		/// <summary>
+		/// The mesh asset each proxy was built from, used to notice when it is unloaded or reimported.
+		/// </summary>
+		std::vector<std::weak_ptr<AssetMesh>> MeshAssets;
+
+		RenderResourceTable<Shader> Shaders;
+		RenderResourceTable<Material> Materials;
+		RenderResourceTable<MaterialUniformBlock> UniformBlocks;
+		RenderResourceTable<SubMesh> SubMeshes;
+
+		/// <summary>
+		/// Indexed by material id, refreshed by RefreshMaterialStates.
+		/// </summary>
+		std::vector<RenderMaterialState> MaterialStates;
+
+		/// <summary>
+		/// Indexed by sub mesh id, where each sub mesh sits in the geometry pool.
+		/// Refreshed by RefreshSubMeshRanges.
+		/// </summary>
+		std::vector<GeometryDrawRange> SubMeshRanges;
+
+		/// <summary>
+		/// Apply every change the scene has queued since the last sync, rebuilding
+		/// every proxy if the scene is not the one the store was built from.
+		/// Must be called from the main thread, as it may load assets.
+		/// </summary>
+		void Sync(Scene* scene);
+
+		/// <summary>
+		/// Resolve the shader and draw pass of every known material. Materials can
+		/// change shader or render type in place, so this runs every frame, but only
+		/// costs one lookup per material rather than one per draw.
+		/// </summary>
+		void RefreshMaterialStates();
+
+		/// <summary>
+		/// Look up where every known sub mesh sits in the geometry pool, uploading any
+		/// that are not in it yet. Main thread only. Sub meshes that have been freed get an empty range, so their pool space is never drawn after
+		/// it may have been handed to another mesh.
+		/// </summary>
+		void RefreshSubMeshRanges();
+
+		/// <summary>
+		/// Queue a proxy to be rebuilt at the next Sync, e.g. because its mesh asset was unloaded.
+		/// </summary>
+		void MarkStale(entt::entity entity_handle) { m_StaleEntities.push_back(entity_handle); }
+
+		uint32_t GetProxyIndex(entt::entity entity_handle) const;
+
+		size_t Size() const { return EntityHandles.size(); }
+
+		void Clear();
+
+	private:
+
+		void UpdateProxy(Scene* scene, entt::entity entity_handle);
+		void RemoveProxy(entt::entity entity_handle);
+
+		/// <summary>
+		/// Give the ids of freed resources back to their tables once no proxy refers
+		/// to them, so new assets reuse them rather than growing past the sort key fields.
+		/// </summary>
+		void ReclaimResourceIDs();
+
+		Scene* m_Scene = nullptr;
+
+		// Entity number to proxy index
+		std::vector<uint32_t> m_ProxyIndices;
+
+		std::vector<entt::entity> m_DirtyEntities;
+		std::vector<entt::entity> m_StaleEntities;
+
+		// Expired ids a proxy still referred to at the last reclaim, and whether any proxy's draws changed since
+		size_t m_ReferencedExpiredCount = 0;
+		bool m_DrawsChanged = false;
+	};
+
+}
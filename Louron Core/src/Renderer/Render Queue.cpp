@@ -0,0 +1,58 @@
+#include "Render Queue.h"
+
+// Louron Core Headers
+#include "../Debug/Profiler.h"
+
+// C++ Standard Library Headers
+#include <array>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	void RenderQueue::Sort() {
+
+		const size_t item_count = m_Items.size();
+		if (item_count < 2)
+			return;
+
+		L_PROFILE_SCOPE("Render Queue - Radix Sort");
+
+		// Count every byte of every key in one read of the items
+		std::array<std::array<uint32_t, 256>, 8> histograms{};
+		for (const DrawItem& item : m_Items)
+			for (size_t byte = 0; byte < 8; byte++)
+				histograms[byte][(item.SortKey >> (byte * 8)) & 0xFF]++;
+
+		m_Scratch.resize(item_count);
+
+		DrawItem* source = m_Items.data();
+		DrawItem* destination = m_Scratch.data();
+
+		for (size_t byte = 0; byte < 8; byte++) {
+
+			auto& histogram = histograms[byte];
+
+			// Every key has the same value in this byte, order would not change
+			if (histogram[(source[0].SortKey >> (byte * 8)) & 0xFF] == item_count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t& count : histogram) {
+				uint32_t bucket_count = count;
+				count = offset;
+				offset += bucket_count;
+			}
+
+			for (size_t i = 0; i < item_count; i++)
+				destination[histogram[(source[i].SortKey >> (byte * 8)) & 0xFF]++] = source[i];
+
+			std::swap(source, destination);
+		}
+
+		// An odd number of passes leaves the sorted items in the scratch buffer
+		if (source != m_Items.data())
+			m_Items.swap(m_Scratch);
+	}
+
+}
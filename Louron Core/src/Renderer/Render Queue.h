@@ -0,0 +1,207 @@
+#pragma once
+
+// Louron Core Headers
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	constexpr uint32_t RENDER_RESOURCE_NULL_ID = UINT32_MAX;
+	constexpr uint32_t RENDER_PROXY_NULL_INDEX = UINT32_MAX;
+
+	/// <summary>
+	/// Gives each render resource (shader, material, uniform block, sub mesh) a small
+	/// id that stays the same across frames, so draw items can be keyed and compared
+	/// by id instead of hashing shared pointers every frame. Only weak references are
+	/// kept, the table never extends the lifetime of an asset.
+	///
+	/// Ids of freed resources are handed out again once ReclaimExpired releases them,
+	/// so ids stay within the sort key fields as assets are loaded and unloaded.
+	/// </summary>
+	template<typename T>
+	class RenderResourceTable {
+
+	public:
+
+		/// <summary>
+		/// Get the id of the resource, assigning a free id the first time it is seen.
+		/// </summary>
+		uint32_t GetID(const std::shared_ptr<T>& resource) {
+
+			if (!resource)
+				return RENDER_RESOURCE_NULL_ID;
+
+			auto [it, inserted] = m_IDs.try_emplace(resource.get(), static_cast<uint32_t>(m_Resources.size()));
+			if (inserted) {
+
+				if (!m_FreeIDs.empty()) {
+					it->second = m_FreeIDs.back();
+					m_FreeIDs.pop_back();
+
+					m_Resources[it->second] = resource;
+					m_Keys[it->second] = resource.get();
+					return it->second;
+				}
+
+				m_Resources.push_back(resource);
+				m_Keys.push_back(resource.get());
+				return it->second;
+			}
+
+			// A freed resource's address may have been reused by a new one
+			if (m_Resources[it->second].expired())
+				m_Resources[it->second] = resource;
+
+			return it->second;
+		}
+
+		std::shared_ptr<T> Get(uint32_t id) const {
+			return id < m_Resources.size() ? m_Resources[id].lock() : nullptr;
+		}
+
+		/// <summary>
+		/// The number of ids whose resource has been freed but that have not been reclaimed.
+		/// </summary>
+		size_t GetExpiredCount() const {
+
+			size_t expired_count = 0;
+			for (uint32_t id = 0; id < static_cast<uint32_t>(m_Resources.size()); id++)
+				if (m_Keys[id] && m_Resources[id].expired())
+					expired_count++;
+
+			return expired_count;
+		}
+
+		/// <summary>
+		/// Release the ids of freed resources for reuse, skipping any id for which
+		/// is_referenced(id) returns true as something still refers to it.
+		/// </summary>
+		template<typename Predicate>
+		void ReclaimExpired(Predicate&& is_referenced) {
+
+			for (uint32_t id = 0; id < static_cast<uint32_t>(m_Resources.size()); id++) {
+
+				if (!m_Keys[id] || !m_Resources[id].expired() || is_referenced(id))
+					continue;
+
+				if (auto it = m_IDs.find(m_Keys[id]); it != m_IDs.end() && it->second == id)
+					m_IDs.erase(it);
+
+				m_Resources[id].reset();
+				m_Keys[id] = nullptr;
+				m_FreeIDs.push_back(id);
+			}
+		}
+
+		size_t Size() const { return m_Resources.size(); }
+
+		void Clear() {
+			m_IDs.clear();
+			m_Resources.clear();
+			m_Keys.clear();
+			m_FreeIDs.clear();
+		}
+
+	private:
+
+		std::unordered_map<const T*, uint32_t> m_IDs;
+		std::vector<std::weak_ptr<T>> m_Resources;
+
+		// The address each id is keyed by in m_IDs, nullptr while the id is free
+		std::vector<const T*> m_Keys;
+		std::vector<uint32_t> m_FreeIDs;
+	};
+
+	/// <summary>
+	/// One sub mesh of one render proxy to be drawn. The ids index the render resource tables,
+	/// the sort key only decides draw order, so ids that do not fit in their key field
+	/// still draw correctly and only cost extra state changes.
+	/// </summary>
+	struct DrawItem {
+		uint64_t SortKey = 0;
+		uint32_t ProxyIndex = RENDER_PROXY_NULL_INDEX;
+		uint32_t MaterialID = RENDER_RESOURCE_NULL_ID;
+		uint32_t UniformBlockID = RENDER_RESOURCE_NULL_ID;
+		uint32_t SubMeshID = RENDER_RESOURCE_NULL_ID;
+	};
+
+	enum DrawPass : uint8_t {
+		DrawPass_Opaque = 0,
+		DrawPass_TransparentWriteDepth = 1,
+		DrawPass_Transparent = 2
+	};
+
+	namespace DrawSortKey {
+
+		// Opaque:		pass(2) | shader(10) | material(12) | uniform block(12) | sub mesh(12) | depth(16), front to back
+		// Transparent:	pass(2) | inverted depth(16) | shader(10) | material(12) | uniform block(12) | sub mesh(12), back to front
+
+		inline uint64_t Field(uint32_t id, uint32_t bits) { return static_cast<uint64_t>(id & ((1u << bits) - 1u)); }
+
+		/// <summary>
+		/// Quantise the distance to the camera into 16 bits over the camera's far plane.
+		/// </summary>
+		inline uint32_t QuantiseDepth(float distance, float far_plane) {
+
+			float normalised = (far_plane > 0.0f) ? distance / far_plane : 0.0f;
+			normalised = normalised < 0.0f ? 0.0f : (normalised > 1.0f ? 1.0f : normalised);
+
+			return static_cast<uint32_t>(normalised * 65535.0f);
+		}
+
+		inline uint64_t MakeOpaque(uint32_t shader_id, uint32_t material_id, uint32_t uniform_block_id, uint32_t sub_mesh_id, uint32_t depth) {
+			return	(static_cast<uint64_t>(DrawPass_Opaque) << 62) |
+					(Field(shader_id, 10) << 52) |
+					(Field(material_id, 12) << 40) |
+					(Field(uniform_block_id, 12) << 28) |
+					(Field(sub_mesh_id, 12) << 16) |
+					Field(depth, 16);
+		}
+
+		inline uint64_t MakeTransparent(DrawPass pass, uint32_t shader_id, uint32_t material_id, uint32_t uniform_block_id, uint32_t sub_mesh_id, uint32_t depth) {
+			return	(static_cast<uint64_t>(pass & 0x3) << 62) |
+					(Field(0xFFFFu - (depth & 0xFFFFu), 16) << 46) |
+					(Field(shader_id, 10) << 36) |
+					(Field(material_id, 12) << 24) |
+					(Field(uniform_block_id, 12) << 12) |
+					Field(sub_mesh_id, 12);
+		}
+	}
+
+	/// <summary>
+	/// A flat list of draw items, ordered by their sort key with a radix sort. The
+	/// item and scratch storage is kept between frames, so once the list has grown
+	/// to the size of the scene, building and sorting it does not allocate.
+	/// </summary>
+	class RenderQueue {
+
+	public:
+
+		void Clear() { m_Items.clear(); }
+		void Reserve(size_t count) { m_Items.reserve(count); m_Scratch.reserve(count); }
+
+		void Push(const DrawItem& item) { m_Items.push_back(item); }
+
+		/// <summary>
+		/// Stable LSD radix sort on the 64 bit sort keys, one pass per byte.
+		/// Passes where every key has the same byte are skipped.
+		/// </summary>
+		void Sort();
+
+		const std::vector<DrawItem>& GetItems() const { return m_Items; }
+		size_t Size() const { return m_Items.size(); }
+		bool IsEmpty() const { return m_Items.empty(); }
+
+	private:
+
+		std::vector<DrawItem> m_Items;
+		std::vector<DrawItem> m_Scratch;
+	};
+
+}
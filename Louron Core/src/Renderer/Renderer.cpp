@@ -1,13 +1,20 @@
 #include "Renderer.h"
 
 #include "../OpenGL/Buffer.h"
+#include "../OpenGL/Geometry Pool.h"
+#include "../OpenGL/Instance Buffer Ring.h"
 #include "../OpenGL/Vertex Array.h"
 
+#include <cstring>
+
 namespace Louron {
 
 	static std::unique_ptr<VertexArray> s_DebugCubeVAO;
 	static std::unique_ptr<VertexArray> s_DebugSphereVAO; // TODO: Implement this
 
+	// Vertices and indices of every sub mesh, uploaded on first draw
+	static std::shared_ptr<GeometryPool> s_GeometryPool;
+
 	RenderPassStats Renderer::s_RenderStats = {};
 
 	void Renderer::Init() 
@@ -51,6 +58,15 @@ namespace Louron {
 
 			s_DebugCubeVAO->UnBind();
 		}
+
+		// Room for a handful of typical meshes before the first grow
+		if (!s_GeometryPool)
+			s_GeometryPool = std::make_shared<GeometryPool>(1u << 16, 3u << 16);
+	}
+
+	std::shared_ptr<GeometryPool> Renderer::GetGeometryPool()
+	{
+		return s_GeometryPool;
 	}
 
 	void Renderer::ClearColour(const glm::vec4 colour) 
@@ -231,48 +247,84 @@ namespace Louron {
 
 	void Renderer::DrawSubMesh(std::shared_ptr<SubMesh> sub_mesh, bool is_depth_pass)
 	{
-		DrawSubMesh(*sub_mesh->VAO, is_depth_pass);
+		const GeometryDrawRange range = sub_mesh->GetPoolDrawRange();
+		if (range.IndexCount == 0)
+			return;
+
+		s_GeometryPool->Bind();
+		glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.IndexCount), GL_UNSIGNED_INT, reinterpret_cast<const void*>(static_cast<uintptr_t>(range.FirstIndex) * sizeof(GLuint)), range.BaseVertex);
+		s_GeometryPool->UnBind();
+
+		s_RenderStats.Individual_DrawCalls++;
+
+		if (is_depth_pass)
+		{
+			s_RenderStats.Geometry_Depth_Rendered++;
+			s_RenderStats.Geometry_Depth_TriangleCount += range.IndexCount / 3;
+			s_RenderStats.Geometry_Depth_VerticeCount += range.IndexCount;
+		}
+		else
+		{
+			s_RenderStats.Geometry_Colour_Rendered++;
+			s_RenderStats.Geometry_Colour_TriangleCount += range.IndexCount / 3;
+			s_RenderStats.Geometry_Colour_VerticeCount += range.IndexCount;
+		}
 	}
 
-	static GLuint s_MeshInstanceBuffers = -1;
+	// Instance transforms for every instanced sub mesh draw of a frame, written straight into mapped memory
+	static std::unique_ptr<InstanceBufferRing> s_MeshInstanceRing;
 
-	void Renderer::DrawInstancedSubMesh(const VertexArray& sub_mesh, std::vector<glm::mat4> transforms)
+	// Indirect draw commands for every multi draw of a frame
+	static std::unique_ptr<InstanceBufferRing> s_IndirectCommandRing;
+
+	void Renderer::BeginInstanceFrame()
 	{
-		if (transforms.empty())
-			return;
+		if (!s_MeshInstanceRing)
+			s_MeshInstanceRing = std::make_unique<InstanceBufferRing>(GL_ARRAY_BUFFER, 1024 * sizeof(glm::mat4));
 
-		if (s_MeshInstanceBuffers == -1) {
+		if (!s_IndirectCommandRing)
+			s_IndirectCommandRing = std::make_unique<InstanceBufferRing>(GL_DRAW_INDIRECT_BUFFER, 1024 * sizeof(DrawElementsIndirectCommand));
 
-			glGenBuffers(1, &s_MeshInstanceBuffers);
-			glBindBuffer(GL_ARRAY_BUFFER, s_MeshInstanceBuffers);
-			glBufferData(GL_ARRAY_BUFFER, transforms.size() * sizeof(glm::mat4), transforms.data(), GL_DYNAMIC_DRAW);
-		}
-		else {
+		s_MeshInstanceRing->BeginFrame();
+		s_IndirectCommandRing->BeginFrame();
+	}
 
-			glBindBuffer(GL_ARRAY_BUFFER, s_MeshInstanceBuffers);
+	void Renderer::EndInstanceFrame()
+	{
+		if (s_MeshInstanceRing)
+			s_MeshInstanceRing->EndFrame();
 
-			GLint bufferSize = 0;
-			glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &bufferSize);
+		if (s_IndirectCommandRing)
+			s_IndirectCommandRing->EndFrame();
+	}
 
-			if (bufferSize < transforms.size() * sizeof(glm::mat4)) {
-				// Reallocate buffer with the new size
-				glBufferData(GL_ARRAY_BUFFER, transforms.size() * sizeof(glm::mat4), &transforms[0], GL_DYNAMIC_DRAW);
-			}
-			else {
-				// Update existing buffer with new data
-				glBufferSubData(GL_ARRAY_BUFFER, 0, transforms.size() * sizeof(glm::mat4), &transforms[0]);
-			}
+	glm::mat4* Renderer::AllocateInstanceTransforms(GLuint count, GLuint& base_instance)
+	{
+		if (!s_MeshInstanceRing)
+			BeginInstanceFrame();
+
+		GLintptr offset = 0;
+		auto transforms = static_cast<glm::mat4*>(s_MeshInstanceRing->Allocate(count * sizeof(glm::mat4), sizeof(glm::mat4), offset));
+
+		if (!transforms) {
+			L_CORE_ERROR("Could Not Allocate Instance Transforms.");
+			return nullptr;
 		}
 
-		// Additional validation
-		if (glIsBuffer(s_MeshInstanceBuffers) == GL_FALSE) {
-			L_CORE_ERROR("Buffer is not valid after binding or updating data.");
+		base_instance = static_cast<GLuint>(offset / sizeof(glm::mat4));
+		return transforms;
+	}
+
+	void Renderer::DrawInstancedSubMesh(const VertexArray& sub_mesh, GLuint base_instance, GLuint instance_count)
+	{
+		if (instance_count == 0 || !s_MeshInstanceRing)
 			return;
-		}
 
 		sub_mesh.Bind();
 
-		// Set vertex attributes
+		glBindBuffer(GL_ARRAY_BUFFER, s_MeshInstanceRing->GetBuffer());
+
+		// Set vertex attributes, base instance offsets these into this frame's region of the ring
 		std::size_t vec4Size = sizeof(glm::vec4);
 		glEnableVertexAttribArray(5);
 		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, GLsizei(4 * vec4Size), (void*)0);
@@ -292,7 +344,7 @@ namespace Louron {
 		glVertexAttribDivisor(8, 1);
 
 		// DRAW CALL
-		glDrawElementsInstanced(GL_TRIANGLES, sub_mesh.GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, 0, static_cast<GLuint>(transforms.size()));
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, sub_mesh.GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instance_count), base_instance);
 
 		// Reset state after drawing
 		glDisableVertexAttribArray(5);
@@ -310,23 +362,121 @@ namespace Louron {
 
 		s_RenderStats.Instanced_DrawCalls++;
 
-		s_RenderStats.Geometry_Colour_Instanced += static_cast<GLuint>(transforms.size());
-		s_RenderStats.Geometry_Colour_TriangleCount += (sub_mesh.GetIndexBuffer()->GetCount() / 3) * static_cast<GLuint>(transforms.size());
-		s_RenderStats.Geometry_Colour_VerticeCount += sub_mesh.GetIndexBuffer()->GetCount() * static_cast<GLuint>(transforms.size());
+		s_RenderStats.Geometry_Colour_Instanced += instance_count;
+		s_RenderStats.Geometry_Colour_TriangleCount += (sub_mesh.GetIndexBuffer()->GetCount() / 3) * instance_count;
+		s_RenderStats.Geometry_Colour_VerticeCount += sub_mesh.GetIndexBuffer()->GetCount() * instance_count;
 	}
 
-	void Renderer::DrawInstancedSubMesh(std::shared_ptr<SubMesh> sub_mesh, std::vector<glm::mat4> transforms)
+	void Renderer::DrawInstancedSubMesh(std::shared_ptr<SubMesh> sub_mesh, GLuint base_instance, GLuint instance_count)
 	{
-		DrawInstancedSubMesh(*sub_mesh->VAO, transforms);
+		if (instance_count == 0 || !s_MeshInstanceRing)
+			return;
+
+		const GeometryDrawRange range = sub_mesh->GetPoolDrawRange();
+		if (range.IndexCount == 0)
+			return;
+
+		s_GeometryPool->SetInstanceBuffer(s_MeshInstanceRing->GetBuffer());
+		s_GeometryPool->Bind();
+
+		// DRAW CALL
+		glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(range.IndexCount), GL_UNSIGNED_INT, reinterpret_cast<const void*>(static_cast<uintptr_t>(range.FirstIndex) * sizeof(GLuint)), static_cast<GLsizei>(instance_count), range.BaseVertex, base_instance);
+
+		s_GeometryPool->UnBind();
+		s_GeometryPool->SetInstanceBuffer(0);
+
+		s_RenderStats.Instanced_DrawCalls++;
+
+		s_RenderStats.Geometry_Colour_Instanced += instance_count;
+		s_RenderStats.Geometry_Colour_TriangleCount += (range.IndexCount / 3) * instance_count;
+		s_RenderStats.Geometry_Colour_VerticeCount += range.IndexCount * instance_count;
 	}
 
-	void Renderer::CleanupRenderData() 
+	void Renderer::DrawIndirectSubMeshes(const DrawElementsIndirectCommand* commands, GLuint command_count, GLuint base_instance)
 	{
+		if (command_count == 0 || !s_MeshInstanceRing || !s_IndirectCommandRing || !s_GeometryPool)
+			return;
+
+		GLintptr command_offset = 0;
+		auto indirect_commands = static_cast<DrawElementsIndirectCommand*>(s_IndirectCommandRing->Allocate(command_count * sizeof(DrawElementsIndirectCommand), sizeof(GLuint), command_offset));
 
-		if (s_MeshInstanceBuffers != -1) {
-			glDeleteBuffers(1, &s_MeshInstanceBuffers);
-			s_MeshInstanceBuffers = -1;
+		if (!indirect_commands) {
+			L_CORE_ERROR("Could Not Allocate Indirect Draw Commands.");
+			return;
 		}
+
+		GLuint instance_count = 0;
+		GLuint triangle_count = 0;
+		GLuint vertice_count = 0;
+
+		// Commands count instances from the start of the draw list, offset them into this frame's instance data
+		for (GLuint i = 0; i < command_count; i++) {
+
+			DrawElementsIndirectCommand command = commands[i];
+			command.BaseInstance += base_instance;
+			indirect_commands[i] = command;
+
+			instance_count += command.InstanceCount;
+			triangle_count += (command.Count / 3) * command.InstanceCount;
+			vertice_count += command.Count * command.InstanceCount;
+		}
+
+		s_GeometryPool->SetInstanceBuffer(s_MeshInstanceRing->GetBuffer());
+		s_GeometryPool->Bind();
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s_IndirectCommandRing->GetBuffer());
+
+		// DRAW CALL
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(command_offset), static_cast<GLsizei>(command_count), 0);
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		s_GeometryPool->UnBind();
+		s_GeometryPool->SetInstanceBuffer(0);
+
+		s_RenderStats.Instanced_DrawCalls++;
+
+		s_RenderStats.Geometry_Colour_Instanced += instance_count;
+		s_RenderStats.Geometry_Colour_TriangleCount += triangle_count;
+		s_RenderStats.Geometry_Colour_VerticeCount += vertice_count;
+	}
+
+	void Renderer::DrawInstancedSubMesh(const VertexArray& sub_mesh, const std::vector<glm::mat4>& transforms)
+	{
+		if (transforms.empty())
+			return;
+
+		GLuint base_instance = 0;
+		glm::mat4* instance_transforms = AllocateInstanceTransforms(static_cast<GLuint>(transforms.size()), base_instance);
+		if (!instance_transforms)
+			return;
+
+		std::memcpy(instance_transforms, transforms.data(), transforms.size() * sizeof(glm::mat4));
+
+		DrawInstancedSubMesh(sub_mesh, base_instance, static_cast<GLuint>(transforms.size()));
+	}
+
+	void Renderer::DrawInstancedSubMesh(std::shared_ptr<SubMesh> sub_mesh, const std::vector<glm::mat4>& transforms)
+	{
+		if (transforms.empty())
+			return;
+
+		GLuint base_instance = 0;
+		glm::mat4* instance_transforms = AllocateInstanceTransforms(static_cast<GLuint>(transforms.size()), base_instance);
+		if (!instance_transforms)
+			return;
+
+		std::memcpy(instance_transforms, transforms.data(), transforms.size() * sizeof(glm::mat4));
+
+		DrawInstancedSubMesh(sub_mesh, base_instance, static_cast<GLuint>(transforms.size()));
+	}
+
+	void Renderer::CleanupRenderData() 
+	{
+		s_MeshInstanceRing.reset();
+		s_IndirectCommandRing.reset();
+
+		// Sub meshes upload themselves again into the next pool when drawn
+		s_GeometryPool.reset();
 	}
 
 	void Renderer::ClearRenderStats() { s_RenderStats = {}; }
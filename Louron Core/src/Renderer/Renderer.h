@@ -6,6 +6,8 @@
 #include "../Scene/Components/Mesh.h"
 #include "../Scene/Components/Skybox.h"
 
+#include "Indirect Draw List.h"
+
 // C++ Standard Library Headers
 
 // External Vendor Library Headers
@@ -63,9 +65,15 @@ namespace Louron {
 
 		Renderer() = default;
 
-		// This is used to init the debug vertex arrays for cubes and spheres
+		// This is used to init the debug vertex arrays for cubes and spheres, and the geometry pool
 		static void Init();
 
+		/// <summary>
+		/// The pool every sub mesh is drawn from. Created by Init and destroyed by
+		/// CleanupRenderData, null in between.
+		/// </summary>
+		static std::shared_ptr<GeometryPool> GetGeometryPool();
+
 		static void ClearColour(const glm::vec4 colour);
 		static void ClearBuffer(GLbitfield mask);
 
@@ -78,8 +86,36 @@ namespace Louron {
 		static void DrawSubMesh(const VertexArray& sub_mesh, bool is_depth_pass = false);
 		static void DrawSubMesh(std::shared_ptr<SubMesh> sub_mesh, bool is_depth_pass = false);
 		static void DrawSkybox(SkyboxComponent& skybox);
-		static void DrawInstancedSubMesh(const VertexArray& sub_mesh, std::vector<glm::mat4> transforms);
-		static void DrawInstancedSubMesh(std::shared_ptr<SubMesh> sub_mesh, std::vector<glm::mat4> transforms);
+		static void DrawInstancedSubMesh(const VertexArray& sub_mesh, const std::vector<glm::mat4>& transforms);
+		static void DrawInstancedSubMesh(std::shared_ptr<SubMesh> sub_mesh, const std::vector<glm::mat4>& transforms);
+
+		/// <summary>
+		/// Draw instance_count instances of the sub mesh using the transforms starting at
+		/// base_instance, as returned by AllocateInstanceTransforms this frame.
+		/// </summary>
+		static void DrawInstancedSubMesh(const VertexArray& sub_mesh, GLuint base_instance, GLuint instance_count);
+		static void DrawInstancedSubMesh(std::shared_ptr<SubMesh> sub_mesh, GLuint base_instance, GLuint instance_count);
+
+		/// <summary>
+		/// Draw every command from the geometry pool in one glMultiDrawElementsIndirect call.
+		/// Each command's base instance is offset by base_instance, as returned by
+		/// AllocateInstanceTransforms this frame.
+		/// </summary>
+		static void DrawIndirectSubMeshes(const DrawElementsIndirectCommand* commands, GLuint command_count, GLuint base_instance);
+
+		/// <summary>
+		/// Instance transforms and indirect commands live in persistently mapped rings with a
+		/// region per frame in flight. Begin waits until the GPU is done with the next
+		/// region, End fences it.
+		/// </summary>
+		static void BeginInstanceFrame();
+		static void EndInstanceFrame();
+
+		/// <summary>
+		/// Reserve room for count transforms in this frame's region and return the mapped
+		/// memory to write them to. Returns nullptr if the ring could not be mapped.
+		/// </summary>
+		static glm::mat4* AllocateInstanceTransforms(GLuint count, GLuint& base_instance);
 
 		static void CleanupRenderData();
 
@@ -13,14 +13,17 @@
 #include "../Scene/Components/Mesh.h"
 
 #include "../Scene/OctreeBounds.h"
+#include "../Scene/Scene Systems/Bounds System.h"
 
 #include "../Debug/Profiler.h"
 
+#include "../Core/Engine.h"
 #include "../Core/Time.h"
 
 #include "../OpenGL/Framebuffer.h"
 
 // C++ Standard Library Headers
+#include <bit>
 
 // External Vendor Library Headers
 #include <entt/entt.hpp>
@@ -230,9 +233,19 @@ namespace Louron {
 			FP_Data.Camera_Frustum.RecalculateFrustum(projection_matrix * view_matrix);
 
 			// Wait for Octree Update Thread
-			if (FP_Data.OctreeUpdateThread.joinable()) {
-				L_PROFILE_SCOPE("Forward Plus - Octree Thread Wait");
-				FP_Data.OctreeUpdateThread.join();
+			if (!FP_Data.OctreeUpdateJob.IsFinished()) {
+				L_PROFILE_SCOPE("Forward Plus - Octree Job Wait");
+				Engine::Get().GetJobSystem().Wait(FP_Data.OctreeUpdateJob);
+			}
+
+			// Apply this frame's entity changes to the render proxies before anything reads them
+			{
+				L_PROFILE_SCOPE("Forward Plus - Render Proxy Sync");
+
+				std::unique_lock lock(FP_Data.RenderSortingMutex);
+				FP_Data.RenderProxies.Sync(scene_ref.get());
+				FP_Data.RenderProxies.RefreshMaterialStates();
+				FP_Data.RenderProxies.RefreshSubMeshRanges();
 			}
 
 			// Gather All Point and Spot Lights Visible in Camera Frustum
@@ -244,58 +257,56 @@ namespace Louron {
 			// Gather All Meshes Visible in Camera Frustum
 			ConductRenderableFrustumCull(camera_position, projection_matrix);
 
-			// Dispatch Thread
-			FP_Data.OctreeUpdateThread = std::thread([&]() -> void {
+			// Dispatch Octree Update Job
+			FP_Data.OctreeUpdateJob = Engine::Get().GetJobSystem().Schedule([this]() -> void {
 
 				auto oct_scene_ref = m_Scene.lock();
 
 				L_PROFILE_SCOPE("Forward Plus - Octree Update");
 					
-				if (auto oct_ref = oct_scene_ref->GetOctree().lock(); oct_ref) {
-
-					std::unique_lock lock(oct_ref->GetOctreeMutex());
-						
-					// Check which objects are no longer in the scene
-					const auto& octree_data_sources = oct_ref->GetAllOctreeDataSources();
-					std::vector<Entity> remove_entities{};
-					for (const auto& data_source : octree_data_sources) {
-
-						if (oct_scene_ref->HasEntity(data_source->Data)) {
-							Entity entity = data_source->Data;
-							if (!entity.HasComponent<MeshFilterComponent>() || !entity.HasComponent<MeshRendererComponent>()) {
-								remove_entities.push_back(entity);
-							}
-						}
-						else {
-							remove_entities.push_back(data_source->Data);
-						}
+				if (auto oct_ref = oct_scene_ref->GetSpatialIndex().lock(); oct_ref) {
+
+					// Held for the whole update, the mesh filter pool is read and written through out
+					// and DestroyEntities takes this lock before it removes components from the registry
+					std::unique_lock lock(oct_ref->GetMutex());
+
+					// Only visit entities that were created, destroyed, moved or had their mesh changed since last frame
+					auto& dirty_entities = FP_Data.OctreeDirtyEntities;
+					dirty_entities.clear();
+					oct_scene_ref->GetOctreeDirtyQueue().PopAll(dirty_entities);
+
+					entt::registry* registry = oct_scene_ref->GetRegistry();
+
+					// Clear before updating so a transform change made while we update queues the entity again
+					for (const auto& entity_handle : dirty_entities) {
+						if (registry->valid(entity_handle) && registry->has<MeshFilterComponent>(entity_handle))
+							registry->get<MeshFilterComponent>(entity_handle).OctreeNeedsUpdate.store(false, std::memory_order_release);
 					}
 
-					for (const auto& entity : remove_entities) 
-						oct_ref->Remove(entity);
+					// Recompute every stale world AABB in one batch
+					BoundsSystem::UpdateTransformedAABBs(oct_scene_ref.get(), dirty_entities);
 
-					oct_ref->TryShrinkOctree();
-					auto mesh_view = oct_scene_ref->GetAllEntitiesWith<MeshRendererComponent, MeshFilterComponent>();
-					for (const auto& entity_handle : mesh_view) {
+					for (const auto& entity_handle : dirty_entities) {
 
-						auto& component = mesh_view.get<MeshFilterComponent>(entity_handle);
+						Entity entity = { entity_handle, oct_scene_ref.get() };
 
-						if (component.MeshFilterAssetHandle == NULL_UUID)
-							continue;
+						if (!registry->valid(entity_handle) || !registry->has<MeshFilterComponent>(entity_handle) || !registry->has<MeshRendererComponent>(entity_handle) ||
+							registry->get<MeshFilterComponent>(entity_handle).MeshFilterAssetHandle == NULL_UUID || registry->has<DespawnedComponent>(entity_handle)) {
 
-						if (component.AABBNeedsUpdate) {
-							component.UpdateTransformedAABB();
+							if (oct_ref->HasDataSource(entity))
+								oct_ref->Remove(entity);
+							continue;
 						}
 
-						if (component.OctreeNeedsUpdate) {
-							if (oct_ref->Update({ entity_handle, oct_scene_ref.get() }, component.TransformedAABB))
-								component.OctreeNeedsUpdate = false;
-							else {
-								L_CORE_WARN("Could Not Be Inserted Into Octree - Deleting Entity: {0}", component.GetEntity().GetName());
-								oct_scene_ref->DestroyEntity({ entity_handle, oct_scene_ref.get() });
-							}
+						auto& component = registry->get<MeshFilterComponent>(entity_handle);
+
+						if (!oct_ref->Update(entity, component.TransformedAABB)) {
+							L_CORE_WARN("Could Not Be Inserted Into Octree - Deleting Entity: {0}", entity.GetName());
+							oct_scene_ref->DestroyEntity(entity, &lock);
 						}
 					}
+
+					oct_ref->PerformMaintenance();
 				}
 			});
 		}
@@ -321,6 +332,15 @@ namespace Louron {
 			// culling for colour pass.
 			ConductRenderableOcclusionCull();
 
+			// Sort this frame's draw lists while the light culling runs, the render pass waits on it
+			{
+				float far_plane = projection_matrix[3][2] / (projection_matrix[2][2] + 1.0f);
+
+				FP_Data.RenderQueueSortingJob = Engine::Get().GetJobSystem().Schedule([this, camera_position, far_plane]() -> void {
+					BuildRenderQueues(camera_position, far_plane);
+				});
+			}
+
 			ConductTiledBasedLightCull(projection_matrix, view_matrix);
 
 			glDrawBuffer(GL_COLOR_ATTACHMENT0);
@@ -329,7 +349,9 @@ namespace Louron {
 			Renderer::ClearColour(camera_entity ? camera_entity.GetComponent<CameraComponent>().ClearColour : glm::vec4(49.0f, 77.0f, 121.0f, 1.0f));
 			Renderer::ClearBuffer(GL_COLOR_BUFFER_BIT);
 			
+			Renderer::BeginInstanceFrame();
 			ConductRenderPass(camera_position, projection_matrix, view_matrix);
+			Renderer::EndInstanceFrame();
 			
 			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
@@ -337,6 +359,13 @@ namespace Louron {
 			scene_ref->GetSceneFrameBuffer()->Unbind();
 
 		}
+
+		// The octree update reads transforms and writes mesh filters, so it has to finish
+		// before anything outside of rendering changes the registry again
+		if (!FP_Data.OctreeUpdateJob.IsFinished()) {
+			L_PROFILE_SCOPE("Forward Plus - Octree Job Wait");
+			Engine::Get().GetJobSystem().Wait(FP_Data.OctreeUpdateJob);
+		}
 	}
 
 	/// <summary>
@@ -352,6 +381,9 @@ namespace Louron {
 		glEnable(GL_CULL_FACE);
 		glDepthFunc(GL_LEQUAL); 
 
+		// Recreate the geometry pool if a previous OnStopPipeline released it
+		Renderer::Init();
+
 		m_Scene = scene;
 
 		auto scene_ref = m_Scene.lock();
@@ -529,30 +561,33 @@ namespace Louron {
 
 		}
 
-		FP_Data.RenderableEntitiesInFrustum.reserve(1024);
-		FP_Data.OctreeEntitiesInCamera.reserve(1024);
+		FP_Data.RenderableProxiesInFrustum.reserve(1024);
+		FP_Data.RenderProxies.Clear();
 
 		FP_Data.PLEntitiesInFrustum.reserve(MAX_POINT_LIGHTS);
 		FP_Data.SLEntitiesInFrustum.reserve(MAX_SPOT_LIGHTS);
 		FP_Data.DLEntities.reserve(MAX_DIRECTIONAL_LIGHTS);
 
 		FP_Data.OpaqueRenderables = {};
+		FP_Data.OpaqueIndirectDraws = {};
 		FP_Data.TransparentRenderables = {};
 
 		FP_Data.EntityOcclusionQueries = {};
 		FP_Data.EntityOcclusionHistory = {};
 	}
 
+	void ForwardPlusPipeline::WaitForJobs() {
+
+		Engine::Get().GetJobSystem().Wait(FP_Data.OctreeUpdateJob);
+		Engine::Get().GetJobSystem().Wait(FP_Data.RenderQueueSortingJob);
+	}
+
 	/// <summary>
 	/// Reset OpenGL state configuration required by renderer and clean FP_Data and Light SSBOs.
 	/// </summary>
 	void ForwardPlusPipeline::OnStopPipeline() {
 		
-		if (FP_Data.OctreeUpdateThread.joinable())
-			FP_Data.OctreeUpdateThread.join();
-
-		if (FP_Data.RenderQueueSortingThread.joinable())
-			FP_Data.RenderQueueSortingThread.join();
+		WaitForJobs();
 
 		glDisable(GL_CULL_FACE);
 		glDisable(GL_DEPTH_TEST);
@@ -795,7 +830,7 @@ namespace Louron {
 
 		L_PROFILE_SCOPE("Forward Plus - Frustum Culling (LIGHTS)");
 
-		auto pl_view = scene_ref->GetAllEntitiesWith<PointLightComponent>();
+		auto pl_view = scene_ref->GetRegistry()->view<PointLightComponent>(entt::exclude<DespawnedComponent>);
 		for (const auto& entity_handle : pl_view) {
 
 			if (FP_Data.PLEntitiesInFrustum.size() >= MAX_POINT_LIGHTS)
@@ -811,7 +846,7 @@ namespace Louron {
 
 		}
 
-		auto sl_view = scene_ref->GetAllEntitiesWith<SpotLightComponent>();
+		auto sl_view = scene_ref->GetRegistry()->view<SpotLightComponent>(entt::exclude<DespawnedComponent>);
 		for (const auto& entity_handle : sl_view) {
 
 			if (FP_Data.SLEntitiesInFrustum.size() >= MAX_SPOT_LIGHTS)
@@ -845,7 +880,7 @@ namespace Louron {
 
 		}
 
-		auto dl_view = scene_ref->GetAllEntitiesWith<DirectionalLightComponent>();
+		auto dl_view = scene_ref->GetRegistry()->view<DirectionalLightComponent>(entt::exclude<DespawnedComponent>);
 		for (const auto& entity_handle : dl_view) {
 
 			if (FP_Data.DLEntities.size() >= MAX_DIRECTIONAL_LIGHTS)
@@ -874,38 +909,49 @@ namespace Louron {
 			return;
 		}
 
+		// View 0 is the camera, the shadow casting lights follow so the octree is only walked once
+		FP_Data.OctreeQueryVolumes.clear();
+		FP_Data.OctreeQueryVolumes.emplace_back(FP_Data.Camera_Frustum);
+		GatherShadowCastingViews(camera_position, projection_matrix);
+
 		size_t entity_counter{};
-		if (auto oct_ref = scene_ref->GetOctree().lock(); oct_ref) {
+		if (auto oct_ref = scene_ref->GetSpatialIndex().lock(); oct_ref) {
 
-			std::unique_lock lock(oct_ref->GetOctreeMutex());
-			const auto& query_vec = oct_ref->Query(FP_Data.Camera_Frustum);
+			std::shared_lock lock(oct_ref->GetMutex());
+			oct_ref->Query(FP_Data.OctreeQueryVolumes, FP_Data.OctreeQueryResults);
 
 			entity_counter = oct_ref->TotalCount();
-
-			if (query_vec.size() > FP_Data.OctreeEntitiesInCamera.capacity())
-				FP_Data.OctreeEntitiesInCamera.reserve(FP_Data.OctreeEntitiesInCamera.capacity() * 2);
-			
-			FP_Data.OctreeEntitiesInCamera.insert(FP_Data.OctreeEntitiesInCamera.begin(), query_vec.begin(), query_vec.end());
 		}
+		else {
+			FP_Data.OctreeQueryResults.resize(FP_Data.OctreeQueryVolumes.size());
+			for (auto& result : FP_Data.OctreeQueryResults)
+				result.clear();
+		}
+
+		const auto& octree_entities_in_camera = FP_Data.OctreeQueryResults[0];
 
 		std::unique_lock lock(FP_Data.RenderSortingMutex);
 
+		const RenderProxyStore& proxies = FP_Data.RenderProxies;
+
 		// Transfer Data Over because we don't want 
-		// to hold the shared_ptr's to OctreeData
-		FP_Data.RenderableEntitiesInFrustum.clear();
+		// to hold the Octree's data sources
+		FP_Data.RenderableProxiesInFrustum.clear();
+		FP_Data.ProxyInFrustum.assign(proxies.Size(), 0);
 
-		if (FP_Data.OctreeEntitiesInCamera.size() > FP_Data.RenderableEntitiesInFrustum.capacity())
-			FP_Data.RenderableEntitiesInFrustum.reserve(FP_Data.RenderableEntitiesInFrustum.capacity() * 2);
+		if (octree_entities_in_camera.size() > FP_Data.RenderableProxiesInFrustum.capacity())
+			FP_Data.RenderableProxiesInFrustum.reserve(FP_Data.RenderableProxiesInFrustum.capacity() * 2);
 
-		for (const auto& data : FP_Data.OctreeEntitiesInCamera) 
+		for (const auto& data : octree_entities_in_camera) 
 		{
-			if (!data->Data)
+			uint32_t proxy_index = proxies.GetProxyIndex((entt::entity)data.Data);
+			if (proxy_index == RENDER_PROXY_NULL_INDEX)
 				continue;
 
-			auto& component = data->Data.GetComponent<MeshRendererComponent>();
-			if (component.Active)
+			if (proxies.Flags[proxy_index] & RenderProxyFlag_Active)
 			{
-				FP_Data.RenderableEntitiesInFrustum.push_back(data->Data);
+				FP_Data.RenderableProxiesInFrustum.push_back(proxy_index);
+				FP_Data.ProxyInFrustum[proxy_index] = 1;
 			}
 		}
 
@@ -916,7 +962,7 @@ namespace Louron {
 			float B = projection_matrix[3][2];
 			float far_plane = B / (A + 1.0f);
 
-			auto view = scene_ref->GetAllEntitiesWith<LODMeshComponent>();
+			auto view = scene_ref->GetRegistry()->view<LODMeshComponent>(entt::exclude<DespawnedComponent>);
 			for (auto& entity_handle : view)
 			{
 				Entity lod_entity = { entity_handle, scene_ref.get() };
@@ -950,15 +996,125 @@ namespace Louron {
 						if (entity_handle == NULL_UUID)
 							continue;
 
-						FP_Data.RenderableEntitiesInFrustum.erase(std::remove(FP_Data.RenderableEntitiesInFrustum.begin(), FP_Data.RenderableEntitiesInFrustum.end(), scene_ref->FindEntityByUUID(entity_handle)), FP_Data.RenderableEntitiesInFrustum.end());
+						uint32_t proxy_index = proxies.GetProxyIndex((entt::entity)scene_ref->TryFindEntityByUUID(entity_handle));
+						if (proxy_index != RENDER_PROXY_NULL_INDEX)
+							FP_Data.ProxyInFrustum[proxy_index] = 0;
 					}
 				}
 
 			}
+
+			// Drop every LOD level that was flagged out in one pass
+			auto& in_frustum = FP_Data.ProxyInFrustum;
+			FP_Data.RenderableProxiesInFrustum.erase(std::remove_if(FP_Data.RenderableProxiesInFrustum.begin(), FP_Data.RenderableProxiesInFrustum.end(),
+				[&in_frustum](uint32_t proxy_index) { return in_frustum[proxy_index] == 0; }), FP_Data.RenderableProxiesInFrustum.end());
 		}
 
-		FP_Data.OctreeEntitiesInCamera.clear();
-		Renderer::s_RenderStats.Entities_Culled_Frustum = static_cast<GLuint>(entity_counter - FP_Data.RenderableEntitiesInFrustum.size());		
+		Renderer::s_RenderStats.Entities_Culled_Frustum = static_cast<GLuint>(entity_counter - FP_Data.RenderableProxiesInFrustum.size());		
+	}
+
+	/// <summary>
+	/// Selects the shadow casting lights for this frame and appends their query 
+	/// volumes to FP_Data.OctreeQueryVolumes, so their meshes are culled in the 
+	/// same octree traversal as the camera.
+	/// </summary>
+	void ForwardPlusPipeline::GatherShadowCastingViews(const glm::vec3& camera_position, const glm::mat4& projection_matrix) {
+
+		L_PROFILE_SCOPE("Forward Plus - Gather Shadow Casting Views");
+
+		// Directional Lights
+		{
+			FP_Data.DL_Shadow_CastingEntities.clear();
+			for (auto& entity : FP_Data.DLEntities)
+				if (entity.GetComponent<DirectionalLightComponent>().ShadowFlag != ShadowTypeFlag::NoShadows)
+				{
+					if (FP_Data.DL_Shadow_CastingEntities.size() >= FP_Data.DL_Shadow_Max_Maps)
+						break;
+
+					FP_Data.DL_Shadow_CastingEntities.push_back(entity);
+				}
+
+			// All directional lights share the one query around the camera.
+			// TODO: Need to fix this because it is not including objects that are behind camera frustum that 
+			// may cast shadow into frustum. Maybe we do this after generating the cascades and use the 
+			// world space AABB of the light projection to find our meshes?
+			if (!FP_Data.DL_Shadow_CastingEntities.empty())
+			{
+				float A = projection_matrix[2][2];
+				float B = projection_matrix[3][2];
+
+				Bounds_Sphere world_light_bounds;
+				world_light_bounds.BoundsCentre = camera_position;
+				world_light_bounds.BoundsRadius = B / (A + 1.0f);
+
+				FP_Data.DL_Shadow_QueryView = static_cast<uint32_t>(FP_Data.OctreeQueryVolumes.size());
+				FP_Data.OctreeQueryVolumes.emplace_back(world_light_bounds);
+			}
+		}
+
+		// Spot Lights
+		{
+			FP_Data.SL_Shadow_CastingEntities.clear();
+			FP_Data.SL_Shadow_LightSpaceMatrices.clear();
+			FP_Data.SL_Shadow_FirstQueryView = static_cast<uint32_t>(FP_Data.OctreeQueryVolumes.size());
+
+			for (auto& entity : FP_Data.SLEntitiesInFrustum)
+			{
+				if (!entity || entity.GetComponent<SpotLightComponent>().ShadowFlag == ShadowTypeFlag::NoShadows)
+					continue;
+
+				if (FP_Data.SL_Shadow_CastingEntities.size() >= FP_Data.SL_Shadow_Max_Maps)
+					break;
+
+				auto& transform = entity.GetComponent<TransformComponent>();
+
+				glm::mat4 light_proj = glm::perspective(glm::radians(entity.GetComponent<SpotLightComponent>().Angle), 1.0f, 0.1f, entity.GetComponent<SpotLightComponent>().Range);
+				glm::mat4 light_view = glm::lookAt(transform.GetGlobalPosition(), transform.GetGlobalPosition() + transform.GetForwardDirection(), glm::vec3(0.0f, 1.0f, 0.0f));
+
+				FP_Data.SL_Shadow_CastingEntities.push_back(entity);
+				FP_Data.SL_Shadow_LightSpaceMatrices.push_back(light_proj * light_view);
+				FP_Data.OctreeQueryVolumes.emplace_back(Frustum(FP_Data.SL_Shadow_LightSpaceMatrices.back()));
+			}
+		}
+
+		// Point Lights
+		{
+			constexpr int numShadowCastingLights = 5; // Number of shadow-casting lights
+
+			auto& pl_shadow_casting_vec = FP_Data.PL_Shadow_CastingEntities;
+			pl_shadow_casting_vec.clear();
+			for (auto& entity : FP_Data.PLEntitiesInFrustum)
+				if (entity.GetComponent<PointLightComponent>().ShadowFlag != ShadowTypeFlag::NoShadows)
+					pl_shadow_casting_vec.push_back(entity);
+
+			// Sort array based on distance
+			std::sort(pl_shadow_casting_vec.begin(), pl_shadow_casting_vec.end(),
+				[&camera_position](Entity& a, Entity& b) {
+					glm::vec3 posA = a.GetComponent<TransformComponent>().GetGlobalPosition();
+					glm::vec3 posB = b.GetComponent<TransformComponent>().GetGlobalPosition();
+					return glm::length(posA - camera_position) < glm::length(posB - camera_position);
+				});
+
+			// Keep only the closest 5 point lights
+			// TODO: Increase this so there is like a shadow map atlas with lower resolutions? 
+			// E.g., One cube map in the array could hold 4 more point light textures if the resolution is halved?
+			// Maybe we implement an algorithm to determine which are the most important point lights, 
+			//		- Create a cube map array with 25 x 2k textures
+			//		- assign a hard limit of maybe 5 x 2K cube maps for the most important point lights, 
+			//		- then have another 5 cube maps that are made up of 20 1K point lights, and so on
+			if (pl_shadow_casting_vec.size() > numShadowCastingLights)
+				pl_shadow_casting_vec.erase(pl_shadow_casting_vec.begin() + numShadowCastingLights, pl_shadow_casting_vec.end());
+
+			FP_Data.PL_Shadow_FirstQueryView = static_cast<uint32_t>(FP_Data.OctreeQueryVolumes.size());
+			for (auto& point_light : pl_shadow_casting_vec) {
+
+				Bounds_Sphere sphere{};
+				sphere.BoundsCentre = point_light.GetComponent<TransformComponent>().GetGlobalPosition();
+				sphere.BoundsRadius = point_light.GetComponent<PointLightComponent>().Radius;
+
+				FP_Data.OctreeQueryVolumes.emplace_back(sphere);
+			}
+		}
 	}
 
 	void ForwardPlusPipeline::ConductRenderableOcclusionCull()
@@ -974,11 +1130,13 @@ namespace Louron {
 
 		std::unique_lock lock(FP_Data.RenderSortingMutex);
 
+		const RenderProxyStore& proxies = FP_Data.RenderProxies;
+
 		// Occlusion Culling Checks
-		size_t entity_counter = FP_Data.RenderableEntitiesInFrustum.size();
+		size_t entity_counter = FP_Data.RenderableProxiesInFrustum.size();
 		for (auto it = FP_Data.EntityOcclusionQueries.begin(); it != FP_Data.EntityOcclusionQueries.end();)
 		{
-			Entity entity = scene_ref->FindEntityByUUID(it->first);
+			Entity entity = scene_ref->TryFindEntityByUUID(it->first);
 			if (!entity)
 			{
 				++it;
@@ -998,15 +1156,12 @@ namespace Louron {
 			bool is_visible = query.GetResult() != GL_FALSE;
 			FP_Data.EntityOcclusionHistory[it->first] = (is_visible) ? 5 : 0; // Result stays visible for atleast 5 frames
 
-			auto find_in_frustum_culled = std::find_if(
-				FP_Data.RenderableEntitiesInFrustum.begin(),
-				FP_Data.RenderableEntitiesInFrustum.end(),
-				[&](Entity& entity_find) { return entity_find == entity; });
+			uint32_t proxy_index = proxies.GetProxyIndex((entt::entity)entity);
 
-			if (find_in_frustum_culled != FP_Data.RenderableEntitiesInFrustum.end())
+			if (proxy_index != RENDER_PROXY_NULL_INDEX && FP_Data.ProxyInFrustum[proxy_index])
 			{
 				if (!is_visible)  // Entity is occluded
-					FP_Data.RenderableEntitiesInFrustum.erase(find_in_frustum_culled);
+					FP_Data.ProxyInFrustum[proxy_index] = 0;
 			}
 			else
 			{
@@ -1019,8 +1174,12 @@ namespace Louron {
 			++it;
 		}
 
-		Renderer::s_RenderStats.Entities_Culled_Occlusion = static_cast<GLuint>(entity_counter - FP_Data.RenderableEntitiesInFrustum.size());
-		Renderer::s_RenderStats.Entities_Culled_Remaining = static_cast<GLuint>(FP_Data.RenderableEntitiesInFrustum.size());
+		auto& in_frustum = FP_Data.ProxyInFrustum;
+		FP_Data.RenderableProxiesInFrustum.erase(std::remove_if(FP_Data.RenderableProxiesInFrustum.begin(), FP_Data.RenderableProxiesInFrustum.end(),
+			[&in_frustum](uint32_t proxy_index) { return in_frustum[proxy_index] == 0; }), FP_Data.RenderableProxiesInFrustum.end());
+
+		Renderer::s_RenderStats.Entities_Culled_Occlusion = static_cast<GLuint>(entity_counter - FP_Data.RenderableProxiesInFrustum.size());
+		Renderer::s_RenderStats.Entities_Culled_Remaining = static_cast<GLuint>(FP_Data.RenderableProxiesInFrustum.size());
 	}
 
 	/// <summary>
@@ -1046,38 +1205,36 @@ namespace Louron {
 
 		scene_ref->GetSceneFrameBuffer()->ClearEntityPixelData(NULL_UUID);
 
+		RenderProxyStore& proxies = FP_Data.RenderProxies;
+
 		{
 			L_PROFILE_SCOPE("Forward Plus - Depth Pass::Sorting");
 
-			FP_Data.DepthRenderables.clear();
+			FP_Data.DepthRenderables.Clear();
 
-			if (FP_Data.RenderableEntitiesInFrustum.empty())
+			if (FP_Data.RenderableProxiesInFrustum.empty())
 				return;
 
-			for (auto& entity : FP_Data.RenderableEntitiesInFrustum)
+			for (uint32_t proxy_index : FP_Data.RenderableProxiesInFrustum)
 			{
-				if (!scene_ref->ValidEntity(entity)) continue;
-
-				const glm::vec3& objectPosition = entity.GetComponent<TransformComponent>().GetGlobalPosition();
-				const Bounds_AABB& object_bounds = entity.GetComponent<MeshFilterComponent>().TransformedAABB;
+				if (proxies.Draws[proxy_index].empty())
+					continue;
 
 				// Find distance from closest point of AABB from camera_position
-				float distance = glm::length(camera_position - object_bounds.ClosestPoint(camera_position));
-
-				auto& material_vector = entity.GetComponent<MeshRendererComponent>().MeshRendererMaterialHandles;
-				if (material_vector.empty())
-					continue;
+				float distance = glm::length(camera_position - proxies.Bounds[proxy_index].ClosestPoint(camera_position));
 
-				FP_Data.DepthRenderables.emplace_back(distance, entity.GetUUID());
+				// Non negative floats keep their order when compared as unsigned integers
+				DrawItem item;
+				item.SortKey = std::bit_cast<uint32_t>(distance);
+				item.ProxyIndex = proxy_index;
+				FP_Data.DepthRenderables.Push(item);
 			}
 
 			// Front-to-Back sorting
-			std::sort(FP_Data.DepthRenderables.begin(), FP_Data.DepthRenderables.end(), [](const auto& a, const auto& b) {
-				return std::get<0>(a) < std::get<0>(b);
-			});
+			FP_Data.DepthRenderables.Sort();
 		}
 
-		if (!FP_Data.DepthRenderables.empty()) 
+		if (!FP_Data.DepthRenderables.IsEmpty()) 
 		{
 			L_PROFILE_SCOPE("Forward Plus - Depth Pass::Rendering");
 
@@ -1091,40 +1248,14 @@ namespace Louron {
 				shader->SetMat4("u_View", view_matrix);
 				shader->SetIntVec2("u_ScreenSize", screen_size);
 
-				for (auto& [distance, entity_uuid] : FP_Data.DepthRenderables) 
+				for (const DrawItem& depth_item : FP_Data.DepthRenderables.GetItems()) 
 				{
-					Entity entity = scene_ref->FindEntityByUUID(entity_uuid);
-					if (!entity) continue;
+					const uint32_t proxy_index = depth_item.ProxyIndex;
+					const UUID& entity_uuid = proxies.EntityUUIDs[proxy_index];
 
-					shader->SetMat4("u_Model", entity.GetComponent<TransformComponent>().GetGlobalTransform());
+					shader->SetMat4("u_Model", proxies.WorldMatrices[proxy_index]);
 					shader->SetUInt("u_EntityID", entity_uuid);
 
-					auto& mesh_filter_component = entity.GetComponent<MeshFilterComponent>();
-					auto& asset_mesh_handle = mesh_filter_component.MeshFilterAssetHandle;
-
-					// Check if Asset Handle is Valid
-					if (!AssetManager::IsAssetHandleValid(asset_mesh_handle))
-						continue;
-
-					// Retrieve Cached Mesh Asset
-					auto mesh_asset = FP_Data.CachedMeshAssets[asset_mesh_handle].lock();
-
-					// Check if Loaded
-					if (!mesh_asset)
-					{
-						// If Not Loaded, Call GetAsset to Load
-						FP_Data.CachedMeshAssets[asset_mesh_handle] = AssetManager::GetAsset<AssetMesh>(asset_mesh_handle);
-						mesh_asset = FP_Data.CachedMeshAssets[asset_mesh_handle].lock();
-						
-						// If Failed to Load - Continue
-						if (!mesh_asset)
-							continue;
-					}
-
-					auto& material_vector = entity.GetComponent<MeshRendererComponent>().MeshRendererMaterialHandles;
-					if (material_vector.empty())
-						continue;
-
 					if (FP_Data.EntityOcclusionQueries.count(entity_uuid) == 0)
 						FP_Data.EntityOcclusionQueries[entity_uuid] = Query(Query::Type::AnySamplesPassed);
 
@@ -1135,28 +1266,20 @@ namespace Louron {
 					if (conduct_query) 
 						FP_Data.EntityOcclusionQueries[entity_uuid].Begin();
 					
-					// Should I draw this to the depth map? How can I determine 
-					// whether to draw this to the depth map or not?
-					for (int i = 0; i < mesh_asset->SubMeshes.size(); i++)
+					for (const RenderProxyDraw& draw : proxies.Draws[proxy_index])
 					{
-						auto& material_asset_handle = i < material_vector.size() ? material_vector[i].first : material_vector.back().first;
-						auto asset_material = FP_Data.CachedMaterialAssets[material_asset_handle].lock();
-
-						if (!asset_material)
+						auto sub_mesh = proxies.SubMeshes.Get(draw.SubMeshID);
+						if (!sub_mesh)
 						{
-							// If Not Loaded, Call GetAsset to Load
-							FP_Data.CachedMaterialAssets[material_asset_handle] = AssetManager::GetAsset<Material>(material_asset_handle);
-							asset_material = FP_Data.CachedMaterialAssets[material_asset_handle].lock();
-
-							// If Failed to Load - Continue
-							if (!asset_material)
-								continue;
+							// The mesh was unloaded or reimported, rebuild the proxy next frame
+							proxies.MarkStale(proxies.EntityHandles[proxy_index]);
+							continue;
 						}
-						
-						bool disable_depth = (asset_material->GetRenderType() != RenderType::L_MATERIAL_OPAQUE);
+
+						bool disable_depth = !proxies.MaterialStates[draw.MaterialID].Drawable || proxies.MaterialStates[draw.MaterialID].Pass != DrawPass_Opaque;
 						if (disable_depth) glDepthMask(GL_FALSE);
 
-						Renderer::DrawSubMesh(mesh_asset->SubMeshes[i], true);
+						Renderer::DrawSubMesh(sub_mesh, true);
 
 						if (disable_depth) glDepthMask(GL_TRUE);
 					}
@@ -1246,8 +1369,8 @@ namespace Louron {
 
 		#pragma region Directional Light Shadows
 
-		std::vector<Entity> dl_shadow_casting_vec;
-		std::vector<Entity> dl_shadow_renderable_entities;
+		std::vector<Entity>& dl_shadow_casting_vec = FP_Data.DL_Shadow_CastingEntities;
+		std::vector<uint32_t> dl_shadow_casters;
 		std::vector<glm::mat4> dl_shadow_light_space_matricies;
 
 		FP_Data.DL_Shadow_LightSpaceMatrixIndex.clear();
@@ -1261,57 +1384,15 @@ namespace Louron {
 		float near_plane = B / (A - 1.0f);
 		float far_plane = B / (A + 1.0f);
 
-		// 1. Gather Directional Lights
-		{
-			L_PROFILE_SCOPE("Directional Shadow Mapping 1. Gathering");
-			dl_shadow_casting_vec.reserve(FP_Data.DLEntities.size());
-			for (auto& entity : FP_Data.DLEntities)
-				if (entity.GetComponent<DirectionalLightComponent>().ShadowFlag != ShadowTypeFlag::NoShadows)
-				{
-					if (dl_shadow_casting_vec.size() >= FP_Data.DL_Shadow_Max_Maps)
-						break;
-
-					dl_shadow_casting_vec.push_back(entity);
-				}
-		}
-
 		if(!dl_shadow_casting_vec.empty())
 		{
 
-			// 2. Calculate Light Space World Space AABB - Get Meshes Intersecting with AABB from Octree
-			// TODO: Need to fix this because it is not including objects that are behind camera frustum that 
-			// may cast shadow into frustum. Maybe we do this after generating the cascades and use the 
-			// world space AABB of the light projection to find our meshes?
-			Bounds_Sphere world_light_bounds;
-			{
-				L_PROFILE_SCOPE("Directional Shadow Mapping 2a. Calculate Light Space Bounds");
-
-				world_light_bounds.BoundsCentre = camera_position;
-				world_light_bounds.BoundsRadius = far_plane;
-			}
+			// 2. Get Meshes Intersecting with the Light Bounds, culled alongside the camera in ConductRenderableFrustumCull
 
 			{
-				L_PROFILE_SCOPE("Directional Shadow Mapping 2b. Get Meshes");
-
-				if (auto oct_ref = scene_ref->GetOctree().lock(); oct_ref) {
-
-					std::unique_lock lock(oct_ref->GetOctreeMutex());
-
-					const auto& query_vec = oct_ref->Query(world_light_bounds);
-
-					dl_shadow_renderable_entities.reserve(query_vec.size());
-
-					for (const auto& data : query_vec)
-					{
-						if (!data->Data)
-							continue;
-
-						auto& component = data->Data.GetComponent<MeshRendererComponent>();
-						if (component.Active && component.CastShadows)
-							dl_shadow_renderable_entities.push_back(data->Data);
-					}
-				}
+				L_PROFILE_SCOPE("Directional Shadow Mapping 2. Get Meshes");
 
+				GatherShadowCasters(FP_Data.OctreeQueryResults[FP_Data.DL_Shadow_QueryView], dl_shadow_casters);
 			}
 
 			// 3. Calculate Light Space Matricies Per Light Per Cascade - 40 x glm::mat4's is the max = MAX_DIRECTIONAL_LIGHTS * 4 cascades (per directional light)
@@ -1372,22 +1453,7 @@ namespace Louron {
 
 					shader->SetUInt("u_LightIndex", light_index);
 
-					for (auto& mesh_entity : dl_shadow_renderable_entities) {
-
-						if (!mesh_entity)
-							continue;
-
-						glm::mat4 transform = mesh_entity.GetComponent<TransformComponent>().GetGlobalTransform();
-						shader->SetMat4("u_Model", transform);
-
-						std::shared_ptr<AssetMesh> asset_mesh = AssetManager::GetAsset<AssetMesh>(mesh_entity.GetComponent<MeshFilterComponent>().MeshFilterAssetHandle);
-
-						if (asset_mesh)
-						{
-							for (auto& sub_mesh : asset_mesh->SubMeshes)
-								Renderer::DrawSubMesh(sub_mesh);
-						}
-					}
+					DrawShadowCasters(dl_shadow_casters, shader);
 
 				}
 
@@ -1401,69 +1467,22 @@ namespace Louron {
 
 		#pragma region Spot Light Shadows
 
-		std::vector<Entity> sl_shadow_casting_vec;
-		std::vector<glm::mat4> sl_shadow_light_space_matricies;
-		sl_shadow_light_space_matricies.reserve(30);
-		std::unordered_map<UUID, std::vector<Entity>> sl_shadow_renderable_entities;
+		std::vector<Entity>& sl_shadow_casting_vec = FP_Data.SL_Shadow_CastingEntities;
+		const std::vector<glm::mat4>& sl_shadow_light_space_matricies = FP_Data.SL_Shadow_LightSpaceMatrices;
+		std::unordered_map<UUID, std::vector<uint32_t>> sl_shadow_casters;
 
 		FP_Data.SL_Shadow_LightIndexMap.clear();
 
-		// 1. Gather Spot Lights
-
-		{
-			L_PROFILE_SCOPE("Spot Shadow Mapping 1. Gathering");
-			sl_shadow_casting_vec.reserve(FP_Data.SLEntitiesInFrustum.size());
-			for (auto& entity : FP_Data.SLEntitiesInFrustum)
-				if (entity.GetComponent<SpotLightComponent>().ShadowFlag != ShadowTypeFlag::NoShadows)
-				{
-					if (sl_shadow_casting_vec.size() >= FP_Data.SL_Shadow_Max_Maps)
-						break;
-
-					sl_shadow_casting_vec.push_back(entity);
-				}
-		}
-
-		// 2. Gather Meshes Inside Spot Light AABB's
-
 		if(!sl_shadow_casting_vec.empty())
 		{
 
-			{
-				L_PROFILE_SCOPE("Spot Shadow Mapping 2. Calculate ViewProj and Get Meshes in Frustum");
-				for (auto& entity : sl_shadow_casting_vec) {
-
-					if (!entity)
-						continue;
-
-					auto& transform = entity.GetComponent<TransformComponent>();
-
-					glm::mat4 light_proj = glm::perspective(glm::radians(entity.GetComponent<SpotLightComponent>().Angle), 1.0f, 0.1f, entity.GetComponent<SpotLightComponent>().Range);
-					glm::mat4 light_view = glm::lookAt(transform.GetGlobalPosition(), transform.GetGlobalPosition() + transform.GetForwardDirection(), glm::vec3(0.0f, 1.0f, 0.0f));
-
-					sl_shadow_light_space_matricies.push_back(light_proj * light_view);
-
-					Frustum spot_frustum = { sl_shadow_light_space_matricies.back() };
+			// 2. Get Meshes Inside each Spot Light Frustum, culled alongside the camera in ConductRenderableFrustumCull
 
-					if (auto oct_ref = scene_ref->GetOctree().lock(); oct_ref) {
-
-						std::unique_lock lock(oct_ref->GetOctreeMutex());
-
-						const auto& query_vec = oct_ref->Query(spot_frustum);
-
-						auto& sl_renderable_entities = sl_shadow_renderable_entities[entity.GetUUID()];
-						sl_renderable_entities.reserve(query_vec.size());
-
-						for (const auto& data : query_vec)
-						{
-							if (!data->Data)
-								continue;
-
-							auto& component = data->Data.GetComponent<MeshRendererComponent>();
-							if (component.Active && component.CastShadows)
-								sl_renderable_entities.push_back(data->Data);
-						}
-					}
+			{
+				L_PROFILE_SCOPE("Spot Shadow Mapping 2. Get Meshes in Frustum");
+				for (size_t light_index = 0; light_index < sl_shadow_casting_vec.size(); light_index++) {
 
+					GatherShadowCasters(FP_Data.OctreeQueryResults[FP_Data.SL_Shadow_FirstQueryView + light_index], sl_shadow_casters[sl_shadow_casting_vec[light_index].GetUUID()]);
 				}
 
 			}
@@ -1508,18 +1527,7 @@ namespace Louron {
 					shader->SetMat4("u_LightSpaceMatrix", sl_shadow_light_space_matricies[light_index]);
 					glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, FP_Data.SL_Shadow_Texture_Array, 0, light_index);
 
-					for (auto& mesh_entity : sl_shadow_renderable_entities[entity.GetUUID()]) {
-
-						if (!mesh_entity)
-							continue;
-
-						glm::mat4 transform = mesh_entity.GetComponent<TransformComponent>().GetGlobalTransform();
-						shader->SetMat4("u_Model", transform);
-
-						std::shared_ptr<AssetMesh> asset_mesh = AssetManager::GetAsset<AssetMesh>(mesh_entity.GetComponent<MeshFilterComponent>().MeshFilterAssetHandle);
-						for (auto& sub_mesh : asset_mesh->SubMeshes)
-							Renderer::DrawSubMesh(sub_mesh);
-					}
+					DrawShadowCasters(sl_shadow_casters[entity.GetUUID()], shader);
 
 				}
 
@@ -1535,64 +1543,17 @@ namespace Louron {
 
 		FP_Data.PL_Shadow_LightIndexMap.clear();
 
-		std::vector<Entity> pl_shadow_casting_vec;
-		std::unordered_map<UUID, std::vector<Entity>> pl_shadow_casting_meshes_map; // What meshes are inside this point light?
-		constexpr int numShadowCastingLights = 5; // Number of shadow-casting lights
+		std::vector<Entity>& pl_shadow_casting_vec = FP_Data.PL_Shadow_CastingEntities;
+		std::unordered_map<UUID, std::vector<uint32_t>> pl_shadow_casting_meshes_map; // What meshes are inside this point light?
 			
-		// 1. Gather and Sort Point Lights that have shadow mapping enabled
+		// 1. Get Meshes Inside each Point Light, culled alongside the camera in ConductRenderableFrustumCull
 		{
-			L_PROFILE_SCOPE("Point Shadow Mapping 1. Sorting");
-			pl_shadow_casting_vec.reserve(FP_Data.PLEntitiesInFrustum.size());
-			for (auto& entity : FP_Data.PLEntitiesInFrustum)
-				if (entity.GetComponent<PointLightComponent>().ShadowFlag != ShadowTypeFlag::NoShadows)
-					pl_shadow_casting_vec.push_back(entity);
-
-			// Sort array based on distance
-			std::sort(pl_shadow_casting_vec.begin(), pl_shadow_casting_vec.end(),
-				[&camera_position](Entity& a, Entity& b) {
-					glm::vec3 posA = a.GetComponent<TransformComponent>().GetGlobalPosition();
-					glm::vec3 posB = b.GetComponent<TransformComponent>().GetGlobalPosition();
-					return glm::length(posA - camera_position) < glm::length(posB - camera_position);
-				});
+			L_PROFILE_SCOPE("Point Shadow Mapping 1. Get Meshes");
 
-			// Keep only the closest 5 point lights
-			// TODO: Increase this so there is like a shadow map atlas with lower resolutions? 
-			// E.g., One cube map in the array could hold 4 more point light textures if the resolution is halved?
-			// Maybe we implement an algorithm to determine which are the most important point lights, 
-			//		- Create a cube map array with 25 x 2k textures
-			//		- assign a hard limit of maybe 5 x 2K cube maps for the most important point lights, 
-			//		- then have another 5 cube maps that are made up of 20 1K point lights, and so on
-			if (pl_shadow_casting_vec.size() > numShadowCastingLights)
-				pl_shadow_casting_vec.erase(pl_shadow_casting_vec.begin() + numShadowCastingLights, pl_shadow_casting_vec.end());
-
-			for (auto& point_light : pl_shadow_casting_vec) {
-
-				Bounds_Sphere sphere{};
-				sphere.BoundsCentre = point_light.GetComponent<TransformComponent>().GetGlobalPosition();
-				sphere.BoundsRadius = point_light.GetComponent<PointLightComponent>().Radius;
-
-				if (auto oct_ref = scene_ref->GetOctree().lock(); oct_ref) {
-
-					std::unique_lock lock(oct_ref->GetOctreeMutex());
-
-					const auto& query_vec = oct_ref->Query(sphere);
-
-					std::vector<Entity>& entities_in_light = pl_shadow_casting_meshes_map[point_light.GetUUID()];
-					entities_in_light.reserve(query_vec.size());
-
-					for (const auto& data : query_vec)
-					{
-						if (!data->Data)
-							continue;
-
-						auto& component = data->Data.GetComponent<MeshRendererComponent>();
-						if (component.Active && component.CastShadows)
-							entities_in_light.push_back(data->Data);
-					}
-				}
+			for (size_t light_index = 0; light_index < pl_shadow_casting_vec.size(); light_index++) {
 
+				GatherShadowCasters(FP_Data.OctreeQueryResults[FP_Data.PL_Shadow_FirstQueryView + light_index], pl_shadow_casting_meshes_map[pl_shadow_casting_vec[light_index].GetUUID()]);
 			}
-
 		}
 
 		// 2. Initialise and Draw Shadow CubeMap Array
@@ -1641,18 +1602,7 @@ namespace Louron {
 				FP_Data.PL_Shadow_LightIndexMap.insert({ pl_shadow_casting_vec[lightIndex].GetUUID(), lightIndex });
 
 				// Render all entities THAT ARE IN RANGE of this light in one pass.
-				for (auto& entity : pl_shadow_casting_meshes_map[pl_shadow_casting_vec[lightIndex].GetUUID()]) {
-
-					if (!entity)
-						continue;
-
-					glm::mat4 transform = entity.GetComponent<TransformComponent>().GetGlobalTransform();
-					shader->SetMat4("u_Model", transform);
-
-					std::shared_ptr<AssetMesh> asset_mesh = AssetManager::GetAsset<AssetMesh>(entity.GetComponent<MeshFilterComponent>().MeshFilterAssetHandle);
-					for (auto& sub_mesh : asset_mesh->SubMeshes)
-						Renderer::DrawSubMesh(sub_mesh);
-				}
+				DrawShadowCasters(pl_shadow_casting_meshes_map[pl_shadow_casting_vec[lightIndex].GetUUID()], shader);
 			}
 
 			shader->UnBind();
@@ -1666,6 +1616,52 @@ namespace Louron {
 			scene_ref->GetSceneFrameBuffer()->Bind();
 	}
 
+	/// <summary>
+	/// Collect the render proxies of the active, shadow casting meshes in an octree query result.
+	/// </summary>
+	void ForwardPlusPipeline::GatherShadowCasters(const std::vector<OctreeDataSource<Entity>>& query_results, std::vector<uint32_t>& shadow_casters) const {
+
+		const RenderProxyStore& proxies = FP_Data.RenderProxies;
+
+		shadow_casters.clear();
+		shadow_casters.reserve(query_results.size());
+
+		constexpr uint8_t shadow_caster_flags = RenderProxyFlag_Active | RenderProxyFlag_CastShadows;
+
+		for (const auto& data : query_results)
+		{
+			uint32_t proxy_index = proxies.GetProxyIndex((entt::entity)data.Data);
+			if (proxy_index == RENDER_PROXY_NULL_INDEX)
+				continue;
+
+			if ((proxies.Flags[proxy_index] & shadow_caster_flags) == shadow_caster_flags)
+				shadow_casters.push_back(proxy_index);
+		}
+	}
+
+	/// <summary>
+	/// Draw every sub mesh of each shadow caster with the bound shadow shader.
+	/// </summary>
+	void ForwardPlusPipeline::DrawShadowCasters(const std::vector<uint32_t>& shadow_casters, const std::shared_ptr<Shader>& shader) {
+
+		RenderProxyStore& proxies = FP_Data.RenderProxies;
+
+		for (uint32_t proxy_index : shadow_casters)
+		{
+			auto asset_mesh = proxies.MeshAssets[proxy_index].lock();
+			if (!asset_mesh)
+			{
+				proxies.MarkStale(proxies.EntityHandles[proxy_index]);
+				continue;
+			}
+
+			shader->SetMat4("u_Model", proxies.WorldMatrices[proxy_index]);
+
+			for (auto& sub_mesh : asset_mesh->SubMeshes)
+				Renderer::DrawSubMesh(sub_mesh);
+		}
+	}
+
 
 	/// <summary>
 	/// Conduct final colour pass. Meshes are sorted by material, then
@@ -1684,6 +1680,8 @@ namespace Louron {
 			return;
 		}
 
+		const RenderProxyStore& proxies = FP_Data.RenderProxies;
+
 		//// Render Skybox First w/ No Depth Testing
 		{
 			L_PROFILE_SCOPE("Forward Plus - Render Pass::Skybox");
@@ -1729,9 +1727,9 @@ namespace Louron {
 		}
 
 		// Wait for Sorting to Finish
-		if (FP_Data.RenderQueueSortingThread.joinable()) {
-			L_PROFILE_SCOPE("Forward Plus - Render Pass::Renderable Sorting Thread Wait");
-			FP_Data.RenderQueueSortingThread.join();
+		if (!FP_Data.RenderQueueSortingJob.IsFinished()) {
+			L_PROFILE_SCOPE("Forward Plus - Render Pass::Renderable Sorting Job Wait");
+			Engine::Get().GetJobSystem().Wait(FP_Data.RenderQueueSortingJob);
 		}
 		
 		// Rendering
@@ -1741,13 +1739,30 @@ namespace Louron {
 		float far_plane = B / (A + 1.0f);
 
 		// Lets colour in some triangles!
-		if (!FP_Data.OpaqueRenderables.empty()) 
+		if (!FP_Data.OpaqueIndirectDraws.IsEmpty()) 
 		{
 			L_PROFILE_SCOPE("Forward Plus - Render Pass::Opaque Pass");
-			for (const auto& [material_wrapper_pair, mesh_map] : FP_Data.OpaqueRenderables) 
+
+			const std::vector<DrawItem>& draw_items = FP_Data.OpaqueRenderables.GetItems();
+			const std::vector<DrawElementsIndirectCommand>& indirect_commands = FP_Data.OpaqueIndirectDraws.GetCommands();
+			const std::vector<IndirectDrawFallback>& indirect_fallbacks = FP_Data.OpaqueIndirectDraws.GetFallbacks();
+
+			// Write every visible transform into the instance ring once, in draw order, so each
+			// command below is just a base instance and a count into this frame's region
+			GLuint base_instance = 0;
+			glm::mat4* instance_transforms = Renderer::AllocateInstanceTransforms(static_cast<GLuint>(draw_items.size()), base_instance);
+			if (instance_transforms) {
+				for (size_t i = 0; i < draw_items.size(); i++)
+					instance_transforms[i] = proxies.WorldMatrices[draw_items[i].ProxyIndex];
+			}
+
+			// One material bind and one multi draw per material and uniform block
+			for (const IndirectDrawBucket& bucket : FP_Data.OpaqueIndirectDraws.GetBuckets())
 			{
+				if (!instance_transforms)
+					break;
 
-				const auto& material_asset = material_wrapper_pair.material;
+				const auto material_asset = proxies.Materials.Get(bucket.MaterialID);
 
 				if (!material_asset)
 					continue;
@@ -1758,7 +1773,7 @@ namespace Louron {
 				auto shader = material_asset->GetShader();
 				if (shader->IsValid())
 				{
-					material_asset->UpdateUniforms(material_wrapper_pair.uniform_block); // Change
+					material_asset->UpdateUniforms(proxies.UniformBlocks.Get(bucket.UniformBlockID));
 
 					// Update Specific Forward Plus Uniforms
 					shader->SetInt("u_TilesX", FP_Data.workGroupsX);
@@ -1816,38 +1831,36 @@ namespace Louron {
 					shader->SetMat4("u_VertexIn.View", view_matrix);
 				}
 
-				for (const auto& [sub_mesh, entities] : mesh_map) 
+				if (bucket.CommandCount > 0) {
+					shader->SetBool("u_UseInstanceData", true);
+					Renderer::DrawIndirectSubMeshes(&indirect_commands[bucket.FirstCommand], bucket.CommandCount, base_instance);
+				}
+
+				// Sub meshes missing from the geometry pool are drawn one at a time, which retries their upload
+				for (uint32_t i = bucket.FirstFallback; i < bucket.FirstFallback + bucket.FallbackCount; i++) 
 				{
+					const IndirectDrawFallback& fallback = indirect_fallbacks[i];
 
-					size_t entity_count = entities.size();
-					if (entity_count == 0)
+					const auto sub_mesh = proxies.SubMeshes.Get(fallback.SubMeshID);
+					if (!sub_mesh)
 						continue;
 
-					bool use_instance_data = (entity_count > 1);
+					bool use_instance_data = (fallback.InstanceCount > 1);
 					shader->SetBool("u_UseInstanceData", use_instance_data);
 
 					if (use_instance_data) {
-						std::vector<glm::mat4> transforms;
-						transforms.reserve(entity_count);
-
-						for (const auto& entity : entities) {
-							const auto& transform = scene_ref->FindEntityByUUID(entity).GetComponent<TransformComponent>().GetGlobalTransform();
-							transforms.push_back(transform);
-						}
-
-						Renderer::DrawInstancedSubMesh(sub_mesh, transforms);
+						Renderer::DrawInstancedSubMesh(sub_mesh, base_instance + fallback.FirstInstance, fallback.InstanceCount);
 					}
 					else 
 					{
-						const auto& transform = scene_ref->FindEntityByUUID(entities[0]).GetComponent<TransformComponent>().GetGlobalTransform();
-						shader->SetMat4("u_VertexIn.Model", transform);
+						shader->SetMat4("u_VertexIn.Model", proxies.WorldMatrices[draw_items[fallback.FirstInstance].ProxyIndex]);
 						Renderer::DrawSubMesh(sub_mesh);
 					}
 				}
 			}
 		}
 
-		if (!FP_Data.TransparentRenderables.empty())
+		if (!FP_Data.TransparentRenderables.IsEmpty())
 		{
 			L_PROFILE_SCOPE("Forward Plus - Render Pass::Transparent Pass");
 
@@ -1858,12 +1871,13 @@ namespace Louron {
 			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 			// Render Transparent Objects Back to Front One By One....
-			for (const auto& [distance, material_wrapper_pair, sub_mesh, entity_uuid] : FP_Data.TransparentRenderables)
+			for (const DrawItem& draw_item : FP_Data.TransparentRenderables.GetItems())
 			{
-				Entity ent = scene_ref->FindEntityByUUID(entity_uuid);
-				if (!ent) continue;
+				const auto material_asset = proxies.Materials.Get(draw_item.MaterialID);
+				const auto sub_mesh = proxies.SubMeshes.Get(draw_item.SubMeshID);
 
-				const auto& material_asset = material_wrapper_pair.material;
+				if (!sub_mesh)
+					continue;
 
 				if (!material_asset)
 					continue;
@@ -1879,7 +1893,7 @@ namespace Louron {
 					// We may not want to override current depth during transparent pass
 					glDepthMask(material_asset->IsTransparencyWriteDepth());
 
-					material_asset->UpdateUniforms(material_wrapper_pair.uniform_block);
+					material_asset->UpdateUniforms(proxies.UniformBlocks.Get(draw_item.UniformBlockID));
 
 					// Update Specific Forward Plus Uniforms
 					shader->SetInt("u_TilesX", FP_Data.workGroupsX);
@@ -1940,8 +1954,7 @@ namespace Louron {
 
 				shader->SetBool("u_UseInstanceData", false);
 
-				const auto& transform = ent.GetComponent<TransformComponent>().GetGlobalTransform();
-				shader->SetMat4("u_VertexIn.Model", transform);
+				shader->SetMat4("u_VertexIn.Model", proxies.WorldMatrices[draw_item.ProxyIndex]);
 				Renderer::DrawSubMesh(sub_mesh);
 			}
 
@@ -1952,171 +1965,6 @@ namespace Louron {
 			glDisable(GL_BLEND);
 		}
 
-		// Sorting
-		FP_Data.RenderQueueSortingThread = std::thread([&]() -> void 
-		{
-
-			L_PROFILE_SCOPE("Forward Plus - Render Pass::Renderable Sorting");
-
-			auto thread_scene_ref = m_Scene.lock();
-
-			if (!thread_scene_ref) {
-				L_CORE_ERROR("Invalid Scene!");
-				return;
-			}
-
-			FP_Data.OpaqueRenderables.clear();
-			FP_Data.TransparentRenderables.clear();
-			FP_Data.Debug_RenderAABB.clear();
-
-			std::unique_lock lock(FP_Data.RenderSortingMutex);
-			if (FP_Data.RenderableEntitiesInFrustum.empty())
-				return;
-
-			for (auto& entity : FP_Data.RenderableEntitiesInFrustum)
-			{
-				if (!thread_scene_ref->ValidEntity(entity))
-					continue;
-
-				auto& mesh_filter_component = entity.GetComponent<MeshFilterComponent>();
-
-				// Check if Asset Handle is Valid
-				if (!AssetManager::IsAssetHandleValid(mesh_filter_component.MeshFilterAssetHandle))
-					continue;
-
-				// Retrieve Cached Mesh Asset
-				auto mesh_asset = FP_Data.CachedMeshAssets[mesh_filter_component.MeshFilterAssetHandle].lock();
-
-				// Check if Loaded
-				if (!mesh_asset)
-				{
-					// If Not Loaded, Call GetAsset to Load
-					FP_Data.CachedMeshAssets[mesh_filter_component.MeshFilterAssetHandle] = AssetManager::GetAsset<AssetMesh>(mesh_filter_component.MeshFilterAssetHandle);
-					mesh_asset = FP_Data.CachedMeshAssets[mesh_filter_component.MeshFilterAssetHandle].lock();
-
-					// If Failed to Load - Continue
-					if (!mesh_asset)
-						continue;
-				}
-
-				// Retrieve Sub Meshes
-				auto& sub_meshes = mesh_asset->SubMeshes;
-
-				// Retrieve All MeshMaterialHandles
-				auto& material_handles = entity.GetComponent<MeshRendererComponent>().MeshRendererMaterialHandles;
-
-				if (sub_meshes.empty() || material_handles.empty())
-					continue;
-
-				// MATERIAL AND MATERIAL UNIFORM BLOCK SORTING
-				// Materials will be sorted based on their material, and the uniform 
-				// block of an individual material on a MeshRendererComponent.
-				int material_index = 0;
-				for (int i = 0; i < sub_meshes.size(); ++i)
-				{
-					// Material Handle + Uniform Group in Mesh Renderer Component
-					// Nullptr means there is no custom uniform block
-					auto& mesh_renderer_material_pair = material_handles[material_index];
-
-					// Retrieve Cached Mesh Asset
-					auto material_asset = FP_Data.CachedMaterialAssets[mesh_renderer_material_pair.first].lock();
-
-					// Check if Loaded
-					if (!material_asset)
-					{
-						// If Not Loaded, Call GetAsset to Load
-						FP_Data.CachedMaterialAssets[mesh_renderer_material_pair.first] = AssetManager::GetAsset<Material>(mesh_renderer_material_pair.first);
-						material_asset = FP_Data.CachedMaterialAssets[mesh_renderer_material_pair.first].lock();
-
-						// If Failed to Load - Continue
-						if (!material_asset)
-							continue;
-					}
-
-					// Opaque Sorting
-					if (material_asset->GetRenderType() == RenderType::L_MATERIAL_OPAQUE)
-					{
-
-						// Retrieve the Uniform Block Associated w/ This Mesh Renderer Material
-						const auto& uniform_block = (mesh_renderer_material_pair.second) ? mesh_renderer_material_pair.second : material_asset->GetUniformBlock();
-
-						// Key the Material Wrapper to Secure Placement in Opaque Queue
-						auto& sub_mesh_map = FP_Data.OpaqueRenderables[{ material_asset, uniform_block}]; // Keys this to the opaque renderables
-
-						// Key the Sub Mesh to Retrieve Vector of Entities in this Rendering State
-						auto& entity_vector = sub_mesh_map[sub_meshes[i]];
-
-						// If First - Set Allocation for 8 entities
-						if (entity_vector.size() == 0 && entity_vector.capacity() == 0)
-							entity_vector.reserve(8);
-
-						// If we need to reallocate, double if capacity 
-						// is under 64, if above, we will + 8 only
-						if (entity_vector.size() >= entity_vector.capacity())
-							entity_vector.reserve(entity_vector.size() < 64 ? entity_vector.capacity() * 2 : entity_vector.capacity() + 8);
-
-						entity_vector.push_back(entity.GetUUID());
-
-					}
-					// Transparent Sorting
-					else if (material_asset->GetRenderType() == RenderType::L_MATERIAL_TRANSPARENT || material_asset->GetRenderType() == RenderType::L_MATERIAL_TRANSPARENT_WRITE_DEPTH)
-					{
-						const glm::vec3& objectPosition = entity.GetComponent<TransformComponent>().GetGlobalPosition();
-						float distance = glm::length(objectPosition - camera_position);
-
-						// If First - Set Allocation for 128 entities
-						// This queue is not batched w/ multiple render
-						// states or materials, these all need to be 
-						// rendered back to front
-						if (FP_Data.TransparentRenderables.size() == 0 && FP_Data.TransparentRenderables.capacity() == 0)
-							FP_Data.TransparentRenderables.reserve(128);
-
-						// If we need to reallocate, double if capacity is under 1024, if above, we will + 16 only
-						if (FP_Data.TransparentRenderables.size() >= FP_Data.TransparentRenderables.capacity())
-							FP_Data.TransparentRenderables.reserve(FP_Data.TransparentRenderables.size() < 1024 ? FP_Data.TransparentRenderables.capacity() * 2 : FP_Data.TransparentRenderables.capacity() + 16);
-
-						// Emplace to Back of TransparentRenderQueue
-						FP_Data.TransparentRenderables.emplace_back
-						(
-							distance,
-							_MaterialWrapper{ material_asset, mesh_renderer_material_pair.second ? mesh_renderer_material_pair.second : material_asset->GetUniformBlock() },
-							sub_meshes[i],
-							entity.GetUUID()
-						);
-					}
-
-					// Makes sure we don't exceed the maximum materials, if we do, then we will 
-					// just continue using the last material in the Mesh Renderer materials vector
-					if (material_index < material_handles.size() - 1)
-						material_index++;
-				}
-
-				// Set Option for Debug Draw Cube for AABB
-				if (mesh_filter_component.GetShouldDisplayDebugLines())
-					FP_Data.Debug_RenderAABB.push_back(mesh_filter_component.TransformedAABB.GetGlobalBoundsMat4());
-			}
-
-			// Back-to-Front Sorting - Transparent Objects
-			std::sort(FP_Data.TransparentRenderables.begin(), FP_Data.TransparentRenderables.end(), [](const auto& a, const auto& b) 
-			{    
-				// Check if either material should be rendered first (before sorting by distance)
-				bool aRenderFirst = std::get<1>(a).material->IsTransparencyWriteDepth();
-				bool bRenderFirst = std::get<1>(b).material->IsTransparencyWriteDepth();
-
-				if (aRenderFirst && !bRenderFirst) {
-					// If 'a' should be rendered first, put it in front
-					return true;
-				}
-				else if (!aRenderFirst && bRenderFirst) {
-					// If 'b' should be rendered first, put it in front
-					return false;
-				}
-
-				// If neither or both materials should be rendered first, perform the standard back-to-front sorting by distance
-				return std::get<0>(a) > std::get<0>(b); // Sort by distance, back-to-front
-			});
-		});
-
 		// Debug Rendering
 		{
 			L_PROFILE_SCOPE("Forward Plus - Render Pass::Draw Debug Lines");
@@ -2128,7 +1976,7 @@ namespace Louron {
 				bounds_matricies.clear();
 
 			// Octree Display Enabled
-			if (auto octree_ref = scene_ref->GetOctree().lock(); octree_ref && scene_ref->GetDisplayOctree()) {
+			if (auto octree_ref = scene_ref->GetSpatialIndex().lock(); octree_ref && scene_ref->GetDisplayOctree()) {
 
 				// Draw Octree
 				auto debug_line_shader = AssetManager::GetInbuiltShader("Debug_Line_Draw");
@@ -2139,7 +1987,12 @@ namespace Louron {
 					debug_line_shader->SetMat4("u_VertexIn.View", view_matrix);
 					debug_line_shader->SetBool("u_UseInstanceData", true);
 
-					Renderer::DrawInstancedDebugCube(octree_ref->GetAllOctreeBoundsMat4());
+					std::vector<glm::mat4> index_bounds_matricies;
+					{
+						std::shared_lock lock(octree_ref->GetMutex());
+						index_bounds_matricies = octree_ref->GetAllBoundsMat4();
+					}
+					Renderer::DrawInstancedDebugCube(index_bounds_matricies);
 
 					debug_line_shader->Bind();
 					debug_line_shader->SetFloatVec4("u_LineColor", { 0.0f, 1.0f, 0.0f, 1.0f });
@@ -2148,13 +2001,8 @@ namespace Louron {
 					debug_line_shader->SetBool("u_UseInstanceData", true);
 
 					// Draw All Bounds of Data Sources in Octree
-					for (auto& entity : FP_Data.RenderableEntitiesInFrustum) {
-
-						if (!scene_ref->ValidEntity(entity)) continue;
-
-						if (entity.HasComponent<MeshFilterComponent>())
-							bounds_matricies.push_back(entity.GetComponent<MeshFilterComponent>().TransformedAABB.GetGlobalBoundsMat4());
-					}
+					for (uint32_t proxy_index : FP_Data.RenderableProxiesInFrustum)
+						bounds_matricies.push_back(proxies.Bounds[proxy_index].GetGlobalBoundsMat4());
 
 					Renderer::DrawInstancedDebugCube(bounds_matricies);
 
@@ -2191,6 +2039,68 @@ namespace Louron {
 		glUseProgram(0);
 	}
 
+	/// <summary>
+	/// Build and sort the opaque and transparent draw lists from the render proxies
+	/// that survived culling this frame. Only reads the proxy columns, so this is
+	/// safe to run on the sorting thread while the main thread dispatches the light cull.
+	/// </summary>
+	void ForwardPlusPipeline::BuildRenderQueues(const glm::vec3& camera_position, float far_plane) {
+
+		L_PROFILE_SCOPE("Forward Plus - Render Pass::Renderable Sorting");
+
+		std::unique_lock lock(FP_Data.RenderSortingMutex);
+
+		const RenderProxyStore& proxies = FP_Data.RenderProxies;
+
+		FP_Data.OpaqueRenderables.Clear();
+		FP_Data.TransparentRenderables.Clear();
+		FP_Data.Debug_RenderAABB.clear();
+
+		for (uint32_t proxy_index : FP_Data.RenderableProxiesInFrustum)
+		{
+			const glm::vec3 object_position = glm::vec3(proxies.WorldMatrices[proxy_index][3]);
+			const uint32_t depth = DrawSortKey::QuantiseDepth(glm::length(object_position - camera_position), far_plane);
+
+			// MATERIAL AND MATERIAL UNIFORM BLOCK SORTING
+			// Draws will be sorted based on their material, and the uniform 
+			// block of an individual material on a MeshRendererComponent.
+			for (const RenderProxyDraw& draw : proxies.Draws[proxy_index])
+			{
+				const RenderMaterialState& material_state = proxies.MaterialStates[draw.MaterialID];
+				if (!material_state.Drawable)
+					continue;
+
+				DrawItem item;
+				item.ProxyIndex = proxy_index;
+				item.MaterialID = draw.MaterialID;
+				item.UniformBlockID = draw.UniformBlockID;
+				item.SubMeshID = draw.SubMeshID;
+
+				// Opaque - grouped by render state, then front to back
+				if (material_state.Pass == DrawPass_Opaque)
+				{
+					item.SortKey = DrawSortKey::MakeOpaque(material_state.ShaderID, item.MaterialID, item.UniformBlockID, item.SubMeshID, depth);
+					FP_Data.OpaqueRenderables.Push(item);
+				}
+				// Transparent - depth writing materials first, then back to front
+				else
+				{
+					item.SortKey = DrawSortKey::MakeTransparent(material_state.Pass, material_state.ShaderID, item.MaterialID, item.UniformBlockID, item.SubMeshID, depth);
+					FP_Data.TransparentRenderables.Push(item);
+				}
+			}
+
+			// Set Option for Debug Draw Cube for AABB
+			if (proxies.Flags[proxy_index] & RenderProxyFlag_DisplayDebugBounds)
+				FP_Data.Debug_RenderAABB.push_back(proxies.Bounds[proxy_index].GetGlobalBoundsMat4());
+		}
+
+		FP_Data.OpaqueRenderables.Sort();
+		FP_Data.TransparentRenderables.Sort();
+
+		FP_Data.OpaqueIndirectDraws.Build(FP_Data.OpaqueRenderables.GetItems(), proxies.SubMeshRanges);
+	}
+
 	void ForwardPlusPipeline::RenderFBOQuad() {
 
 		auto scene_ref = m_Scene.lock();
@@ -7,32 +7,17 @@
 #include "../OpenGL/Vertex Array.h"
 #include "../Scene/Frustum.h"
 #include "../Scene/OctreeBounds.h"
+#include "Render Queue.h"
+#include "Render Proxy.h"
+#include "Indirect Draw List.h"
+#include "../Core/Job System.h"
 
 // C++ Standard Library Headers
 #include <memory>
 
 // External Vendor Library Headers
 #include <glad/glad.h>
-
-// So we can Key a Pair of Material and Uniform Block
-struct _MaterialWrapper {
-	std::shared_ptr<Louron::Material> material;
-	std::shared_ptr<Louron::MaterialUniformBlock> uniform_block;
-
-	// Compare the actual contents, not just pointers
-	bool operator==(const _MaterialWrapper& other) const {
-		return material.get() == other.material.get() && uniform_block.get() == other.uniform_block.get();
-	}
-};
-
-namespace std {
-	template <>
-	struct hash<_MaterialWrapper> {
-		std::size_t operator()(const _MaterialWrapper& mw) const {
-			return std::hash<std::shared_ptr<Louron::Material>>{}(mw.material) ^ (std::hash<std::shared_ptr<Louron::MaterialUniformBlock>>{}(mw.uniform_block) << 1);
-		}
-	};
-}
+#include <entt/entt.hpp>
 
 namespace Louron {
 
@@ -67,6 +52,12 @@ namespace Louron {
 
 		virtual void RenderFBOQuad() {}
 
+		/// <summary>
+		/// Block until the jobs the last OnUpdate left running have finished, e.g. the
+		/// octree update, which writes to the scene's registry and spatial index.
+		/// </summary>
+		virtual void WaitForJobs() {}
+
 	private:
 
 		void ConductRenderPass(const glm::vec3& camera_position, const glm::mat4& projection_matrix, const glm::mat4& view_matrix);
@@ -76,9 +67,6 @@ namespace Louron {
 		std::weak_ptr<Louron::Scene> m_Scene;
 	};
 
-	using DepthRenderQueue = std::vector<std::tuple<float, UUID>>;
-	using OpaqueRenderQueue = std::unordered_map<_MaterialWrapper, std::unordered_map<std::shared_ptr<SubMesh>, std::vector<UUID>>>;
-	using TransparentRenderQueue = std::vector<std::tuple<float, _MaterialWrapper, std::shared_ptr<SubMesh>, UUID>>;
 	using GeometryQueryMap = std::unordered_map<UUID, Query>;
 
 	class ForwardPlusPipeline : public RenderPipeline {
@@ -95,6 +83,8 @@ namespace Louron {
 
 		void RenderFBOQuad() override;
 
+		void WaitForJobs() override;
+
 	private:
 
 		void UpdateComputeData();
@@ -102,12 +92,18 @@ namespace Louron {
 		void UpdateSSBOData();
 		void ConductLightFrustumCull();
 		void ConductRenderableFrustumCull(const glm::vec3& camera_position, const glm::mat4& projection_matrix);
+		void GatherShadowCastingViews(const glm::vec3& camera_position, const glm::mat4& projection_matrix);
 		void ConductRenderableOcclusionCull();
 		void ConductDepthPass(const glm::vec3& camera_position, const glm::mat4& projection_matrix, const glm::mat4& view_matrix);
 		void ConductTiledBasedLightCull(const glm::mat4& projection_matrix, const glm::mat4& view_matrix);
 		void ConductShadowMapping(const glm::vec3& camera_position, const glm::mat4& projection_matrix, const glm::mat4& view_matrix);
 		void ConductRenderPass(const glm::vec3& camera_position, const glm::mat4& projection_matrix, const glm::mat4& view_matrix);
 
+		void BuildRenderQueues(const glm::vec3& camera_position, float far_plane);
+
+		void GatherShadowCasters(const std::vector<OctreeDataSource<Entity>>& query_results, std::vector<uint32_t>& shadow_casters) const;
+		void DrawShadowCasters(const std::vector<uint32_t>& shadow_casters, const std::shared_ptr<Shader>& shader);
+
 		bool IsSphereInsideFrustum(const Bounds_Sphere& bounds, const Frustum& frustum);
 
 	private:
@@ -130,8 +126,9 @@ namespace Louron {
 			GeometryQueryMap EntityOcclusionQueries;
 			std::unordered_map<UUID, uint8_t> EntityOcclusionHistory;
 
-			// TODO: Consider Unordered Set for O(1) opposed to O(n)
-			std::vector<Entity> RenderableEntitiesInFrustum;
+			// Indices into RenderProxies, ProxyInFrustum is indexed by proxy and flags the same set
+			std::vector<uint32_t> RenderableProxiesInFrustum;
+			std::vector<uint8_t> ProxyInFrustum;
 			std::vector<Entity> PLEntitiesInFrustum;
 			std::vector<Entity> SLEntitiesInFrustum;
 			std::vector<Entity> DLEntities;
@@ -142,24 +139,30 @@ namespace Louron {
 			bool Debug_ShowWireframe = false;
 			std::vector<glm::mat4> Debug_RenderAABB;
 
-			DepthRenderQueue DepthRenderables;
-			OpaqueRenderQueue OpaqueRenderables;
-			TransparentRenderQueue TransparentRenderables;
+			// Mesh entities as seen by the renderer, only updated when an entity changes
+			RenderProxyStore RenderProxies;
+
+			RenderQueue DepthRenderables;
+			RenderQueue OpaqueRenderables;
+			IndirectDrawList OpaqueIndirectDraws;
+			RenderQueue TransparentRenderables;
 			std::mutex RenderSortingMutex;
-			std::thread RenderQueueSortingThread;
+			JobHandle RenderQueueSortingJob;
 
-			// Cached weak ptr's to reduce AssetManager Get Calls
-			std::unordered_map<AssetHandle, std::weak_ptr<AssetMesh>> CachedMeshAssets;
-			std::unordered_map<AssetHandle, std::weak_ptr<Material>> CachedMaterialAssets;
+			JobHandle OctreeUpdateJob;
+			std::vector<entt::entity> OctreeDirtyEntities;
 
-			std::thread OctreeUpdateThread;
-			std::vector<std::shared_ptr<OctreeDataSource<Entity>>> OctreeEntitiesInCamera;
+			// Camera and shadow casting views culled in one octree traversal, view 0 is the camera
+			std::vector<OctreeQueryVolume> OctreeQueryVolumes;
+			std::vector<std::vector<OctreeDataSource<Entity>>> OctreeQueryResults;
 
 			GLuint PL_Shadow_Max_Maps = 5;
 			GLuint PL_Shadow_Map_Res = 1024;
 			GLuint PL_Shadow_FrameBuffer = -1;
 			GLuint PL_Shadow_CubeMap_Array = -1;
 			std::unordered_map<UUID, GLuint> PL_Shadow_LightIndexMap;
+			std::vector<Entity> PL_Shadow_CastingEntities;
+			uint32_t PL_Shadow_FirstQueryView = 0;				// Octree query view of PL_Shadow_CastingEntities[0]
 
 			GLuint SL_Shadow_Max_Maps = 30;
 			GLuint SL_Shadow_Map_Res = 1024;
@@ -167,6 +170,9 @@ namespace Louron {
 			GLuint SL_Shadow_Texture_Array = -1;
 			GLuint SL_Shadow_LightSpaceMatrix_Buffer = -1;	// Buffer that holds light space matrice for each directional light cascade
 			std::unordered_map<UUID, GLuint> SL_Shadow_LightIndexMap;
+			std::vector<Entity> SL_Shadow_CastingEntities;
+			std::vector<glm::mat4> SL_Shadow_LightSpaceMatrices;
+			uint32_t SL_Shadow_FirstQueryView = 0;				// Octree query view of SL_Shadow_CastingEntities[0]
 
 			GLuint DL_Shadow_Max_Maps = 5;
 			GLuint DL_Shadow_Map_Res = 1024;
@@ -176,6 +182,8 @@ namespace Louron {
 
 			std::unordered_map<UUID, GLuint> DL_Shadow_LightSpaceMatrixIndex;
 			std::unordered_map<UUID, std::array<float, 5>> DL_Shadow_LightShadowCascadeDistances;
+			std::vector<Entity> DL_Shadow_CastingEntities;
+			uint32_t DL_Shadow_QueryView = 0;					// Octree query view shared by all directional lights
 
 		} FP_Data;
 
@@ -0,0 +1,1142 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../Core/Logging.h"
+#include "../Debug/Assert.h"
+
+#include "Bounds.h"
+#include "Frustum.h"
+#include "Spatial Index.h"
+
+namespace Louron {
+
+	struct BVHBoundsConfig {
+
+		/// <summary>
+		/// How many bins per axis the SAH build sorts centroids into when
+		/// choosing where to split a node. More bins find slightly better
+		/// splits at the cost of a slower build.
+		/// </summary>
+		uint32_t SAHBinCount = 16;
+
+		/// <summary>
+		/// Leaf bounds are expanded by this margin in worldspace, so a data source
+		/// can move this far before its leaf and the leaf's parents need refitting.
+		/// </summary>
+		float LeafMargin = 0.1f;
+
+		/// <summary>
+		/// Refitting and incremental inserts slowly make the tree worse. When the
+		/// SAH cost of the tree grows past this multiple of the cost right after
+		/// the last full build, PerformMaintenance rebuilds the tree.
+		/// </summary>
+		float RebuildCostRatio = 1.5f;
+
+	};
+
+	/// <summary>
+	/// Index used by the BVH node arena to mark a node that does not exist.
+	/// </summary>
+	constexpr uint32_t BVH_NULL_INDEX = UINT32_MAX;
+
+	/// <summary>
+	/// Binary Bounding Volume Hierarchy with one data source per leaf. The tree is
+	/// built top down with a binned Surface Area Heuristic, single data sources are
+	/// inserted by walking down to the cheapest sibling, and updates refit the
+	/// leaf and its parents in place instead of reinserting.
+	///
+	/// Query results match OctreeBounds, a data source is returned when the query
+	/// does not report DoesNotContain for its bounds.
+	/// </summary>
+	template <typename DataType>
+	class BVHBounds : public SpatialIndex<DataType> {
+
+	public:
+
+		using BVHData = OctreeDataSource<DataType>;
+		using BVHRayHit = typename SpatialIndex<DataType>::RayHit;
+		using BVHRayFilter = typename SpatialIndex<DataType>::RayFilter;
+
+	private:
+
+		/// <summary>
+		/// Nodes are stored by value in the node arena and reference their parent
+		/// and children by 32-bit index. Freed nodes are recycled through a free list.
+		/// </summary>
+		struct BVHBoundsNode {
+
+			/// <summary>
+			/// Bounds enclosing both children, or the data source of a leaf
+			/// expanded by the LeafMargin.
+			/// </summary>
+			Bounds_AABB NodeBounds{};
+
+			uint32_t ParentNode = BVH_NULL_INDEX;
+			uint32_t LeftNode = BVH_NULL_INDEX;
+			uint32_t RightNode = BVH_NULL_INDEX;
+
+			/// <summary>
+			/// Index of the data source in m_DataSources, only set for leaves.
+			/// </summary>
+			uint32_t DataSourceIndex = BVH_NULL_INDEX;
+
+			bool IsLeaf() const { return DataSourceIndex != BVH_NULL_INDEX; }
+		};
+
+	public:
+
+		BVHBounds() = default;
+
+		BVHBounds(const BVHBoundsConfig& config) : m_Config(config) { }
+
+		BVHBounds(const BVHBoundsConfig& config, std::vector<BVHData> data_sources) : m_Config(config) {
+			BuildBVH(std::move(data_sources));
+		}
+
+		~BVHBounds() override = default;
+
+		/// <summary>
+		/// Copying a BVH is a straight copy of its arenas. The caller should lock
+		/// the other BVH's mutex if it may be updated from another thread.
+		/// </summary>
+		BVHBounds(const BVHBounds& other) :
+			m_Config(other.m_Config), m_RootNode(other.m_RootNode),
+			m_Nodes(other.m_Nodes), m_FreeNodes(other.m_FreeNodes),
+			m_DataSources(other.m_DataSources), m_DataSourceLeaves(other.m_DataSourceLeaves),
+			m_DataSourceIndices(other.m_DataSourceIndices),
+			m_BuildCost(other.m_BuildCost), m_ChangesSinceCostCheck(other.m_ChangesSinceCostCheck) { }
+
+		BVHBounds& operator=(const BVHBounds& other) {
+			if (this == &other)
+				return *this;
+
+			m_Config = other.m_Config;
+			m_RootNode = other.m_RootNode;
+			m_Nodes = other.m_Nodes;
+			m_FreeNodes = other.m_FreeNodes;
+			m_DataSources = other.m_DataSources;
+			m_DataSourceLeaves = other.m_DataSourceLeaves;
+			m_DataSourceIndices = other.m_DataSourceIndices;
+			m_BuildCost = other.m_BuildCost;
+			m_ChangesSinceCostCheck = other.m_ChangesSinceCostCheck;
+			return *this;
+		}
+
+		SpatialIndexType GetType() const override { return SpatialIndexType::BVH; }
+
+		/// <summary>
+		/// This will insert a data source into the BVH next to the sibling that
+		/// grows the tree the least. If the data is already within the BVH, its
+		/// bounds will be updated.
+		/// </summary>
+		bool Insert(const DataType& data, const Bounds_AABB& bounds) override {
+
+			if (m_DataSourceIndices.contains(data))
+				return Update(data, bounds);
+
+			L_CORE_ASSERT(m_DataSources.size() < BVH_NULL_INDEX, "BVH - Data Source Storage Exhausted!");
+
+			uint32_t data_index = static_cast<uint32_t>(m_DataSources.size());
+			m_DataSources.emplace_back(data, bounds);
+			m_DataSourceLeaves.push_back(BVH_NULL_INDEX);
+			m_DataSourceIndices[data] = data_index;
+
+			uint32_t leaf_index = AllocateNode(FattenBounds(bounds), BVH_NULL_INDEX);
+			m_Nodes[leaf_index].DataSourceIndex = data_index;
+			m_DataSourceLeaves[data_index] = leaf_index;
+
+			InsertLeaf(leaf_index);
+			m_ChangesSinceCostCheck++;
+			return true;
+		}
+
+		bool Insert(const BVHData& data_source) {
+			return Insert(data_source.Data, data_source.Bounds);
+		}
+
+		/// <summary>
+		/// This will remove the data source and its leaf from the BVH, the
+		/// leaf's sibling takes the place of their parent.
+		/// </summary>
+		bool Remove(const DataType& data) override {
+
+			auto it = m_DataSourceIndices.find(data);
+			if (it == m_DataSourceIndices.end()) {
+				L_CORE_WARN("BVH - Data Not Found in Data Sources.");
+				return false;
+			}
+
+			uint32_t data_index = it->second;
+			m_DataSourceIndices.erase(it);
+
+			uint32_t leaf_index = m_DataSourceLeaves[data_index];
+			RemoveLeaf(leaf_index);
+			FreeNode(leaf_index);
+
+			// Swap the last data source into the freed slot to keep the storage dense
+			uint32_t last_index = static_cast<uint32_t>(m_DataSources.size() - 1);
+			if (data_index != last_index) {
+				m_DataSources[data_index] = std::move(m_DataSources[last_index]);
+				m_DataSourceLeaves[data_index] = m_DataSourceLeaves[last_index];
+				m_Nodes[m_DataSourceLeaves[data_index]].DataSourceIndex = data_index;
+				m_DataSourceIndices[m_DataSources[data_index].Data] = data_index;
+			}
+			m_DataSources.pop_back();
+			m_DataSourceLeaves.pop_back();
+
+			m_ChangesSinceCostCheck++;
+			return true;
+		}
+
+		/// <summary>
+		/// This will update a data source within the BVH. If the new bounds still fit
+		/// within its leaf only the data source is updated, otherwise the leaf is refit
+		/// to the new bounds along with every parent that no longer encloses it.
+		///
+		/// If the data source is not within the BVH, it will just insert it.
+		/// </summary>
+		bool Update(const DataType& data, const Bounds_AABB& bounds) override {
+
+			auto it = m_DataSourceIndices.find(data);
+			if (it == m_DataSourceIndices.end())
+				return Insert(data, bounds);
+
+			uint32_t data_index = it->second;
+			m_DataSources[data_index].Bounds = bounds;
+
+			uint32_t leaf_index = m_DataSourceLeaves[data_index];
+			if (m_Nodes[leaf_index].NodeBounds.Contains(bounds) == BoundsContainResult::Contains)
+				return true;
+
+			m_Nodes[leaf_index].NodeBounds = FattenBounds(bounds);
+			RefitParents(m_Nodes[leaf_index].ParentNode);
+
+			m_ChangesSinceCostCheck++;
+			return true;
+		}
+
+		bool HasDataSource(const DataType& data) const override {
+			return m_DataSourceIndices.contains(data);
+		}
+
+		size_t TotalCount() const override { return m_DataSources.size(); }
+
+		bool IsEmpty() const override { return m_DataSources.empty(); }
+
+		/// <summary>
+		/// Query the BVH for all data sources that intersect the bounds, writing
+		/// them into the caller owned result vector. The result is cleared first.
+		/// Hold a std::shared_lock on GetMutex() while querying.
+		/// </summary>
+		void Query(const Bounds_AABB& bounds, std::vector<BVHData>& result) const override {
+			QueryBVH(bounds, result);
+		}
+
+		/// <summary>
+		/// Query the BVH for all data sources that intersect the sphere, writing
+		/// them into the caller owned result vector. The result is cleared first.
+		/// Hold a std::shared_lock on GetMutex() while querying.
+		/// </summary>
+		void Query(const Bounds_Sphere& bounds, std::vector<BVHData>& result) const override {
+			QueryBVH(bounds, result);
+		}
+
+		/// <summary>
+		/// Query the BVH for all data sources that intersect the frustum, writing
+		/// them into the caller owned result vector. The result is cleared first.
+		/// Hold a std::shared_lock on GetMutex() while querying.
+		/// </summary>
+		void Query(const Frustum& frustum, std::vector<BVHData>& result) const override {
+			QueryBVH(frustum, result);
+		}
+
+		/// <summary>
+		/// Query the BVH for many views in a single traversal. Both children of a
+		/// node are classified together for every view still overlapping the node,
+		/// and views that contain a node take its whole subtree without testing.
+		///
+		/// results is resized to match volumes, results[i] is the same set of data
+		/// sources Query(volumes[i]) would return. Hold a std::shared_lock on
+		/// GetMutex() while querying.
+		/// </summary>
+		void Query(const std::vector<OctreeQueryVolume>& volumes, std::vector<std::vector<BVHData>>& results) const override {
+
+			results.resize(volumes.size());
+			for (auto& result : results)
+				result.clear();
+
+			if (m_RootNode == BVH_NULL_INDEX)
+				return;
+
+			// Views are tracked in a 64 bit mask, so larger batches are walked in chunks of 64
+			for (size_t first_view = 0; first_view < volumes.size(); first_view += 64) {
+
+				size_t view_count = glm::min<size_t>(volumes.size() - first_view, 64);
+
+				BVHBatchState state{};
+				state.ActiveViews = view_count == 64 ? ~0ull : (1ull << view_count) - 1;
+				state.PlaneMasks.fill(0x3F);
+
+				BVHBatchState root_state;
+				ClassifyBatchNodes(volumes.data() + first_view, state, &m_Nodes[m_RootNode].NodeBounds, 1, &root_state);
+
+				if (root_state.ActiveViews != 0 || root_state.ContainedViews != 0)
+					QueryBatchNode(m_RootNode, volumes.data() + first_view, results.data() + first_view, root_state);
+			}
+		}
+
+		/// <summary>
+		/// Find the nearest data source hit by the ray. Children are walked front to
+		/// back and anything further than the nearest hit so far is skipped. Hold a
+		/// std::shared_lock on GetMutex() while querying.
+		/// </summary>
+		bool Raycast(const Bounds_Ray& ray, float max_distance, BVHRayHit& hit, const BVHRayFilter& filter = {}) const override {
+
+			if (m_RootNode == BVH_NULL_INDEX)
+				return false;
+
+			float root_distance = 0.0f;
+			if (!ray.Intersects(m_Nodes[m_RootNode].NodeBounds, max_distance, root_distance))
+				return false;
+
+			BVHRayHit nearest_hit{};
+
+			RaycastNode(m_RootNode, ray, root_distance, max_distance, &nearest_hit, nullptr, filter);
+
+			if (nearest_hit.Distance == FLT_MAX)
+				return false;
+
+			hit = nearest_hit;
+			return true;
+		}
+
+		/// <summary>
+		/// Find every data source hit by the ray, sorted nearest first. The result is
+		/// cleared first. Hold a std::shared_lock on GetMutex() while querying.
+		/// </summary>
+		void RaycastAll(const Bounds_Ray& ray, float max_distance, std::vector<BVHRayHit>& hits, const BVHRayFilter& filter = {}) const override {
+
+			hits.clear();
+
+			if (m_RootNode == BVH_NULL_INDEX)
+				return;
+
+			float root_distance = 0.0f;
+			if (!ray.Intersects(m_Nodes[m_RootNode].NodeBounds, max_distance, root_distance))
+				return;
+
+			RaycastNode(m_RootNode, ray, root_distance, max_distance, nullptr, &hits, filter);
+
+			std::sort(hits.begin(), hits.end(), [](const BVHRayHit& a, const BVHRayHit& b) { return a.Distance < b.Distance; });
+		}
+
+		/// <summary>
+		/// This will rebuild the BVH with all its current data sources.
+		/// </summary>
+		void RebuildBVH() {
+			std::unique_lock lock(m_BVHMutex);
+			BuildBVH(m_DataSources);
+		}
+
+		/// <summary>
+		/// This will rebuild the BVH with all its current data sources,
+		/// but with a new configuration for the BVH.
+		/// </summary>
+		void RebuildBVH(const BVHBoundsConfig& new_config) {
+			std::unique_lock lock(m_BVHMutex);
+			m_Config = new_config;
+			BuildBVH(m_DataSources);
+		}
+
+		/// <summary>
+		/// Rebuilds the tree once refitting and incremental inserts have made it
+		/// noticeably worse than a fresh SAH build. The cost is only measured after
+		/// a decent share of the data sources have changed since it was last measured.
+		/// </summary>
+		void PerformMaintenance() override {
+
+			if (m_RootNode == BVH_NULL_INDEX || m_ChangesSinceCostCheck < glm::max<size_t>(m_DataSources.size() / 8, 64))
+				return;
+
+			m_ChangesSinceCostCheck = 0;
+
+			if (CalculateCost() > m_BuildCost * m_Config.RebuildCostRatio)
+				BuildBVH(m_DataSources);
+		}
+
+		/// <summary>
+		/// This will clear all nodes and data sources. The arenas keep their capacity.
+		/// </summary>
+		void Clear() {
+			m_RootNode = BVH_NULL_INDEX;
+			m_Nodes.clear();
+			m_FreeNodes.clear();
+			m_DataSources.clear();
+			m_DataSourceLeaves.clear();
+			m_DataSourceIndices.clear();
+			m_BuildCost = 0.0f;
+			m_ChangesSinceCostCheck = 0;
+		}
+
+		/// <summary>
+		/// Surface Area Heuristic cost of the tree, the sum of the surface area of
+		/// every internal node relative to the root. Lower is faster to query.
+		/// </summary>
+		float CalculateCost() const {
+
+			if (m_RootNode == BVH_NULL_INDEX)
+				return 0.0f;
+
+			float root_area = SurfaceArea(m_Nodes[m_RootNode].NodeBounds);
+			if (root_area <= 0.0f)
+				return 0.0f;
+
+			float cost = 0.0f;
+			std::vector<uint32_t> node_stack{ m_RootNode };
+			while (!node_stack.empty()) {
+
+				uint32_t node_index = node_stack.back();
+				node_stack.pop_back();
+
+				const auto& node = m_Nodes[node_index];
+				if (node.IsLeaf())
+					continue;
+
+				cost += SurfaceArea(node.NodeBounds);
+				node_stack.push_back(node.LeftNode);
+				node_stack.push_back(node.RightNode);
+			}
+
+			return cost / root_area;
+		}
+
+		/// <summary>
+		/// This will get the bounds of the root node, this is the
+		/// entire region the BVH currently covers.
+		/// </summary>
+		Bounds_AABB GetRootNodeBounds() const {
+			return m_RootNode != BVH_NULL_INDEX ? m_Nodes[m_RootNode].NodeBounds : Bounds_AABB{};
+		}
+
+		void SetConfig(const BVHBoundsConfig& config) { m_Config = config; }
+		const BVHBoundsConfig& GetConfig() const { return m_Config; }
+
+		/// <summary>
+		/// Reader/writer lock for the BVH. Take a std::unique_lock when
+		/// inserting, removing or updating, and a std::shared_lock to Query.
+		/// </summary>
+		std::shared_mutex& GetMutex() override { return m_BVHMutex; }
+
+		/// <summary>
+		/// This will return a copy of all data sources within the BVH.
+		/// </summary>
+		std::vector<BVHData> GetAllDataSources() const override { return m_DataSources; }
+
+		std::shared_ptr<SpatialIndex<DataType>> Clone(const std::function<DataType(const DataType&)>& remap = {}) const override {
+
+			std::shared_ptr<BVHBounds<DataType>> clone = std::make_shared<BVHBounds<DataType>>(*this);
+			if (!remap)
+				return clone;
+
+			for (BVHData& data_source : clone->m_DataSources)
+				data_source.Data = remap(data_source.Data);
+
+			clone->m_DataSourceIndices.clear();
+			clone->m_DataSourceIndices.reserve(m_DataSourceIndices.size());
+			for (const auto& [data, index] : m_DataSourceIndices)
+				clone->m_DataSourceIndices.emplace(remap(data), index);
+
+			return clone;
+		}
+
+		/// <summary>
+		/// This will return a vector of AABB bounds of every node in the BVH.
+		/// </summary>
+		std::vector<Bounds_AABB> GetAllBVHBounds() const {
+
+			std::vector<Bounds_AABB> bounds_vector;
+			if (m_RootNode == BVH_NULL_INDEX)
+				return bounds_vector;
+
+			std::vector<uint32_t> node_stack{ m_RootNode };
+			while (!node_stack.empty()) {
+
+				uint32_t node_index = node_stack.back();
+				node_stack.pop_back();
+
+				const auto& node = m_Nodes[node_index];
+				bounds_vector.push_back(node.NodeBounds);
+
+				if (!node.IsLeaf()) {
+					node_stack.push_back(node.LeftNode);
+					node_stack.push_back(node.RightNode);
+				}
+			}
+
+			return bounds_vector;
+		}
+
+		/// <summary>
+		/// This will return a vector of glm::mat4 matricies of every node bounds in the BVH.
+		/// </summary>
+		std::vector<glm::mat4> GetAllBoundsMat4() const override {
+			std::vector<Bounds_AABB> bounds_vector = GetAllBVHBounds();
+
+			std::vector<glm::mat4> transforms_vector;
+			transforms_vector.reserve(bounds_vector.size());
+			for (const auto& bounds : bounds_vector)
+				transforms_vector.push_back(bounds.GetGlobalBoundsMat4());
+			return transforms_vector;
+		}
+
+	private:
+
+#pragma region Build
+
+		/// <summary>
+		/// A range of build items waiting to become a node.
+		/// </summary>
+		struct BVHBuildTask {
+			uint32_t NodeIndex = BVH_NULL_INDEX;
+			uint32_t ItemsBegin = 0;
+			uint32_t ItemsEnd = 0;
+		};
+
+		/// <summary>
+		/// A data source being built into the tree, with its fattened bounds and centroid.
+		/// </summary>
+		struct BVHBuildItem {
+			Bounds_AABB Bounds{};
+			glm::vec3 Centroid{};
+			uint32_t DataIndex = BVH_NULL_INDEX;
+		};
+
+		/// <summary>
+		/// Centroids and bounds of the items that fall into one SAH bin.
+		/// </summary>
+		struct BVHBuildBin {
+			Bounds_AABB Bounds{};
+			uint32_t Count = 0;
+		};
+
+		/// <summary>
+		/// This will clear the BVH and build it from scratch over the data sources. Each
+		/// range of items is split where the binned Surface Area Heuristic is cheapest,
+		/// falling back to a median split when the centroids cannot be separated.
+		/// </summary>
+		void BuildBVH(std::vector<BVHData> data_sources) {
+
+			Clear();
+
+			// Dedupe so the last duplicate wins, matching repeated Inserts
+			m_DataSources.reserve(data_sources.size());
+			for (auto& data_source : data_sources) {
+
+				auto [it, inserted] = m_DataSourceIndices.try_emplace(data_source.Data, static_cast<uint32_t>(m_DataSources.size()));
+				if (inserted)
+					m_DataSources.push_back(std::move(data_source));
+				else
+					m_DataSources[it->second].Bounds = data_source.Bounds;
+			}
+
+			if (m_DataSources.empty())
+				return;
+
+			m_DataSourceLeaves.assign(m_DataSources.size(), BVH_NULL_INDEX);
+
+			std::vector<BVHBuildItem> items(m_DataSources.size());
+			for (uint32_t i = 0; i < static_cast<uint32_t>(items.size()); i++) {
+				items[i].Bounds = FattenBounds(m_DataSources[i].Bounds);
+				items[i].Centroid = items[i].Bounds.Center();
+				items[i].DataIndex = i;
+			}
+
+			// A full binary tree with one data source per leaf always has 2n - 1 nodes
+			m_Nodes.reserve(items.size() * 2 - 1);
+
+			m_RootNode = AllocateNode(Bounds_AABB{}, BVH_NULL_INDEX);
+
+			std::vector<BVHBuildTask> task_stack{ { m_RootNode, 0, static_cast<uint32_t>(items.size()) } };
+			std::vector<BVHBuildBin> bins(glm::max(m_Config.SAHBinCount, 2u));
+			std::vector<float> right_costs(bins.size());
+
+			while (!task_stack.empty()) {
+
+				BVHBuildTask task = task_stack.back();
+				task_stack.pop_back();
+
+				// 1. Bounds of the node, and of its centroids to bin against
+				Bounds_AABB node_bounds{};
+				Bounds_AABB centroid_bounds{};
+				for (uint32_t i = task.ItemsBegin; i < task.ItemsEnd; i++) {
+					node_bounds = MergeBounds(node_bounds, items[i].Bounds);
+					centroid_bounds = MergeBounds(centroid_bounds, Bounds_AABB(items[i].Centroid, items[i].Centroid));
+				}
+				m_Nodes[task.NodeIndex].NodeBounds = node_bounds;
+
+				// 2. Single data sources become leaves
+				if (task.ItemsEnd - task.ItemsBegin == 1) {
+					uint32_t data_index = items[task.ItemsBegin].DataIndex;
+					m_Nodes[task.NodeIndex].DataSourceIndex = data_index;
+					m_DataSourceLeaves[data_index] = task.NodeIndex;
+					continue;
+				}
+
+				// 3. Split where the SAH is cheapest, otherwise at the median of the longest axis
+				uint32_t split = FindSAHSplit(items, task.ItemsBegin, task.ItemsEnd, centroid_bounds, bins, right_costs);
+				if (split == task.ItemsBegin || split == task.ItemsEnd) {
+
+					glm::vec3 extent = centroid_bounds.Size();
+					int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+					split = task.ItemsBegin + (task.ItemsEnd - task.ItemsBegin) / 2;
+					std::nth_element(items.begin() + task.ItemsBegin, items.begin() + split, items.begin() + task.ItemsEnd,
+						[axis](const BVHBuildItem& a, const BVHBuildItem& b) { return a.Centroid[axis] < b.Centroid[axis]; });
+				}
+
+				uint32_t left_index = AllocateNode(Bounds_AABB{}, task.NodeIndex);
+				uint32_t right_index = AllocateNode(Bounds_AABB{}, task.NodeIndex);
+				m_Nodes[task.NodeIndex].LeftNode = left_index;
+				m_Nodes[task.NodeIndex].RightNode = right_index;
+
+				task_stack.push_back({ right_index, split, task.ItemsEnd });
+				task_stack.push_back({ left_index, task.ItemsBegin, split });
+			}
+
+			// Children are built after their parents, so the node bounds are already final
+			m_BuildCost = CalculateCost();
+			m_ChangesSinceCostCheck = 0;
+		}
+
+		/// <summary>
+		/// Bin the items by centroid along each axis and partition them at the cheapest
+		/// bin boundary, cost being the surface area of each side times its item count.
+		/// </summary>
+		/// <returns>The first item of the right side, or items_end if no split was found.</returns>
+		uint32_t FindSAHSplit(std::vector<BVHBuildItem>& items, uint32_t items_begin, uint32_t items_end, const Bounds_AABB& centroid_bounds, std::vector<BVHBuildBin>& bins, std::vector<float>& right_costs) const {
+
+			const uint32_t bin_count = static_cast<uint32_t>(bins.size());
+			const glm::vec3 extent = centroid_bounds.Size();
+
+			float best_cost = FLT_MAX;
+			int best_axis = -1;
+			uint32_t best_bin = 0;
+
+			for (int axis = 0; axis < 3; axis++) {
+
+				if (extent[axis] <= 0.0f)
+					continue;
+
+				const float bin_scale = static_cast<float>(bin_count) / extent[axis];
+
+				for (auto& bin : bins)
+					bin = BVHBuildBin{};
+
+				for (uint32_t i = items_begin; i < items_end; i++) {
+					uint32_t bin_index = glm::min(static_cast<uint32_t>((items[i].Centroid[axis] - centroid_bounds.BoundsMin[axis]) * bin_scale), bin_count - 1);
+					bins[bin_index].Bounds = MergeBounds(bins[bin_index].Bounds, items[i].Bounds);
+					bins[bin_index].Count++;
+				}
+
+				// Sweep from the right to get the cost of everything right of each boundary...
+				Bounds_AABB right_bounds{};
+				uint32_t right_count = 0;
+				for (uint32_t b = bin_count - 1; b > 0; b--) {
+					right_bounds = MergeBounds(right_bounds, bins[b].Bounds);
+					right_count += bins[b].Count;
+					right_costs[b] = right_count > 0 ? SurfaceArea(right_bounds) * static_cast<float>(right_count) : 0.0f;
+				}
+
+				// ...then from the left, adding the cost of the left side
+				Bounds_AABB left_bounds{};
+				uint32_t left_count = 0;
+				for (uint32_t b = 0; b < bin_count - 1; b++) {
+
+					left_bounds = MergeBounds(left_bounds, bins[b].Bounds);
+					left_count += bins[b].Count;
+
+					if (left_count == 0 || left_count == items_end - items_begin)
+						continue;
+
+					float cost = SurfaceArea(left_bounds) * static_cast<float>(left_count) + right_costs[b + 1];
+					if (cost < best_cost) {
+						best_cost = cost;
+						best_axis = axis;
+						best_bin = b;
+					}
+				}
+			}
+
+			if (best_axis == -1)
+				return items_end;
+
+			const float bin_scale = static_cast<float>(bin_count) / extent[best_axis];
+			auto middle = std::partition(items.begin() + items_begin, items.begin() + items_end, [&](const BVHBuildItem& item) {
+				return glm::min(static_cast<uint32_t>((item.Centroid[best_axis] - centroid_bounds.BoundsMin[best_axis]) * bin_scale), bin_count - 1) <= best_bin;
+			});
+
+			return static_cast<uint32_t>(middle - items.begin());
+		}
+
+#pragma endregion
+
+#pragma region Node Operations
+
+		/// <summary>
+		/// Insert a leaf into the tree next to the sibling that adds the least surface
+		/// area, walking down from the root while a child is cheaper than stopping here.
+		/// </summary>
+		void InsertLeaf(uint32_t leaf_index) {
+
+			if (m_RootNode == BVH_NULL_INDEX) {
+				m_RootNode = leaf_index;
+				m_Nodes[leaf_index].ParentNode = BVH_NULL_INDEX;
+				return;
+			}
+
+			const Bounds_AABB leaf_bounds = m_Nodes[leaf_index].NodeBounds;
+
+			// 1. Find the best sibling
+			uint32_t sibling_index = m_RootNode;
+			while (!m_Nodes[sibling_index].IsLeaf()) {
+
+				const auto& node = m_Nodes[sibling_index];
+
+				float area = SurfaceArea(node.NodeBounds);
+				float combined_area = SurfaceArea(MergeBounds(node.NodeBounds, leaf_bounds));
+
+				// Cost of making a new parent for this node and the leaf, and the cost
+				// pushed onto this node's parents if the leaf goes further down instead
+				float cost = 2.0f * combined_area;
+				float inheritance_cost = 2.0f * (combined_area - area);
+
+				float left_cost = ChildInsertCost(node.LeftNode, leaf_bounds) + inheritance_cost;
+				float right_cost = ChildInsertCost(node.RightNode, leaf_bounds) + inheritance_cost;
+
+				if (cost < left_cost && cost < right_cost)
+					break;
+
+				sibling_index = left_cost < right_cost ? node.LeftNode : node.RightNode;
+			}
+
+			// 2. Create a new parent for the sibling and the leaf
+			uint32_t old_parent_index = m_Nodes[sibling_index].ParentNode;
+			uint32_t new_parent_index = AllocateNode(MergeBounds(leaf_bounds, m_Nodes[sibling_index].NodeBounds), old_parent_index);
+
+			m_Nodes[new_parent_index].LeftNode = sibling_index;
+			m_Nodes[new_parent_index].RightNode = leaf_index;
+			m_Nodes[sibling_index].ParentNode = new_parent_index;
+			m_Nodes[leaf_index].ParentNode = new_parent_index;
+
+			if (old_parent_index == BVH_NULL_INDEX) {
+				m_RootNode = new_parent_index;
+			}
+			else {
+				auto& old_parent = m_Nodes[old_parent_index];
+				if (old_parent.LeftNode == sibling_index)
+					old_parent.LeftNode = new_parent_index;
+				else
+					old_parent.RightNode = new_parent_index;
+			}
+
+			// 3. Walk back up refitting the parents
+			RefitParents(old_parent_index);
+		}
+
+		/// <summary>
+		/// Cost of descending into a child to insert a leaf with the given bounds.
+		/// </summary>
+		float ChildInsertCost(uint32_t child_index, const Bounds_AABB& leaf_bounds) const {
+
+			const auto& child = m_Nodes[child_index];
+			float combined_area = SurfaceArea(MergeBounds(child.NodeBounds, leaf_bounds));
+
+			if (child.IsLeaf())
+				return combined_area;
+
+			return combined_area - SurfaceArea(child.NodeBounds);
+		}
+
+		/// <summary>
+		/// Detach a leaf from the tree, its sibling takes the place of their parent.
+		/// The leaf node itself is not freed.
+		/// </summary>
+		void RemoveLeaf(uint32_t leaf_index) {
+
+			if (leaf_index == m_RootNode) {
+				m_RootNode = BVH_NULL_INDEX;
+				return;
+			}
+
+			uint32_t parent_index = m_Nodes[leaf_index].ParentNode;
+			uint32_t grand_parent_index = m_Nodes[parent_index].ParentNode;
+			uint32_t sibling_index = m_Nodes[parent_index].LeftNode == leaf_index ? m_Nodes[parent_index].RightNode : m_Nodes[parent_index].LeftNode;
+
+			if (grand_parent_index == BVH_NULL_INDEX) {
+				m_RootNode = sibling_index;
+				m_Nodes[sibling_index].ParentNode = BVH_NULL_INDEX;
+			}
+			else {
+				auto& grand_parent = m_Nodes[grand_parent_index];
+				if (grand_parent.LeftNode == parent_index)
+					grand_parent.LeftNode = sibling_index;
+				else
+					grand_parent.RightNode = sibling_index;
+
+				m_Nodes[sibling_index].ParentNode = grand_parent_index;
+			}
+
+			m_Nodes[parent_index].LeftNode = BVH_NULL_INDEX;
+			m_Nodes[parent_index].RightNode = BVH_NULL_INDEX;
+			FreeNode(parent_index);
+
+			m_Nodes[leaf_index].ParentNode = BVH_NULL_INDEX;
+
+			RefitParents(grand_parent_index);
+		}
+
+		/// <summary>
+		/// Refit the node and its parents to the union of their children, stopping
+		/// early once a node's bounds no longer change.
+		/// </summary>
+		void RefitParents(uint32_t node_index) {
+
+			while (node_index != BVH_NULL_INDEX) {
+
+				auto& node = m_Nodes[node_index];
+				Bounds_AABB refit_bounds = MergeBounds(m_Nodes[node.LeftNode].NodeBounds, m_Nodes[node.RightNode].NodeBounds);
+
+				if (refit_bounds.BoundsMin == node.NodeBounds.BoundsMin && refit_bounds.BoundsMax == node.NodeBounds.BoundsMax)
+					break;
+
+				node.NodeBounds = refit_bounds;
+				node_index = node.ParentNode;
+			}
+		}
+
+		/// <summary>
+		/// Query the BVH from the root node into the result vector.
+		/// </summary>
+		template <typename QueryType>
+		void QueryBVH(const QueryType& query, std::vector<BVHData>& result) const {
+
+			result.clear();
+
+			if (m_RootNode == BVH_NULL_INDEX)
+				return;
+
+			BoundsContainResult root_result;
+			SpatialIndexTests::TestBounds(query, &m_Nodes[m_RootNode].NodeBounds, 1, &root_result);
+
+			QueryNode(m_RootNode, query, result, root_result);
+		}
+
+		/// <summary>
+		/// Query a node that has already been tested by its parent, node_result is
+		/// that result. Both children are tested in one batch before recursing.
+		/// </summary>
+		template <typename QueryType>
+		void QueryNode(uint32_t node_index, const QueryType& query, std::vector<BVHData>& result, BoundsContainResult node_result) const {
+
+			const auto& node = m_Nodes[node_index];
+
+			switch (node_result) {
+
+				case BoundsContainResult::Contains: {
+					GatherNodeData(node_index, result);
+					break;
+				}
+
+				case BoundsContainResult::Intersects: {
+
+					if (node.IsLeaf()) {
+
+						BoundsContainResult data_result;
+						SpatialIndexTests::TestBounds(query, &m_DataSources[node.DataSourceIndex].Bounds, 1, &data_result);
+
+						if (data_result != BoundsContainResult::DoesNotContain)
+							result.push_back(m_DataSources[node.DataSourceIndex]);
+						break;
+					}
+
+					std::array<Bounds_AABB, 2> child_bounds = { m_Nodes[node.LeftNode].NodeBounds, m_Nodes[node.RightNode].NodeBounds };
+					std::array<BoundsContainResult, 2> child_results;
+
+					SpatialIndexTests::TestBounds(query, child_bounds.data(), 2, child_results.data());
+
+					QueryNode(node.LeftNode, query, result, child_results[0]);
+					QueryNode(node.RightNode, query, result, child_results[1]);
+					break;
+				}
+
+				default: break;
+			}
+		}
+
+		/// <summary>
+		/// Per view state passed down a batched query. ActiveViews still need
+		/// testing, ContainedViews already contain the node and everything
+		/// below it, and PlaneMasks holds the frustum planes left to test.
+		/// </summary>
+		struct BVHBatchState {
+			uint64_t ActiveViews = 0;
+			uint64_t ContainedViews = 0;
+			std::array<uint8_t, 64> PlaneMasks{};
+		};
+
+		/// <summary>
+		/// Classify up to two bounds against every view still active in the parent
+		/// state, each of the bounds gets its own copy of the state with the result.
+		/// </summary>
+		void ClassifyBatchNodes(const OctreeQueryVolume* volumes, const BVHBatchState& parent_state, const Bounds_AABB* bounds, uint32_t count, BVHBatchState* states) const {
+
+			for (uint32_t i = 0; i < count; i++)
+				states[i] = parent_state;
+
+			std::array<BoundsContainResult, 2> view_results;
+			std::array<uint8_t, 2> view_plane_masks;
+
+			for (uint64_t views = parent_state.ActiveViews; views; views &= views - 1) {
+
+				int view = std::countr_zero(views);
+				uint64_t view_bit = 1ull << view;
+
+				SpatialIndexTests::TestVolume(volumes[view], bounds, count, parent_state.PlaneMasks[view], view_results.data(), view_plane_masks.data());
+
+				for (uint32_t i = 0; i < count; i++) {
+
+					switch (view_results[i]) {
+
+						case BoundsContainResult::Contains:
+							states[i].ActiveViews &= ~view_bit;
+							states[i].ContainedViews |= view_bit;
+							break;
+
+						case BoundsContainResult::DoesNotContain:
+							states[i].ActiveViews &= ~view_bit;
+							break;
+
+						default:
+							states[i].PlaneMasks[view] = view_plane_masks[i];
+							break;
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Batched version of QueryNode. The state already holds this node's
+		/// result for every view.
+		/// </summary>
+		void QueryBatchNode(uint32_t node_index, const OctreeQueryVolume* volumes, std::vector<BVHData>* results, const BVHBatchState& state) const {
+
+			const auto& node = m_Nodes[node_index];
+
+			// Views that contain the node take its whole subtree without testing
+			for (uint64_t views = state.ContainedViews; views; views &= views - 1)
+				GatherNodeData(node_index, results[std::countr_zero(views)]);
+
+			if (state.ActiveViews == 0)
+				return;
+
+			if (node.IsLeaf()) {
+
+				const BVHData& data_source = m_DataSources[node.DataSourceIndex];
+
+				for (uint64_t views = state.ActiveViews; views; views &= views - 1) {
+
+					int view = std::countr_zero(views);
+
+					BoundsContainResult data_result;
+					SpatialIndexTests::TestVolume(volumes[view], &data_source.Bounds, 1, state.PlaneMasks[view], &data_result, nullptr);
+
+					if (data_result != BoundsContainResult::DoesNotContain)
+						results[view].push_back(data_source);
+				}
+				return;
+			}
+
+			// Contained views have already gathered the subtree, only the active views go further
+			BVHBatchState active_state = state;
+			active_state.ContainedViews = 0;
+
+			std::array<Bounds_AABB, 2> child_bounds = { m_Nodes[node.LeftNode].NodeBounds, m_Nodes[node.RightNode].NodeBounds };
+			std::array<BVHBatchState, 2> child_states;
+			ClassifyBatchNodes(volumes, active_state, child_bounds.data(), 2, child_states.data());
+
+			if (child_states[0].ActiveViews != 0 || child_states[0].ContainedViews != 0)
+				QueryBatchNode(node.LeftNode, volumes, results, child_states[0]);
+
+			if (child_states[1].ActiveViews != 0 || child_states[1].ContainedViews != 0)
+				QueryBatchNode(node.RightNode, volumes, results, child_states[1]);
+		}
+
+		/// <summary>
+		/// This will append all data sources below this node to the result.
+		/// </summary>
+		void GatherNodeData(uint32_t node_index, std::vector<BVHData>& result) const {
+
+			const auto& node = m_Nodes[node_index];
+
+			if (node.IsLeaf()) {
+				result.push_back(m_DataSources[node.DataSourceIndex]);
+				return;
+			}
+
+			GatherNodeData(node.LeftNode, result);
+			GatherNodeData(node.RightNode, result);
+		}
+
+		/// <summary>
+		/// Walk the node and its children for a ray query. When nearest_hit is set
+		/// only the nearest hit is kept and max_distance shrinks to it as hits are
+		/// found, otherwise every hit is appended to all_hits.
+		/// </summary>
+		void RaycastNode(uint32_t node_index, const Bounds_Ray& ray, float node_distance, float& max_distance, BVHRayHit* nearest_hit, std::vector<BVHRayHit>* all_hits, const BVHRayFilter& filter) const {
+
+			// A nearer hit was found since this node was queued
+			if (node_distance > max_distance)
+				return;
+
+			const auto& node = m_Nodes[node_index];
+
+			if (node.IsLeaf()) {
+
+				const BVHData& data_source = m_DataSources[node.DataSourceIndex];
+
+				float distance = 0.0f;
+				if (!ray.Intersects(data_source.Bounds, max_distance, distance))
+					return;
+
+				if (filter && (!filter(data_source, distance) || distance > max_distance))
+					return;
+
+				if (nearest_hit) {
+					if (distance < nearest_hit->Distance) {
+						*nearest_hit = { data_source, distance };
+						max_distance = distance;
+					}
+				}
+				else {
+					all_hits->push_back({ data_source, distance });
+				}
+				return;
+			}
+
+			// Walk the children the ray passes through front to back
+			float left_distance = 0.0f, right_distance = 0.0f;
+			bool left_hit = ray.Intersects(m_Nodes[node.LeftNode].NodeBounds, max_distance, left_distance);
+			bool right_hit = ray.Intersects(m_Nodes[node.RightNode].NodeBounds, max_distance, right_distance);
+
+			if (left_hit && right_hit) {
+				if (right_distance < left_distance) {
+					RaycastNode(node.RightNode, ray, right_distance, max_distance, nearest_hit, all_hits, filter);
+					RaycastNode(node.LeftNode, ray, left_distance, max_distance, nearest_hit, all_hits, filter);
+				}
+				else {
+					RaycastNode(node.LeftNode, ray, left_distance, max_distance, nearest_hit, all_hits, filter);
+					RaycastNode(node.RightNode, ray, right_distance, max_distance, nearest_hit, all_hits, filter);
+				}
+			}
+			else if (left_hit) {
+				RaycastNode(node.LeftNode, ray, left_distance, max_distance, nearest_hit, all_hits, filter);
+			}
+			else if (right_hit) {
+				RaycastNode(node.RightNode, ray, right_distance, max_distance, nearest_hit, all_hits, filter);
+			}
+		}
+
+#pragma endregion
+
+#pragma region Arena Allocation
+
+		/// <summary>
+		/// This will allocate a node from the node arena, reusing a freed node if possible.
+		/// </summary>
+		uint32_t AllocateNode(const Bounds_AABB& node_bounds, uint32_t parent_index) {
+
+			uint32_t node_index;
+			if (!m_FreeNodes.empty()) {
+				node_index = m_FreeNodes.back();
+				m_FreeNodes.pop_back();
+				m_Nodes[node_index] = BVHBoundsNode{};
+			}
+			else {
+				L_CORE_ASSERT(m_Nodes.size() < BVH_NULL_INDEX, "BVH - Node Arena Exhausted!");
+				node_index = static_cast<uint32_t>(m_Nodes.size());
+				m_Nodes.emplace_back();
+			}
+
+			m_Nodes[node_index].NodeBounds = node_bounds;
+			m_Nodes[node_index].ParentNode = parent_index;
+			return node_index;
+		}
+
+		/// <summary>
+		/// This will release a single node back to the arena.
+		/// </summary>
+		void FreeNode(uint32_t node_index) {
+			m_Nodes[node_index] = BVHBoundsNode{};
+			m_FreeNodes.push_back(node_index);
+		}
+
+		Bounds_AABB FattenBounds(const Bounds_AABB& bounds) const {
+			return Bounds_AABB(bounds.BoundsMin - glm::vec3(m_Config.LeafMargin), bounds.BoundsMax + glm::vec3(m_Config.LeafMargin));
+		}
+
+		static Bounds_AABB MergeBounds(const Bounds_AABB& a, const Bounds_AABB& b) {
+			return Bounds_AABB(glm::min(a.BoundsMin, b.BoundsMin), glm::max(a.BoundsMax, b.BoundsMax));
+		}
+
+		static float SurfaceArea(const Bounds_AABB& bounds) {
+			glm::vec3 size = glm::max(bounds.BoundsMax - bounds.BoundsMin, glm::vec3(0.0f));
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+#pragma endregion
+
+		BVHBoundsConfig m_Config{};
+
+		/// <summary>
+		/// Node arena index of the root node, BVH_NULL_INDEX while the BVH is empty.
+		/// </summary>
+		uint32_t m_RootNode = BVH_NULL_INDEX;
+
+		/// <summary>
+		/// Node arena, nodes are addressed by index and recycled through m_FreeNodes.
+		/// </summary>
+		std::vector<BVHBoundsNode> m_Nodes{};
+		std::vector<uint32_t> m_FreeNodes{};
+
+		/// <summary>
+		/// Dense data source storage, m_DataSourceLeaves[i] is the leaf node of
+		/// m_DataSources[i] and m_DataSourceIndices maps data back to its index.
+		/// DataType must be hashable.
+		/// </summary>
+		std::vector<BVHData> m_DataSources{};
+		std::vector<uint32_t> m_DataSourceLeaves{};
+		std::unordered_map<DataType, uint32_t> m_DataSourceIndices{};
+
+		/// <summary>
+		/// SAH cost right after the last full build, and how many inserts, removes
+		/// and refits have happened since the cost was last checked.
+		/// </summary>
+		float m_BuildCost = 0.0f;
+		size_t m_ChangesSinceCostCheck = 0;
+
+		std::shared_mutex m_BVHMutex{};
+
+	};
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+// Louron Core Headers
+#include "Bounds.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+
+// External Vendor Library Headers
+
+// Widest instruction set the compiler was told it can use. AVX2 needs /arch:AVX2,
+// SSE2 is always available on x64. Anything else falls back to the scalar tests.
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define L_BOUNDS_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define L_BOUNDS_SIMD_WIDTH 4
+#else
+	#define L_BOUNDS_SIMD_WIDTH 1
+#endif
+
+namespace Louron::BoundsSIMD {
+
+	constexpr int Width = L_BOUNDS_SIMD_WIDTH;
+
+	/// <summary>
+	/// Run the batched sphere, frustum and transform kernels over seeded random boxes, 
+	/// comparing every result with the single AABB function it must match exactly. 
+	/// The first mismatch of each kind is logged. Debug builds run this at start up.
+	/// </summary>
+	/// <returns>True if every batched result matched the scalar one.</returns>
+	bool ValidateAgainstScalar(uint32_t seed = 1337, size_t box_count = 1024);
+
+#if L_BOUNDS_SIMD_WIDTH == 8
+
+	using Float = __m256;
+
+	inline Float Set1(float value) { return _mm256_set1_ps(value); }
+	inline Float Load(const float* values) { return _mm256_loadu_ps(values); }
+
+	inline Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+	inline Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+	inline Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+	inline Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+
+	inline Float Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	inline Float Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	inline Float GreaterEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+
+	inline Float And(Float a, Float b) { return _mm256_and_ps(a, b); }
+	inline Float Or(Float a, Float b) { return _mm256_or_ps(a, b); }
+	inline Float AndNot(Float a, Float b) { return _mm256_andnot_ps(a, b); }
+
+	inline int MoveMask(Float a) { return _mm256_movemask_ps(a); }
+
+#elif L_BOUNDS_SIMD_WIDTH == 4
+
+	using Float = __m128;
+
+	inline Float Set1(float value) { return _mm_set1_ps(value); }
+	inline Float Load(const float* values) { return _mm_loadu_ps(values); }
+
+	inline Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+	inline Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+	inline Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+	inline Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+
+	inline Float Less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+	inline Float Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+	inline Float GreaterEqual(Float a, Float b) { return _mm_cmpge_ps(a, b); }
+
+	inline Float And(Float a, Float b) { return _mm_and_ps(a, b); }
+	inline Float Or(Float a, Float b) { return _mm_or_ps(a, b); }
+	inline Float AndNot(Float a, Float b) { return _mm_andnot_ps(a, b); }
+
+	inline int MoveMask(Float a) { return _mm_movemask_ps(a); }
+
+#endif
+
+#if L_BOUNDS_SIMD_WIDTH > 1
+
+	/// <summary>
+	/// Per lane select, takes a where the mask is set and b everywhere else.
+	/// </summary>
+	inline Float Select(Float mask, Float a, Float b) { return Or(And(mask, a), AndNot(mask, b)); }
+
+	/// <summary>
+	/// Width AABBs stored structure of arrays, one lane per AABB.
+	/// </summary>
+	struct AABBLanes {
+		Float MinX, MinY, MinZ;
+		Float MaxX, MaxY, MaxZ;
+	};
+
+	/// <summary>
+	/// Transpose up to Width AABBs into lanes. Unused lanes repeat the
+	/// last AABB so they do not produce NaNs, their results are ignored.
+	/// </summary>
+	inline AABBLanes LoadAABBs(const Bounds_AABB* bounds, size_t count) {
+
+		alignas(32) float lanes[6][Width];
+
+		for (int i = 0; i < Width; i++) {
+
+			const Bounds_AABB& aabb = bounds[static_cast<size_t>(i) < count ? i : count - 1];
+
+			lanes[0][i] = aabb.BoundsMin.x;
+			lanes[1][i] = aabb.BoundsMin.y;
+			lanes[2][i] = aabb.BoundsMin.z;
+			lanes[3][i] = aabb.BoundsMax.x;
+			lanes[4][i] = aabb.BoundsMax.y;
+			lanes[5][i] = aabb.BoundsMax.z;
+		}
+
+		return { Load(lanes[0]), Load(lanes[1]), Load(lanes[2]), Load(lanes[3]), Load(lanes[4]), Load(lanes[5]) };
+	}
+
+#endif
+
+}
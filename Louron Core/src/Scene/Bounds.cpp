@@ -1,5 +1,14 @@
 #include "Bounds.h"
+#include "Bounds SIMD.h"
+#include "Frustum.h"
 
+#include "../Core/Logging.h"
+
+#include <algorithm>
+#include <random>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/norm.hpp>
 
 namespace Louron {
@@ -50,22 +59,85 @@ namespace Louron {
 			return BoundsContainResult::DoesNotContain;
 		}
 
-		// Check if the sphere contains the entire AABB
-		bool contains = true;
+		// Check if the sphere contains the entire AABB, which is when the corner furthest from the centre is within the sphere
+		float farthestDistanceSquared = 0.0f;
 		for (int i = 0; i < 3; ++i) {
-			if (aabb.BoundsMin[i] < BoundsCentre[i] - temp_radius || aabb.BoundsMax[i] > BoundsCentre[i] + temp_radius) {
-				contains = false;
-				break;
-			}
+			float farthest = glm::max(BoundsCentre[i] - aabb.BoundsMin[i], aabb.BoundsMax[i] - BoundsCentre[i]);
+			farthestDistanceSquared += farthest * farthest;
 		}
 
-		if (contains) {
+		if (farthestDistanceSquared <= temp_radius * temp_radius) {
 			return BoundsContainResult::Contains;
 		}
 
 		return BoundsContainResult::Intersects;
 	}
 
+	void Bounds_Sphere::Contains(const Bounds_AABB* aabbs, size_t count, BoundsContainResult* results, float looseness) const {
+
+#if L_BOUNDS_SIMD_WIDTH > 1
+
+		using namespace BoundsSIMD;
+
+		const float temp_radius = BoundsRadius * looseness;
+
+		const Float zero = Set1(0.0f);
+		const Float radius_squared = Set1(temp_radius * temp_radius);
+
+		const Float centre_x = Set1(BoundsCentre.x);
+		const Float centre_y = Set1(BoundsCentre.y);
+		const Float centre_z = Set1(BoundsCentre.z);
+
+		// Squared distance from the centre to the AABB along one axis, zero if the centre is within the slab
+		auto axis_distance_squared = [&zero](Float centre, Float aabb_min, Float aabb_max) {
+			const Float below = Sub(aabb_min, centre);
+			const Float above = Sub(centre, aabb_max);
+			return Select(Less(centre, aabb_min), Mul(below, below), Select(Greater(centre, aabb_max), Mul(above, above), zero));
+		};
+
+		for (size_t first = 0; first < count; first += Width) {
+
+			const size_t lane_count = std::min<size_t>(count - first, Width);
+			const AABBLanes box = LoadAABBs(aabbs + first, lane_count);
+
+			const Float distance_squared = Add(Add(
+				axis_distance_squared(centre_x, box.MinX, box.MaxX),
+				axis_distance_squared(centre_y, box.MinY, box.MaxY)),
+				axis_distance_squared(centre_z, box.MinZ, box.MaxZ));
+
+			const int outside_lanes = MoveMask(Greater(distance_squared, radius_squared));
+
+			// Squared distance from the centre to the furthest corner, the sphere contains the AABB if that corner is inside
+			const Float farthest_x = Max(Sub(centre_x, box.MinX), Sub(box.MaxX, centre_x));
+			const Float farthest_y = Max(Sub(centre_y, box.MinY), Sub(box.MaxY, centre_y));
+			const Float farthest_z = Max(Sub(centre_z, box.MinZ), Sub(box.MaxZ, centre_z));
+
+			const Float not_contained = Greater(
+				Add(Add(Mul(farthest_x, farthest_x), Mul(farthest_y, farthest_y)), Mul(farthest_z, farthest_z)),
+				radius_squared);
+
+			const int not_contained_lanes = MoveMask(not_contained);
+
+			for (size_t lane = 0; lane < lane_count; lane++) {
+
+				if (outside_lanes & (1 << lane))
+					results[first + lane] = BoundsContainResult::DoesNotContain;
+				else if (not_contained_lanes & (1 << lane))
+					results[first + lane] = BoundsContainResult::Intersects;
+				else
+					results[first + lane] = BoundsContainResult::Contains;
+			}
+		}
+
+#else
+
+		for (size_t i = 0; i < count; i++)
+			results[i] = Contains(aabbs[i], looseness);
+
+#endif
+
+	}
+
 #pragma endregion
 
 #pragma region AABB
@@ -181,6 +253,271 @@ namespace Louron {
 		return closest_point;
 	}
 
+	Bounds_AABB Bounds_AABB::Transform(const glm::mat4& transform) const {
+
+		glm::vec3 centre = (BoundsMin + BoundsMax) * 0.5f;
+		glm::vec3 extent = (BoundsMax - BoundsMin) * 0.5f;
+
+		// Operation order matches the SIMD path in the batched Transform
+		glm::vec3 new_centre = ((glm::vec3(transform[0]) * centre.x + glm::vec3(transform[1]) * centre.y) + glm::vec3(transform[2]) * centre.z) + glm::vec3(transform[3]);
+		glm::vec3 new_extent = (glm::abs(glm::vec3(transform[0])) * extent.x + glm::abs(glm::vec3(transform[1])) * extent.y) + glm::abs(glm::vec3(transform[2])) * extent.z;
+
+		return Bounds_AABB(new_centre - new_extent, new_centre + new_extent);
+	}
+
+	void Bounds_AABB::Transform(const Bounds_AABB* bounds, const glm::mat4* transforms, Bounds_AABB* results, size_t count) {
+
+#if L_BOUNDS_SIMD_WIDTH > 1
+
+		// One AABB per iteration, the four matrix columns are already laid out as SIMD registers
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+		for (size_t i = 0; i < count; i++) {
+
+			const Bounds_AABB& aabb = bounds[i];
+			const float* matrix = &transforms[i][0][0];
+
+			const __m128 column_0 = _mm_loadu_ps(matrix);
+			const __m128 column_1 = _mm_loadu_ps(matrix + 4);
+			const __m128 column_2 = _mm_loadu_ps(matrix + 8);
+			const __m128 column_3 = _mm_loadu_ps(matrix + 12);
+
+			const __m128 aabb_min = _mm_setr_ps(aabb.BoundsMin.x, aabb.BoundsMin.y, aabb.BoundsMin.z, 0.0f);
+			const __m128 aabb_max = _mm_setr_ps(aabb.BoundsMax.x, aabb.BoundsMax.y, aabb.BoundsMax.z, 0.0f);
+
+			alignas(16) float centre[4];
+			alignas(16) float extent[4];
+			_mm_store_ps(centre, _mm_mul_ps(_mm_add_ps(aabb_min, aabb_max), half));
+			_mm_store_ps(extent, _mm_mul_ps(_mm_sub_ps(aabb_max, aabb_min), half));
+
+			const __m128 new_centre = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(column_0, _mm_set1_ps(centre[0])),
+				_mm_mul_ps(column_1, _mm_set1_ps(centre[1]))),
+				_mm_mul_ps(column_2, _mm_set1_ps(centre[2]))),
+				column_3);
+
+			const __m128 new_extent = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_andnot_ps(sign_mask, column_0), _mm_set1_ps(extent[0])),
+				_mm_mul_ps(_mm_andnot_ps(sign_mask, column_1), _mm_set1_ps(extent[1]))),
+				_mm_mul_ps(_mm_andnot_ps(sign_mask, column_2), _mm_set1_ps(extent[2])));
+
+			alignas(16) float new_min[4];
+			alignas(16) float new_max[4];
+			_mm_store_ps(new_min, _mm_sub_ps(new_centre, new_extent));
+			_mm_store_ps(new_max, _mm_add_ps(new_centre, new_extent));
+
+			results[i].BoundsMin = glm::vec3(new_min[0], new_min[1], new_min[2]);
+			results[i].BoundsMax = glm::vec3(new_max[0], new_max[1], new_max[2]);
+		}
+
+#else
+
+		for (size_t i = 0; i < count; i++)
+			results[i] = bounds[i].Transform(transforms[i]);
+
+#endif
+
+	}
+
+#pragma endregion
+
+#pragma region Ray
+
+	Bounds_Ray::Bounds_Ray(const glm::vec3& origin, const glm::vec3& direction) : RayOrigin(origin) {
+
+		float length = glm::length(direction);
+		RayDirection = length > 0.0f ? direction / length : glm::vec3(0.0f, 0.0f, -1.0f);
+
+		// Zero components become infinity, which the slab test handles
+		RayInverseDirection = 1.0f / RayDirection;
+	}
+
+	bool Bounds_Ray::Intersects(const Bounds_AABB& aabb, float max_distance, float& distance) const {
+
+		float t_enter = 0.0f;
+		float t_exit = max_distance;
+
+		for (int axis = 0; axis < 3; axis++) {
+
+			// Parallel to this slab, the origin must already be between the planes
+			if (RayDirection[axis] == 0.0f) {
+				if (RayOrigin[axis] < aabb.BoundsMin[axis] || RayOrigin[axis] > aabb.BoundsMax[axis])
+					return false;
+				continue;
+			}
+
+			float t_near = (aabb.BoundsMin[axis] - RayOrigin[axis]) * RayInverseDirection[axis];
+			float t_far = (aabb.BoundsMax[axis] - RayOrigin[axis]) * RayInverseDirection[axis];
+
+			if (t_near > t_far)
+				std::swap(t_near, t_far);
+
+			t_enter = std::max(t_enter, t_near);
+			t_exit = std::min(t_exit, t_far);
+
+			if (t_enter > t_exit)
+				return false;
+		}
+
+		distance = t_enter;
+		return true;
+	}
+
+	bool Bounds_Ray::Intersects(const glm::vec3& vertex_0, const glm::vec3& vertex_1, const glm::vec3& vertex_2, float max_distance, float& distance) const {
+
+		constexpr float epsilon = 1e-8f;
+
+		glm::vec3 edge_1 = vertex_1 - vertex_0;
+		glm::vec3 edge_2 = vertex_2 - vertex_0;
+
+		glm::vec3 p = glm::cross(RayDirection, edge_2);
+		float determinant = glm::dot(edge_1, p);
+
+		// Ray is parallel to the triangle
+		if (std::abs(determinant) < epsilon)
+			return false;
+
+		float inverse_determinant = 1.0f / determinant;
+
+		glm::vec3 origin_offset = RayOrigin - vertex_0;
+		float u = glm::dot(origin_offset, p) * inverse_determinant;
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		glm::vec3 q = glm::cross(origin_offset, edge_1);
+		float v = glm::dot(RayDirection, q) * inverse_determinant;
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		float t = glm::dot(edge_2, q) * inverse_determinant;
+		if (t < 0.0f || t > max_distance)
+			return false;
+
+		distance = t;
+		return true;
+	}
+
+#pragma endregion
+
+#pragma region SIMD Validation
+
+	bool BoundsSIMD::ValidateAgainstScalar(uint32_t seed, size_t box_count) {
+
+		std::mt19937 random_engine(seed);
+		std::uniform_real_distribution<float> position_distribution(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> size_distribution(0.0f, 20.0f);
+		std::uniform_real_distribution<float> unit_distribution(-1.0f, 1.0f);
+		std::uniform_int_distribution<int> mask_distribution(0, 0x3F);
+
+		auto random_direction = [&]() {
+			glm::vec3 direction(unit_distribution(random_engine), unit_distribution(random_engine), unit_distribution(random_engine));
+			return glm::length(direction) > 0.001f ? glm::normalize(direction) : glm::vec3(0.0f, 0.0f, 1.0f);
+		};
+
+		// Every eighth box is a point, so boxes sitting exactly on a plane are covered too
+		std::vector<Bounds_AABB> boxes(box_count);
+		for (size_t i = 0; i < box_count; i++) {
+
+			glm::vec3 box_min(position_distribution(random_engine), position_distribution(random_engine), position_distribution(random_engine));
+			glm::vec3 box_size = (i % 8 == 0) ? glm::vec3(0.0f) : glm::vec3(size_distribution(random_engine), size_distribution(random_engine), size_distribution(random_engine));
+			boxes[i] = { box_min, box_min + box_size };
+		}
+
+		bool matched = true;
+
+		// 1. Spheres, with and without looseness
+		{
+			std::vector<BoundsContainResult> results(box_count);
+			bool logged = false;
+
+			for (int query = 0; query < 32; query++) {
+
+				Bounds_Sphere sphere(glm::vec3(position_distribution(random_engine), position_distribution(random_engine), position_distribution(random_engine)), size_distribution(random_engine) * 5.0f);
+				float looseness = (query % 2 == 0) ? 1.0f : 1.5f;
+
+				sphere.Contains(boxes.data(), box_count, results.data(), looseness);
+
+				for (size_t i = 0; i < box_count; i++) {
+
+					if (results[i] == sphere.Contains(boxes[i], looseness))
+						continue;
+
+					matched = false;
+					if (!logged) {
+						L_CORE_ERROR("Bounds SIMD - Sphere Result Mismatch on Box {0} of Query {1}.", i, query);
+						logged = true;
+					}
+				}
+			}
+		}
+
+		// 2. Frustums, with every plane and with random plane masks
+		{
+			std::vector<FrustumContainResult> results(box_count);
+			std::vector<uint8_t> result_plane_masks(box_count);
+			bool logged = false;
+
+			for (int query = 0; query < 32; query++) {
+
+				glm::vec3 eye(position_distribution(random_engine), position_distribution(random_engine), position_distribution(random_engine));
+				glm::vec3 forward = random_direction();
+				glm::vec3 up = glm::abs(forward.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+				Frustum frustum(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f) * glm::lookAt(eye, eye + forward, up));
+
+				uint8_t plane_mask = (query % 2 == 0) ? 0x3F : static_cast<uint8_t>(mask_distribution(random_engine));
+
+				frustum.Contains(boxes.data(), box_count, results.data(), plane_mask, result_plane_masks.data());
+
+				for (size_t i = 0; i < box_count; i++) {
+
+					uint8_t scalar_plane_mask = plane_mask;
+					FrustumContainResult scalar_result = frustum.Contains(boxes[i], scalar_plane_mask);
+
+					// The remaining mask is only meaningful when the box is not culled
+					if (results[i] == scalar_result && (scalar_result == FrustumContainResult::DoesNotContain || result_plane_masks[i] == scalar_plane_mask))
+						continue;
+
+					matched = false;
+					if (!logged) {
+						L_CORE_ERROR("Bounds SIMD - Frustum Result Mismatch on Box {0} of Query {1}.", i, query);
+						logged = true;
+					}
+				}
+			}
+		}
+
+		// 3. Transforms, random rotation, scale and translation per box
+		{
+			std::vector<glm::mat4> transforms(box_count);
+			for (size_t i = 0; i < box_count; i++) {
+
+				glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(position_distribution(random_engine), position_distribution(random_engine), position_distribution(random_engine)));
+				transform = glm::rotate(transform, unit_distribution(random_engine) * glm::pi<float>(), random_direction());
+				transforms[i] = glm::scale(transform, glm::vec3(size_distribution(random_engine) + 0.1f, size_distribution(random_engine) + 0.1f, size_distribution(random_engine) + 0.1f));
+			}
+
+			std::vector<Bounds_AABB> results(box_count);
+			Bounds_AABB::Transform(boxes.data(), transforms.data(), results.data(), box_count);
+
+			for (size_t i = 0; i < box_count; i++) {
+
+				Bounds_AABB scalar_result = boxes[i].Transform(transforms[i]);
+				if (results[i].BoundsMin == scalar_result.BoundsMin && results[i].BoundsMax == scalar_result.BoundsMax)
+					continue;
+
+				L_CORE_ERROR("Bounds SIMD - Transform Result Mismatch on Box {0}.", i);
+				matched = false;
+				break;
+			}
+		}
+
+		if (matched)
+			L_CORE_INFO("Bounds SIMD - {0} Wide Kernels Match the Scalar Tests.", Width);
+
+		return matched;
+	}
+
 #pragma endregion
 
-}
\ No newline at end of file
+}
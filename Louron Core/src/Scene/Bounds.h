@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -40,6 +42,12 @@ namespace Louron {
 		/// <param name="looseness">This is a multiplier. 1.0f = Normal Radius, 2.0f = Test Against Current Radius Expanded by 2.0f.</param>
 		/// <returns>An enum holding the result of the function.</returns>
 		BoundsContainResult Contains(const Bounds_AABB& aabb, float looseness = 1.0f) const;
+
+		/// <summary>
+		/// Classify count AABBs against this sphere at once, 4 or 8 at a time depending 
+		/// on the instruction set. results[i] matches Contains(aabbs[i], looseness) exactly.
+		/// </summary>
+		void Contains(const Bounds_AABB* aabbs, size_t count, BoundsContainResult* results, float looseness = 1.0f) const;
 	};
 
 	struct Bounds_AABB {
@@ -129,6 +137,61 @@ namespace Louron {
 		BoundsContainResult Contains(const glm::vec3& point, float looseness = 1.0f) const;
 
 		glm::vec3 ClosestPoint(const glm::vec3& point_location) const;
+
+		/// <summary>
+		/// Transform this AABB by an affine matrix and return the AABB enclosing the 
+		/// result. Uses Arvo's method, the centre is transformed and the extents are 
+		/// projected through the absolute of the matrix, instead of transforming 8 corners.
+		/// </summary>
+		Bounds_AABB Transform(const glm::mat4& transform) const;
+
+		/// <summary>
+		/// Batched Transform, results[i] = bounds[i].Transform(transforms[i]). Uses 
+		/// SIMD where available and matches the single AABB Transform exactly.
+		/// </summary>
+		static void Transform(const Bounds_AABB* bounds, const glm::mat4* transforms, Bounds_AABB* results, size_t count);
+	};
+
+	/// <summary>
+	/// A ray from an origin along a normalised direction. Segments are a 
+	/// ray with a max distance equal to the length of the segment.
+	/// </summary>
+	struct Bounds_Ray {
+
+		glm::vec3 RayOrigin = glm::vec3(0.0f);
+		glm::vec3 RayDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+
+		/// <summary>
+		/// 1.0f / RayDirection, cached for the slab test. This is set by the 
+		/// constructors, so construct a new ray rather than editing RayDirection.
+		/// </summary>
+		glm::vec3 RayInverseDirection = glm::vec3(INFINITY, INFINITY, -1.0f);
+
+		Bounds_Ray() = default;
+		Bounds_Ray(const glm::vec3& origin, const glm::vec3& direction);
+		Bounds_Ray(const Bounds_Ray&) = default;
+		Bounds_Ray(Bounds_Ray&&) = default;
+		Bounds_Ray& operator=(const Bounds_Ray&) = default;
+		~Bounds_Ray() = default;
+
+		glm::vec3 GetPoint(float distance) const { return RayOrigin + RayDirection * distance; }
+
+		/// <summary>
+		/// Slab test against an AABB.
+		/// </summary>
+		/// <param name="aabb">The Bounds_AABB to test against.</param>
+		/// <param name="max_distance">Hits further along the ray than this are ignored.</param>
+		/// <param name="distance">Distance along the ray the AABB is entered, 0.0f if the origin is inside.</param>
+		/// <returns>True if the ray hits the AABB within max_distance.</returns>
+		bool Intersects(const Bounds_AABB& aabb, float max_distance, float& distance) const;
+
+		/// <summary>
+		/// Moller-Trumbore test against a triangle, both faces are hit.
+		/// </summary>
+		/// <param name="max_distance">Hits further along the ray than this are ignored.</param>
+		/// <param name="distance">Distance along the ray the triangle is hit.</param>
+		/// <returns>True if the ray hits the triangle within max_distance.</returns>
+		bool Intersects(const glm::vec3& vertex_0, const glm::vec3& vertex_1, const glm::vec3& vertex_2, float max_distance, float& distance) const;
 	};
 
 }
\ No newline at end of file
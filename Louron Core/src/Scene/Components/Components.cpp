@@ -410,7 +410,7 @@ namespace Louron {
         );
     }
 
-    void TransformComponent::OnTransformUpdated() {
+    void TransformComponent::OnTransformUpdated(bool propagate_to_children) {
 
         AddFlag(TransformFlag_GlobalTransformUpdated);
 
@@ -418,15 +418,17 @@ namespace Louron {
 
         if (entity.HasComponent<MeshFilterComponent>()) {
 
-            auto& component = entity.GetComponent<MeshFilterComponent>();
-            component.AABBNeedsUpdate = true;
-            component.OctreeNeedsUpdate = true;
+            entity.GetComponent<MeshFilterComponent>().MarkDirty();
         }
 
-        if (entity && entity.GetScene()) {
+        // The TransformSystem visits children after their parents, so it 
+        // flags them itself rather than looking each child up by UUID here
+        if (propagate_to_children && entity && entity.GetScene()) {
 
-            for (const auto& child_uuid : entity.GetComponent<HierarchyComponent>().GetChildren()) {
-                Entity child_entity = entity.GetScene()->FindEntityByUUID(child_uuid);
+            const auto& hierarchy = entity.GetComponent<HierarchyComponent>();
+
+            for (size_t i = 0; i < hierarchy.GetChildren().size(); i++) {
+                Entity child_entity = hierarchy.GetChildEntity(i);
 
                 child_entity.GetComponent<TransformComponent>().OnTransformUpdated();
             }
@@ -434,28 +436,33 @@ namespace Louron {
 
     }
 
-    void TransformComponent::UpdateLocalTransformMatrix() {
-
-        Entity entity = GetEntity();
+    void TransformComponent::UpdateLocalTransformMatrix(bool propagate_to_children) {
 
         // Check if any changes made to local transform, if YES WE UPDATE
         if (CheckFlag(TransformFlag_PropertiesUpdated)) {
 
+            Entity entity = GetEntity();
+
             // Compute the local transform matrix if it has changed
-            m_LocalTransform =  glm::translate(glm::mat4(1.0f), m_Position) *
-                                glm::mat4_cast(glm::quat(glm::radians(m_Rotation))) *
-                                glm::scale(glm::mat4(1.0f), m_Scale);
+            ComputeLocalTransformMatrix();
 
-            OnTransformUpdated();
+            OnTransformUpdated(propagate_to_children);
 
             if (entity && entity.GetScene() && entity.HasComponent<RigidbodyComponent>() && entity.GetComponent<RigidbodyComponent>().GetActor())
                 entity.GetComponent<RigidbodyComponent>().GetActor()->AddFlag(RigidbodyFlag_TransformUpdated);
-
-            RemoveFlag(TransformFlag_PropertiesUpdated);
         }
 
     }
 
+    void TransformComponent::ComputeLocalTransformMatrix() {
+
+        m_LocalTransform =  glm::translate(glm::mat4(1.0f), m_Position) *
+                            glm::mat4_cast(glm::quat(glm::radians(m_Rotation))) *
+                            glm::scale(glm::mat4(1.0f), m_Scale);
+
+        RemoveFlag(TransformFlag_PropertiesUpdated);
+    }
+
     glm::vec3 TransformComponent::GetGlobalPosition() {
         if (CheckFlag(TransformFlag_GlobalTransformUpdated)) 
             return GetGlobalTransform()[3];
@@ -576,49 +583,68 @@ namespace Louron {
 
         if (CheckFlag(TransformFlag_GlobalTransformUpdated)) {
 
-            glm::vec3 old_global_scale = glm::vec3(
-                glm::length(m_GlobalTransform[0]),
-                glm::length(m_GlobalTransform[1]),
-                glm::length(m_GlobalTransform[2])
-            ); // Can't call GetGlobalScale here as it would send it into a never ending recursion as GetGlobalScale will call GetGlobalTransform if the flag is not cleared
-
             Entity entity = GetEntity();
 
             if (entity && entity.GetScene() && entity.GetComponent<HierarchyComponent>().HasParent())
-                m_GlobalTransform = entity.GetComponent<HierarchyComponent>().GetParentEntity().GetComponent<TransformComponent>().GetGlobalTransform() * GetLocalTransform();
+                RecalculateGlobalTransform(entity, &entity.GetComponent<HierarchyComponent>().GetParentEntity().GetComponent<TransformComponent>().GetGlobalTransform());
             else
-                m_GlobalTransform = m_LocalTransform;
+                RecalculateGlobalTransform(entity, nullptr);
+        }
+        return m_GlobalTransform;
+    }
 
-            RemoveFlag(TransformFlag_GlobalTransformUpdated);
+    void TransformComponent::RecalculateGlobalTransform(Entity entity, const glm::mat4* parent_global_transform) {
 
-            if (entity) {
+        UpdateLocalTransformMatrix();
+        OnGlobalTransformRecalculated(entity, ComputeGlobalTransform(parent_global_transform));
+    }
 
-                if (entity.HasComponent<SphereColliderComponent>()) {
+    bool TransformComponent::ComputeGlobalTransform(const glm::mat4* parent_global_transform) {
 
-                    auto& component = entity.GetComponent<SphereColliderComponent>();
+        glm::vec3 old_global_scale = glm::vec3(
+            glm::length(m_GlobalTransform[0]),
+            glm::length(m_GlobalTransform[1]),
+            glm::length(m_GlobalTransform[2])
+        ); // Can't call GetGlobalScale here as it would send it into a never ending recursion as GetGlobalScale will call GetGlobalTransform if the flag is not cleared
 
-                    if (component.GetShape() && component.GetShape()->IsStatic())
-                        component.AddFlag(ColliderFlag_TransformUpdated);
+        if (parent_global_transform)
+            m_GlobalTransform = *parent_global_transform * m_LocalTransform;
+        else
+            m_GlobalTransform = m_LocalTransform;
 
-                    if (old_global_scale != GetGlobalScale())
-                        component.AddFlag(ColliderFlag_ShapePropsUpdated); // TODO: Fix this because it goes on the fritz when child is attached to parent, and the parent scale changes
+        RemoveFlag(TransformFlag_GlobalTransformUpdated);
 
-                }
-                
-                if (entity.HasComponent<BoxColliderComponent>()) {
+        return old_global_scale != GetGlobalScale();
+    }
 
-                    auto& component = entity.GetComponent<BoxColliderComponent>();
+    void TransformComponent::OnGlobalTransformRecalculated(Entity entity, bool global_scale_changed) {
 
-                    if(component.GetShape() && component.GetShape()->IsStatic())
-                        component.AddFlag(ColliderFlag_TransformUpdated);
+        if (!entity)
+            return;
 
-                    if (old_global_scale != GetGlobalScale())
-                        component.AddFlag(ColliderFlag_ShapePropsUpdated);
+        if (entity.HasComponent<SphereColliderComponent>()) {
+
+            auto& component = entity.GetComponent<SphereColliderComponent>();
+
+            if (component.GetShape() && component.GetShape()->IsStatic())
+                component.AddFlag(ColliderFlag_TransformUpdated);
+
+            if (global_scale_changed)
+                component.AddFlag(ColliderFlag_ShapePropsUpdated); // TODO: Fix this because it goes on the fritz when child is attached to parent, and the parent scale changes
+
+        }
+        
+        if (entity.HasComponent<BoxColliderComponent>()) {
+
+            auto& component = entity.GetComponent<BoxColliderComponent>();
+
+            if(component.GetShape() && component.GetShape()->IsStatic())
+                component.AddFlag(ColliderFlag_TransformUpdated);
+
+            if (global_scale_changed)
+                component.AddFlag(ColliderFlag_ShapePropsUpdated);
 
-                }
-            }
         }
-        return m_GlobalTransform;
     }
 
     const glm::mat4& TransformComponent::GetLocalTransform() {
@@ -757,12 +783,13 @@ namespace Louron {
             return {};
         }
 
-        if (!scene->HasEntity(entity_uuid)) {
+        Entity entity = scene->ResolveEntity(entity_handle, entity_uuid);
+        if (!entity) {
             L_CORE_ERROR("Cannot Get Entity - Current Entity Is Invalid!");
             return {};
         }
 
-        return scene->FindEntityByUUID(entity_uuid);
+        return entity;
     }
 
     template<typename T>
@@ -1105,7 +1132,10 @@ namespace Louron {
 
         // Finalise relationship 8==D~({})
         m_Parent = newParentID;
-        new_parent_entity.GetComponent<HierarchyComponent>().m_Children.push_back(entity.GetUUID());
+        m_ParentHandle = new_parent_entity;
+        new_parent_entity.GetComponent<HierarchyComponent>().AddChildLink(entity.GetUUID(), entity);
+
+        entity.GetScene()->MarkTransformHierarchyDirty();
     }
 
     void HierarchyComponent::DetachParent() {
@@ -1157,19 +1187,16 @@ namespace Louron {
         }
 
         if (m_Parent != NULL_UUID) {
-            Entity parentEntity = entity.GetScene()->FindEntityByUUID(m_Parent);
+            Entity parentEntity = entity.GetScene()->ResolveEntity(m_ParentHandle, m_Parent);
             if (parentEntity) {
-                auto& parentChildren = parentEntity.GetComponent<HierarchyComponent>().m_Children;
-
-                // Erase-remove idiom to remove the child from the parent's children list
-                parentChildren.erase(
-                    std::remove(parentChildren.begin(), parentChildren.end(), entity.GetUUID()),
-                    parentChildren.end()
-                );
+                parentEntity.GetComponent<HierarchyComponent>().RemoveChildLink(entity.GetUUID());
             }
 
             // Clear the parent ID
             m_Parent = NULL_UUID;
+            m_ParentHandle = entt::null;
+
+            entity.GetScene()->MarkTransformHierarchyDirty();
         }
     }
 
@@ -1182,13 +1209,17 @@ namespace Louron {
             return;
         }
 
-        for (const auto& child : m_Children) {
-            entity.GetScene()->FindEntityByUUID(child).GetComponent<HierarchyComponent>().DetachParent();
+        const size_t child_count = m_Children.size();
+
+        // Back to front, as detaching a child removes it from m_Children
+        for (size_t i = child_count; i-- > 0;) {
+            if (Entity child_entity = GetChildEntity(i); child_entity)
+                child_entity.GetComponent<HierarchyComponent>().DetachParent();
         }
 
-        L_CORE_INFO("Detached {0} Children From Entity({1}).", m_Children.size(), entity.GetName());
+        L_CORE_INFO("Detached {0} Children From Entity({1}).", child_count, entity.GetName());
 
-        m_Children.clear();
+        ClearChildLinks();
     }
 
     void HierarchyComponent::RehomeChildren(const UUID& newParentID) {
@@ -1206,15 +1237,19 @@ namespace Louron {
             return;
         }
 
-        for (const auto& child : m_Children) {
+        const size_t child_count = m_Children.size();
 
-            entity.GetScene()->FindEntityByUUID(child).GetComponent<HierarchyComponent>().AttachParent(newParentID);
+        // Back to front, as attaching a child to a new parent removes it from m_Children
+        for (size_t i = child_count; i-- > 0;) {
+
+            if (Entity child_entity = GetChildEntity(i); child_entity)
+                child_entity.GetComponent<HierarchyComponent>().AttachParent(newParentID);
 
         }
         
-        L_CORE_INFO("Rehomed {0} Children From Entity({1}) to Entity({2}).", m_Children.size(), entity.GetName(), new_parent.GetName());
+        L_CORE_INFO("Rehomed {0} Children From Entity({1}) to Entity({2}).", child_count, entity.GetName(), new_parent.GetName());
 
-        m_Children.clear();
+        ClearChildLinks();
 
     }
 
@@ -1292,7 +1327,60 @@ namespace Louron {
             return {};
         }
 
-        return scene->FindEntityByUUID(m_Parent);
+        return scene->ResolveEntity(m_ParentHandle, m_Parent);
+    }
+
+    Entity HierarchyComponent::GetChildEntity(size_t child_index) const {
+
+        if (!scene || child_index >= m_Children.size())
+            return {};
+
+        entt::entity child_handle = entt::null;
+        if (child_index < m_ChildHandles.size())
+            child_handle = m_ChildHandles[child_index];
+
+        return scene->ResolveEntity(child_handle, m_Children[child_index]);
+    }
+
+    void HierarchyComponent::ResolveHandles() {
+
+        if (!scene)
+            return;
+
+        if (HasParent())
+            m_ParentHandle = scene->ResolveEntity(m_ParentHandle, m_Parent);
+        else
+            m_ParentHandle = entt::null;
+
+        m_ChildHandles.resize(m_Children.size(), entt::null);
+        for (size_t i = 0; i < m_Children.size(); i++)
+            m_ChildHandles[i] = scene->ResolveEntity(m_ChildHandles[i], m_Children[i]);
+    }
+
+    void HierarchyComponent::AddChildLink(const UUID& child_uuid, entt::entity child_handle) {
+
+        // Keep the handles index matched with the children before appending
+        m_ChildHandles.resize(m_Children.size(), entt::null);
+
+        m_Children.push_back(child_uuid);
+        m_ChildHandles.push_back(child_handle);
+    }
+
+    void HierarchyComponent::RemoveChildLink(const UUID& child_uuid) {
+
+        m_ChildHandles.resize(m_Children.size(), entt::null);
+
+        for (size_t i = m_Children.size(); i-- > 0;) {
+            if (m_Children[i] == child_uuid) {
+                m_Children.erase(m_Children.begin() + i);
+                m_ChildHandles.erase(m_ChildHandles.begin() + i);
+            }
+        }
+    }
+
+    void HierarchyComponent::ClearChildLinks() {
+        m_Children.clear();
+        m_ChildHandles.clear();
     }
 
     const UUID& HierarchyComponent::GetParentID() const {
@@ -1331,6 +1419,7 @@ namespace Louron {
         // Deserialize the Parent value
         if (component["Parent"]) {
             m_Parent = component["Parent"].as<uint32_t>();  
+            m_ParentHandle = entt::null;
         }
 
         // Deserialize the Children sequence
@@ -1338,11 +1427,14 @@ namespace Louron {
 
             if (component["Children"].IsSequence()) {
                 
-                m_Children.clear();
+                ClearChildLinks();
                 for (size_t i = 0; i < component["Children"].size(); ++i) {
                     m_Children.push_back(component["Children"][i].as<uint32_t>());
                 }
 
+                // Handles are resolved once every entity has been loaded
+                m_ChildHandles.assign(m_Children.size(), entt::null);
+
             }
 
         }
@@ -1364,51 +1456,28 @@ namespace Louron {
     bool TagComponent::Deserialize(const YAML::Node data)
     {
         if (data["Tag"])
-            Tag = data["Tag"].as<std::string>();
+            SetTag(data["Tag"].as<std::string>());
 
         return true;
     }
 
-    void TagComponent::SetUniqueName(const std::string& name)
+    void TagComponent::SetTag(const std::string& name)
     {
-        std::string uniqueName = name.empty() ? "Untitled Entity" : name;
-        int suffix = 1;
-        std::string baseName = uniqueName;
-
-        // Ensure the name is unique by appending a numeric suffix
-        auto check_tags = [&](const char* name) -> bool {
-
-            if (GetComponent<HierarchyComponent>()->HasParent()) { // Has Parent
-                std::vector<UUID> uuids = GetComponentInParent<HierarchyComponent>()->GetChildren();
-                for (auto& uuid : uuids) {
-
-                    if (uuid == entity_uuid)
-                        continue;
-
-                    const TagComponent& tag = scene->FindEntityByUUID(uuid).GetComponent<TagComponent>();
-                    if (tag.Tag == name)
-                        return true;
-                }
-            }
-            else { // At Root Level
-
-                auto view = scene->GetAllEntitiesWith<HierarchyComponent, TagComponent>();
-                for (auto& entity : view) {
+        if (scene)
+            scene->OnEntityRenamed(*this, name);
 
-                    if (!view.get<HierarchyComponent>(entity).HasParent()) {
-                        if (view.get<TagComponent>(entity).Tag == name)
-                            return true;
-                    }
-                }
-            }
-
-            return false;
-        };
+        Tag = name;
+    }
 
-        while (check_tags(uniqueName.c_str())) {
-            uniqueName = baseName + " (" + std::to_string(suffix++) + ")";
+    void TagComponent::SetUniqueName(const std::string& name)
+    {
+        if (!scene) {
+            SetTag(name.empty() ? "Untitled Entity" : name);
+            return;
         }
-        Tag = uniqueName;
+
+        // Unique among siblings, or among root entities if this has no parent
+        SetTag(scene->GetUniqueSiblingName(GetEntity(), name));
     }
 
     void CameraComponent::Serialize(YAML::Emitter& out)
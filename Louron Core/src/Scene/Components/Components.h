@@ -12,6 +12,7 @@
 #include <optional>
 
 // External Vendor Library Headers
+#include <entt/entt.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -45,6 +46,13 @@ namespace Louron {
         UUID entity_uuid = NULL_UUID;
         Scene* scene = nullptr;
 
+        /// <summary>
+        /// Registry handle of the owning entity, cached so GetEntity does not need a
+        /// UUID lookup. The UUID stays the persistent identity, the handle is checked
+        /// against it before use so a stale handle only costs the lookup.
+        /// </summary>
+        entt::entity entity_handle = entt::null;
+
         Entity GetEntity() const;
 
         template<typename T>
@@ -88,8 +96,28 @@ namespace Louron {
         bool Deserialize(const YAML::Node data);
     };
 
+    /// <summary>
+    /// Added to the root of a prefab copy spawned from a pooled prefab, so it can
+    /// be returned to its prefab's pool when despawned. InstanceEntities holds 
+    /// every entity of the copy in the prefab template's order.
+    /// </summary>
+    struct PrefabInstanceComponent : public Component {
+        UUID PrefabHandle = NULL_UUID;
+        std::vector<UUID> InstanceEntities;
+    };
+
+    /// <summary>
+    /// Added to every entity of a despawned prefab copy while it waits in its pool.
+    /// The entity stays in the scene, but scripts, rendering and physics skip it.
+    /// </summary>
+    struct DespawnedComponent : public Component { };
+
 	struct TagComponent : public Component {
 
+        /// <summary>
+        /// Rename through SetTag or SetUniqueName, writing this directly 
+        /// leaves the scene's name lookup out of date.
+        /// </summary>
 		std::string Tag;
 
 		TagComponent() = default;
@@ -99,6 +127,7 @@ namespace Louron {
         void Serialize(YAML::Emitter& out);
         bool Deserialize(const YAML::Node data);
 
+        void SetTag(const std::string& name);
         void SetUniqueName(const std::string& name);
 	};
 
@@ -111,8 +140,11 @@ namespace Louron {
 
             entity_uuid = other.entity_uuid;
             scene = other.scene;
+            entity_handle = other.entity_handle;
             m_Parent = other.m_Parent;
+            m_ParentHandle = other.m_ParentHandle;
             m_Children = other.m_Children;
+            m_ChildHandles = other.m_ChildHandles;
             m_HierarchyOrderIndex = other.m_HierarchyOrderIndex;
         }
 
@@ -120,10 +152,14 @@ namespace Louron {
 
             entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
             scene = other.scene; other.scene = nullptr;
+            entity_handle = other.entity_handle; other.entity_handle = entt::null;
             m_Parent = other.m_Parent; other.m_Parent = NULL_UUID;
+            m_ParentHandle = other.m_ParentHandle; other.m_ParentHandle = entt::null;
 
             m_Children = std::move(other.m_Children); // Move the children directly
             other.m_Children.clear();
+            m_ChildHandles = std::move(other.m_ChildHandles);
+            other.m_ChildHandles.clear();
 
             m_HierarchyOrderIndex = other.m_HierarchyOrderIndex; other.m_HierarchyOrderIndex = -1;
         }
@@ -135,8 +171,11 @@ namespace Louron {
 
             entity_uuid = other.entity_uuid;
             scene = other.scene;
+            entity_handle = other.entity_handle;
             m_Parent = other.m_Parent;
+            m_ParentHandle = other.m_ParentHandle;
             m_Children = other.m_Children;
+            m_ChildHandles = other.m_ChildHandles;
             m_HierarchyOrderIndex = other.m_HierarchyOrderIndex;
 
             return *this;
@@ -149,10 +188,14 @@ namespace Louron {
 
             entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
             scene = other.scene; other.scene = nullptr;
+            entity_handle = other.entity_handle; other.entity_handle = entt::null;
             m_Parent = other.m_Parent; other.m_Parent = NULL_UUID;
+            m_ParentHandle = other.m_ParentHandle; other.m_ParentHandle = entt::null;
 
             m_Children = std::move(other.m_Children); // Move the children directly
             other.m_Children.clear();
+            m_ChildHandles = std::move(other.m_ChildHandles);
+            other.m_ChildHandles.clear();
 
             m_HierarchyOrderIndex = other.m_HierarchyOrderIndex; other.m_HierarchyOrderIndex = -1;
 
@@ -169,10 +212,22 @@ namespace Louron {
         Entity FindChild(const std::string& childName) const;
         const std::vector<UUID>& GetChildren() const;
 
+        /// <summary>
+        /// The child at the same index as in GetChildren, resolved through 
+        /// the cached handle rather than a UUID lookup where possible.
+        /// </summary>
+        Entity GetChildEntity(size_t child_index) const;
+
         Entity GetParentEntity() const;
         const UUID& GetParentID() const;
         bool HasParent() const;
 
+        /// <summary>
+        /// Re-resolve the cached parent and child handles from their UUIDs. Call 
+        /// this once every entity exists, e.g. after deserialising or copying a scene.
+        /// </summary>
+        void ResolveHandles();
+
         void Serialize(YAML::Emitter& out);
         bool Deserialize(const YAML::Node data);
 
@@ -181,9 +236,19 @@ namespace Louron {
         UUID m_Parent = NULL_UUID;
         std::vector<UUID> m_Children;
 
+        // Cached registry handles of m_Parent and m_Children, index matched 
+        // with m_Children. The UUIDs are always authoritative.
+        entt::entity m_ParentHandle = entt::null;
+        std::vector<entt::entity> m_ChildHandles;
+
+        void AddChildLink(const UUID& child_uuid, entt::entity child_handle);
+        void RemoveChildLink(const UUID& child_uuid);
+        void ClearChildLinks();
+
         // This is for the editor hierarchy panel ordering
         uint32_t m_HierarchyOrderIndex = -1;
 
+        friend class Scene;
         friend class Prefab;
         friend class ModelImporter;
 
@@ -321,8 +386,28 @@ namespace Louron {
 
         TransformFlags m_StateFlags = TransformFlag_None;
 
-        void OnTransformUpdated();
-        void UpdateLocalTransformMatrix();
+        void OnTransformUpdated(bool propagate_to_children = true);
+        void UpdateLocalTransformMatrix(bool propagate_to_children = true);
+
+        /// <summary>
+        /// Recompute the global transform from the parent's global transform, or from
+        /// the local transform alone when parent_global_transform is nullptr, and flag
+        /// any colliders on the entity that need to follow it.
+        /// </summary>
+        void RecalculateGlobalTransform(Entity entity, const glm::mat4* parent_global_transform);
+
+        /// <summary>
+        /// The matrix maths of UpdateLocalTransformMatrix and RecalculateGlobalTransform
+        /// without touching the entity or scene, so the TransformSystem can run them on 
+        /// worker threads. ComputeGlobalTransform returns true if the global scale changed.
+        /// </summary>
+        void ComputeLocalTransformMatrix();
+        bool ComputeGlobalTransform(const glm::mat4* parent_global_transform);
+
+        /// <summary>
+        /// Flag the colliders on the entity once its global transform has been recomputed.
+        /// </summary>
+        void OnGlobalTransformRecalculated(Entity entity, bool global_scale_changed);
 
 
     public:
@@ -4,6 +4,7 @@
 #include "Components.h"
 #include "../../Renderer/Renderer.h"
 #include "../../Asset/Asset Manager API.h"
+#include "../Entity.h"
 
 // C++ Standard Library Headers
 #include <iomanip>
@@ -19,21 +20,55 @@ namespace Louron {
 
 	SubMesh::SubMesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices) {
 
-		VAO = std::make_unique<VertexArray>();
-		VertexBuffer* vbo = new VertexBuffer(vertices, (GLuint)vertices.size());
-		BufferLayout layout = {
-			{ ShaderDataType::Float3, "aPos" },
-			{ ShaderDataType::Float3, "aNormal" },
-			{ ShaderDataType::Float2, "aTexCoord" },
-			{ ShaderDataType::Float3, "aTangent" },
-			{ ShaderDataType::Float3, "aBitangent" }
-		};
-		vbo->SetLayout(layout);
-
-		IndexBuffer* ebo = new IndexBuffer(indices, (GLuint)indices.size());
-
-		VAO->AddVertexBuffer(vbo);
-		VAO->SetIndexBuffer(ebo);
+		for (const auto& vertex : vertices) {
+			SubMeshBounds.BoundsMin = glm::min(SubMeshBounds.BoundsMin, vertex.position);
+			SubMeshBounds.BoundsMax = glm::max(SubMeshBounds.BoundsMax, vertex.position);
+		}
+		Vertices = vertices;
+		Indices = indices;
+	}
+
+	bool SubMesh::Raycast(const Bounds_Ray& ray, float max_distance, float& distance) const {
+
+		float bounds_distance = 0.0f;
+		if (!ray.Intersects(SubMeshBounds, max_distance, bounds_distance))
+			return false;
+
+		bool hit = false;
+		for (size_t i = 0; i + 2 < Indices.size(); i += 3) {
+
+			if (Indices[i] >= Vertices.size() || Indices[i + 1] >= Vertices.size() || Indices[i + 2] >= Vertices.size())
+				continue;
+
+			float triangle_distance = 0.0f;
+			if (ray.Intersects(Vertices[Indices[i]].position, Vertices[Indices[i + 1]].position, Vertices[Indices[i + 2]].position, max_distance, triangle_distance)) {
+				max_distance = triangle_distance;
+				distance = triangle_distance;
+				hit = true;
+			}
+		}
+
+		return hit;
+	}
+
+	GeometryDrawRange SubMesh::GetPoolDrawRange() {
+
+		std::shared_ptr<GeometryPool> geometry_pool = Renderer::GetGeometryPool();
+		if (!geometry_pool)
+			return {};
+
+		// Upload lazily, and again after the renderer has recreated its pool
+		if (!m_PoolAllocation.BelongsTo(geometry_pool))
+			m_PoolAllocation = geometry_pool->Upload(Vertices, Indices);
+
+		return m_PoolAllocation.IsValid() ? m_PoolAllocation.GetDrawRange() : GeometryDrawRange{};
+	}
+
+	void MeshRendererComponent::MarkDirty() {
+
+		Entity entity = GetEntity();
+		if (entity && entity.GetScene())
+			entity.GetScene()->MarkRenderProxyDirty(entity);
 	}
 
 	void MeshRendererComponent::Serialize(YAML::Emitter& out) {
@@ -101,39 +136,69 @@ namespace Louron {
 		
 		if (auto mesh_asset = AssetManager::GetAsset<AssetMesh>(MeshFilterAssetHandle); mesh_asset) {
 
-			// Define the 8 corner points of the AABB
-			std::array<glm::vec3, 8> corners = {
-				mesh_asset->MeshBounds.BoundsMin,
-				glm::vec3(mesh_asset->MeshBounds.BoundsMax.x, mesh_asset->MeshBounds.BoundsMin.y, mesh_asset->MeshBounds.BoundsMin.z),
-				glm::vec3(mesh_asset->MeshBounds.BoundsMax.x, mesh_asset->MeshBounds.BoundsMax.y, mesh_asset->MeshBounds.BoundsMin.z),
-				glm::vec3(mesh_asset->MeshBounds.BoundsMin.x, mesh_asset->MeshBounds.BoundsMax.y, mesh_asset->MeshBounds.BoundsMin.z),
-				glm::vec3(mesh_asset->MeshBounds.BoundsMin.x, mesh_asset->MeshBounds.BoundsMin.y, mesh_asset->MeshBounds.BoundsMax.z),
-				glm::vec3(mesh_asset->MeshBounds.BoundsMax.x, mesh_asset->MeshBounds.BoundsMin.y, mesh_asset->MeshBounds.BoundsMax.z),
-				glm::vec3(mesh_asset->MeshBounds.BoundsMax.x, mesh_asset->MeshBounds.BoundsMax.y, mesh_asset->MeshBounds.BoundsMax.z),
-				glm::vec3(mesh_asset->MeshBounds.BoundsMin.x, mesh_asset->MeshBounds.BoundsMax.y, mesh_asset->MeshBounds.BoundsMax.z)
-			};
-
-			// Transform the corner points
-			glm::mat4 global_transform = GetComponent<TransformComponent>()->GetGlobalTransform();
-			for (int i = 0; i < 8; ++i) {
-				glm::vec4 transformed_corner = global_transform * glm::vec4(corners[i], 1.0f);
-				corners[i] = glm::vec3(transformed_corner);
-			}
-
-			// Find the new BoundsMin and BoundsMax
-			glm::vec3 newMin = corners[0];
-			glm::vec3 newMax = corners[0];
-			for (int i = 1; i < 8; ++i) {
-				newMin = glm::min(newMin, corners[i]);
-				newMax = glm::max(newMax, corners[i]);
-			}
-			TransformedAABB.BoundsMin = newMin;
-			TransformedAABB.BoundsMax = newMax;
+			// Cleared before the transform is read, so a move made after the read marks it stale again
+			AABBNeedsUpdate.store(false, std::memory_order_release);
 
-			AABBNeedsUpdate = false;
+			// Same transform BoundsSystem uses for batched updates
+			TransformedAABB = mesh_asset->MeshBounds.Transform(GetComponent<TransformComponent>()->GetGlobalTransform());
 		}
 	}
 
+	MeshFilterComponent::MeshFilterComponent(const MeshFilterComponent& other) : Component(other) {
+
+		MeshFilterAssetHandle = other.MeshFilterAssetHandle;
+		TransformedAABB = other.TransformedAABB;
+		AABBNeedsUpdate = other.AABBNeedsUpdate.load();
+		OctreeNeedsUpdate = other.OctreeNeedsUpdate.load();
+		RenderProxyNeedsUpdate = other.RenderProxyNeedsUpdate.load();
+		m_DisplayDebugAABB = other.m_DisplayDebugAABB;
+	}
+
+	MeshFilterComponent::MeshFilterComponent(MeshFilterComponent&& other) noexcept : MeshFilterComponent(static_cast<const MeshFilterComponent&>(other)) {
+
+	}
+
+	MeshFilterComponent& MeshFilterComponent::operator=(const MeshFilterComponent& other) {
+
+		if (this == &other)
+			return *this;
+
+		Component::operator=(other);
+
+		MeshFilterAssetHandle = other.MeshFilterAssetHandle;
+		TransformedAABB = other.TransformedAABB;
+		AABBNeedsUpdate = other.AABBNeedsUpdate.load();
+		OctreeNeedsUpdate = other.OctreeNeedsUpdate.load();
+		RenderProxyNeedsUpdate = other.RenderProxyNeedsUpdate.load();
+		m_DisplayDebugAABB = other.m_DisplayDebugAABB;
+
+		return *this;
+	}
+
+	MeshFilterComponent& MeshFilterComponent::operator=(MeshFilterComponent&& other) noexcept {
+		return *this = static_cast<const MeshFilterComponent&>(other);
+	}
+
+	void MeshFilterComponent::MarkDirty() {
+
+		AABBNeedsUpdate.store(true, std::memory_order_release);
+
+		// Already queued, the octree and render proxy will pick up the latest bounds when they drain their queues
+		if (OctreeNeedsUpdate.load(std::memory_order_acquire) && RenderProxyNeedsUpdate.load(std::memory_order_acquire))
+			return;
+
+		Entity entity = GetEntity();
+		if (!entity || !entity.GetScene())
+			return;
+
+		// Whoever flips the flag queues the entity, so it is queued exactly once per clear
+		if (!OctreeNeedsUpdate.exchange(true, std::memory_order_acq_rel))
+			entity.GetScene()->MarkOctreeDirty(entity);
+
+		if (!RenderProxyNeedsUpdate.exchange(true, std::memory_order_acq_rel))
+			entity.GetScene()->MarkRenderProxyDirty(entity);
+	}
+
 	void MeshFilterComponent::Serialize(YAML::Emitter& out) const {
 
 		out << YAML::Key << "MeshFilterComponent";
@@ -6,6 +6,7 @@
 #include "../../OpenGL/Texture.h"
 #include "../../OpenGL/Material.h"
 #include "../../OpenGL/Vertex Array.h"
+#include "../../OpenGL/Geometry Pool.h"
 
 #include "Components.h"
 
@@ -15,6 +16,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <atomic>
 
 // External Vendor Library Headers
 #include <assimp/Importer.hpp>
@@ -33,17 +35,42 @@ namespace Louron {
 
 	struct SubMesh {
 
-		std::unique_ptr<VertexArray> VAO = nullptr;
+		/// <summary>
+		/// CPU copy of the vertices and indices in mesh space, kept so ray
+		/// queries can test triangles without the GPU, and so the geometry
+		/// can be uploaded again when the renderer recreates its geometry pool.
+		/// </summary>
+		std::vector<Vertex> Vertices{};
+		std::vector<GLuint> Indices{};
+		Bounds_AABB SubMeshBounds{};
 
 		SubMesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices);
 		~SubMesh() = default;
 
-		SubMesh(const SubMesh&) = default;
-		SubMesh& operator=(const SubMesh& other) = default;
+		SubMesh(const SubMesh&) = delete;
+		SubMesh& operator=(const SubMesh& other) = delete;
 
 		SubMesh(SubMesh&&) = default;
 		SubMesh& operator=(SubMesh&& other) = default;
 
+		/// <summary>
+		/// Find the nearest triangle hit by a ray in mesh space.
+		/// </summary>
+		/// <returns>True if a triangle was hit within max_distance.</returns>
+		bool Raycast(const Bounds_Ray& ray, float max_distance, float& distance) const;
+
+		/// <summary>
+		/// Where this sub mesh sits in the renderer's geometry pool, uploading it
+		/// first if it is not in the current pool yet. Must be called from the
+		/// thread that owns the OpenGL context. An index count of zero means
+		/// the sub mesh could not be drawn.
+		/// </summary>
+		GeometryDrawRange GetPoolDrawRange();
+
+	private:
+
+		GeometryPoolAllocation m_PoolAllocation{};
+
 	};
 
 	struct AssetMesh : public Asset {
@@ -70,24 +97,34 @@ namespace Louron {
 		AssetHandle MeshFilterAssetHandle = NULL_UUID;
 
 		Bounds_AABB TransformedAABB{};
-		bool AABBNeedsUpdate = true;
-		bool OctreeNeedsUpdate = true;
+
+		// Set on the main thread by MarkDirty and cleared by the octree update
+		// job and the render proxy sync, so they are atomic
+		std::atomic<bool> AABBNeedsUpdate = true;
+		std::atomic<bool> OctreeNeedsUpdate = true;
+		std::atomic<bool> RenderProxyNeedsUpdate = true;
 
 		void UpdateTransformedAABB();
 
+		/// <summary>
+		/// Flag the transformed AABB as stale and queue this entity for octree
+		/// maintenance and a render proxy rebuild if it is not already queued.
+		/// </summary>
+		void MarkDirty();
+
 		MeshFilterComponent() = default;
 		~MeshFilterComponent() = default;
 
-		MeshFilterComponent(const MeshFilterComponent& other) = default;
-		MeshFilterComponent(MeshFilterComponent&& other) noexcept = default;
+		MeshFilterComponent(const MeshFilterComponent& other);
+		MeshFilterComponent(MeshFilterComponent&& other) noexcept;
 
-		MeshFilterComponent& operator=(const MeshFilterComponent& other) = default;
-		MeshFilterComponent& operator=(MeshFilterComponent&& other) = default;
+		MeshFilterComponent& operator=(const MeshFilterComponent& other);
+		MeshFilterComponent& operator=(MeshFilterComponent&& other) noexcept;
 
 		void Serialize(YAML::Emitter& out) const;
 		bool Deserialize(const YAML::Node data);
 
-		void SetShouldDisplayDebugLines(const bool& shouldDisplay) { m_DisplayDebugAABB = shouldDisplay; }
+		void SetShouldDisplayDebugLines(const bool& shouldDisplay) { m_DisplayDebugAABB = shouldDisplay; MarkDirty(); }
 		bool GetShouldDisplayDebugLines() const { return m_DisplayDebugAABB; }
 
 	private:
@@ -104,6 +141,12 @@ namespace Louron {
 
 		bool CastShadows = false;
 
+		/// <summary>
+		/// Queue this entity's render proxy to be rebuilt, call this after changing
+		/// any member directly so the change is drawn on the same frame.
+		/// </summary>
+		void MarkDirty();
+
 		void Serialize(YAML::Emitter& out);
 		bool Deserialize(const YAML::Node data);
 
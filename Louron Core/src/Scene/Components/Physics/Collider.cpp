@@ -69,6 +69,9 @@ namespace Louron {
         if (entity_uuid == NULL_UUID)
             entity_uuid = other.entity_uuid;
 
+        if (entity_handle == entt::null)
+            entity_handle = other.entity_handle;
+
         m_Radius = other.m_Radius;
         m_IsTrigger = other.m_IsTrigger;
         m_Centre = other.m_Centre;
@@ -91,6 +94,7 @@ namespace Louron {
         // Component Base Class Move
         scene = other.scene; other.scene = nullptr;
         entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
+        entity_handle = other.entity_handle; other.entity_handle = entt::null;
 
         // Sphere Collider Class Move
         m_Radius = other.m_Radius; other.m_Radius = 0.5f;
@@ -162,6 +166,7 @@ namespace Louron {
         // Component Base Class Move
         scene = other.scene; other.scene = nullptr;
         entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
+        entity_handle = other.entity_handle; other.entity_handle = entt::null;
 
         // Sphere Collider Class Move
         m_Radius = other.m_Radius; other.m_Radius = 0.5f;
@@ -250,21 +255,22 @@ namespace Louron {
             return;
         }
 
-        if (!entity.GetScene()->FindEntityByUUID(rigidbodyEntityUUID)) {
+        Entity rigidbody_entity = entity.GetScene()->TryFindEntityByUUID(rigidbodyEntityUUID, true);
+        if (!rigidbody_entity) {
             
             L_CORE_WARN("Cannot Update Rigidbody - New Rigidbody Entity Is Invalid and Cannot Access Scene!");
             CreateStaticRigidbody();
             return;
         }
         
-        if (!entity.GetScene()->FindEntityByUUID(rigidbodyEntityUUID).HasComponent<RigidbodyComponent>()) {
+        if (!rigidbody_entity.HasComponent<RigidbodyComponent>()) {
             
             L_CORE_WARN("Cannot Update Rigidbody - New Rigidbody Entity Does Not Have Rigidbody Component!");
             CreateStaticRigidbody();
             return;
         }
 
-        if (auto rb_ref = entity.GetScene()->FindEntityByUUID(rigidbodyEntityUUID).GetComponent<RigidbodyComponent>().GetActor();  rb_ref && *rb_ref) {
+        if (auto rb_ref = rigidbody_entity.GetComponent<RigidbodyComponent>().GetActor();  rb_ref && *rb_ref) {
 
             ResetRigidbody();
 
@@ -526,6 +532,9 @@ namespace Louron {
         if (entity_uuid == NULL_UUID)
             entity_uuid = other.entity_uuid;
 
+        if (entity_handle == entt::null)
+            entity_handle = other.entity_handle;
+
         m_BoxExtents = other.m_BoxExtents;
         m_IsTrigger = other.m_IsTrigger;
         m_Centre = other.m_Centre;
@@ -548,6 +557,7 @@ namespace Louron {
         // Component Base Class Move
         scene = other.scene; other.scene = nullptr;
         entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
+        entity_handle = other.entity_handle; other.entity_handle = entt::null;
 
         // Sphere Collider Class Move
         m_BoxExtents = other.m_BoxExtents; other.m_BoxExtents = { 1.0f, 1.0f, 1.0f };
@@ -618,6 +628,7 @@ namespace Louron {
         // Component Base Class Move
         scene = other.scene; other.scene = nullptr;
         entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
+        entity_handle = other.entity_handle; other.entity_handle = entt::null;
 
         // Sphere Collider Class Move
         m_BoxExtents = other.m_BoxExtents; other.m_BoxExtents = { 1.0f, 1.0f, 1.0f };
@@ -705,21 +716,22 @@ namespace Louron {
             return;
         }
 
-        if (!entity.GetScene()->FindEntityByUUID(rigidbodyEntityUUID)) {
+        Entity rigidbody_entity = entity.GetScene()->TryFindEntityByUUID(rigidbodyEntityUUID, true);
+        if (!rigidbody_entity) {
 
             L_CORE_WARN("Cannot Update Rigidbody - New Rigidbody Entity Is Invalid and Cannot Access Scene!");
             CreateStaticRigidbody();
             return;
         }
 
-        if (!entity.GetScene()->FindEntityByUUID(rigidbodyEntityUUID).HasComponent<RigidbodyComponent>()) {
+        if (!rigidbody_entity.HasComponent<RigidbodyComponent>()) {
 
             L_CORE_WARN("Cannot Update Rigidbody - New Rigidbody Entity Does Not Have Rigidbody Component!");
             CreateStaticRigidbody();
             return;
         }
 
-        if (auto rb_ref = entity.GetScene()->FindEntityByUUID(rigidbodyEntityUUID).GetComponent<RigidbodyComponent>().GetActor();  rb_ref && *rb_ref) {
+        if (auto rb_ref = rigidbody_entity.GetComponent<RigidbodyComponent>().GetActor();  rb_ref && *rb_ref) {
 
             ResetRigidbody();
 
@@ -20,8 +20,8 @@ namespace Louron {
 				}
 						
 				std::array<Entity, 2> entities{
-					scene_ref->FindEntityByUUID(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(cp.shapes[0]->userData))),
-					scene_ref->FindEntityByUUID(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(cp.shapes[1]->userData)))
+					scene_ref->TryFindEntityByUUID(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(cp.shapes[0]->userData))),
+					scene_ref->TryFindEntityByUUID(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(cp.shapes[1]->userData)))
 				};
 
 				if (entities[0] && entities[1]) {
@@ -68,8 +68,8 @@ namespace Louron {
 				uint32_t triggerUUID = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(tp.triggerShape->userData));
 				uint32_t otherUUID = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(tp.otherShape->userData));
 
-				Entity triggerEntity = scene_ref->FindEntityByUUID(triggerUUID);
-				Entity otherEntity = scene_ref->FindEntityByUUID(otherUUID);
+				Entity triggerEntity = scene_ref->TryFindEntityByUUID(triggerUUID);
+				Entity otherEntity = scene_ref->TryFindEntityByUUID(otherUUID);
 
 				if (triggerEntity && otherEntity) {
 					std::pair<uint32_t, uint32_t> triggerPair = { triggerUUID, otherUUID };
@@ -29,6 +29,7 @@ namespace Louron {
 
 		RigidbodyFlag_TransformUpdated	= 1U << 0,	// Only add this flag where there have been changes made to the entities transform manually
 		RigidbodyFlag_ShapesUpdated		= 1U << 1,	// Only add this flag where there has been a shape change to the Rigidbody
+		RigidbodyFlag_PoseUpdated		= 1U << 2,	// Only add this flag where the simulation has moved the actor since its pose was last written to the transform
 
 	};
 	
@@ -67,7 +67,8 @@ namespace Louron {
 
 	void RigidbodyComponent::Shutdown() {
 
-		if(m_PhysScene && m_RigidDynamic && m_RigidDynamic->GetActor())
+		// The actor may have already been removed with the rest of a batch
+		if(m_PhysScene && m_RigidDynamic && m_RigidDynamic->GetActor() && m_RigidDynamic->GetActor()->getScene())
 			m_PhysScene->removeActor(*m_RigidDynamic->GetActor());
 
 		if(m_RigidDynamic) {
@@ -86,6 +87,9 @@ namespace Louron {
 		if (!entity_uuid)
 			entity_uuid = other.entity_uuid;
 
+		if (entity_handle == entt::null)
+			entity_handle = other.entity_handle;
+
 		m_Mass = other.m_Mass;
 		m_Drag = other.m_Drag;
 		m_AngularDrag = other.m_AngularDrag;
@@ -115,6 +119,7 @@ namespace Louron {
 	{
 		// Component Base Class Move
 		entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
+		entity_handle = other.entity_handle; other.entity_handle = entt::null;
 		scene = other.scene; other.scene = nullptr;
 
 		// Rigidbody Component Class Move
@@ -150,6 +155,9 @@ namespace Louron {
 		if (!entity_uuid)
 			entity_uuid = other.entity_uuid;
 
+		if (entity_handle == entt::null)
+			entity_handle = other.entity_handle;
+
 		m_Mass = other.m_Mass;
 		m_Drag = other.m_Drag;
 		m_AngularDrag = other.m_AngularDrag;
@@ -186,6 +194,7 @@ namespace Louron {
 
 		// Component Base Class Move
 		entity_uuid = other.entity_uuid; other.entity_uuid = NULL_UUID;
+		entity_handle = other.entity_handle; other.entity_handle = entt::null;
 		scene = other.scene; other.scene = nullptr;
 
 		// Rigidbody Component Class Move
@@ -0,0 +1,181 @@
+#pragma once
+
+// Louron Core Headers
+#include "Components/UUID.h"
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <vector>
+
+// External Vendor Library Headers
+#include <entt/entt.hpp>
+
+namespace Louron {
+
+	/// <summary>
+	/// UUID to entt handle lookup for Scenes and Prefabs. All entries live in one
+	/// flat array using open addressing with linear probing, so a lookup is a hash
+	/// and a short scan of neighbouring slots with no allocation or pointer chasing.
+	/// Erasing shifts the following entries back instead of leaving tombstones,
+	/// so lookups stay short however many entities have been created and destroyed.
+	/// </summary>
+	class EntityMap {
+
+	public:
+
+		EntityMap() = default;
+
+		/// <summary>
+		/// Insert the entity under the UUID if the UUID is not already in the map.
+		/// </summary>
+		/// <returns>True if the entity was inserted.</returns>
+		bool Insert(const UUID& uuid, entt::entity entity_handle) {
+
+			if (entity_handle == entt::null)
+				return false;
+
+			if ((m_Count + 1) * s_MaxLoadDenominator > m_Slots.size() * s_MaxLoadNumerator)
+				Rehash(m_Slots.empty() ? s_MinCapacity : m_Slots.size() * 2);
+
+			const uint32_t key = uuid;
+			const size_t mask = m_Slots.size() - 1;
+
+			for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+
+				EntityMapSlot& slot = m_Slots[i];
+
+				if (slot.EntityHandle == entt::null) {
+					slot.Key = key;
+					slot.EntityHandle = entity_handle;
+					m_Count++;
+					return true;
+				}
+
+				if (slot.Key == key)
+					return false;
+			}
+		}
+
+		/// <summary>
+		/// Remove the UUID from the map.
+		/// </summary>
+		/// <returns>True if the UUID was in the map.</returns>
+		bool Erase(const UUID& uuid) {
+
+			size_t hole = FindSlot(uuid);
+			if (hole == s_NullSlot)
+				return false;
+
+			const size_t mask = m_Slots.size() - 1;
+
+			// Shift back any following entries that probed past the hole,
+			// so every entry stays reachable from its home slot
+			for (size_t next = (hole + 1) & mask; m_Slots[next].EntityHandle != entt::null; next = (next + 1) & mask) {
+
+				const size_t home = Hash(m_Slots[next].Key) & mask;
+				if (((next - home) & mask) >= ((next - hole) & mask)) {
+					m_Slots[hole] = m_Slots[next];
+					hole = next;
+				}
+			}
+
+			m_Slots[hole] = EntityMapSlot{};
+			m_Count--;
+			return true;
+		}
+
+		/// <summary>
+		/// Find the entity for the UUID. Does not log on a miss.
+		/// </summary>
+		/// <returns>The entt handle, or entt::null if the UUID is not in the map.</returns>
+		entt::entity TryFind(const UUID& uuid) const {
+			size_t slot = FindSlot(uuid);
+			return slot == s_NullSlot ? entt::entity{ entt::null } : m_Slots[slot].EntityHandle;
+		}
+
+		bool Contains(const UUID& uuid) const { return FindSlot(uuid) != s_NullSlot; }
+
+		/// <summary>
+		/// Make room for at least this many entries without rehashing.
+		/// </summary>
+		void Reserve(size_t count) {
+
+			size_t capacity = s_MinCapacity;
+			while (count * s_MaxLoadDenominator > capacity * s_MaxLoadNumerator)
+				capacity *= 2;
+
+			if (capacity > m_Slots.size())
+				Rehash(capacity);
+		}
+
+		void Clear() {
+			m_Slots.clear();
+			m_Count = 0;
+		}
+
+		size_t Size() const { return m_Count; }
+		bool Empty() const { return m_Count == 0; }
+
+	private:
+
+		struct EntityMapSlot {
+			uint32_t Key = NULL_UUID;
+			entt::entity EntityHandle = entt::null;
+		};
+
+		static constexpr size_t s_NullSlot = SIZE_MAX;
+		static constexpr size_t s_MinCapacity = 16;
+
+		// Grow past 7/8 full, linear probing stays short up to here
+		static constexpr size_t s_MaxLoadNumerator = 7;
+		static constexpr size_t s_MaxLoadDenominator = 8;
+
+		/// <summary>
+		/// Scene UUIDs are random but Prefab UUIDs are sequential entt handles,
+		/// so the bits are mixed to spread both evenly over the slots.
+		/// </summary>
+		static uint32_t Hash(uint32_t key) {
+			key ^= key >> 16;
+			key *= 0x85ebca6bu;
+			key ^= key >> 13;
+			key *= 0xc2b2ae35u;
+			key ^= key >> 16;
+			return key;
+		}
+
+		size_t FindSlot(const UUID& uuid) const {
+
+			if (m_Count == 0)
+				return s_NullSlot;
+
+			const uint32_t key = uuid;
+			const size_t mask = m_Slots.size() - 1;
+
+			for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+
+				const EntityMapSlot& slot = m_Slots[i];
+
+				if (slot.EntityHandle == entt::null)
+					return s_NullSlot;
+
+				if (slot.Key == key)
+					return i;
+			}
+		}
+
+		void Rehash(size_t capacity) {
+
+			std::vector<EntityMapSlot> old_slots = std::move(m_Slots);
+			m_Slots.assign(capacity, EntityMapSlot{});
+			m_Count = 0;
+
+			for (const EntityMapSlot& slot : old_slots)
+				if (slot.EntityHandle != entt::null)
+					Insert(slot.Key, slot.EntityHandle);
+		}
+
+		std::vector<EntityMapSlot> m_Slots;
+		size_t m_Count = 0;
+	};
+
+}
@@ -50,6 +50,7 @@ namespace Louron {
 
 			component.scene = m_Scene;
 			component.entity_uuid = m_Scene->m_Registry.get<IDComponent>(m_EntityHandle).ID;
+			component.entity_handle = m_EntityHandle;
 
 			if constexpr (std::is_same_v<T, ScriptComponent>) {
 				if(m_Scene && m_Scene->IsRunning())
@@ -221,4 +222,18 @@ namespace Louron {
 	};
 
 
-}
\ No newline at end of file
+}
+// Define specialisation for the hash template when custom type used (Louron::Entity)
+namespace std {
+	template <typename T> struct hash;
+
+	template<>
+	struct hash<Louron::Entity>
+	{
+		std::size_t operator()(const Louron::Entity& entity) const
+		{
+			return std::hash<uint32_t>{}((uint32_t)entity) ^ (std::hash<Louron::Scene*>{}(entity.GetScene()) << 1);
+		}
+	};
+
+}
@@ -1,6 +1,9 @@
 #include "Frustum.h"
 
 #include "Bounds.h"
+#include "Bounds SIMD.h"
+
+#include <algorithm>
 #include <vector>
 
 namespace Louron {
@@ -240,4 +243,118 @@ namespace Louron {
         return FrustumContainResult::DoesNotContain;
 	}
 
+	FrustumContainResult Frustum::Contains(const Bounds_AABB& bounds, uint8_t& plane_mask) const {
+
+        for (int i = 0; i < 6; i++) {
+
+            if (!(plane_mask & (1 << i)))
+                continue;
+
+            const Plane& plane = planes[i];
+
+            glm::vec3 positiveVertex = bounds.BoundsMin;
+            glm::vec3 negativeVertex = bounds.BoundsMax;
+
+            if (plane.normal.x >= 0) {
+                positiveVertex.x = bounds.BoundsMax.x;
+                negativeVertex.x = bounds.BoundsMin.x;
+            }
+            if (plane.normal.y >= 0) {
+                positiveVertex.y = bounds.BoundsMax.y;
+                negativeVertex.y = bounds.BoundsMin.y;
+            }
+            if (plane.normal.z >= 0) {
+                positiveVertex.z = bounds.BoundsMax.z;
+                negativeVertex.z = bounds.BoundsMin.z;
+            }
+
+            // Entirely outside this plane
+            if (glm::dot(plane.normal, positiveVertex) + plane.distance < 0)
+                return FrustumContainResult::DoesNotContain;
+
+            // Entirely inside this plane, nothing within these bounds needs to test it again
+            if (glm::dot(plane.normal, negativeVertex) + plane.distance >= 0)
+                plane_mask &= ~(1 << i);
+        }
+
+        return plane_mask == 0 ? FrustumContainResult::Contains : FrustumContainResult::Intersects;
+	}
+
+	void Frustum::Contains(const Bounds_AABB* bounds, size_t count, FrustumContainResult* results, uint8_t plane_mask, uint8_t* result_plane_masks) const {
+
+#if L_BOUNDS_SIMD_WIDTH > 1
+
+        using namespace BoundsSIMD;
+
+        const Float zero = Set1(0.0f);
+
+        for (size_t first = 0; first < count; first += Width) {
+
+            const size_t lane_count = std::min<size_t>(count - first, Width);
+            const AABBLanes box = LoadAABBs(bounds + first, lane_count);
+
+            int outside_lanes = 0;
+            uint8_t lane_plane_masks[Width];
+            std::fill_n(lane_plane_masks, Width, plane_mask);
+
+            for (int i = 0; i < 6; i++) {
+
+                if (!(plane_mask & (1 << i)))
+                    continue;
+
+                const Plane& plane = planes[i];
+
+                // The positive and negative vertex only depend on the plane, so every lane picks the same side
+                const Float positive_x = plane.normal.x >= 0 ? box.MaxX : box.MinX;
+                const Float positive_y = plane.normal.y >= 0 ? box.MaxY : box.MinY;
+                const Float positive_z = plane.normal.z >= 0 ? box.MaxZ : box.MinZ;
+                const Float negative_x = plane.normal.x >= 0 ? box.MinX : box.MaxX;
+                const Float negative_y = plane.normal.y >= 0 ? box.MinY : box.MaxY;
+                const Float negative_z = plane.normal.z >= 0 ? box.MinZ : box.MaxZ;
+
+                const Float normal_x = Set1(plane.normal.x);
+                const Float normal_y = Set1(plane.normal.y);
+                const Float normal_z = Set1(plane.normal.z);
+                const Float distance = Set1(plane.distance);
+
+                // Same operation order as glm::dot(normal, vertex) + distance so results match the scalar test
+                const Float distance_positive = Add(Add(Add(Mul(normal_x, positive_x), Mul(normal_y, positive_y)), Mul(normal_z, positive_z)), distance);
+                const Float distance_negative = Add(Add(Add(Mul(normal_x, negative_x), Mul(normal_y, negative_y)), Mul(normal_z, negative_z)), distance);
+
+                outside_lanes |= MoveMask(Less(distance_positive, zero));
+
+                const int inside_lanes = MoveMask(GreaterEqual(distance_negative, zero));
+                for (int lane = 0; lane < Width; lane++) {
+                    if (inside_lanes & (1 << lane))
+                        lane_plane_masks[lane] &= ~(1 << i);
+                }
+            }
+
+            for (size_t lane = 0; lane < lane_count; lane++) {
+
+                if (outside_lanes & (1 << lane))
+                    results[first + lane] = FrustumContainResult::DoesNotContain;
+                else
+                    results[first + lane] = lane_plane_masks[lane] == 0 ? FrustumContainResult::Contains : FrustumContainResult::Intersects;
+
+                if (result_plane_masks)
+                    result_plane_masks[first + lane] = lane_plane_masks[lane];
+            }
+        }
+
+#else
+
+        for (size_t i = 0; i < count; i++) {
+
+            uint8_t mask = plane_mask;
+            results[i] = Contains(bounds[i], mask);
+
+            if (result_plane_masks)
+                result_plane_masks[i] = mask;
+        }
+
+#endif
+
+	}
+
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -50,6 +51,21 @@ namespace Louron {
 		static std::array<glm::mat4, 5> CalculateCascadeLightSpaceMatrices(float fov, float aspect_ratio, float near_plane, float far_plane, const glm::mat4& view_matrix, const glm::vec3& light_direction, std::array<float, 5>& shadow_cascade_plane_distances);
 
 		FrustumContainResult Contains(const Bounds_AABB& bounds) const;
+
+		/// <summary>
+		/// Same test as Contains, but only the planes flagged in plane_mask (bit i is planes[i]) 
+		/// are tested. Planes the bounds are entirely inside of are cleared from the mask, so 
+		/// anything contained within these bounds can skip them. An empty mask means Contains.
+		/// </summary>
+		FrustumContainResult Contains(const Bounds_AABB& bounds, uint8_t& plane_mask) const;
+
+		/// <summary>
+		/// Classify count AABBs at once, 4 or 8 at a time depending on the instruction set. 
+		/// results[i] matches Contains(bounds[i], mask) exactly. If result_plane_masks is 
+		/// given it receives each box's remaining plane mask, which is only meaningful when 
+		/// the result is not DoesNotContain.
+		/// </summary>
+		void Contains(const Bounds_AABB* bounds, size_t count, FrustumContainResult* results, uint8_t plane_mask = 0x3F, uint8_t* result_plane_masks = nullptr) const;
 	};
 
 }
\ No newline at end of file
@@ -4,17 +4,29 @@
 // where I hear crickets from the crowd and eventually figure it out myself lol
 // https://gamedev.stackexchange.com/questions/211647/octree-query-frustum-search-and-recursive-vector-inserts/211698#211698
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/component_wise.hpp>
 
+#include "../Core/Job System.h"
 #include "../Core/Logging.h"
 #include "../Debug/Assert.h"
 
 #include "Bounds.h"
 #include "Frustum.h"
+#include "Spatial Index.h"
 
 namespace Louron {
 
@@ -80,1142 +92,1669 @@ namespace Louron {
 
 	};
 
-	template <typename DataType>
-	struct OctreeDataSource {
+	/// <summary>
+	/// Index used by the Octree node and data arenas to mark a 
+	/// child node or data block that has not been allocated.
+	/// </summary>
+	constexpr uint32_t OCTREE_NULL_INDEX = UINT32_MAX;
 
-		DataType Data;
-		Bounds_AABB Bounds;
+	/// <summary>
+	/// Number of bounds the Octree classifies per batched SIMD test, 
+	/// this also covers the 8 children of a node in one call.
+	/// </summary>
+	constexpr uint32_t OCTREE_TEST_BATCH_SIZE = SPATIAL_INDEX_TEST_BATCH_SIZE;
 
-		OctreeDataSource() = delete;
-		OctreeDataSource(DataType data, Bounds_AABB bounds) : Data(data), Bounds(bounds) { }
+	template <typename DataType>
+	class OctreeBounds : public SpatialIndex<DataType> {
 
-		OctreeDataSource(const OctreeDataSource& other) = default;
-		OctreeDataSource& operator=(const OctreeDataSource& other) = default;
+	public:
 
-		OctreeDataSource(OctreeDataSource&& other) = default;
-		OctreeDataSource& operator=(OctreeDataSource&& other) = default;
-	};
+		using OctreeData = OctreeDataSource<DataType>;
 
-	template <typename DataType>
-	class OctreeBounds {
+		using OctreeRayHit = typename SpatialIndex<DataType>::RayHit;
+		using OctreeRayFilter = typename SpatialIndex<DataType>::RayFilter;
 
 	private:
 
-		template <typename DataType>
-		class OctreeBoundsNode {
+		/// <summary>
+		/// Nodes are stored by value in the Octree node arena and only reference
+		/// their children, parent and data sources by 32-bit index. This keeps a
+		/// traversal inside two contiguous vectors, and nodes are recycled through 
+		/// a free list when the Octree splits, shrinks or prunes empty nodes.
+		/// </summary>
+		struct OctreeBoundsNode {
 
-		private:
+			OctreeBoundsNode() { ChildrenNodes.fill(OCTREE_NULL_INDEX); }
 
-			using OctreeNode = std::shared_ptr<OctreeBoundsNode<DataType>>;
-			using OctreeData = std::shared_ptr<OctreeDataSource<DataType>>;
-			friend class OctreeBounds;
+			/// <summary>
+			/// The actual bounds of the node unaffected by the looseness.
+			/// 
+			/// Please note, this is not varied when looseness changes. This 
+			/// will always be the actual bounds of the current node.
+			/// 
+			/// The looseness will ONLY be taken into account when attempting 
+			/// to insert a Data Source, or querying a particular node.
+			/// </summary>
+			Bounds_AABB NodeBounds{};
 
-		public:
+			/// <summary>
+			/// Node arena indices of the 8 (oct) child nodes of this node.
+			/// </summary>
+			std::array<uint32_t, 8> ChildrenNodes{};
 
-			// Constructor and Destructor
-			OctreeBoundsNode() = default;
-			OctreeBoundsNode(Bounds_AABB node_bounds, OctreeBounds<DataType>* octree) : m_NodeBounds(node_bounds), m_Octree(octree){
+			/// <summary>
+			/// Node arena index of the parent node, the root node has no parent.
+			/// </summary>
+			uint32_t ParentNode = OCTREE_NULL_INDEX;
 
-				m_LifeMax = m_Octree ? m_Octree->m_Config.MaxLifeIfEmpty : 8;
+			/// <summary>
+			/// This is the index of the start of this node's block in the 
+			/// Octree Data Storage.
+			/// </summary>
+			uint32_t DataSourceIndex = OCTREE_NULL_INDEX;
 
-				m_NodeMat4 = m_NodeBounds.GetGlobalBoundsMat4();
-				m_ChildrenBounds = this->CalculateChildBounds();
-			}
-			~OctreeBoundsNode() = default;
+			/// <summary>
+			/// This is the size of how many DataSources are contained in 
+			/// this Node at the DataSourceIndex in the Octree Data Storage.
+			/// </summary>
+			uint32_t DataSourceSize = 0;
 
-			// COPY
-			OctreeBoundsNode(const OctreeBoundsNode&) = default;
-			OctreeBoundsNode& operator=(const OctreeBoundsNode&) = default;
+			/// <summary>
+			/// This is how many DataSources this node's block can hold before
+			/// it needs to be moved to a larger block. Always a power of two.
+			/// </summary>
+			uint32_t DataSourceCapacity = 0;
 
-			// MOVE
-			OctreeBoundsNode(OctreeBoundsNode&&) = default;
-			OctreeBoundsNode& operator=(OctreeBoundsNode&&) = default;
+			/// <summary>
+			/// The current size of self including all child data sources.
+			/// </summary>
+			uint32_t TotalNodeDataSourceSize = 0;
 
 			/// <summary>
-			/// This will attempt to insert a data source within the Octree.
+			/// This tells us if this node has been split into child nodes or not.
 			/// </summary>
-			bool Insert(OctreeData data, size_t node_data_start_position, bool already_checked_contains = false) {
+			bool IsNodeSplit = false;
 
-				// 1. Set the position of the Node's data source start index
-				m_DataSourceIndex = node_data_start_position;
+			/// <summary>
+			/// This is the max amount of times a node can be pruned whilst itself 
+			/// and its children have no data sources.
+			/// </summary>
+			uint8_t LifeMax = 8;
 
-				// 2. Have we already checked if this node contains the data source?
-				if (!already_checked_contains) {
-					// No we haven't so we will perform the check now!
-					if (m_NodeBounds.Contains(data->Bounds, m_Octree->m_Config.Looseness) != BoundsContainResult::Contains) {
-						// The data does not fit in the current node, return it to the caller :'( OR :D ... depends what node you're in ;)
-						return false;
-					}
-				}
+			/// <summary>
+			/// This is the death counter, it will start at 0 and work its way up to 
+			/// Life Max each time the Octree is pruned. If it reaches LifeMax it 
+			/// will delete the current node and all its children. If the node is 
+			/// saved and something is placed in it, then the LifeMax of the node 
+			/// is doubled.
+			/// </summary>
+			uint8_t LifeCount = 0;
+		};
 
-				// 3. First Insert Check: check if the current node has less than the suggested max data_sources
-				// or pass this check if the node has already been split.
-				if (m_DataSourceSize < m_Octree->m_Config.PreferredDataSourceLimit && !IsNodeSplit()) {
-					
-					InsertDataToNode(data);
-					return true;
-				}
+		/// <summary>
+		/// Where a data source currently lives within the Octree.
+		/// </summary>
+		struct OctreeDataLocation {
+			uint32_t NodeIndex = OCTREE_NULL_INDEX;
+			uint32_t DataIndex = OCTREE_NULL_INDEX;
+		};
 
-				// 4. Second Insert Check: are we able to split the node? 
-				
-				// If the children nodes will be smaller than the defined minimum size, we 
-				// will simply add to this node and return true.
-				glm::vec3 child_bounds_size = m_ChildrenBounds[0].Size();
-				if (child_bounds_size.x < m_Octree->m_Config.MinNodeSize || child_bounds_size.y < m_Octree->m_Config.MinNodeSize || child_bounds_size.z < m_Octree->m_Config.MinNodeSize) {
+	public:
 
-					InsertDataToNode(data);
-					return true;
-				}
+		OctreeBounds() {
+			BuildOctree({});
+		}
 
-				// Split the node as we should not place into the current node YET
-				if(!IsNodeSplit())
-					SplitNode();
+		OctreeBounds(const OctreeBoundsConfig& config) : m_Config(config) {
+			BuildOctree({});
+		};
 
-				// 5. Third Insert Check: Attempt insert into child node
-				size_t child_data_start = m_DataSourceIndex + m_DataSourceSize;
-				for (int i = 0; i < m_ChildrenBounds.size(); i++) {
+		/// <summary>
+		/// If a job system is given, building and rebuilding the Octree is split
+		/// across its workers, otherwise it is built on the calling thread.
+		/// </summary>
+		OctreeBounds(const OctreeBoundsConfig& config, std::vector<OctreeData> data_sources, JobSystem* job_system = nullptr) : m_Config(config), m_JobSystem(job_system) {
+			BuildOctree(data_sources);
+		};
 
-					if (m_ChildrenBounds[i].Contains(data->Bounds, m_Octree->m_Config.Looseness) == BoundsContainResult::Contains) {
+		~OctreeBounds() override = default;
 
-						if (!m_ChildrenNodes[i]) {
-							m_ChildrenNodes[i] = std::make_shared<OctreeBoundsNode<DataType>>(m_ChildrenBounds[i], m_Octree);
-							m_IsNodeSplit = true;
-						}
+		/// <summary>
+		/// Copying an Octree is a straight copy of its arenas as nodes do not
+		/// hold any pointers. The caller should lock the other Octree's mutex 
+		/// if it may be updated from another thread.
+		/// </summary>
+		OctreeBounds(const OctreeBounds& other) :
+			m_Config(other.m_Config), m_JobSystem(other.m_JobSystem), m_RootNode(other.m_RootNode),
+			m_Nodes(other.m_Nodes), m_FreeNodes(other.m_FreeNodes),
+			m_DataSources(other.m_DataSources), m_FreeDataBlocks(other.m_FreeDataBlocks),
+			m_DataSourceLocations(other.m_DataSourceLocations) { }
+
+		OctreeBounds& operator=(const OctreeBounds& other) {
+			if (this == &other)
+				return *this;
+
+			m_Config = other.m_Config;
+			m_JobSystem = other.m_JobSystem;
+			m_RootNode = other.m_RootNode;
+			m_Nodes = other.m_Nodes;
+			m_FreeNodes = other.m_FreeNodes;
+			m_DataSources = other.m_DataSources;
+			m_FreeDataBlocks = other.m_FreeDataBlocks;
+			m_DataSourceLocations = other.m_DataSourceLocations;
+			return *this;
+		}
 
-						if (m_ChildrenNodes[i]->Insert(data, child_data_start, true)) {
-							m_TotalNodeDataSourceSize++;
-							return true;
-						}
-						else { 
-							break; 
-						}
+		OctreeBounds(OctreeBounds&& other) noexcept :
+			m_Config(other.m_Config), m_JobSystem(other.m_JobSystem), m_RootNode(other.m_RootNode),
+			m_Nodes(std::move(other.m_Nodes)), m_FreeNodes(std::move(other.m_FreeNodes)),
+			m_DataSources(std::move(other.m_DataSources)), m_FreeDataBlocks(std::move(other.m_FreeDataBlocks)),
+			m_DataSourceLocations(std::move(other.m_DataSourceLocations)) {
+			other.m_RootNode = OCTREE_NULL_INDEX;
+		}
 
-					}
+		OctreeBounds& operator=(OctreeBounds&& other) noexcept {
+			if (this == &other)
+				return *this;
+
+			m_Config = other.m_Config;
+			m_JobSystem = other.m_JobSystem;
+			m_RootNode = other.m_RootNode;
+			m_Nodes = std::move(other.m_Nodes);
+			m_FreeNodes = std::move(other.m_FreeNodes);
+			m_DataSources = std::move(other.m_DataSources);
+			m_FreeDataBlocks = std::move(other.m_FreeDataBlocks);
+			m_DataSourceLocations = std::move(other.m_DataSourceLocations);
+			other.m_RootNode = OCTREE_NULL_INDEX;
+			return *this;
+		}
 
-					if(m_ChildrenNodes[i])
-						child_data_start += m_ChildrenNodes[i]->TotalCount();
-				}
+		/// <summary>
+		/// This will attempt to insert a data source into the Octree, growing
+		/// the root node if the data source is outside of the Octree.
+		/// 
+		/// If the data is already within the Octree, its bounds will be updated.
+		/// </summary>
+		bool Insert(const OctreeData& data_source) {
 
-				// 6. Fourth Insert Check: If the data_source could not be inserted into a child
-				// or for some reason there was an error, we will just insert into this node.
+			if (m_DataSourceLocations.contains(data_source.Data))
+				return Update(data_source.Data, data_source.Bounds);
 
-				InsertDataToNode(data);
-				return true;
+			return InsertDataSource(data_source);
+		}
+
+		/// <summary>
+		/// This will attempt to insert a data source into the Octree.
+		/// </summary>
+		bool Insert(const DataType& data, const Bounds_AABB& bounds) override {
+			return Insert(OctreeData(data, bounds));
+		}
+
+		/// <summary>
+		/// This will attempt to insert an entire vector of data source 
+		/// to the Octree.
+		/// </summary>
+		/// <returns>
+		/// If anything is returned, these are the data sources
+		/// that could not be inserted into the Octree. Deal with these
+		/// remaining data sources as you see fit.
+		/// </returns>
+		std::vector<OctreeData> InsertVector(const std::vector<OctreeData>& data_sources) {
+
+			// These are data sources that are out of bounds
+			std::vector<OctreeData> remaining_data_sources{};
+
+			for (const auto& data : data_sources) {
+				if (!Insert(data))
+					remaining_data_sources.push_back(data);
 			}
 
-			/// <summary>
-			/// This will find the node that holds this data_position, and 
-			/// remove this data source from the Octree Storage, and update
-			/// the node size and all parent total node size.
-			/// </summary>
-			bool Remove(size_t data_position) {
+			return remaining_data_sources;
+		}
 
-				// 1. Check if data position out of TOTAL node data bounds
-				size_t end = m_TotalNodeDataSourceSize > 0 ? m_DataSourceIndex + m_TotalNodeDataSourceSize - 1 : m_DataSourceIndex;
-				if (data_position < m_DataSourceIndex || data_position > end || m_TotalNodeDataSourceSize == 0)
-					return false;
+		/// <summary>
+		/// This will attempt to remove the data source from the Octree.
+		/// </summary>
+		bool Remove(const DataType& data) override {
 
-				// 2. Check if data position out of CURRENT node data bounds, we need to check children
-				end = m_DataSourceSize > 0 ? m_DataSourceIndex + m_DataSourceSize - 1 : 0;
-				if (data_position > end || m_DataSourceSize == 0) {
+			if (m_RootNode == OCTREE_NULL_INDEX)
+				return false;
 
-					for (int i = 0; i < m_ChildrenNodes.size(); i++) {
-						if (m_ChildrenNodes[i]) {
-							if (m_ChildrenNodes[i]->Remove(data_position)) {
-								m_TotalNodeDataSourceSize--;
-								return true;
-							}
-						}
-					}
+			auto it = m_DataSourceLocations.find(data);
+			if (it == m_DataSourceLocations.end()) {
+				L_CORE_WARN("Octree - Data Not Found in Data Sources.");
+				return false;
+			}
 
-					L_CORE_WARN("Octree - Data Misalignment: Data Source Could Not Be Removed From Children.");
-					return false; // If this could not be removed from children, what the heck has happened here?
-				}
+			OctreeDataLocation location = it->second;
+			RemoveDataFromNode(location.NodeIndex, location.DataIndex);
+			return true;
+		}
 
-				if (!m_Octree)
-					return false;
+		/// <summary>
+		/// This will update a data source within the current Octree. If the new bounds
+		/// still fit within the loose bounds of its current node, the data source is 
+		/// updated in place. Otherwise it is removed from its node and reinserted from 
+		/// the closest parent node that contains the new bounds.
+		/// 
+		/// If the data source is not within the current Octree, it will just insert
+		/// it into the Octree.
+		/// </summary>
+		bool Update(const DataType& data, const Bounds_AABB& bounds) override {
 
-				m_Octree->m_DataSources.erase(m_Octree->m_DataSources.begin() + data_position);
-				
-				if (m_DataSourceSize > 0)
-					m_DataSourceSize--;
-				
-				if (m_TotalNodeDataSourceSize > 0) 
-					m_TotalNodeDataSourceSize--;
-				
+			if (m_RootNode == OCTREE_NULL_INDEX)
+				return false;
+
+			auto it = m_DataSourceLocations.find(data);
+			if (it == m_DataSourceLocations.end())
+				return InsertDataSource(OctreeData(data, bounds));
+
+			OctreeDataLocation location = it->second;
+
+			// 1. Small move, we still fit within our current node so just update the bounds
+			if (m_Nodes[location.NodeIndex].NodeBounds.Contains(bounds, m_Config.Looseness) == BoundsContainResult::Contains) {
+				m_DataSources[location.DataIndex].Bounds = bounds;
 				return true;
 			}
 
-			/// <summary>
-			/// Query a particular region and return a result.
-			/// </summary>
-			void Query(const Bounds_AABB& query_bounds, std::vector<OctreeData>& result, bool& should_delete_node) {
+			// 2. Find the closest parent node which still contains the new bounds
+			uint32_t parent_index = m_Nodes[location.NodeIndex].ParentNode;
+			while (parent_index != OCTREE_NULL_INDEX && m_Nodes[parent_index].NodeBounds.Contains(bounds, m_Config.Looseness) != BoundsContainResult::Contains)
+				parent_index = m_Nodes[parent_index].ParentNode;
 
-				// If there are no data sources in itself or children 
-				// why bother testing this node?
-				if (TotalCount() == 0) {
-					should_delete_node = CheckShouldDeleteNode();
-					return;
-				}
+			RemoveDataFromNode(location.NodeIndex, location.DataIndex);
 
-				switch (query_bounds.Contains(m_NodeBounds)) {
+			// 3. Nothing contains the new bounds, insert from the root so the Octree can grow
+			if (parent_index == OCTREE_NULL_INDEX)
+				return InsertDataSource(OctreeData(data, bounds));
 
-				case BoundsContainResult::Contains: {
+			// 4. Reinsert from the parent node, and increment the totals of the 
+			// nodes above it as the insert only accounts for the parent downwards
+			InsertIntoNode(parent_index, OctreeData(data, bounds), true);
+			for (uint32_t node_index = m_Nodes[parent_index].ParentNode; node_index != OCTREE_NULL_INDEX; node_index = m_Nodes[node_index].ParentNode)
+				m_Nodes[node_index].TotalNodeDataSourceSize++;
 
-					// Mmmm grab all of our contiguous data in one fell swoop, yummy
-					result.insert(
-						result.end(),
-						m_Octree->m_DataSources.begin() + m_DataSourceIndex,
-						m_Octree->m_DataSources.begin() + m_DataSourceIndex + TotalCount()
-					);
-					break;
-				}
+			return true;
+		}
 
-				case BoundsContainResult::Intersects: {
+		/// <summary>
+		/// This will tell us if the data is within the Octree.
+		/// </summary>
+		bool HasDataSource(const DataType& data) const override {
+			return m_DataSourceLocations.contains(data);
+		}
 
-					// Test intersection of each data source pertaining to this node
-					for (int i = 0; i < m_DataSourceSize; i++) {
-						try {
-							const auto& data = m_Octree->m_DataSources.at(m_DataSourceIndex + i);
-							if (query_bounds.Contains(data->Bounds) != BoundsContainResult::DoesNotContain)
-								result.push_back(data);
-						}
-						catch (const std::out_of_range& ex) {
-							L_CORE_ERROR("Octree Query - Data Out of Range Could Not Test Intersection.");
-							L_CORE_ERROR(ex.what());
-						}
-					}
+		/// <summary>
+		/// Query the octree for all data sources that intersect the bounds, writing 
+		/// them into the caller owned result vector. The result is cleared first.
+		/// 
+		/// Queries do not modify the Octree, so any number of threads may query at 
+		/// once while holding a std::shared_lock on GetOctreeMutex().
+		/// </summary>
+		/// <param name="bounds">Bounds AABB Range to Query</param>
+		/// <param name="result">Caller owned output, reuse it between frames to avoid reallocating</param>
+		void Query(const Bounds_AABB& bounds, std::vector<OctreeData>& result) const override {
+			QueryOctree(bounds, result);
+		}
 
-					// If Node is not split, just break
-					if (!IsNodeSplit())
-						break;
+		/// <summary>
+		/// Query the octree for all data sources that intersect the sphere, writing 
+		/// them into the caller owned result vector. The result is cleared first.
+		/// 
+		/// Queries do not modify the Octree, so any number of threads may query at 
+		/// once while holding a std::shared_lock on GetOctreeMutex().
+		/// </summary>
+		/// <param name="bounds">Bounds Sphere Range to Query</param>
+		/// <param name="result">Caller owned output, reuse it between frames to avoid reallocating</param>
+		void Query(const Bounds_Sphere& bounds, std::vector<OctreeData>& result) const override {
+			QueryOctree(bounds, result);
+		}
 
-					// Query children
-					for (int i = 0; i < m_ChildrenNodes.size(); i++) {
-
-						if (m_ChildrenNodes[i])
-						{
-							bool should_delete = false;
-							m_ChildrenNodes[i]->Query(query_bounds, result, should_delete);
-							if (should_delete && !m_ChildrenNodes[i]->IsRootNode()) {
-								m_ChildrenNodes[i]->Clear();
-								m_ChildrenNodes[i].reset();
-								m_ChildrenNodes[i] = nullptr;
-							}
-						}
+		/// <summary>
+		/// Query the octree for all data sources that intersect the frustum, writing 
+		/// them into the caller owned result vector. The result is cleared first.
+		/// 
+		/// Queries do not modify the Octree, so any number of threads may query at 
+		/// once while holding a std::shared_lock on GetOctreeMutex().
+		/// </summary>
+		/// <param name="frustum">Camera Frustum to Query</param>
+		/// <param name="result">Caller owned output, reuse it between frames to avoid reallocating</param>
+		void Query(const Frustum& frustum, std::vector<OctreeData>& result) const override {
+			QueryOctree(frustum, result);
+		}
 
-					}
+		/// <summary>
+		/// Query the octree for many views in a single traversal. Each node is 
+		/// tested once against every view that still overlaps it, frustum planes 
+		/// a node is entirely inside of are not tested again for its children, 
+		/// and views that contain a node take its data sources without testing.
+		/// 
+		/// results is resized to match volumes, results[i] is the same set of data 
+		/// sources Query(volumes[i]) would return. Hold a std::shared_lock on 
+		/// GetOctreeMutex() while querying.
+		/// </summary>
+		/// <param name="volumes">Views to Query</param>
+		/// <param name="results">Caller owned output, one list per view</param>
+		void Query(const std::vector<OctreeQueryVolume>& volumes, std::vector<std::vector<OctreeData>>& results) const override {
 
-					break;
-				}
+			results.resize(volumes.size());
+			for (auto& result : results)
+				result.clear();
 
-				}
+			if (m_RootNode == OCTREE_NULL_INDEX || IsEmpty())
+				return;
+
+			// Views are tracked in a 64 bit mask, so larger batches are walked in chunks of 64
+			for (size_t first_view = 0; first_view < volumes.size(); first_view += 64) {
+
+				size_t view_count = glm::min<size_t>(volumes.size() - first_view, 64);
+
+				OctreeBatchState state{};
+				state.ActiveViews = view_count == 64 ? ~0ull : (1ull << view_count) - 1;
+				state.PlaneMasks.fill(0x3F);
+
+				// Classify the root here, every other node is classified by its parent
+				const Bounds_AABB root_bounds = m_Nodes[m_RootNode].NodeBounds * m_Config.Looseness;
+
+				OctreeBatchState root_state;
+				ClassifyBatchNodes(volumes.data() + first_view, state, &root_bounds, 1, &root_state);
+
+				if (root_state.ActiveViews != 0 || root_state.ContainedViews != 0)
+					QueryBatchNode(m_RootNode, volumes.data() + first_view, results.data() + first_view, root_state);
 			}
+		}
 
-			/// <summary>
-			/// Query a particular region and return a result.
-			/// </summary>
-			void Query(const Bounds_Sphere& query_bounds, std::vector<OctreeData>& result, bool& should_delete_node) {
+		/// <summary>
+		/// Find the nearest data source hit by the ray. Nodes are walked front to back 
+		/// and anything further than the nearest hit so far is skipped. Hold a 
+		/// std::shared_lock on GetOctreeMutex() while querying.
+		/// </summary>
+		/// <param name="ray">Ray to Query</param>
+		/// <param name="max_distance">Hits further along the ray than this are ignored</param>
+		/// <param name="hit">The nearest hit, only written if something was hit</param>
+		/// <param name="filter">Optional narrow phase, see OctreeRayFilter</param>
+		/// <returns>True if a data source was hit.</returns>
+		bool Raycast(const Bounds_Ray& ray, float max_distance, OctreeRayHit& hit, const OctreeRayFilter& filter = {}) const override {
+
+			if (m_RootNode == OCTREE_NULL_INDEX || IsEmpty())
+				return false;
+
+			float root_distance = 0.0f;
+			if (!ray.Intersects(m_Nodes[m_RootNode].NodeBounds * m_Config.Looseness, max_distance, root_distance))
+				return false;
+
+			OctreeRayHit nearest_hit{};
+
+			RaycastNode(m_RootNode, ray, root_distance, max_distance, &nearest_hit, nullptr, filter);
+
+			if (nearest_hit.Distance == FLT_MAX)
+				return false;
+
+			hit = nearest_hit;
+			return true;
+		}
+
+		/// <summary>
+		/// Find every data source hit by the ray, sorted nearest first. The result is 
+		/// cleared first. Hold a std::shared_lock on GetOctreeMutex() while querying.
+		/// </summary>
+		/// <param name="ray">Ray to Query</param>
+		/// <param name="max_distance">Hits further along the ray than this are ignored</param>
+		/// <param name="hits">Caller owned output, reuse it between queries to avoid reallocating</param>
+		/// <param name="filter">Optional narrow phase, see OctreeRayFilter</param>
+		void RaycastAll(const Bounds_Ray& ray, float max_distance, std::vector<OctreeRayHit>& hits, const OctreeRayFilter& filter = {}) const override {
+
+			hits.clear();
+
+			if (m_RootNode == OCTREE_NULL_INDEX || IsEmpty())
+				return;
+
+			float root_distance = 0.0f;
+			if (!ray.Intersects(m_Nodes[m_RootNode].NodeBounds * m_Config.Looseness, max_distance, root_distance))
+				return;
+
+			RaycastNode(m_RootNode, ray, root_distance, max_distance, nullptr, &hits, filter);
+
+			std::sort(hits.begin(), hits.end(), [](const OctreeRayHit& a, const OctreeRayHit& b) { return a.Distance < b.Distance; });
+		}
+
+		/// <summary>
+		/// This will rebuild the octree with all its current data sources.
+		/// </summary>
+		void RebuildOctree() {
+			std::unique_lock lock(m_OctreeMutex);
+			BuildOctree();
+		}
+
+		/// <summary>
+		/// This will rebuild the octree with all its current data sources, 
+		/// but with a new configuration for the Octree.
+		/// </summary>
+		void RebuildOctree(const OctreeBoundsConfig& new_config) {
+			std::unique_lock lock(m_OctreeMutex);
+			m_Config = new_config;
+			BuildOctree();
+		}
+
+		/// <summary>
+		/// This will return the data sources contained ONLY in the root node.
+		/// </summary>
+		/// <returns></returns>
+		size_t Count() const { 
+			return m_RootNode != OCTREE_NULL_INDEX ? m_Nodes[m_RootNode].DataSourceSize : 0;
+		}
+
+		/// <summary>
+		/// This will return the 'lazy' approach count which tracks the
+		/// total count of its data sources and sub nodes data sources.
+		/// </summary>
+		size_t TotalCount() const override {
+			return m_RootNode != OCTREE_NULL_INDEX ? m_Nodes[m_RootNode].TotalNodeDataSourceSize : 0;
+		}
+
+		/// <summary>
+		/// This will force a manual recursive count of all the Octree's node
+		/// data sources to ensure accuracy.
+		/// </summary>
+		size_t ForceTotalCount() {
+			return m_RootNode != OCTREE_NULL_INDEX ? ForceNodeTotalCount(m_RootNode) : 0;
+		}
+
+		/// <summary>
+		/// This will clear all nodes and data sources, leaving an empty root 
+		/// node with the same bounds. The arenas keep their capacity.
+		/// </summary>
+		void Clear() { 
+
+			if (m_RootNode == OCTREE_NULL_INDEX)
+				return;
+
+			Bounds_AABB root_bounds = m_Nodes[m_RootNode].NodeBounds;
+
+			m_Nodes.clear();
+			m_FreeNodes.clear();
+			m_DataSources.clear();
+			for (auto& free_blocks : m_FreeDataBlocks)
+				free_blocks.clear();
+			m_DataSourceLocations.clear();
+
+			m_RootNode = AllocateNode(root_bounds, OCTREE_NULL_INDEX);
+		}
+
+		bool IsEmpty() const override { 
+			return TotalCount() == 0; 
+		}
+
+		/// <summary>
+		/// This will get the node bounds of the root node, this is the 
+		/// entire region the Octree currently covers.
+		/// </summary>
+		Bounds_AABB GetRootNodeBounds() const {
+			return m_RootNode != OCTREE_NULL_INDEX ? m_Nodes[m_RootNode].NodeBounds : Bounds_AABB{};
+		}
+
+		/// <summary>
+		/// Calling this function will try to shrink the Root Node if there is 
+		/// only one octant which contains data.
+		/// </summary>
+		void TryShrinkOctree() {
+
+			uint32_t node_index = ShrinkOctree();
+			if (node_index == OCTREE_NULL_INDEX || node_index == m_RootNode)
+				return;
+
+			// Detach the new root so it is not released with the old root's empty nodes
+			uint32_t old_root_node = m_RootNode;
+			for (auto& child_index : m_Nodes[old_root_node].ChildrenNodes) {
+				if (child_index == node_index)
+					child_index = OCTREE_NULL_INDEX;
+			}
+
+			m_Nodes[node_index].ParentNode = OCTREE_NULL_INDEX;
+			m_RootNode = node_index;
+			FreeNode(old_root_node);
+		}
+
+		void SetConfig(const OctreeBoundsConfig& config) { m_Config = config; }
+		const OctreeBoundsConfig& GetConfig() const { return m_Config; }
+
+		/// <summary>
+		/// Walks the Octree and frees child nodes that have been empty for longer 
+		/// than their LifeMax. This is the only place empty nodes are released, 
+		/// call it from the thread that updates the Octree.
+		/// </summary>
+		void PruneEmptyNodes() {
+			if (m_RootNode != OCTREE_NULL_INDEX)
+				PruneNode(m_RootNode);
+		}
+
+		/// <summary>
+		/// Reader/writer lock for the octree. Take a std::unique_lock when 
+		/// inserting, removing or updating, and a std::shared_lock to Query.
+		/// </summary>
+		std::shared_mutex& GetOctreeMutex() { return m_OctreeMutex; }
+		std::shared_mutex& GetMutex() override { return m_OctreeMutex; }
+
+		SpatialIndexType GetType() const override { return SpatialIndexType::Octree; }
+
+		/// <summary>
+		/// Prune nodes that have been empty for too long, then try to shrink the root.
+		/// </summary>
+		void PerformMaintenance() override {
+			PruneEmptyNodes();
+			TryShrinkOctree();
+		}
+
+		std::vector<OctreeData> GetAllDataSources() const override { return GetAllOctreeDataSources(); }
+		std::vector<glm::mat4> GetAllBoundsMat4() const override { return GetAllOctreeBoundsMat4(); }
+
+		std::shared_ptr<SpatialIndex<DataType>> Clone(const std::function<DataType(const DataType&)>& remap = {}) const override {
 
-				// If there are no data sources in itself or children 
-				// why bother testing this node?
-				if (TotalCount() == 0) {
-					should_delete_node = CheckShouldDeleteNode();
-					return;
-				}
+			std::shared_ptr<OctreeBounds<DataType>> clone = std::make_shared<OctreeBounds<DataType>>(*this);
+			if (!remap)
+				return clone;
 
-				switch (query_bounds.Contains(m_NodeBounds)) {
+			// Free blocks in the arena are remapped too, they are overwritten before they are read
+			for (OctreeData& data_source : clone->m_DataSources)
+				data_source.Data = remap(data_source.Data);
 
-				case BoundsContainResult::Contains: {
+			clone->m_DataSourceLocations.clear();
+			clone->m_DataSourceLocations.reserve(m_DataSourceLocations.size());
+			for (const auto& [data, location] : m_DataSourceLocations)
+				clone->m_DataSourceLocations.emplace(remap(data), location);
 
-					// Mmmm grab all of our contiguous data in one fell swoop, yummy
-					result.insert(
-						result.end(),
-						m_Octree->m_DataSources.begin() + m_DataSourceIndex,
-						m_Octree->m_DataSources.begin() + m_DataSourceIndex + TotalCount()
-					);
-					break;
-				}
+			return clone;
+		}
 
-				case BoundsContainResult::Intersects: {
+		/// <summary>
+		/// This will return a copy of all data sources within the Octree.
+		/// </summary>
+		std::vector<OctreeData> GetAllOctreeDataSources() const {
+			std::vector<OctreeData> data_sources;
+			data_sources.reserve(TotalCount());
+			if (m_RootNode != OCTREE_NULL_INDEX)
+				GatherNodeData(m_RootNode, data_sources);
+			return data_sources;
+		}
 
-					// Test intersection of each data source pertaining to this node
-					for (int i = 0; i < m_DataSourceSize; i++) {
-						try {
-							const auto& data = m_Octree->m_DataSources.at(m_DataSourceIndex + i);
-							if (data && query_bounds.Contains(data->Bounds) != BoundsContainResult::DoesNotContain)
-								result.push_back(data);
-						}
-						catch (const std::out_of_range& ex) {
-							L_CORE_ERROR("Octree Query - Data Out of Range Could Not Test Intersection.");
-							L_CORE_ERROR(ex.what());
-						}
-					}
+		/// <summary>
+		/// This will return a vector of AABB bounds of the entire Octree's node's recursively.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<Bounds_AABB> GetAllOctreeBounds() const {
+			std::vector<Bounds_AABB> bounds_vector;
+			if (m_RootNode != OCTREE_NULL_INDEX)
+				GatherNodeBounds(m_RootNode, bounds_vector);
+			return bounds_vector;
+		}
 
-					// If Node is not split, just break
-					if (!IsNodeSplit())
-						break;
+		/// <summary>
+		/// This will return a vector of glm::mat4 matricies of the entire Octree's node bounds recursively.
+		/// </summary>
+		std::vector<glm::mat4> GetAllOctreeBoundsMat4() const {
+			std::vector<Bounds_AABB> bounds_vector = GetAllOctreeBounds();
 
-					// Query children
-					for (int i = 0; i < m_ChildrenNodes.size(); i++) {
-
-						if (m_ChildrenNodes[i])
-						{
-							bool should_delete = false;
-							m_ChildrenNodes[i]->Query(query_bounds, result, should_delete);
-							if (should_delete && !m_ChildrenNodes[i]->IsRootNode()) {
-								m_ChildrenNodes[i]->Clear();
-								m_ChildrenNodes[i].reset();
-								m_ChildrenNodes[i] = nullptr;
-							}
-						}
+			std::vector<glm::mat4> transforms_vector;
+			transforms_vector.reserve(bounds_vector.size());
+			for (const auto& bounds : bounds_vector)
+				transforms_vector.push_back(bounds.GetGlobalBoundsMat4());
+			return transforms_vector;
+		}
 
-					}
+	private:
 
-					break;
-				}
+		/// <summary>
+		/// This will insert a data source that is not yet within the Octree, 
+		/// growing the root node if the data source is outside of the Octree.
+		/// </summary>
+		bool InsertDataSource(const OctreeData& data_source) {
 
-				}
+			if (m_RootNode == OCTREE_NULL_INDEX) {
+				L_CORE_ERROR("Octree - Root Node Invalid or Octree Not Built - Cannot Insert Data Source.");
+				return false;
 			}
 
-			/// <summary>
-			/// Query a particular region and return a result.
-			/// </summary>
-			void Query(const Frustum& frustum, std::vector<OctreeData>& result, bool& should_delete_node) {
+			int octree_growth_attempts = 0;
+			const int max_attempts = 20; // We are expanding to infinity if we even get close to this number....
 
-				// If there are no data sources in itself or children 
-				// why bother testing this node?
-				if (TotalCount() == 0) {
-					should_delete_node = CheckShouldDeleteNode();
-					return;
+			uint32_t old_root_node_for_if_fail = m_RootNode;
+			while (!InsertIntoNode(m_RootNode, data_source, false)) {
+
+				if (octree_growth_attempts < max_attempts) {
+					GrowOctree(data_source.Bounds.Center() - m_Nodes[m_RootNode].NodeBounds.Center());
 				}
-				
-				switch (frustum.Contains(m_NodeBounds * m_Octree->m_Config.Looseness)) {
-
-					case FrustumContainResult::Contains: {
-						
-						// Mmmm grab all of our contiguous data in one fell swoop, yummy
-						result.insert(
-							result.end(),
-							m_Octree->m_DataSources.begin() + m_DataSourceIndex,
-							m_Octree->m_DataSources.begin() + m_DataSourceIndex + TotalCount()
-						);
-						break;
-					}
+				else {
+					L_CORE_WARN("Octree - Could Not Grow the Octree to Fit Data Source.");
 
-					case FrustumContainResult::Intersects: {
+					// Unwind the grown root nodes, each of these only holds the previous root as a child
+					while (m_RootNode != old_root_node_for_if_fail) {
 
-						// Test intersection of each data source pertaining to this node
-						for (int i = 0; i < m_DataSourceSize; i++) {
-							try {
-								const auto& data = m_Octree->m_DataSources.at(m_DataSourceIndex + i);
-								if (frustum.Contains(data->Bounds) != FrustumContainResult::DoesNotContain)
-									result.push_back(data);
-							}
-							catch (const std::out_of_range& ex) {
-								L_CORE_ERROR("Octree Query - Data Out of Range Could Not Test Intersection.");
-								L_CORE_ERROR(ex.what());
+						uint32_t grown_root_node = m_RootNode;
+						for (uint32_t child_index : m_Nodes[grown_root_node].ChildrenNodes) {
+							if (child_index != OCTREE_NULL_INDEX) {
+								m_RootNode = child_index;
+								break;
 							}
 						}
 
-						// If Node is not split, just break
-						if (!IsNodeSplit())
-							break;
+						m_Nodes[grown_root_node].ChildrenNodes.fill(OCTREE_NULL_INDEX);
+						m_Nodes[m_RootNode].ParentNode = OCTREE_NULL_INDEX;
+						FreeNode(grown_root_node);
+					}
+					return false;
+				}
 
-						// Query children
-						for (int i = 0; i < m_ChildrenNodes.size(); i++) {
-
-							if (m_ChildrenNodes[i])
-							{
-								bool should_delete = false;
-								m_ChildrenNodes[i]->Query(frustum, result, should_delete);
-								if (should_delete) {
-									m_ChildrenNodes[i].reset();
-									m_ChildrenNodes[i] = nullptr;
-								}
-							}
+				octree_growth_attempts++;
+			}
 
-						}
+			return true;
+		}
 
-						break;
-					}
+#pragma region Node Operations
+
+		/// <summary>
+		/// This will attempt to insert a data source within the given node or
+		/// one of its children.
+		/// </summary>
+		bool InsertIntoNode(uint32_t node_index, const OctreeData& data, bool already_checked_contains) {
 
+			// 1. Have we already checked if this node contains the data source?
+			if (!already_checked_contains) {
+				// No we haven't so we will perform the check now!
+				if (m_Nodes[node_index].NodeBounds.Contains(data.Bounds, m_Config.Looseness) != BoundsContainResult::Contains) {
+					// The data does not fit in the current node, return it to the caller :'( OR :D ... depends what node you're in ;)
+					return false;
 				}
 			}
 
-			/// <summary>
-			/// This should be called any time we make any changes 
-			/// to the Octree Data Storage to ensure all nodes point
-			/// to the valid index of where their data starts.
-			/// </summary>
-			void RevalidateNodes(size_t start_index) {
+			// 2. First Insert Check: check if the current node has less than the suggested max data_sources
+			// or pass this check if the node has already been split.
+			if (static_cast<int>(m_Nodes[node_index].DataSourceSize) < m_Config.PreferredDataSourceLimit && !m_Nodes[node_index].IsNodeSplit) {
+				InsertDataToNode(node_index, data);
+				return true;
+			}
 
-				L_CORE_ASSERT(start_index + m_DataSourceSize <= m_Octree->m_DataSources.size(), "Octree - Index Out Of Bounds!");
+			// 3. Second Insert Check: are we able to split the node? 
 
-				m_DataSourceIndex = start_index;
+			// If the children nodes will be smaller than the defined minimum size, we 
+			// will simply add to this node and return true.
+			glm::vec3 child_bounds_size = m_Nodes[node_index].NodeBounds.Size() * 0.5f;
+			if (child_bounds_size.x < m_Config.MinNodeSize || child_bounds_size.y < m_Config.MinNodeSize || child_bounds_size.z < m_Config.MinNodeSize) {
+				InsertDataToNode(node_index, data);
+				return true;
+			}
 
-				if (!IsNodeSplit()) {
-					return;
-				}
+			// Split the node as we should not place into the current node YET
+			if (!m_Nodes[node_index].IsNodeSplit)
+				SplitNode(node_index);
 
-				start_index += m_DataSourceSize;
+			// 4. Third Insert Check: Attempt insert into child node
+			for (int i = 0; i < 8; i++) {
 
-				for (int i = 0; i < m_ChildrenNodes.size(); i++) {
-					if (!m_ChildrenNodes[i])
-						continue;
+				if (CalculateChildBounds(m_Nodes[node_index].NodeBounds, i).Contains(data.Bounds, m_Config.Looseness) == BoundsContainResult::Contains) {
 
-					m_ChildrenNodes[i]->RevalidateNodes(start_index);
-					start_index += m_ChildrenNodes[i]->TotalCount();
+					uint32_t child_index = GetOrCreateChildNode(node_index, i);
+					if (InsertIntoNode(child_index, data, true)) {
+						m_Nodes[node_index].TotalNodeDataSourceSize++;
+						return true;
+					}
+					break;
 				}
-
-				m_TotalNodeDataSourceSize = start_index - m_DataSourceIndex;
 			}
 
-			/// <summary>
-			/// Get count of node's data.
-			/// </summary>
-			/// <returns></returns>
-			const size_t& Count() const {
-				return m_DataSourceSize;
-			}
+			// 5. Fourth Insert Check: If the data_source could not be inserted into a child
+			// or for some reason there was an error, we will just insert into this node.
+			InsertDataToNode(node_index, data);
+			return true;
+		}
 
-			/// <summary>
-			/// Get count of node's data including children
-			/// data sources.
-			/// </summary>
-			size_t TotalCount() const {
-				return m_TotalNodeDataSourceSize;
+		/// <summary>
+		/// This will actually insert the data into the node's block in the Octree 
+		/// Data Storage when we have determined if something fits inside this node.
+		/// </summary>
+		void InsertDataToNode(uint32_t node_index, const OctreeData& data) {
+
+			auto& node = m_Nodes[node_index];
+
+			if (node.LifeCount > 0 || node.TotalNodeDataSourceSize == 0) {
+				node.LifeCount = 0;
+				node.LifeMax = static_cast<uint8_t>(glm::min(node.LifeMax * 2, 64));
 			}
 
-			/// <summary>
-			/// Manual recursive approach to getting the true
-			/// size of self and all child nodes data count.
-			/// </summary>
-			size_t ForceTotalCount() {
+			// The block is full, move it to a block twice the size
+			if (node.DataSourceSize == node.DataSourceCapacity)
+				GrowDataBlock(node_index);
 
-				size_t count = m_DataSourceSize;
+			m_DataSources[node.DataSourceIndex + node.DataSourceSize] = data;
+			m_DataSourceLocations[data.Data] = { node_index, node.DataSourceIndex + node.DataSourceSize };
+			node.DataSourceSize++;
+			node.TotalNodeDataSourceSize++;
+		}
 
-				for (const auto& child_node : m_ChildrenNodes)
-					if (child_node)
-						count += child_node->ForceTotalCount();
+		/// <summary>
+		/// This will remove the data source at the data index from the node's block 
+		/// and update the total count of the node and all of its parents.
+		/// </summary>
+		void RemoveDataFromNode(uint32_t node_index, uint32_t data_index) {
 
-				m_TotalNodeDataSourceSize = count;
+			m_DataSourceLocations.erase(m_DataSources[data_index].Data);
+			RemoveDataFromBlock(node_index, data_index);
 
-				return count;
+			for (uint32_t parent_index = node_index; parent_index != OCTREE_NULL_INDEX; parent_index = m_Nodes[parent_index].ParentNode) {
+				if (m_Nodes[parent_index].TotalNodeDataSourceSize > 0)
+					m_Nodes[parent_index].TotalNodeDataSourceSize--;
 			}
+		}
 
-			/// <summary>
-			/// This will clear all data sources in this and all children nodes.
-			/// </summary>
-			void Clear() {
-				// Clear data sources
-				m_Octree->m_DataSources.erase(m_Octree->m_DataSources.begin() + m_DataSourceIndex, m_Octree->m_DataSources.begin() + m_DataSourceIndex + TotalCount());
-				m_DataSourceSize = 0;
-				m_TotalNodeDataSourceSize = 0;
-
-				// Recursively clear child nodes
-				for (auto& child_node : m_ChildrenNodes) {
-					if (child_node) {
-						child_node.reset();
-						child_node = nullptr;
-					}
-				}
+		/// <summary>
+		/// This will remove the data source at the data index from the node's block by
+		/// swapping it with the last data source of the block. This does not update the 
+		/// total count of the node or its parents, or remove the data from the index.
+		/// </summary>
+		void RemoveDataFromBlock(uint32_t node_index, uint32_t data_index) {
 
-				m_Octree->m_RootNode->RevalidateNodes(0);
+			auto& node = m_Nodes[node_index];
 
-				// Reset split status
-				m_IsNodeSplit = false;
+			L_CORE_ASSERT(data_index >= node.DataSourceIndex && data_index < node.DataSourceIndex + node.DataSourceSize, "Octree - Data Index Not Within Node!");
+
+			uint32_t last_index = node.DataSourceIndex + node.DataSourceSize - 1;
+			if (data_index != last_index) {
+				m_DataSources[data_index] = std::move(m_DataSources[last_index]);
+				m_DataSourceLocations[m_DataSources[data_index].Data].DataIndex = data_index;
 			}
+			m_DataSources[last_index] = OctreeData{};
 
-			/// <summary>
-			/// This will tell us if our node has been split into children.
-			/// </summary>
-			bool IsNodeSplit() const {
-				return m_IsNodeSplit;
+			node.DataSourceSize--;
+
+			if (node.DataSourceSize == 0) {
+				FreeDataBlock(node.DataSourceIndex, node.DataSourceCapacity);
+				node.DataSourceIndex = OCTREE_NULL_INDEX;
+				node.DataSourceCapacity = 0;
 			}
+		}
 
-			/// <summary>
-			/// This will tell us if we are in the root node or not.
-			/// </summary>
-			bool IsRootNode() const {
+		/// <summary>
+		/// This will split the node and distribute its data sources into
+		/// child nodes. Any data sources that do not fit in a child stay
+		/// in this node.
+		/// </summary>
+		void SplitNode(uint32_t node_index) {
 
-				if (!m_Octree) {
-					L_CORE_ERROR("Octree - Node Does Not Contain Valid Reference to Octree.");
-					return false;
-				}
+			m_Nodes[node_index].IsNodeSplit = true;
 
-				if (m_Octree->GetRootNode().get() == this)
-					return true;
-				return false;
-			}
+			uint32_t i = 0;
+			while (i < m_Nodes[node_index].DataSourceSize) {
 
-			/// <summary>
-			/// This assigns a child node to this parent node.
-			/// </summary>
-			bool SetChildNode(int index, OctreeNode node) {
-				if (index >= 8 || index < 0)
-					return false;
+				uint32_t data_index = m_Nodes[node_index].DataSourceIndex + i;
 
-				m_ChildrenNodes[index] = node;
-				m_TotalNodeDataSourceSize += node->m_TotalNodeDataSourceSize;
-				m_IsNodeSplit = true;
-				return true;
-			}
-			
-			/// <summary>
-			/// This finds which child node a particular point would fit in best.
-			/// </summary>
-			int BestFitChild(const glm::vec3& point) {
-				for (int i = 0; i < m_ChildrenBounds.size(); i++) {
-					if (m_ChildrenBounds[i].Contains(point) == BoundsContainResult::Contains)
-						return i;
+				int child = -1;
+				for (int c = 0; c < 8; c++) {
+					if (CalculateChildBounds(m_Nodes[node_index].NodeBounds, c).Contains(m_DataSources[data_index].Bounds, m_Config.Looseness) == BoundsContainResult::Contains) {
+						child = c;
+						break;
+					}
 				}
-				return -1; // Unsuccessful
-			}
-
-			/// <summary>
-			/// This will get the node bounds of the children directly relative to 
-			/// this node only, and not children of children.
-			/// </summary>
-			const std::array<Bounds_AABB, 8>& GetNodeChildBounds() const { return m_ChildrenBounds; }
 
-			/// <summary>
-			/// This will get the node bounds for this and all child nodes.
-			/// </summary>
-			std::vector<Bounds_AABB> GetRecursiveChildBounds() {
-				std::vector<Bounds_AABB> bounds_vector;
-				bounds_vector.push_back(GetNodeBounds());
-				
-				// Base case: if no children, return this nodes bounds
-				if (!IsNodeSplit()) {
-					return bounds_vector;
+				if (child == -1) {
+					i++;
+					continue;
 				}
 
-				// Recursively gather bounds from child nodes
-				for (const auto& child : m_ChildrenNodes) {
-					if (child) {
+				// Copy out as the child insert may reallocate the Octree Data Storage
+				OctreeData data = m_DataSources[data_index];
 
-						// Recursively call this on children
-						if(std::vector<Bounds_AABB> child_bounds_vector = child->GetRecursiveChildBounds(); !child_bounds_vector.empty()) {
-							bounds_vector.insert(bounds_vector.end(), child_bounds_vector.begin(), child_bounds_vector.end());
-						}
-					}
-				}
+				uint32_t child_index = GetOrCreateChildNode(node_index, child);
+				InsertDataToNode(child_index, data);
 
-				return bounds_vector;
+				// The data source has only moved within this node's subtree, so the total is unchanged. The 
+				// last data source is swapped into this slot, so we do not increment i
+				RemoveDataFromBlock(node_index, data_index);
 			}
+		}
 
-			/// <summary>
-			/// This will get the node bounds glm::mat4 for this and all child nodes.
-			/// </summary>
-			std::vector<glm::mat4> GetRecursiveChildBoundsMat4() {
-				std::vector<glm::mat4> transforms_vector;
-				transforms_vector.push_back(GetNodeBoundsMat4());
+		/// <summary>
+		/// This will return the child node at the child index, creating
+		/// the child node if it does not exist yet.
+		/// </summary>
+		uint32_t GetOrCreateChildNode(uint32_t node_index, int child) {
 
-				// Base case: if no children, return this nodes mat4
-				if (!IsNodeSplit()) {
-					return transforms_vector;
-				}
+			if (m_Nodes[node_index].ChildrenNodes[child] == OCTREE_NULL_INDEX) {
+				uint32_t child_index = AllocateNode(CalculateChildBounds(m_Nodes[node_index].NodeBounds, child), node_index);
+				m_Nodes[node_index].ChildrenNodes[child] = child_index;
+				m_Nodes[node_index].IsNodeSplit = true;
+			}
 
-				// Recursively gather transforms from child nodes
-				for (const auto& child : m_ChildrenNodes) {
-					if (child) {
+			return m_Nodes[node_index].ChildrenNodes[child];
+		}
 
-						// Recursively call this on children
-						if (std::vector<glm::mat4> child_transforms_vector = child->GetRecursiveChildBoundsMat4(); !child_transforms_vector.empty()) {
-							transforms_vector.insert(transforms_vector.end(), child_transforms_vector.begin(), child_transforms_vector.end());
-						}
+		/// <summary>
+		/// Query the Octree from the root node into the result vector.
+		/// </summary>
+		template <typename QueryType>
+		void QueryOctree(const QueryType& query, std::vector<OctreeData>& result) const {
 
-					}
-				}
+			result.clear();
 
-				return transforms_vector;
-			}
+			if (m_RootNode == OCTREE_NULL_INDEX || IsEmpty())
+				return;
 
-			/// <summary>
-			/// This will get the node bounds for this node only.
-			/// </summary>
-			const Bounds_AABB& GetNodeBounds() { return m_NodeBounds; }
+			const Bounds_AABB root_bounds = m_Nodes[m_RootNode].NodeBounds * m_Config.Looseness;
 
-			/// <summary>
-			/// This will get the node bounds glm::mat4 for this node only.
-			/// </summary>
-			const glm::mat4& GetNodeBoundsMat4() { return m_NodeMat4; }
+			BoundsContainResult root_result;
+			SpatialIndexTests::TestBounds(query, &root_bounds, 1, &root_result);
 
-		private:
+			QueryNode(m_RootNode, query, result, root_result);
+		}
 
-			/// <summary>
-			/// This will split the node and distribute it's children into
-			/// child nodes.
-			/// </summary>
-			void SplitNode() {
+		/// <summary>
+		/// Query a particular region and return a result. Nodes are tested
+		/// against their loose bounds as data sources may extend past the 
+		/// actual node bounds by the looseness of the Octree. The node has 
+		/// already been tested by its parent, node_result is that result.
+		/// </summary>
+		template <typename QueryType>
+		void QueryNode(uint32_t node_index, const QueryType& query, std::vector<OctreeData>& result, BoundsContainResult node_result) const {
+
+			const auto& node = m_Nodes[node_index];
 
-				if (m_DataSourceSize == 0)
-					return;
+			switch (node_result) {
 
-				std::vector<OctreeData> data_sources{};
-				data_sources.reserve(m_DataSourceSize);
+				case BoundsContainResult::Contains: {
 
-				// Move from global Octree and put into temporary storage to distribute data_sources
-				data_sources.insert(data_sources.begin(), m_Octree->m_DataSources.begin() + m_DataSourceIndex, m_Octree->m_DataSources.begin() + m_DataSourceIndex + m_DataSourceSize);
-				m_Octree->m_DataSources.erase(m_Octree->m_DataSources.begin() + m_DataSourceIndex, m_Octree->m_DataSources.begin() + m_DataSourceIndex + m_DataSourceSize);
+					// Mmmm grab all of our data in one fell swoop, yummy
+					GatherNodeData(node_index, result);
+					break;
+				}
 
-				m_DataSourceSize = 0;
+				case BoundsContainResult::Intersects: {
 
-				size_t child_data_start = m_DataSourceIndex;
+					std::array<Bounds_AABB, OCTREE_TEST_BATCH_SIZE> batch_bounds;
+					std::array<BoundsContainResult, OCTREE_TEST_BATCH_SIZE> batch_results;
 
-				// Iterate through m_ChildrenBounds and see if can be placed in different children
-				for (int i = 0; i < m_ChildrenBounds.size(); i++) {
+					// Test intersection of each data source pertaining to this node, a batch at a time
+					for (uint32_t first = 0; first < node.DataSourceSize; first += OCTREE_TEST_BATCH_SIZE) {
 
-					auto it = data_sources.begin();
-					while (it != data_sources.end()) {
+						uint32_t batch_count = glm::min(node.DataSourceSize - first, OCTREE_TEST_BATCH_SIZE);
+						for (uint32_t i = 0; i < batch_count; i++)
+							batch_bounds[i] = m_DataSources[node.DataSourceIndex + first + i].Bounds;
 
-						if (m_ChildrenBounds[i].Contains((*it)->Bounds, m_Octree->m_Config.Looseness) == BoundsContainResult::Contains) {
+						SpatialIndexTests::TestBounds(query, batch_bounds.data(), batch_count, batch_results.data());
 
-							if (!m_ChildrenNodes[i]) {
-								m_ChildrenNodes[i] = std::make_shared<OctreeBoundsNode<DataType>>(m_ChildrenBounds[i], m_Octree);
-								m_ChildrenNodes[i]->m_DataSourceIndex = child_data_start;
-								m_IsNodeSplit = true;
-							}
-							m_ChildrenNodes[i]->m_DataSourceSize++;
-							m_ChildrenNodes[i]->m_TotalNodeDataSourceSize++;
+						for (uint32_t i = 0; i < batch_count; i++) {
+							if (batch_results[i] != BoundsContainResult::DoesNotContain)
+								result.push_back(m_DataSources[node.DataSourceIndex + first + i]);
+						}
+					}
 
-							m_Octree->m_DataSources.insert(m_Octree->m_DataSources.begin() + child_data_start, *it);
-							child_data_start++;
+					// If Node is not split, just break
+					if (!node.IsNodeSplit)
+						break;
 
-							// Erase data from temporary vector, and ensure the while loop 
-							// iterator is no invalidated
-							it = data_sources.erase(it);
-							continue;
+					// Test every child that holds data in one batch, if there are no data 
+					// sources in a child or its children why bother testing it?
+					std::array<uint32_t, 8> child_nodes;
+					uint32_t child_count = 0;
+					for (uint32_t child_index : node.ChildrenNodes) {
+						if (child_index != OCTREE_NULL_INDEX && m_Nodes[child_index].TotalNodeDataSourceSize != 0) {
+							child_nodes[child_count] = child_index;
+							batch_bounds[child_count] = m_Nodes[child_index].NodeBounds * m_Config.Looseness;
+							child_count++;
 						}
-						++it; // Continue to next element
 					}
 
-				}
+					SpatialIndexTests::TestBounds(query, batch_bounds.data(), child_count, batch_results.data());
 
-				for (auto& data_source : data_sources) {
-					size_t insert_position = m_DataSourceIndex + m_DataSourceSize;
-					m_Octree->m_DataSources.insert(m_Octree->m_DataSources.begin() + insert_position, data_source);
-					m_DataSourceSize++;
-				}
+					for (uint32_t i = 0; i < child_count; i++)
+						QueryNode(child_nodes[i], query, result, batch_results[i]);
 
-				// Revalidate child node start positions
-				for (int i = 0; i < m_ChildrenNodes.size(); i++) {
-					if (m_ChildrenNodes[i]) {
-						m_ChildrenNodes[i]->m_DataSourceIndex += m_DataSourceSize;
-					}
+					break;
 				}
+
+				default: break;
 			}
+		}
 
-			/// <summary>
-			/// This checks if this node should be deleted by its parent 
-			/// during a query.
-			/// </summary>
-			bool CheckShouldDeleteNode() {
+		/// <summary>
+		/// Per view state passed down a batched query. ActiveViews still need 
+		/// testing, ContainedViews already contain the node and everything 
+		/// below it, and PlaneMasks holds the frustum planes left to test.
+		/// </summary>
+		struct OctreeBatchState {
+			uint64_t ActiveViews = 0;
+			uint64_t ContainedViews = 0;
+			std::array<uint8_t, 64> PlaneMasks{};
+		};
 
-				// Set a roof of 64 queries it can be empty for before deletion
-				if (m_LifeCount < 64)
-					m_LifeCount++;
+		/// <summary>
+		/// Classify up to OCTREE_TEST_BATCH_SIZE nodes against every view still active in 
+		/// the parent state, each node gets its own copy of the state with the result.
+		/// </summary>
+		void ClassifyBatchNodes(const OctreeQueryVolume* volumes, const OctreeBatchState& parent_state, const Bounds_AABB* bounds, uint32_t count, OctreeBatchState* states) const {
 
-				return (m_LifeCount > m_LifeMax);
-			}
+			for (uint32_t i = 0; i < count; i++)
+				states[i] = parent_state;
 
-			/// <summary>
-			/// This will actually insert the data into the Octree Data Storage
-			/// when we have determined if something fits inside this node.
-			/// </summary>
-			void InsertDataToNode(OctreeData data) {
+			std::array<BoundsContainResult, OCTREE_TEST_BATCH_SIZE> view_results;
+			std::array<uint8_t, OCTREE_TEST_BATCH_SIZE> view_plane_masks;
 
-				if (m_LifeCount > 0 || TotalCount() == 0) {
-					m_LifeCount = 0;
-					m_LifeMax = glm::min(m_LifeMax * 2, 64);
-				}
+			for (uint64_t views = parent_state.ActiveViews; views; views &= views - 1) {
 
-				// 1. Determine the insert location for the data source.
-				size_t insert_position = m_DataSourceIndex + m_DataSourceSize;
+				int view = std::countr_zero(views);
+				uint64_t view_bit = 1ull << view;
 
-				// 2. Insert the new data source into the specified location, the global vector
-				// has already checked if there is enough room to insert, and allocated sufficient
-				// so storage we are safe to raw dog the insertion.
-				m_Octree->m_DataSources.insert(m_Octree->m_DataSources.begin() + insert_position, data);
+				SpatialIndexTests::TestVolume(volumes[view], bounds, count, parent_state.PlaneMasks[view], view_results.data(), view_plane_masks.data());
 
-				// 3. Increment the current nodes data size by 1 because we successfully placed 
-				// this data in this node's memory location!
-				m_DataSourceSize++;
-				m_TotalNodeDataSourceSize++;
-			}
+				for (uint32_t i = 0; i < count; i++) {
 
-			/// <summary>
-			/// This function will calculate the bounding regions for 8 children.
-			/// </summary>
-			/// <returns></returns>
-			std::array<Bounds_AABB, 8> CalculateChildBounds() const {
-				std::array<Bounds_AABB, 8> childBounds{};
+					switch (view_results[i]) {
+
+						case BoundsContainResult::Contains:
+							states[i].ActiveViews &= ~view_bit;
+							states[i].ContainedViews |= view_bit;
+							break;
 
-				// Calculate the size of each child node's bounding box (half the size of the current node)
-				glm::vec3 halfSize = m_NodeBounds.Size() * 0.5f;
+						case BoundsContainResult::DoesNotContain:
+							states[i].ActiveViews &= ~view_bit;
+							break;
 
-				// Calculate the center of the current node
-				glm::vec3 center = m_NodeBounds.Center();
+						default:
+							states[i].PlaneMasks[view] = view_plane_masks[i];
+							break;
+					}
+				}
+			}
+		}
 
-				// Generate the eight child bounding boxes
-				for (int i = 0; i < 8; ++i) {
-					glm::vec3 offset(
-						(i & 1 ? 0.5f : -0.5f) * halfSize.x,
-						(i & 2 ? 0.5f : -0.5f) * halfSize.y,
-						(i & 4 ? 0.5f : -0.5f) * halfSize.z
-					);
+		/// <summary>
+		/// Batched version of QueryNode. The state already holds this node's 
+		/// result for every view, its children are classified here in one 
+		/// batch per view before recursing.
+		/// </summary>
+		void QueryBatchNode(uint32_t node_index, const OctreeQueryVolume* volumes, std::vector<OctreeData>* results, const OctreeBatchState& state) const {
 
-					glm::vec3 childCenter = center + offset;
+			const auto& node = m_Nodes[node_index];
 
-					childBounds[i].BoundsMin = childCenter - halfSize * 0.5f;
-					childBounds[i].BoundsMax = childCenter + halfSize * 0.5f;
+			// Views that contain the node take every data source without testing
+			if (state.ContainedViews != 0) {
+				for (uint32_t i = 0; i < node.DataSourceSize; i++) {
+					for (uint64_t views = state.ContainedViews; views; views &= views - 1)
+						results[std::countr_zero(views)].push_back(m_DataSources[node.DataSourceIndex + i]);
 				}
-
-				return childBounds;
 			}
 
-			/// <summary>
-			/// This is the index of the start of the DataSourceIndex in 
-			/// the Octree Data storage.
-			/// </summary>
-			size_t m_DataSourceIndex = 0;
+			std::array<Bounds_AABB, OCTREE_TEST_BATCH_SIZE> batch_bounds;
 
-			/// <summary>
-			/// This is the size of how many DataSources are contained in 
-			/// this Node at the DataSourceIndex in the Octree Data Storage.
-			/// </summary>
-			size_t m_DataSourceSize = 0;
+			// Views that intersect the node test its data sources a batch at a time, 
+			// data sources only need the planes this node is not entirely inside of
+			if (state.ActiveViews != 0) {
 
-			/// <summary>
-			/// The current size of self including all child data sources.
-			/// </summary>
-			size_t m_TotalNodeDataSourceSize = 0;
+				std::array<BoundsContainResult, OCTREE_TEST_BATCH_SIZE> batch_results;
 
-			/// <summary>
-			/// Array of pointers to 8 (oct) child nodes of this node.
-			/// </summary>
-			std::array<OctreeNode, 8> m_ChildrenNodes{ nullptr };
+				for (uint32_t first = 0; first < node.DataSourceSize; first += OCTREE_TEST_BATCH_SIZE) {
 
-			/// <summary>
-			/// Array of 8 (oct) child nodes bounding regions for this node.
-			/// </summary>
-			std::array<Bounds_AABB, 8> m_ChildrenBounds{};
+					uint32_t batch_count = glm::min(node.DataSourceSize - first, OCTREE_TEST_BATCH_SIZE);
+					for (uint32_t i = 0; i < batch_count; i++)
+						batch_bounds[i] = m_DataSources[node.DataSourceIndex + first + i].Bounds;
 
-			/// <summary>
-			/// This tells us if this node has been split into child nodes or not.
-			/// </summary>
-			bool m_IsNodeSplit = false;
+					for (uint64_t views = state.ActiveViews; views; views &= views - 1) {
 
-			/// <summary>
-			/// The actual bounds of the node unaffected by the looseness.
-			/// 
-			/// Please note, this is not varied when looseness changes. This 
-			/// will always be the actual bounds of the current node.
-			/// 
-			/// The looseness will ONLY be taken into account when attempting 
-			/// to insert a Data Source, or querying a particular node.
-			/// </summary>
-			Bounds_AABB m_NodeBounds;
+						int view = std::countr_zero(views);
 
-			/// <summary>
-			/// This is the mat4 in worldspace of this current node. This is
-			/// useful for when we want to draw the debug version of the octree
-			/// and to save on performance, we calculate this once when the 
-			/// node is created, opposed to every frame.
-			/// </summary>
-			glm::mat4 m_NodeMat4;
+						SpatialIndexTests::TestVolume(volumes[view], batch_bounds.data(), batch_count, state.PlaneMasks[view], batch_results.data(), nullptr);
 
-			/// <summary>
-			/// Pointer to the Octree holding class that contains the root node.
-			/// </summary>
-			OctreeBounds<DataType>* m_Octree;
+						for (uint32_t i = 0; i < batch_count; i++) {
+							if (batch_results[i] != BoundsContainResult::DoesNotContain)
+								results[view].push_back(m_DataSources[node.DataSourceIndex + first + i]);
+						}
+					}
+				}
+			}
 
-			/// <summary>
-			/// This is the max amount of times a node can be queried whilst itself 
-			/// and its children have no data sources.
-			/// </summary>
-			uint8_t m_LifeMax;
+			if (!node.IsNodeSplit)
+				return;
 
-			/// <summary>
-			/// This is the death counter, it will start at 0 and work its way up to 
-			/// Life Max each time this node is queried. If it reaches LifeMax it 
-			/// will delete the current node and all its children. If the node is 
-			/// saved and something is placed in it, then the LifeMax of the node 
-			/// is doubled.
-			/// </summary>
-			uint8_t m_LifeCount = 0;
-		};
-		using OctreeNode = std::shared_ptr<OctreeBoundsNode<DataType>>;
+			std::array<uint32_t, 8> child_nodes;
+			uint32_t child_count = 0;
+			for (uint32_t child_index : node.ChildrenNodes) {
+				if (child_index != OCTREE_NULL_INDEX && m_Nodes[child_index].TotalNodeDataSourceSize != 0) {
+					child_nodes[child_count] = child_index;
+					batch_bounds[child_count] = m_Nodes[child_index].NodeBounds * m_Config.Looseness;
+					child_count++;
+				}
+			}
 
-	public:
+			std::array<OctreeBatchState, 8> child_states;
+			ClassifyBatchNodes(volumes, state, batch_bounds.data(), child_count, child_states.data());
+
+			for (uint32_t i = 0; i < child_count; i++) {
+				if (child_states[i].ActiveViews != 0 || child_states[i].ContainedViews != 0)
+					QueryBatchNode(child_nodes[i], volumes, results, child_states[i]);
+			}
+		}
 
-		using OctreeData = std::shared_ptr<OctreeDataSource<DataType>>;
+		/// <summary>
+		/// Age the empty children of this node and free any that have 
+		/// outlived their LifeMax, then continue into the non empty children.
+		/// </summary>
+		void PruneNode(uint32_t node_index) {
 
-	public:
+			if (!m_Nodes[node_index].IsNodeSplit)
+				return;
 
-		OctreeBounds() {
-			BuildOctree({});
+			for (int i = 0; i < 8; i++) {
+
+				uint32_t child_index = m_Nodes[node_index].ChildrenNodes[i];
+				if (child_index == OCTREE_NULL_INDEX)
+					continue;
+
+				if (m_Nodes[child_index].TotalNodeDataSourceSize != 0) {
+					PruneNode(child_index);
+					continue;
+				}
+
+				if (CheckShouldDeleteNode(child_index)) {
+					FreeNode(child_index);
+					m_Nodes[node_index].ChildrenNodes[i] = OCTREE_NULL_INDEX;
+				}
+			}
 		}
 
-		OctreeBounds(const OctreeBoundsConfig& config) : m_Config(config) {
-			BuildOctree({});
-		};
+		/// <summary>
+		/// This will append all data sources of this node and its children to the result.
+		/// </summary>
+		void GatherNodeData(uint32_t node_index, std::vector<OctreeData>& result) const {
+
+			const auto& node = m_Nodes[node_index];
 
-		OctreeBounds(const OctreeBoundsConfig& config, std::vector<OctreeData> data_sources) : m_Config(config) {
-			BuildOctree(data_sources);
-		};
+			if (node.TotalNodeDataSourceSize == 0)
+				return;
 
-		~OctreeBounds() {
-			m_DataSources.clear();
-			m_RootNode.reset();
-			m_RootNode = nullptr;
-		};
-		
-		OctreeBounds(const OctreeBounds& other) = default;
-		OctreeBounds& operator=(const OctreeBounds& other) = default;
+			if (node.DataSourceSize > 0) {
+				result.insert(
+					result.end(),
+					m_DataSources.begin() + node.DataSourceIndex,
+					m_DataSources.begin() + node.DataSourceIndex + node.DataSourceSize
+				);
+			}
+
+			if (!node.IsNodeSplit)
+				return;
 
-		OctreeBounds(OctreeBounds&& other) = default;
-		OctreeBounds& operator=(OctreeBounds&& other) = default;
+			for (uint32_t child_index : node.ChildrenNodes) {
+				if (child_index != OCTREE_NULL_INDEX)
+					GatherNodeData(child_index, result);
+			}
+		}
 
 		/// <summary>
-		/// This will attempt to insert a data source which has  been
-		/// created into a shared_ptr already.
+		/// This will append the node bounds for this and all child nodes.
 		/// </summary>
-		bool Insert(OctreeData data_source) {
+		void GatherNodeBounds(uint32_t node_index, std::vector<Bounds_AABB>& bounds_vector) const {
 
-			if (!m_RootNode) {
-				L_CORE_ERROR("Octree - Root Node Invalid or Octree Not Built - Cannot Insert Data Source.");
-				return false;
-			}
+			bounds_vector.push_back(m_Nodes[node_index].NodeBounds);
 
-			int octree_growth_attempts = 0;
-			const int max_attempts = 20; // We are expanding to infinity if we even get close to this number....
-			std::array<Bounds_AABB, max_attempts> parent_node_bounding_region{};
+			for (uint32_t child_index : m_Nodes[node_index].ChildrenNodes) {
+				if (child_index != OCTREE_NULL_INDEX)
+					GatherNodeBounds(child_index, bounds_vector);
+			}
+		}
 
-			OctreeNode old_root_node_for_if_fail = m_RootNode;
-			while (!m_RootNode->Insert(data_source, 0, false)) {
+		/// <summary>
+		/// Manual recursive approach to getting the true
+		/// size of self and all child nodes data count.
+		/// </summary>
+		uint32_t ForceNodeTotalCount(uint32_t node_index) {
 
-				if (octree_growth_attempts < max_attempts) {
-					GrowOctree(data_source->Bounds.Center() - m_RootNode->GetNodeBounds().Center());
-				}
-				else {
-					L_CORE_WARN("Octree - Could Not Grow the Octree to Fit Data Source.");
-					m_RootNode = old_root_node_for_if_fail;
-					return false;
-				}
+			uint32_t count = m_Nodes[node_index].DataSourceSize;
 
-				octree_growth_attempts++;
+			for (uint32_t child_index : m_Nodes[node_index].ChildrenNodes) {
+				if (child_index != OCTREE_NULL_INDEX)
+					count += ForceNodeTotalCount(child_index);
 			}
 
-			// Revalidate the entire tree as we have successfully inserted the data source, this
-			// is because when we insert something, all following node data source index start
-			// positions will need to be shifted by 1
-			m_RootNode->RevalidateNodes(0);
-
-			return true;
+			m_Nodes[node_index].TotalNodeDataSourceSize = count;
+			return count;
 		}
 
 		/// <summary>
-		/// This will attempt to insert a data source which has not been
-		/// created into a shared_ptr yet.
+		/// This checks if this node should be deleted by its parent 
+		/// during PruneEmptyNodes.
 		/// </summary>
-		bool Insert(const DataType& data, const Bounds_AABB& bounds) {
+		bool CheckShouldDeleteNode(uint32_t node_index) {
 
-			if (m_DataSources.size() + 1 >= m_DataSources.capacity())
-				m_DataSources.reserve(m_DataSources.capacity() * 2);
+			auto& node = m_Nodes[node_index];
 
-			auto data_source = std::make_shared<OctreeDataSource<DataType>>(data, bounds);
+			// Set a roof of 64 prune passes it can be empty for before deletion
+			if (node.LifeCount < 64)
+				node.LifeCount++;
 
-			if (!Insert(data_source)) {
-				data_source.reset();
-				data_source = nullptr;
-				return false;
-			}
-			return true;
+			return (node.LifeCount > node.LifeMax);
 		}
 
 		/// <summary>
-		/// This will attempt to insert an entire vector of data sources 
-		/// into the Octree that have not been made into shared_ptr's yet.
+		/// This function will calculate the bounding region for one of the 8 children.
 		/// </summary>
-		/// <returns>
-		/// If anything is returned, these are the data sources
-		/// that could not be inserted into the Octree. Deal with these
-		/// remaining data sources as you see fit.
-		/// </returns>
-		std::vector<OctreeDataSource<DataType>> InsertVector(const std::vector<OctreeDataSource<DataType>>& data_sources) {
+		static Bounds_AABB CalculateChildBounds(const Bounds_AABB& node_bounds, int child) {
 
-			// These are data sources that are out of bounds
-			std::vector<OctreeDataSource<DataType>> remaining_data_sources{};
-			remaining_data_sources.reserve(data_sources.size());
+			// Calculate the size of each child node's bounding box (half the size of the current node)
+			glm::vec3 halfSize = node_bounds.Size() * 0.5f;
 
-			if (m_DataSources.size() + data_sources.size() >= m_DataSources.capacity())
-				m_DataSources.reserve(m_DataSources.capacity() * 2);
+			glm::vec3 offset(
+				(child & 1 ? 0.5f : -0.5f) * halfSize.x,
+				(child & 2 ? 0.5f : -0.5f) * halfSize.y,
+				(child & 4 ? 0.5f : -0.5f) * halfSize.z
+			);
 
-			for (const auto& data : data_sources) {
-				auto data_shared = std::make_shared<OctreeDataSource<DataType>>(data);
-				if (!Insert(data_shared)) {
-					remaining_data_sources.push_back(data);
-					data_shared.reset();
-					data_shared = nullptr;
-				}
-			}
+			glm::vec3 childCenter = node_bounds.Center() + offset;
 
-			return remaining_data_sources;
+			return Bounds_AABB(childCenter - halfSize * 0.5f, childCenter + halfSize * 0.5f);
 		}
 
 		/// <summary>
-		/// This will attempt to insert an entire vector of data source 
-		/// to the Octree.
+		/// This finds which child node a particular point would fit in best.
 		/// </summary>
-		/// <returns>
-		/// If anything is returned, these are the data sources
-		/// that could not be inserted into the Octree. Deal with these
-		/// remaining data sources as you see fit.
-		/// </returns>
-		std::vector<OctreeData> InsertVector(const std::vector<OctreeData>& data_sources) {
-
-			// These are data sources that are out of bounds
-			std::vector<OctreeData> remaining_data_sources{};
-			remaining_data_sources.reserve(data_sources.size());
-
-			if (m_DataSources.size() + data_sources.size() >= m_DataSources.capacity())
-				m_DataSources.reserve(m_DataSources.capacity() * 2);
-			
-			for (const auto& data : data_sources) {
-				if(!Insert(data))
-					remaining_data_sources.push_back(data);
+		static int BestFitChild(const Bounds_AABB& node_bounds, const glm::vec3& point) {
+			for (int i = 0; i < 8; i++) {
+				if (CalculateChildBounds(node_bounds, i).Contains(point) == BoundsContainResult::Contains)
+					return i;
 			}
-
-			return remaining_data_sources;
+			return -1; // Unsuccessful
 		}
 
+#pragma endregion
+
+#pragma region Ray Queries
+
 		/// <summary>
-		/// This will attempt to remove the data source from the Octree.
+		/// Walk the node and its children for a ray query. When nearest_hit is set 
+		/// only the nearest hit is kept and max_distance shrinks to it as hits are 
+		/// found, otherwise every hit is appended to all_hits.
 		/// </summary>
-		bool Remove(const DataType& data) {
+		void RaycastNode(uint32_t node_index, const Bounds_Ray& ray, float node_distance, float& max_distance, OctreeRayHit* nearest_hit, std::vector<OctreeRayHit>* all_hits, const OctreeRayFilter& filter) const {
 
-			if (!m_RootNode)
-				return false;
+			// A nearer hit was found since this node was queued
+			if (node_distance > max_distance)
+				return;
 
-			auto it = std::find_if(m_DataSources.begin(), m_DataSources.end(),
-				[&data](const OctreeData& storedData) {
-					return storedData->Data == data;
-			});
-			
-			if (it == m_DataSources.end()) {
-				L_CORE_WARN("Octree - Data Not Found in Data Sources.");
-				return false;
+			const auto& node = m_Nodes[node_index];
+
+			// 1. Test the data sources of this node
+			for (uint32_t data_index = node.DataSourceIndex; data_index < node.DataSourceIndex + node.DataSourceSize; data_index++) {
+
+				const OctreeData& data_source = m_DataSources[data_index];
+
+				float distance = 0.0f;
+				if (!ray.Intersects(data_source.Bounds, max_distance, distance))
+					continue;
+
+				if (filter && (!filter(data_source, distance) || distance > max_distance))
+					continue;
+
+				if (nearest_hit) {
+					if (distance < nearest_hit->Distance) {
+						*nearest_hit = { data_source, distance };
+						max_distance = distance;
+					}
+				}
+				else {
+					all_hits->push_back({ data_source, distance });
+				}
 			}
 
-			// Remove the data from the octree node
-			size_t position = std::distance(m_DataSources.begin(), it);
-			
-			if (!m_RootNode->Remove(position)) {
-				L_CORE_ERROR("Octree - Data Not Actually Contained Within Octree.");
-				return false;
+			if (!node.IsNodeSplit)
+				return;
+
+			// 2. Order the children the ray passes through front to back
+			std::array<std::pair<float, uint32_t>, 8> child_hits;
+			int child_hit_count = 0;
+
+			for (uint32_t child_index : node.ChildrenNodes) {
+
+				if (child_index == OCTREE_NULL_INDEX || m_Nodes[child_index].TotalNodeDataSourceSize == 0)
+					continue;
+
+				float distance = 0.0f;
+				if (!ray.Intersects(m_Nodes[child_index].NodeBounds * m_Config.Looseness, max_distance, distance))
+					continue;
+
+				int insert_index = child_hit_count++;
+				while (insert_index > 0 && child_hits[insert_index - 1].first > distance) {
+					child_hits[insert_index] = child_hits[insert_index - 1];
+					insert_index--;
+				}
+				child_hits[insert_index] = { distance, child_index };
 			}
 
-			m_RootNode->RevalidateNodes(0);
-			return true;
+			// 3. Walk the children, the nearest query stops once the children are further than the nearest hit
+			for (int i = 0; i < child_hit_count; i++)
+				RaycastNode(child_hits[i].second, ray, child_hits[i].first, max_distance, nearest_hit, all_hits, filter);
 		}
 
+#pragma endregion
+
+#pragma region Arena Allocation
+
 		/// <summary>
-		/// This will update a data source within the current Octree. It will first
-		/// remove it from the Octree, then Insert into the Octree.
-		/// 
-		/// If the data source is not within the current Octree, it will just insert
-		/// it into the Octree.
+		/// This will allocate a node from the node arena, reusing a freed node if possible.
 		/// </summary>
-		bool Update(const DataType& data, const Bounds_AABB& bounds) {
+		uint32_t AllocateNode(const Bounds_AABB& node_bounds, uint32_t parent_index) {
 
-			if (!m_RootNode)
-				return false;
+			uint32_t node_index;
+			if (!m_FreeNodes.empty()) {
+				node_index = m_FreeNodes.back();
+				m_FreeNodes.pop_back();
+				m_Nodes[node_index] = OctreeBoundsNode{};
+			}
+			else {
+				L_CORE_ASSERT(m_Nodes.size() < OCTREE_NULL_INDEX, "Octree - Node Arena Exhausted!");
+				node_index = static_cast<uint32_t>(m_Nodes.size());
+				m_Nodes.emplace_back();
+			}
 
-			Remove(data);
-				
-			return Insert(data, bounds);
+			auto& node = m_Nodes[node_index];
+			node.NodeBounds = node_bounds;
+			node.ParentNode = parent_index;
+			node.LifeMax = m_Config.MaxLifeIfEmpty;
+			return node_index;
 		}
 
 		/// <summary>
-		/// This will query the octree and return a const reference to a static vector.
-		/// 
-		/// If you do not process or copy the data from this result before the next query, 
-		/// the next query will overwrite all data returned from the first query call.
-		/// 
-		/// Make sure that you copy the results, or you process them before querying the 
-		/// Octree again.
+		/// This will release the node, its data block and all of its children 
+		/// back to the arenas.
 		/// </summary>
-		/// <param name="frustum">Bounds AABB Range to Query</param>
-		const std::vector<OctreeData>& Query(const Bounds_AABB& bounds) {
+		void FreeNode(uint32_t node_index) {
 
-			if (m_QueryReturnVectors[0].capacity() == 0 || m_QueryReturnVectors[0].capacity() < m_DataSources.size()) {
-				m_QueryReturnVectors[0].reserve(m_DataSources.empty() ? 1024 : m_DataSources.size());
+			for (uint32_t child_index : m_Nodes[node_index].ChildrenNodes) {
+				if (child_index != OCTREE_NULL_INDEX)
+					FreeNode(child_index);
 			}
 
-			m_QueryReturnVectors[0].clear();
+			auto& node = m_Nodes[node_index];
+			for (uint32_t i = 0; i < node.DataSourceSize; i++) {
+				m_DataSourceLocations.erase(m_DataSources[node.DataSourceIndex + i].Data);
+				m_DataSources[node.DataSourceIndex + i] = OctreeData{};
+			}
+			FreeDataBlock(node.DataSourceIndex, node.DataSourceCapacity);
 
-			if (m_DataSources.empty())
-				return m_QueryReturnVectors[0];
+			node = OctreeBoundsNode{};
+			m_FreeNodes.push_back(node_index);
+		}
 
-			if (m_RootNode) {
-				bool should_delete = false;
-				m_RootNode->Query(bounds, m_QueryReturnVectors[0], should_delete);
-			}
-			return m_QueryReturnVectors[0];
+		/// <summary>
+		/// Data blocks are always a power of two in size, so the free list
+		/// for a block is the log2 of its capacity.
+		/// </summary>
+		static uint32_t GetDataBlockClass(uint32_t capacity) {
+			return static_cast<uint32_t>(std::countr_zero(capacity));
 		}
 
 		/// <summary>
-		/// This will query the octree and return a const reference to a static vector.
-		/// 
-		/// If you do not process or copy the data from this result before the next query, 
-		/// the next query will overwrite all data returned from the first query call.
-		/// 
-		/// Make sure that you copy the results, or you process them before querying the 
-		/// Octree again.
+		/// This will allocate a block of data source slots from the Octree Data 
+		/// Storage, reusing a freed block of the same size if possible.
 		/// </summary>
-		/// <param name="frustum">Bounds Sphere Range to Query</param>
-		const std::vector<OctreeData>& Query(const Bounds_Sphere& bounds) {
+		uint32_t AllocateDataBlock(uint32_t capacity) {
 
-			if (m_QueryReturnVectors[1].capacity() == 0 || m_QueryReturnVectors[1].capacity() < m_DataSources.size()) {
-				m_QueryReturnVectors[1].reserve(m_DataSources.empty() ? 1024 : m_DataSources.size());
+			auto& free_blocks = m_FreeDataBlocks[GetDataBlockClass(capacity)];
+			if (!free_blocks.empty()) {
+				uint32_t block_index = free_blocks.back();
+				free_blocks.pop_back();
+				return block_index;
 			}
 
-			m_QueryReturnVectors[1].clear();
+			L_CORE_ASSERT(m_DataSources.size() + capacity < OCTREE_NULL_INDEX, "Octree - Data Arena Exhausted!");
+
+			uint32_t block_index = static_cast<uint32_t>(m_DataSources.size());
+			m_DataSources.resize(m_DataSources.size() + capacity);
+			return block_index;
+		}
 
-			if (m_DataSources.empty())
-				return m_QueryReturnVectors[1];
+		/// <summary>
+		/// This will return a block of data source slots to its free list.
+		/// </summary>
+		void FreeDataBlock(uint32_t block_index, uint32_t capacity) {
+			if (block_index == OCTREE_NULL_INDEX || capacity == 0)
+				return;
 
-			if (m_RootNode) {
-				bool should_delete = false;
-				m_RootNode->Query(bounds, m_QueryReturnVectors[1], should_delete);
-			}
-			return m_QueryReturnVectors[1];
+			m_FreeDataBlocks[GetDataBlockClass(capacity)].push_back(block_index);
 		}
 
 		/// <summary>
-		/// This will query the octree and return a const reference to a static vector.
-		/// 
-		/// If you do not process or copy the data from this result before the next query, 
-		/// the next query will overwrite all data returned from the first query call.
-		/// 
-		/// Make sure that you copy the results, or you process them before querying the 
-		/// Octree again.
+		/// This will move the node's data sources into a block twice the 
+		/// size, or allocate the node's first block if it has none.
 		/// </summary>
-		/// <param name="frustum">Camera Frustum to Query</param>
-		const std::vector<OctreeData>& Query(const Frustum& frustum) {
+		void GrowDataBlock(uint32_t node_index) {
 
-			if (m_QueryReturnVectors[2].capacity() == 0 || m_QueryReturnVectors[2].capacity() < m_DataSources.size()) {
-				m_QueryReturnVectors[2].reserve(m_DataSources.empty() ? 1024 : m_DataSources.size());
-			}
+			auto& node = m_Nodes[node_index];
 
-			m_QueryReturnVectors[2].clear();
+			uint32_t new_capacity = node.DataSourceCapacity == 0 ?
+				std::bit_ceil(static_cast<uint32_t>(std::max(m_Config.PreferredDataSourceLimit, 1))) :
+				node.DataSourceCapacity * 2;
 
-			if (m_DataSources.empty())
-				return m_QueryReturnVectors[2];
+			uint32_t new_index = AllocateDataBlock(new_capacity);
 
-			if (m_RootNode) {
-				bool should_delete = false;
-				m_RootNode->Query(frustum, m_QueryReturnVectors[2], should_delete);
+			if (node.DataSourceSize > 0) {
+				std::move(
+					m_DataSources.begin() + node.DataSourceIndex,
+					m_DataSources.begin() + node.DataSourceIndex + node.DataSourceSize,
+					m_DataSources.begin() + new_index
+				);
+
+				for (uint32_t i = 0; i < node.DataSourceSize; i++)
+					m_DataSourceLocations[m_DataSources[new_index + i].Data].DataIndex = new_index + i;
 			}
-			return m_QueryReturnVectors[2];
+
+			FreeDataBlock(node.DataSourceIndex, node.DataSourceCapacity);
+
+			node.DataSourceIndex = new_index;
+			node.DataSourceCapacity = new_capacity;
 		}
 
+#pragma endregion
+
+#pragma region Bulk Build
+
 		/// <summary>
-		/// This will rebuild the octree with all its current data sources.
+		/// A subtree built by a bulk build. Each worker builds into its own 
+		/// arenas so no vector is shared between threads, and the subtrees 
+		/// are merged into the Octree arenas once they are all finished.
 		/// </summary>
-		void RebuildOctree() {
-			std::unique_lock lock(m_OctreeMutex);
-			BuildOctree();
-		}
+		struct OctreeBuildSubtree {
+			std::vector<OctreeBoundsNode> Nodes{};
+			std::vector<OctreeData> DataSources{};
+		};
 
 		/// <summary>
-		/// This will rebuild the octree with all its current data sources, 
-		/// but with a new configuration for the Octree.
+		/// A subtree that has been deferred to a worker thread. NodeIndex is the 
+		/// placeholder node in the top level subtree that the result replaces.
 		/// </summary>
-		void RebuildOctree(const OctreeBoundsConfig& new_config) {
-			std::unique_lock lock(m_OctreeMutex);
-			m_Config = new_config;
-			BuildOctree();
-		}
+		struct OctreeBuildTask {
+			uint32_t NodeIndex = OCTREE_NULL_INDEX;
+			Bounds_AABB NodeBounds{};
+			uint32_t ItemsBegin = 0;
+			uint32_t ItemsCount = 0;
+			OctreeBuildSubtree Subtree{};
+		};
 
 		/// <summary>
-		/// This will return the data sources contained ONLY in the root node.
+		/// Shared state of a bulk build. Items holds indices into DataSources and is 
+		/// partitioned in place, so every node owns a contiguous range of Items, 
+		/// Scratch and ItemChild and subtrees never touch each other's ranges.
 		/// </summary>
-		/// <returns></returns>
-		size_t Count() const { 
-			return m_RootNode ? m_RootNode->Count() : 0; 
-		}
+		struct OctreeBuildContext {
+			const std::vector<OctreeData>& DataSources;
+			std::vector<uint32_t> Items{};
+			std::vector<uint32_t> Scratch{};
+			std::vector<int8_t> ItemChild{};
+			JobSystem* Jobs = nullptr;
+			uint32_t TaskSize = 0;
+			uint32_t ThreadCount = 1;
+			uint8_t LifeMax = 8;
+		};
 
 		/// <summary>
-		/// This will return the 'lazy' approach count which tracks the
-		/// total count of its data sources and sub nodes data sources.
+		/// Below this many data sources a subtree is built on a single thread.
 		/// </summary>
-		size_t TotalCount() const {
-			return m_RootNode ? m_RootNode->TotalCount() : 0;
-		}
+		static constexpr uint32_t OCTREE_BUILD_MIN_TASK_SIZE = 2048;
 
 		/// <summary>
-		/// This will force a manual recursive count of all the Octree's node
-		/// data sources to ensure accuracy.
+		/// This will build a node and its subtree into the given subtree arenas, 
+		/// following the same rules as InsertIntoNode so the resulting layout is
+		/// the layout incremental insertion produces. If deferred_tasks is set, 
+		/// subtrees small enough to be built by one thread are left as placeholder 
+		/// nodes and appended to deferred_tasks instead.
 		/// </summary>
-		size_t ForceTotalCount() const {
-			return m_RootNode ? m_RootNode->ForceTotalCount() : 0;
-		}
+		/// <returns>The index of the node in the subtree arenas.</returns>
+		uint32_t BuildSubtreeNode(OctreeBuildSubtree& subtree, OctreeBuildContext& context, const Bounds_AABB& node_bounds, uint32_t parent_index, uint32_t items_begin, uint32_t items_count, std::vector<OctreeBuildTask>* deferred_tasks) const {
 
-		void Clear() { 
-			if (m_RootNode) 
-				m_RootNode->Clear(); 
-		}
+			uint32_t node_index = static_cast<uint32_t>(subtree.Nodes.size());
+			subtree.Nodes.emplace_back();
 
-		bool IsEmpty() const { 
-			return TotalCount() == 0; 
-		}
+			{
+				auto& node = subtree.Nodes[node_index];
+				node.NodeBounds = node_bounds;
+				node.ParentNode = parent_index;
+				node.TotalNodeDataSourceSize = items_count;
+
+				// Every node receives a data source when it is created by insertion, which doubles its life
+				node.LifeMax = context.LifeMax;
+			}
+
+			if (deferred_tasks && parent_index != OCTREE_NULL_INDEX && items_count <= context.TaskSize) {
+				deferred_tasks->push_back({ node_index, node_bounds, items_begin, items_count, {} });
+				return node_index;
+			}
+
+			// A node only splits once more than the preferred limit reaches it, and only if its children are not too small
+			glm::vec3 child_bounds_size = node_bounds.Size() * 0.5f;
+			bool can_split = child_bounds_size.x >= m_Config.MinNodeSize && child_bounds_size.y >= m_Config.MinNodeSize && child_bounds_size.z >= m_Config.MinNodeSize;
+
+			if (static_cast<int64_t>(items_count) <= m_Config.PreferredDataSourceLimit || !can_split) {
+				StoreBuildData(subtree, context, node_index, items_begin, items_count);
+				return node_index;
+			}
+
+			subtree.Nodes[node_index].IsNodeSplit = true;
+
+			// 1. Find the first child each data source fits in, -1 stays in this node
+			ClassifyBuildItems(context, node_bounds, items_begin, items_count, deferred_tasks != nullptr);
+
+			// 2. Stable counting sort of the range by child, data sources staying in this node first
+			std::array<uint32_t, 9> bucket_offsets{};
+			for (uint32_t i = items_begin; i < items_begin + items_count; i++)
+				bucket_offsets[context.ItemChild[i] + 1]++;
 
-		OctreeNode GetRootNode() const { 
-			return m_RootNode; 
+			std::array<uint32_t, 9> bucket_begin{};
+			for (uint32_t bucket = 0, offset = items_begin; bucket < 9; bucket++) {
+				bucket_begin[bucket] = offset;
+				offset += bucket_offsets[bucket];
+				bucket_offsets[bucket] = bucket_begin[bucket];
+			}
+
+			for (uint32_t i = items_begin; i < items_begin + items_count; i++)
+				context.Scratch[bucket_offsets[context.ItemChild[i] + 1]++] = context.Items[i];
+
+			std::copy(context.Scratch.begin() + items_begin, context.Scratch.begin() + items_begin + items_count, context.Items.begin() + items_begin);
+
+			// 3. Data sources that do not fit a child stay in this node
+			StoreBuildData(subtree, context, node_index, bucket_begin[0], bucket_begin[1] - bucket_begin[0]);
+
+			// 4. Build each child that has data sources
+			for (int child = 0; child < 8; child++) {
+
+				uint32_t child_begin = bucket_begin[child + 1];
+				uint32_t child_count = (child < 7 ? bucket_begin[child + 2] : items_begin + items_count) - child_begin;
+
+				if (child_count == 0)
+					continue;
+
+				uint32_t child_index = BuildSubtreeNode(subtree, context, CalculateChildBounds(node_bounds, child), node_index, child_begin, child_count, deferred_tasks);
+				subtree.Nodes[node_index].ChildrenNodes[child] = child_index;
+			}
+
+			return node_index;
 		}
 
 		/// <summary>
-		/// Calling this function will try to shrink the Root Node if there is 
-		/// only one octant which contains data.
+		/// This will find the first child of the node each data source in the range
+		/// is contained by. The range is split across the job system if it is large.
 		/// </summary>
-		void TryShrinkOctree() {
-			if(auto node = ShrinkOctree(); node && m_RootNode != node) {
-				m_RootNode = node;
-				m_RootNode->RevalidateNodes(0);
+		void ClassifyBuildItems(OctreeBuildContext& context, const Bounds_AABB& node_bounds, uint32_t items_begin, uint32_t items_count, bool allow_threads) const {
+
+			std::array<Bounds_AABB, 8> child_bounds;
+			for (int child = 0; child < 8; child++)
+				child_bounds[child] = CalculateChildBounds(node_bounds, child);
+
+			auto classify_range = [&](uint32_t range_begin, uint32_t range_end) {
+				for (uint32_t i = range_begin; i < range_end; i++) {
+
+					const Bounds_AABB& bounds = context.DataSources[context.Items[i]].Bounds;
+
+					int8_t found_child = -1;
+					for (int8_t child = 0; child < 8; child++) {
+						if (child_bounds[child].Contains(bounds, m_Config.Looseness) == BoundsContainResult::Contains) {
+							found_child = child;
+							break;
+						}
+					}
+					context.ItemChild[i] = found_child;
+				}
+			};
+
+			if (!allow_threads) {
+				classify_range(items_begin, items_begin + items_count);
+				return;
 			}
-		}
 
-		void SetConfig(const OctreeBoundsConfig& config) { m_Config = config; }
-		const OctreeBoundsConfig& GetConfig() const { return m_Config; }
+			context.Jobs->ParallelFor(items_count, OCTREE_BUILD_MIN_TASK_SIZE, [&](size_t range_begin, size_t range_end) {
+				classify_range(items_begin + static_cast<uint32_t>(range_begin), items_begin + static_cast<uint32_t>(range_end));
+			});
+		}
 
 		/// <summary>
-		/// Use this to lock the octree when doing any updates in a separate thread.
+		/// This will place the data sources of the range into the node's block, 
+		/// sized the same as the block incremental insertion would grow to.
 		/// </summary>
-		std::mutex& GetOctreeMutex() { return m_OctreeMutex; }
+		void StoreBuildData(OctreeBuildSubtree& subtree, const OctreeBuildContext& context, uint32_t node_index, uint32_t items_begin, uint32_t items_count) const {
 
-		const std::vector<OctreeData>& GetAllOctreeDataSources() const {
-			return m_DataSources;
+			if (items_count == 0)
+				return;
+
+			uint32_t capacity = std::max(std::bit_ceil(static_cast<uint32_t>(std::max(m_Config.PreferredDataSourceLimit, 1))), std::bit_ceil(items_count));
+
+			auto& node = subtree.Nodes[node_index];
+			node.DataSourceIndex = static_cast<uint32_t>(subtree.DataSources.size());
+			node.DataSourceSize = items_count;
+			node.DataSourceCapacity = capacity;
+
+			subtree.DataSources.resize(subtree.DataSources.size() + capacity);
+			for (uint32_t i = 0; i < items_count; i++)
+				subtree.DataSources[node.DataSourceIndex + i] = context.DataSources[context.Items[items_begin + i]];
 		}
 
 		/// <summary>
-		/// This will return a vector of AABB bounds of the entire Octree's node's recursively.
+		/// This will move a subtree built by a worker into the Octree arenas. The
+		/// subtree root replaces the placeholder node left in the top level subtree.
 		/// </summary>
-		/// <returns></returns>
-		std::vector<Bounds_AABB> GetAllOctreeBounds() const {
-			return m_RootNode ? m_RootNode->GetRecursiveChildBounds() : std::vector<Bounds_AABB>();
+		void MergeBuildSubtree(OctreeBuildTask& task) {
+
+			uint32_t node_base = static_cast<uint32_t>(m_Nodes.size());
+			uint32_t data_base = static_cast<uint32_t>(m_DataSources.size());
+
+			auto remap_node = [&](uint32_t local_index) -> uint32_t {
+				if (local_index == OCTREE_NULL_INDEX)
+					return OCTREE_NULL_INDEX;
+				return local_index == 0 ? task.NodeIndex : node_base + local_index - 1;
+			};
+
+			L_CORE_ASSERT(m_Nodes.size() + task.Subtree.Nodes.size() < OCTREE_NULL_INDEX, "Octree - Node Arena Exhausted!");
+			L_CORE_ASSERT(m_DataSources.size() + task.Subtree.DataSources.size() < OCTREE_NULL_INDEX, "Octree - Data Arena Exhausted!");
+
+			m_Nodes.resize(m_Nodes.size() + task.Subtree.Nodes.size() - 1);
+
+			for (uint32_t local_index = 0; local_index < task.Subtree.Nodes.size(); local_index++) {
+
+				OctreeBoundsNode node = task.Subtree.Nodes[local_index];
+
+				node.ParentNode = local_index == 0 ? m_Nodes[task.NodeIndex].ParentNode : remap_node(node.ParentNode);
+				for (auto& child_index : node.ChildrenNodes)
+					child_index = remap_node(child_index);
+
+				if (node.DataSourceIndex != OCTREE_NULL_INDEX)
+					node.DataSourceIndex += data_base;
+
+				m_Nodes[remap_node(local_index)] = node;
+			}
+
+			m_DataSources.insert(m_DataSources.end(), std::make_move_iterator(task.Subtree.DataSources.begin()), std::make_move_iterator(task.Subtree.DataSources.end()));
+			task.Subtree = {};
 		}
 
 		/// <summary>
-		/// This will return a vector of glm::mat4 matricies of the entire Octree's node bounds recursively.
+		/// This will build the Octree below the root node from all of the data sources
+		/// at once. Rather than inserting one by one, the data sources are partitioned 
+		/// by child octant top down, and once a subtree is small enough it is built 
+		/// independently on a worker thread. The layout follows the same MinNodeSize, 
+		/// PreferredDataSourceLimit and Looseness rules as InsertIntoNode.
+		/// 
+		/// Without a job system the whole Octree is built on the calling thread.
 		/// </summary>
-		std::vector<glm::mat4> GetAllOctreeBoundsMat4() const {
-			return m_RootNode ? m_RootNode->GetRecursiveChildBoundsMat4() : std::vector<glm::mat4>();
+		/// <returns>The data sources the root node could not contain.</returns>
+		std::vector<OctreeData> BulkBuildOctree(const std::vector<OctreeData>& data_sources, JobSystem* job_system) {
+
+			std::vector<OctreeData> remaining_data_sources{};
+
+			// 1. Inserting the same data twice moves it to the latest bounds, so only keep the last of each
+			for (uint32_t i = 0; i < data_sources.size(); i++)
+				m_DataSourceLocations[data_sources[i].Data].DataIndex = i;
+
+			OctreeBuildContext context{ data_sources };
+			context.Items.reserve(m_DataSourceLocations.size());
+
+			const Bounds_AABB& root_bounds = m_Nodes[m_RootNode].NodeBounds;
+			for (uint32_t i = 0; i < data_sources.size(); i++) {
+
+				if (m_DataSourceLocations[data_sources[i].Data].DataIndex != i)
+					continue;
+
+				if (root_bounds.Contains(data_sources[i].Bounds, m_Config.Looseness) == BoundsContainResult::Contains)
+					context.Items.push_back(i);
+				else
+					remaining_data_sources.push_back(data_sources[i]);
+			}
+
+			m_DataSourceLocations.clear();
+
+			if (context.Items.empty())
+				return remaining_data_sources;
+
+			uint32_t item_count = static_cast<uint32_t>(context.Items.size());
+
+			context.Scratch.resize(item_count);
+			context.ItemChild.resize(item_count);
+
+			context.Jobs = job_system;
+			context.ThreadCount = job_system ? job_system->GetWorkerCount() + 1 : 1;
+			context.TaskSize = std::max(OCTREE_BUILD_MIN_TASK_SIZE, item_count / (context.ThreadCount * 4));
+			context.LifeMax = static_cast<uint8_t>(glm::min(m_Config.MaxLifeIfEmpty * 2, 64));
+
+			// 2. Partition the top of the Octree on this thread, deferring the subtrees below it
+			OctreeBuildSubtree top_subtree{};
+			std::vector<OctreeBuildTask> tasks{};
+			BuildSubtreeNode(top_subtree, context, root_bounds, OCTREE_NULL_INDEX, 0, item_count, job_system ? &tasks : nullptr);
+
+			// 3. Build the deferred subtrees in parallel, each worker pulls the next task until none are left
+			std::atomic<size_t> next_task = 0;
+			auto build_tasks = [&]() {
+				for (size_t task_index = next_task++; task_index < tasks.size(); task_index = next_task++) {
+					auto& task = tasks[task_index];
+					BuildSubtreeNode(task.Subtree, context, task.NodeBounds, OCTREE_NULL_INDEX, task.ItemsBegin, task.ItemsCount, nullptr);
+				}
+			};
+
+			size_t worker_count = std::min<size_t>(context.ThreadCount, tasks.size());
+			if (worker_count > 0)
+				job_system->ParallelFor(worker_count, 1, [&](size_t, size_t) { build_tasks(); });
+
+			// 4. Move everything into the Octree arenas, the top level root replaces the existing root node
+			m_Nodes = std::move(top_subtree.Nodes);
+			m_DataSources = std::move(top_subtree.DataSources);
+			m_RootNode = 0;
+
+			for (auto& task : tasks)
+				MergeBuildSubtree(task);
+
+			// 5. Index every data source by where it ended up
+			m_DataSourceLocations.reserve(item_count);
+			for (uint32_t node_index = 0; node_index < m_Nodes.size(); node_index++) {
+				const auto& node = m_Nodes[node_index];
+				for (uint32_t data_index = node.DataSourceIndex; data_index < node.DataSourceIndex + node.DataSourceSize; data_index++)
+					m_DataSourceLocations[m_DataSources[data_index].Data] = { node_index, data_index };
+			}
+
+			return remaining_data_sources;
 		}
 
-	private:
+#pragma endregion
 
 		/// <summary>
 		/// This will build the octree provided the data in the constructor.
@@ -1229,16 +1768,16 @@ namespace Louron {
 		void BuildOctree(std::vector<OctreeData> data_sources = {}) {
 
 			// 1. Delete old Octree
-			if (m_RootNode) {
-
-				if (data_sources.empty() && !m_DataSources.empty())
-					data_sources = m_DataSources;
-
-				m_RootNode.reset();
-				m_RootNode = nullptr;
-			}
+			if (m_RootNode != OCTREE_NULL_INDEX && data_sources.empty() && !IsEmpty())
+				data_sources = GetAllOctreeDataSources();
 
+			m_RootNode = OCTREE_NULL_INDEX;
+			m_Nodes.clear();
+			m_FreeNodes.clear();
 			m_DataSources.clear();
+			for (auto& free_blocks : m_FreeDataBlocks)
+				free_blocks.clear();
+			m_DataSourceLocations.clear();
 
 			// 2. Calculate Initial Bounds of New Octree
 			if (!data_sources.empty()) {
@@ -1247,10 +1786,8 @@ namespace Louron {
 				m_Config.InitialBounds.BoundsMax = glm::vec3(-FLT_MAX);
 
 				for (const auto& data : data_sources) {
-					if (data) {
-						m_Config.InitialBounds.BoundsMin = glm::min(data->Bounds.BoundsMin, m_Config.InitialBounds.BoundsMin);
-						m_Config.InitialBounds.BoundsMax = glm::max(data->Bounds.BoundsMax, m_Config.InitialBounds.BoundsMax);
-					}
+					m_Config.InitialBounds.BoundsMin = glm::min(data.Bounds.BoundsMin, m_Config.InitialBounds.BoundsMin);
+					m_Config.InitialBounds.BoundsMax = glm::max(data.Bounds.BoundsMax, m_Config.InitialBounds.BoundsMax);
 				}
 
 				// Step 1: Calculate the initial center and extent
@@ -1260,34 +1797,32 @@ namespace Louron {
 				// Step 2: Find the largest extent to ensure the bounding box is a cube
 				float maxExtent = glm::compMax(extent);
 
-				// Step 3: Create a cubic bounding box centered on the original center
-				glm::vec3 halfExtent = glm::vec3(maxExtent) * 0.5f;
+				// Step 3: Create a cubic bounding box centered on the original center, with 
+				// some padding around the entire scene so every data source fits in the root
+				float scaleFactor = 1.1f;
+				glm::vec3 halfExtent = glm::vec3(maxExtent) * 0.5f * scaleFactor;
 
 				// Step 4: Adjust the bounds to make them uniform and cubic
 				m_Config.InitialBounds.BoundsMin = center - halfExtent;
 				m_Config.InitialBounds.BoundsMax = center + halfExtent;
 
-				// Optional: Apply a scaling factor to add some padding around the entire scene
-				float scaleFactor = 1.1f;
-				m_Config.InitialBounds.BoundsMin *= scaleFactor;
-				m_Config.InitialBounds.BoundsMax *= scaleFactor;
-
 			}
 			else {
 				m_Config.InitialBounds.BoundsMin = glm::vec3(-1000.0f);
 				m_Config.InitialBounds.BoundsMax = glm::vec3(1000.0f);
 			}
 
-			// 3. Pre-allocate the global data vector
-			size_t dataSourceCount = data_sources.size();
-			size_t initialCapacity = static_cast<size_t>(std::max(1024.0, std::pow(2.0, std::ceil(std::log2(dataSourceCount)))));
-			m_DataSources.reserve(initialCapacity);
+			// 3. Create Root Octree Node
+			m_RootNode = AllocateNode(m_Config.InitialBounds, OCTREE_NULL_INDEX);
 
-			// 4. Create Root Octree Node
-			m_RootNode = std::make_shared<OctreeBoundsNode<DataType>>(m_Config.InitialBounds, this);
+			if (data_sources.empty())
+				return;
 
-			if (!data_sources.empty())
-				InsertVector(data_sources);
+			// 4. Build the Octree in one pass, then insert anything the root could not 
+			// contain one by one so the Octree grows to fit it
+			std::vector<OctreeData> remaining_data_sources = BulkBuildOctree(data_sources, m_JobSystem);
+			if (!remaining_data_sources.empty())
+				InsertVector(remaining_data_sources);
 		}
 
 		/// <summary>
@@ -1302,10 +1837,11 @@ namespace Louron {
 			int zDirection = direction.z >= 0 ? 1 : -1;
 
 			// 2. Calculate the half size of the current root node.
-			glm::vec3 halfSize = m_RootNode->GetNodeBounds().Size() * 0.5f;
+			Bounds_AABB old_bounds = m_Nodes[m_RootNode].NodeBounds;
+			glm::vec3 halfSize = old_bounds.Size() * 0.5f;
 
 			// 3. Calculate the new center for the expanded root node.
-			glm::vec3 newCenter = m_RootNode->GetNodeBounds().Center() + glm::vec3(
+			glm::vec3 newCenter = old_bounds.Center() + glm::vec3(
 				xDirection * halfSize.x,
 				yDirection * halfSize.y,
 				zDirection * halfSize.z
@@ -1319,46 +1855,47 @@ namespace Louron {
 			new_bounds.BoundsMin = newCenter - newHalfSize;
 			new_bounds.BoundsMax = newCenter + newHalfSize;
 
-			// 6. Store old root node and create new root node
-			OctreeNode old_root_node = m_RootNode;
-			OctreeNode new_root_node = std::make_shared<OctreeBoundsNode<DataType>>(new_bounds, this);
-
-			// 7. Get the node index of the new root node which holds the old root node
-			int child_index = new_root_node->BestFitChild(m_RootNode->GetNodeBounds().Center());
+			// 6. Get the node index of the new root node which holds the old root node
+			int child_index = BestFitChild(new_bounds, old_bounds.Center());
 			if (child_index == -1) {
 				L_CORE_ERROR("Octree - Could Not Determine Child Region for Old Root Node.");
 				return false;
 			}
 
-			// 8. Set the root node to the new root node, and set the child at the appropriate index to the old root node
-			if (new_root_node->SetChildNode(child_index, old_root_node)) {
-				m_RootNode = new_root_node;
-			}
-			else {
-				L_CORE_ERROR("Octree - Could Not Set Old Root Node as Child to New Root Node - Invalid Index.");
-				return false;
-			}
+			// 7. Create the new root node, and set the child at the appropriate index to the old root node
+			uint32_t old_root_node = m_RootNode;
+			uint32_t new_root_node = AllocateNode(new_bounds, OCTREE_NULL_INDEX);
+
+			auto& new_root = m_Nodes[new_root_node];
+			new_root.ChildrenNodes[child_index] = old_root_node;
+			new_root.TotalNodeDataSourceSize = m_Nodes[old_root_node].TotalNodeDataSourceSize;
+			new_root.IsNodeSplit = true;
+
+			m_Nodes[old_root_node].ParentNode = new_root_node;
+			m_RootNode = new_root_node;
 			return true;
 		}
 
 		/// <summary>
 		/// This checks if the root node should be shrunk
 		/// </summary>
-		bool ShouldShrink() {
+		bool ShouldShrink() const {
+
+			const auto& root = m_Nodes[m_RootNode];
 
-			if (!m_RootNode->IsNodeSplit())
+			if (!root.IsNodeSplit)
 				return false;
 
-			if (m_RootNode->m_DataSourceSize > 0)
+			if (root.DataSourceSize > 0)
 				return false;
 
 			bool found_one_child_with_data = false;
-			for (const auto& child : m_RootNode->m_ChildrenNodes) {
+			for (uint32_t child_index : root.ChildrenNodes) {
 
-				if (!child)
+				if (child_index == OCTREE_NULL_INDEX)
 					continue;
 
-				if (child->TotalCount() == 0)
+				if (m_Nodes[child_index].TotalNodeDataSourceSize == 0)
 					continue;
 
 				if (found_one_child_with_data)
@@ -1373,17 +1910,17 @@ namespace Louron {
 		/// <summary>
 		/// This will return the most appropriate root node
 		/// </summary>
-		OctreeNode ShrinkOctree() {
+		uint32_t ShrinkOctree() const {
 
-			if (!m_RootNode)
-				return nullptr;
+			if (m_RootNode == OCTREE_NULL_INDEX)
+				return OCTREE_NULL_INDEX;
 
 			if (!ShouldShrink())
 				return m_RootNode;
 
-			for (int i = 0; i < m_RootNode->m_ChildrenNodes.size(); i++) {
-				if (m_RootNode->m_ChildrenNodes[i] && m_RootNode->m_ChildrenNodes[i]->TotalCount() > 0)
-					return m_RootNode->m_ChildrenNodes[i];
+			for (uint32_t child_index : m_Nodes[m_RootNode].ChildrenNodes) {
+				if (child_index != OCTREE_NULL_INDEX && m_Nodes[child_index].TotalNodeDataSourceSize > 0)
+					return child_index;
 			}
 
 			return m_RootNode;
@@ -1391,13 +1928,39 @@ namespace Louron {
 
 		OctreeBoundsConfig m_Config{};
 
-		OctreeNode m_RootNode;
+		/// <summary>
+		/// Splits bulk builds across its workers, bulk builds run on the calling
+		/// thread when this is null. Not owned by the Octree.
+		/// </summary>
+		JobSystem* m_JobSystem = nullptr;
+
+		/// <summary>
+		/// Node arena index of the root node.
+		/// </summary>
+		uint32_t m_RootNode = OCTREE_NULL_INDEX;
+
+		/// <summary>
+		/// Node arena, nodes are addressed by index and recycled through m_FreeNodes.
+		/// </summary>
+		std::vector<OctreeBoundsNode> m_Nodes{};
+		std::vector<uint32_t> m_FreeNodes{};
 
+		/// <summary>
+		/// Octree Data Storage, each node owns a power of two sized block of 
+		/// this arena. Freed blocks are recycled through m_FreeDataBlocks, 
+		/// indexed by the log2 of the block capacity.
+		/// </summary>
 		std::vector<OctreeData> m_DataSources{};
+		std::array<std::vector<uint32_t>, 32> m_FreeDataBlocks{};
 
-		std::array<std::vector<OctreeData>, 3> m_QueryReturnVectors{};
+		/// <summary>
+		/// Index of where each data source lives in the Octree, this is kept up to 
+		/// date whenever a data source is moved so Remove and Update do not need to 
+		/// search the Octree. DataType must be hashable.
+		/// </summary>
+		std::unordered_map<DataType, OctreeDataLocation> m_DataSourceLocations{};
 
-		std::mutex m_OctreeMutex{};
+		std::shared_mutex m_OctreeMutex{};
 
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+// Louron Core Headers
+#include "Components/UUID.h"
+#include "Components/Components.h"
+#include "Components/Light.h"
+#include "Components/Mesh.h"
+#include "Components/Skybox.h"
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// External Vendor Library Headers
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+namespace Louron {
+
+	constexpr uint32_t PREFAB_TEMPLATE_NULL_INDEX = UINT32_MAX;
+
+	/// <summary>
+	/// Copies of every component of one type within a prefab, and the
+	/// template entity each one belongs to.
+	/// </summary>
+	template<typename T>
+	struct PrefabComponentBlob {
+		std::vector<uint32_t> EntityIndices;
+		std::vector<T> Components;
+	};
+
+	template<typename... Component>
+	using PrefabComponentBlobs = std::tuple<PrefabComponentBlob<Component>...>;
+
+	/// <summary>
+	/// A prefab compiled into a flat array of entities so it can be instantiated
+	/// without walking the prefab's registry. Entities are in hierarchy order,
+	/// every parent comes before its children and the root is always first.
+	///
+	/// Components that only hold data are kept in blobs and copied into the
+	/// scene a whole blob at a time. Physics and script components need to be
+	/// initialised against the scene, so they are still added entity by entity.
+	/// </summary>
+	struct PrefabTemplate {
+
+		struct TemplateEntity {
+
+			/// <summary>
+			/// Handle of the entity in the prefab registry, which is also its prefab UUID.
+			/// </summary>
+			entt::entity PrefabEntity = entt::null;
+
+			uint32_t ParentIndex = PREFAB_TEMPLATE_NULL_INDEX;
+			std::vector<uint32_t> ChildIndices;
+
+			std::string Tag;
+
+			glm::vec3 Position = glm::vec3(0.0f);
+			glm::vec3 Rotation = glm::vec3(0.0f);
+			glm::vec3 Scale = glm::vec3(1.0f);
+
+			/// <summary>
+			/// Whether the entity has a rigidbody, collider or script component.
+			/// </summary>
+			bool HasSceneBoundComponents = false;
+		};
+
+		std::vector<TemplateEntity> Entities;
+
+		PrefabComponentBlobs<
+			CameraComponent,
+			AudioListener,
+			AudioEmitter,
+			MeshFilterComponent,
+			MeshRendererComponent,
+			PointLightComponent,
+			SpotLightComponent,
+			DirectionalLightComponent,
+			SkyboxComponent,
+			LODMeshComponent
+		> Blobs;
+
+		/// <summary>
+		/// Prefab UUID to template entity index, used to remap references
+		/// between prefab entities such as LOD mesh renderers.
+		/// </summary>
+		std::unordered_map<UUID, uint32_t> PrefabUUIDIndices;
+
+		bool IsEmpty() const { return Entities.empty(); }
+	};
+
+}
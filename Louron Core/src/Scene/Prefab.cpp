@@ -12,6 +12,8 @@
 #include "Components/Physics/Rigidbody.h"
 #include "Components/Physics/PhysicsWrappers.h"
 
+#include "../Debug/Profiler.h"
+
 #ifndef YAML_CPP_STATIC_DEFINE
 #define YAML_CPP_STATIC_DEFINE
 #endif
@@ -137,6 +139,7 @@ namespace Louron {
 	entt::entity Prefab::CreateEntity(const std::string& name) {
 
 		entt::entity entity = m_PrefabRegistry.create();
+		m_TemplateDirty = true;
 
 		// 1. Add UUID Component
 		// ID Component - We do not set this to the UUID of the 
@@ -161,7 +164,7 @@ namespace Louron {
 			hierarchy.m_Parent = m_PrefabRegistry.get<IDComponent>(m_RootEntity).ID;
 		}
 
-		m_EntityMap.emplace((uint32_t)entity, entity);
+		m_EntityMap.Insert((uint32_t)entity, entity);
 
 		return entity;
 	}
@@ -178,8 +181,9 @@ namespace Louron {
 			return;
 		}
 
-		m_EntityMap.erase((uint32_t)entity);
+		m_EntityMap.Erase((uint32_t)entity);
 		m_PrefabRegistry.destroy(entity);
+		m_TemplateDirty = true;
 		return;
 	}
 
@@ -198,9 +202,8 @@ namespace Louron {
 
 	entt::entity Prefab::FindEntityByUUID(const UUID& uuid)
 	{
-		if (m_EntityMap.find(uuid) != m_EntityMap.end()) {
-			return m_EntityMap.at(uuid);
-		}
+		if (entt::entity entity = m_EntityMap.TryFind(uuid); entity != entt::null)
+			return entity;
 
 		L_CORE_ERROR("Entity UUID not found in scene");
 		return entt::null;
@@ -366,6 +369,89 @@ namespace Louron {
 		return prefab_entity_handle;
 	}
 
+	const PrefabTemplate& Prefab::GetTemplate() {
+
+		if (m_TemplateDirty)
+			CompileTemplate();
+
+		return m_Template;
+	}
+
+	template<typename T>
+	static void CompileTemplateComponent(entt::registry& prefab_registry, entt::entity prefab_entity, uint32_t template_index, PrefabComponentBlob<T>& blob) {
+
+		if (!prefab_registry.has<T>(prefab_entity))
+			return;
+
+		T& component = blob.Components.emplace_back(prefab_registry.get<T>(prefab_entity));
+
+		// Blob components do not belong to an entity until they are instantiated
+		component.entity_uuid = NULL_UUID;
+		component.scene = nullptr;
+		component.entity_handle = entt::null;
+
+		blob.EntityIndices.push_back(template_index);
+	}
+
+	void Prefab::CompileTemplate() {
+
+		L_PROFILE_SCOPE("Prefab - Compile Template");
+
+		m_Template = PrefabTemplate{};
+		m_TemplateDirty = false;
+
+		if (!m_PrefabRegistry.valid(m_RootEntity))
+			return;
+
+		m_Template.Entities.reserve(m_PrefabRegistry.size<IDComponent>());
+		CompileTemplateEntity(m_RootEntity, PREFAB_TEMPLATE_NULL_INDEX);
+	}
+
+	void Prefab::CompileTemplateEntity(entt::entity prefab_entity, uint32_t parent_index) {
+
+		const uint32_t template_index = (uint32_t)m_Template.Entities.size();
+		m_Template.PrefabUUIDIndices[(uint32_t)prefab_entity] = template_index;
+
+		// 1. Flatten the entity, children are compiled after this
+		{
+			PrefabTemplate::TemplateEntity& template_entity = m_Template.Entities.emplace_back();
+			template_entity.PrefabEntity = prefab_entity;
+			template_entity.ParentIndex = parent_index;
+
+			if (m_PrefabRegistry.has<TagComponent>(prefab_entity))
+				template_entity.Tag = m_PrefabRegistry.get<TagComponent>(prefab_entity).Tag;
+
+			if (m_PrefabRegistry.has<TransformComponent>(prefab_entity)) {
+				const auto& transform = m_PrefabRegistry.get<TransformComponent>(prefab_entity);
+				template_entity.Position = transform.GetLocalPosition();
+				template_entity.Rotation = transform.GetLocalRotation();
+				template_entity.Scale = transform.GetLocalScale();
+			}
+
+			template_entity.HasSceneBoundComponents = m_PrefabRegistry.any<RigidbodyComponent, SphereColliderComponent, BoxColliderComponent, ScriptComponent>(prefab_entity);
+		}
+
+		std::apply([&](auto&... blob) {
+			(CompileTemplateComponent(m_PrefabRegistry, prefab_entity, template_index, blob), ...);
+		}, m_Template.Blobs);
+
+		// 2. Recurse Children
+		if (!m_PrefabRegistry.has<HierarchyComponent>(prefab_entity))
+			return;
+
+		for (const auto& child_uuid : m_PrefabRegistry.get<HierarchyComponent>(prefab_entity).GetChildren()) {
+
+			entt::entity child_entity = m_EntityMap.TryFind(child_uuid);
+			if (child_entity == entt::null) {
+				L_CORE_WARN("Prefab Child Entity Not Found - Skipping Child in Prefab: {0}", m_PrefabName);
+				continue;
+			}
+
+			m_Template.Entities[template_index].ChildIndices.push_back((uint32_t)m_Template.Entities.size());
+			CompileTemplateEntity(child_entity, template_index);
+		}
+	}
+
 	void Prefab::SerializeSubEntity(YAML::Emitter& out, entt::entity entity)
 	{
 
@@ -659,6 +745,8 @@ namespace Louron {
 			m_PrefabName = data["Prefab Name"].as<std::string>();
 		}
 
+		m_TemplateDirty = true;
+
 		YAML::Node entities = data["PrefabEntities"];
 
 		if (!entities)
@@ -9,6 +9,9 @@
 #include "Components/Physics/Collider.h"
 #include "Components/Physics/Rigidbody.h"
 
+#include "Entity Map.h"
+#include "Prefab Template.h"
+
 #include "Scene Systems/Physics System.h"
 
 // C++ Standard Library Headers
@@ -59,11 +62,16 @@ namespace Louron {
 			}
 
 			T& component = m_PrefabRegistry.emplace<T>(entity_handle, std::forward<Args>(args)...);
+			m_TemplateDirty = true;
 
 			return component;
 
 		}
 
+		/// <summary>
+		/// Changes made through the returned reference are not seen by the compiled
+		/// template until MarkTemplateDirty is called.
+		/// </summary>
 		template<typename T>
 		T& GetComponent(entt::entity entity_handle) {
 
@@ -90,21 +98,28 @@ namespace Louron {
 
 		}
 
+		template<typename T>
+		const T& GetComponent(entt::entity entity_handle) const {
+			return const_cast<Prefab*>(this)->GetComponent<T>(entity_handle);
+		}
+
 		template <typename T>
 		void RemoveComponent(entt::entity entity_handle) {
 
 			m_PrefabRegistry.remove_if_exists<T>(entity_handle);
+			m_TemplateDirty = true;
 		}
 
 		// This returns if the Entity has an applicable Component
 		template <typename T>
-		bool HasComponent(entt::entity entity) {
+		bool HasComponent(entt::entity entity) const {
 			return m_PrefabRegistry.has<T>(entity);
 		}
 
 		const std::string& GetPrefabName() const { return m_PrefabName; }
 		void SetPrefabName(const std::string& name) { 
 			m_PrefabName = name;
+			m_TemplateDirty = true;
 			if (m_RootEntity != entt::null) {
 				GetComponent<TagComponent>(m_RootEntity).Tag = name;
 			}
@@ -120,7 +135,28 @@ namespace Louron {
 		template<typename... Components>
 		auto GetAllEntitiesWith() { return m_PrefabRegistry.view<Components...>(); }
 
+		template<typename... Components>
+		auto GetAllEntitiesWith() const { return m_PrefabRegistry.view<const Components...>(); }
+
+		/// <summary>
+		/// Changes made through the registry are not seen by the compiled template
+		/// until MarkTemplateDirty is called.
+		/// </summary>
 		entt::registry* GetRegistry() { return &m_PrefabRegistry; }
+		const entt::registry* GetRegistry() const { return &m_PrefabRegistry; }
+
+		/// <summary>
+		/// Recompile the template the next time it is used. Creating or destroying
+		/// entities, adding or removing components and renaming the prefab already
+		/// do this, anything changed through GetComponent or GetRegistry must call it.
+		/// </summary>
+		void MarkTemplateDirty() { m_TemplateDirty = true; }
+
+		/// <summary>
+		/// The prefab compiled for Scene::InstantiatePrefab. It is compiled on 
+		/// first use, and again the next time it is used after the prefab changes.
+		/// </summary>
+		const PrefabTemplate& GetTemplate();
 		
 		/// <summary>
 		/// Will Serialise the Prefab into a file.
@@ -142,16 +178,22 @@ namespace Louron {
 		void DeserializeSubEntity(entt::entity entity, entt::entity parent_entity, const std::unordered_map<UUID, YAML::Node>& entity_node_map, UUID node_index);
 
 
-		std::unordered_map<UUID, entt::entity> m_EntityMap;
+		EntityMap m_EntityMap;
 
 		entt::entity CopyEntity(Entity start_entity, UUID parent_uuid);
 
+		void CompileTemplate();
+		void CompileTemplateEntity(entt::entity prefab_entity, uint32_t parent_index);
+
 		entt::registry m_PrefabRegistry;
 		entt::entity m_RootEntity = entt::null;
 
 		std::string m_PrefabName;
 
 		bool m_Mutable = false;
+
+		PrefabTemplate m_Template;
+		bool m_TemplateDirty = true;
 		
 		friend class Scene;
 	};
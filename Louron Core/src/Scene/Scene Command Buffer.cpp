@@ -0,0 +1,77 @@
+#include "Scene Command Buffer.h"
+
+// Louron Core Headers
+#include "Scene.h"
+#include "Entity.h"
+
+#include "Components/Components.h"
+
+#include "../Debug/Profiler.h"
+
+// C++ Standard Library Headers
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	void SceneCommandBuffer::DestroyEntity(const UUID& entity_uuid) {
+		m_DestroyedEntities.push_back(entity_uuid);
+	}
+
+	void SceneCommandBuffer::SetParent(const UUID& entity_uuid, const UUID& parent_uuid) {
+
+		Record(entity_uuid, [parent_uuid](Entity entity) {
+			entity.GetComponent<HierarchyComponent>().AttachParent(parent_uuid);
+		});
+	}
+
+	void SceneCommandBuffer::DetachParent(const UUID& entity_uuid) {
+
+		Record(entity_uuid, [](Entity entity) {
+			entity.GetComponent<HierarchyComponent>().DetachParent();
+		});
+	}
+
+	void SceneCommandBuffer::Record(const UUID& entity_uuid, std::function<void(Entity)> command) {
+		m_Commands.push_back({ entity_uuid, std::move(command) });
+	}
+
+	void SceneCommandBuffer::Playback(Scene* scene) {
+
+		if (!scene || IsEmpty())
+			return;
+
+		L_PROFILE_SCOPE("Scene Command Buffer - Playback");
+
+		// Commands may record more commands into this buffer, so play back from a local copy
+		std::vector<SceneCommand> commands = std::move(m_Commands);
+		std::vector<UUID> destroyed_entities = std::move(m_DestroyedEntities);
+		Clear();
+
+		for (SceneCommand& command : commands) {
+
+			// Earlier commands or other buffers may have already destroyed the entity
+			Entity entity = scene->TryFindEntityByUUID(command.EntityUUID);
+			if (entity)
+				command.Command(entity);
+		}
+
+		if (destroyed_entities.empty())
+			return;
+
+		std::vector<Entity> entities;
+		entities.reserve(destroyed_entities.size());
+
+		for (const UUID& entity_uuid : destroyed_entities)
+			if (Entity entity = scene->TryFindEntityByUUID(entity_uuid, true))
+				entities.push_back(entity);
+
+		scene->DestroyEntities(entities);
+	}
+
+	void SceneCommandBuffer::Clear() {
+		m_Commands.clear();
+		m_DestroyedEntities.clear();
+	}
+
+}
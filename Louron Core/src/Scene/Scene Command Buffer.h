@@ -0,0 +1,106 @@
+#pragma once
+
+// Louron Core Headers
+#include "Components/UUID.h"
+
+// C++ Standard Library Headers
+#include <functional>
+#include <vector>
+
+// External Vendor Library Headers
+
+namespace Louron {
+
+	class Scene;
+	class Entity;
+
+	/// <summary>
+	/// Records structural changes to a scene, destroying entities, adding or removing
+	/// components and reparenting, so they can be applied later at a sync point
+	/// where nothing is iterating the registry. A buffer is only recorded into by
+	/// one thread, so recording never locks. Systems running on worker threads
+	/// record into their own buffer and hand it to Scene::SubmitCommandBuffer.
+	/// </summary>
+	class SceneCommandBuffer {
+
+	public:
+
+		SceneCommandBuffer() = default;
+		~SceneCommandBuffer() = default;
+
+		SceneCommandBuffer(const SceneCommandBuffer&) = delete;
+		SceneCommandBuffer& operator=(const SceneCommandBuffer&) = delete;
+
+		SceneCommandBuffer(SceneCommandBuffer&&) noexcept = default;
+		SceneCommandBuffer& operator=(SceneCommandBuffer&&) noexcept = default;
+
+		/// <summary>
+		/// Destroy the entity and its children. All destroys in a buffer are
+		/// applied together as one batch after the buffer's other commands.
+		/// </summary>
+		void DestroyEntity(const UUID& entity_uuid);
+
+		/// <summary>
+		/// Add a copy of the component to the entity, if it does not already have one.
+		/// </summary>
+		template<typename T>
+		void AddComponent(const UUID& entity_uuid, const T& component = T{});
+
+		/// <summary>
+		/// Remove the component from the entity, if it has one.
+		/// </summary>
+		template<typename T>
+		void RemoveComponent(const UUID& entity_uuid);
+
+		void SetParent(const UUID& entity_uuid, const UUID& parent_uuid);
+		void DetachParent(const UUID& entity_uuid);
+
+		/// <summary>
+		/// Record any other change to run against the entity at the sync point.
+		/// The command is skipped if the entity no longer exists by then.
+		/// </summary>
+		void Record(const UUID& entity_uuid, std::function<void(Entity)> command);
+
+		/// <summary>
+		/// Apply every recorded command to the scene in the order recorded, then
+		/// clear the buffer. Must be called from the main thread.
+		/// </summary>
+		void Playback(Scene* scene);
+
+		bool IsEmpty() const { return m_Commands.empty() && m_DestroyedEntities.empty(); }
+		void Clear();
+
+	private:
+
+		struct SceneCommand {
+			UUID EntityUUID = NULL_UUID;
+			std::function<void(Entity)> Command;
+		};
+
+		std::vector<SceneCommand> m_Commands;
+		std::vector<UUID> m_DestroyedEntities;
+
+	};
+
+	// Entity is incomplete here, so the commands take it generically and
+	// are only instantiated where the caller has included Entity.h
+
+	template<typename T>
+	void SceneCommandBuffer::AddComponent(const UUID& entity_uuid, const T& component) {
+
+		Record(entity_uuid, [component](auto entity) {
+			if (!entity.template HasComponent<T>())
+				entity.template AddComponent<T>(component);
+		});
+	}
+
+	template<typename T>
+	void SceneCommandBuffer::RemoveComponent(const UUID& entity_uuid) {
+
+		Record(entity_uuid, [](auto entity) {
+			if (entity.template HasComponent<T>())
+				entity.template RemoveComponent<T>();
+		});
+	}
+
+}
@@ -227,6 +227,7 @@ namespace Louron {
 		out << YAML::Key << "Scene Name" << YAML::Value << scene_ref->m_SceneConfig.Name;
 		out << YAML::Key << "Scene Asset Directory" << YAML::Value << scene_ref->m_SceneConfig.AssetDirectory.string();
 		out << YAML::Key << "Scene Pipeline Type" << YAML::Value << std::to_string((uint8_t)scene_ref->m_SceneConfig.ScenePipelineType);
+		out << YAML::Key << "Scene Spatial Index" << YAML::Value << std::to_string((uint8_t)scene_ref->m_SceneConfig.SceneSpatialIndexType);
 
 		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
 
@@ -312,6 +313,12 @@ namespace Louron {
 					break;
 				}
 			}
+
+			// Older scene files do not have a spatial index, these use the Octree
+			if (data["Scene Spatial Index"])
+				scene_ref->m_SceneConfig.SceneSpatialIndexType = (SpatialIndexType)data["Scene Spatial Index"].as<uint8_t>();
+			else
+				scene_ref->m_SceneConfig.SceneSpatialIndexType = SpatialIndexType::Octree;
 			
 			auto entities = data["Entities"];
 			if (entities) {
@@ -461,6 +468,12 @@ namespace Louron {
 			}
 			//PhysicsSystem::Update(scene_ref);
 
+			// Every entity now exists, so the hierarchy links can cache their handles
+			auto hierarchy_update = scene_ref->GetAllEntitiesWith<HierarchyComponent>();
+			for (const auto& entity_handle : hierarchy_update) {
+				hierarchy_update.get<HierarchyComponent>(entity_handle).ResolveHandles();
+			}
+
 			auto transform_update = scene_ref->GetAllEntitiesWith<TransformComponent>();
 			for (const auto& entity_handle : transform_update) {
 				transform_update.get<TransformComponent>(entity_handle).SetPosition(transform_update.get<TransformComponent>(entity_handle).GetLocalPosition());
@@ -475,28 +488,8 @@ namespace Louron {
 				camera_component.CameraInstance = std::make_shared<SceneCamera>();
 			}
 
-			// Calculate Overall Scene Octree
-			OctreeBoundsConfig octree_config{};
-
-			std::vector<OctreeBounds<Entity>::OctreeData> data_sources;
-
-			auto bounds_view_mesh = scene_ref->GetAllEntitiesWith<MeshFilterComponent, MeshRendererComponent>();
-			for (const auto& entity_handle : bounds_view_mesh) {
-				auto& mesh_filter = bounds_view_mesh.get<MeshFilterComponent>(entity_handle);
-
-				// Ensure the AABB is up to date
-				mesh_filter.UpdateTransformedAABB();
-
-				const auto& aabb = mesh_filter.TransformedAABB;
-
-				data_sources.push_back(std::make_shared<OctreeDataSource<Entity>>(mesh_filter.GetEntity(), aabb));
-			}
-
-			octree_config.Looseness = 1.25f;
-			octree_config.PreferredDataSourceLimit = 8;
-
-			// Create the octree and insert data sources
-			scene_ref->m_Octree = std::make_shared<OctreeBounds<Entity>>(octree_config, data_sources);
+			// Build the Scene Spatial Index over every mesh
+			scene_ref->BuildSpatialIndex();
 			
 			return true;
 		}
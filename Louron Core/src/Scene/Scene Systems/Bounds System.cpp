@@ -0,0 +1,404 @@
+#include "Bounds System.h"
+
+// Louron Core Headers
+#include "../Scene.h"
+#include "../Entity.h"
+#include "../Bounds.h"
+#include "../OctreeBounds.h"
+#include "../Spatial Index.h"
+#include "../Components/Components.h"
+#include "../Components/Mesh.h"
+
+#include "../../Asset/Asset Manager API.h"
+
+#include "../../Core/Job System.h"
+
+#include "../../Debug/Profiler.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <shared_mutex>
+#include <unordered_map>
+
+// External Vendor Library Headers
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Louron {
+
+#pragma region HelperFunctions
+
+	// Below this many AABBs per batch the cost of handing it to a worker outweighs the transform work
+	static constexpr size_t s_MinAABBsPerThread = 4096;
+
+	/// <summary>
+	/// Flat batch of AABBs gathered from the registry. Gathering and writing 
+	/// back is serial, only the transform step touches no shared state.
+	/// </summary>
+	struct TransformedAABBBatch {
+
+		std::vector<MeshFilterComponent*> Components;
+		std::vector<Bounds_AABB> LocalBounds;
+		std::vector<glm::mat4> Transforms;
+		std::vector<Bounds_AABB> Results;
+
+		std::unordered_map<AssetHandle, Bounds_AABB> MeshBoundsCache;
+
+		void Add(MeshFilterComponent& mesh_filter, entt::registry* registry, entt::entity entity_handle, bool force_update = false) {
+
+			if (mesh_filter.MeshFilterAssetHandle == NULL_UUID)
+				return;
+
+			if (!registry->has<TransformComponent>(entity_handle))
+				return;
+
+			auto cache_it = MeshBoundsCache.find(mesh_filter.MeshFilterAssetHandle);
+			if (cache_it == MeshBoundsCache.end()) {
+
+				auto mesh_asset = AssetManager::GetAsset<AssetMesh>(mesh_filter.MeshFilterAssetHandle);
+				if (!mesh_asset)
+					return;
+
+				cache_it = MeshBoundsCache.emplace(mesh_filter.MeshFilterAssetHandle, mesh_asset->MeshBounds).first;
+			}
+
+			// Cleared before the transform is read, so a move made after the read marks it stale again.
+			// This also means an entity listed twice is only gathered once
+			if (!mesh_filter.AABBNeedsUpdate.exchange(false, std::memory_order_acq_rel) && !force_update)
+				return;
+
+			// GetGlobalTransform lazily rebuilds parent chains, so it is called while gathering and not in the ParallelFor ranges
+			Components.push_back(&mesh_filter);
+			LocalBounds.push_back(cache_it->second);
+			Transforms.push_back(registry->get<TransformComponent>(entity_handle).GetGlobalTransform());
+		}
+
+		void Process(JobSystem& job_system) {
+
+			const size_t count = Components.size();
+			if (count == 0)
+				return;
+
+			Results.resize(count);
+
+			// Contiguous ranges per batch, the calling thread takes the first range
+			job_system.ParallelFor(count, s_MinAABBsPerThread, [this](size_t range_start, size_t range_end) {
+				Bounds_AABB::Transform(LocalBounds.data() + range_start, Transforms.data() + range_start, Results.data() + range_start, range_end - range_start);
+			});
+
+			for (size_t i = 0; i < count; i++)
+				Components[i]->TransformedAABB = Results[i];
+		}
+	};
+
+	/// <summary>
+	/// Narrow phase for scene ray queries. The ray is moved into mesh space so the 
+	/// sub mesh triangles do not need transforming, and the mesh space distance is 
+	/// scaled back to world space.
+	/// </summary>
+	static bool RaycastMeshTriangles(Entity entity, const Bounds_Ray& ray, float max_distance, float& distance) {
+
+		if (!entity || !entity.HasComponent<MeshFilterComponent>() || !entity.HasComponent<TransformComponent>())
+			return false;
+
+		auto mesh_asset = AssetManager::GetAsset<AssetMesh>(entity.GetComponent<MeshFilterComponent>().MeshFilterAssetHandle);
+		if (!mesh_asset)
+			return false;
+
+		glm::mat4 inverse_transform = glm::inverse(entity.GetComponent<TransformComponent>().GetGlobalTransform());
+
+		glm::vec3 local_origin = glm::vec3(inverse_transform * glm::vec4(ray.RayOrigin, 1.0f));
+		glm::vec3 local_direction = glm::vec3(inverse_transform * glm::vec4(ray.RayDirection, 0.0f));
+
+		// Mesh space units per world space unit along the ray
+		float local_scale = glm::length(local_direction);
+		if (local_scale <= 0.0f)
+			return false;
+
+		Bounds_Ray local_ray(local_origin, local_direction);
+		float local_max_distance = max_distance * local_scale;
+
+		bool hit = false;
+		for (const auto& sub_mesh : mesh_asset->SubMeshes) {
+
+			float sub_mesh_distance = 0.0f;
+			if (sub_mesh && sub_mesh->Raycast(local_ray, local_max_distance, sub_mesh_distance)) {
+				local_max_distance = sub_mesh_distance;
+				hit = true;
+			}
+		}
+
+		if (hit)
+			distance = local_max_distance / local_scale;
+
+		return hit;
+	}
+
+#pragma endregion
+
+	void BoundsSystem::UpdateTransformedAABBs(Scene* scene, bool force_update) {
+
+		L_PROFILE_SCOPE("Bounds System - Update Transformed AABBs");
+
+		if (!scene)
+			return;
+
+		entt::registry* registry = scene->GetRegistry();
+
+		TransformedAABBBatch batch;
+
+		auto view = registry->view<MeshFilterComponent>();
+		for (const auto& entity_handle : view) {
+
+			auto& mesh_filter = view.get<MeshFilterComponent>(entity_handle);
+			if (force_update || mesh_filter.AABBNeedsUpdate.load(std::memory_order_acquire))
+				batch.Add(mesh_filter, registry, entity_handle, force_update);
+		}
+
+		batch.Process(scene->GetJobSystem());
+	}
+
+	void BoundsSystem::UpdateTransformedAABBs(Scene* scene, const std::vector<entt::entity>& entities) {
+
+		L_PROFILE_SCOPE("Bounds System - Update Transformed AABBs");
+
+		if (!scene)
+			return;
+
+		entt::registry* registry = scene->GetRegistry();
+
+		TransformedAABBBatch batch;
+
+		for (const auto& entity_handle : entities) {
+
+			if (!registry->valid(entity_handle) || !registry->has<MeshFilterComponent>(entity_handle))
+				continue;
+
+			auto& mesh_filter = registry->get<MeshFilterComponent>(entity_handle);
+			if (mesh_filter.AABBNeedsUpdate.load(std::memory_order_acquire))
+				batch.Add(mesh_filter, registry, entity_handle);
+		}
+
+		batch.Process(scene->GetJobSystem());
+	}
+
+	bool BoundsSystem::Raycast(Scene* scene, const Bounds_Ray& ray, float max_distance, SceneRaycastHit& hit, bool test_triangles) {
+
+		L_PROFILE_SCOPE("Bounds System - Raycast");
+
+		if (!scene)
+			return false;
+
+		auto spatial_index = scene->GetSpatialIndex().lock();
+		if (!spatial_index)
+			return false;
+
+		std::shared_lock lock(spatial_index->GetMutex());
+
+		SpatialIndex<Entity>::RayFilter filter;
+		if (test_triangles) {
+			filter = [&](const SpatialIndex<Entity>::IndexData& data_source, float& distance) -> bool {
+				return RaycastMeshTriangles(data_source.Data, ray, max_distance, distance);
+			};
+		}
+
+		SpatialIndex<Entity>::RayHit index_hit;
+		if (!spatial_index->Raycast(ray, max_distance, index_hit, filter))
+			return false;
+
+		hit.EntityHandle = static_cast<entt::entity>(index_hit.DataSource.Data);
+		hit.Distance = index_hit.Distance;
+		hit.Point = ray.GetPoint(index_hit.Distance);
+		return true;
+	}
+
+	void BoundsSystem::RaycastAll(Scene* scene, const Bounds_Ray& ray, float max_distance, std::vector<SceneRaycastHit>& hits, bool test_triangles) {
+
+		L_PROFILE_SCOPE("Bounds System - Raycast All");
+
+		hits.clear();
+
+		if (!scene)
+			return;
+
+		auto spatial_index = scene->GetSpatialIndex().lock();
+		if (!spatial_index)
+			return;
+
+		std::shared_lock lock(spatial_index->GetMutex());
+
+		SpatialIndex<Entity>::RayFilter filter;
+		if (test_triangles) {
+			filter = [&](const SpatialIndex<Entity>::IndexData& data_source, float& distance) -> bool {
+				return RaycastMeshTriangles(data_source.Data, ray, max_distance, distance);
+			};
+		}
+
+		std::vector<SpatialIndex<Entity>::RayHit> index_hits;
+		spatial_index->RaycastAll(ray, max_distance, index_hits, filter);
+
+		hits.reserve(index_hits.size());
+		for (const auto& index_hit : index_hits)
+			hits.push_back({ static_cast<entt::entity>(index_hit.DataSource.Data), index_hit.Distance, ray.GetPoint(index_hit.Distance) });
+	}
+
+	std::vector<SpatialIndexBenchmarkResult> BoundsSystem::BenchmarkSpatialIndexes(Scene* scene, uint32_t query_count) {
+
+		std::vector<SpatialIndexBenchmarkResult> results;
+
+		if (!scene)
+			return results;
+
+		// Benchmark over what the scene's index holds, so nothing in the scene is modified
+		std::vector<OctreeDataSource<Entity>> data_sources;
+		if (auto spatial_index = scene->GetSpatialIndex().lock(); spatial_index) {
+			std::shared_lock lock(spatial_index->GetMutex());
+			data_sources = spatial_index->GetAllDataSources();
+		}
+
+		if (data_sources.empty()) {
+			L_CORE_WARN("Spatial Index Benchmark - Scene Has No Bounds to Benchmark.");
+			return results;
+		}
+
+		Bounds_AABB scene_bounds{};
+		for (const auto& data_source : data_sources) {
+			scene_bounds.BoundsMin = glm::min(scene_bounds.BoundsMin, data_source.Bounds.BoundsMin);
+			scene_bounds.BoundsMax = glm::max(scene_bounds.BoundsMax, data_source.Bounds.BoundsMax);
+		}
+
+		const glm::vec3 scene_size = glm::max(scene_bounds.Size(), glm::vec3(1.0f));
+		const float scene_extent = glm::length(scene_size);
+
+		// 1. Generate the same queries for every index
+		std::mt19937 random_engine(1337);
+		std::uniform_real_distribution<float> unit_distribution(0.0f, 1.0f);
+		std::uniform_real_distribution<float> direction_distribution(-1.0f, 1.0f);
+
+		auto random_point = [&]() {
+			return scene_bounds.BoundsMin + scene_size * glm::vec3(unit_distribution(random_engine), unit_distribution(random_engine), unit_distribution(random_engine));
+		};
+
+		auto random_direction = [&]() {
+			glm::vec3 direction(direction_distribution(random_engine), direction_distribution(random_engine), direction_distribution(random_engine));
+			return glm::length(direction) > 0.001f ? glm::normalize(direction) : glm::vec3(0.0f, 0.0f, 1.0f);
+		};
+
+		std::vector<Bounds_AABB> query_aabbs;
+		std::vector<Bounds_Sphere> query_spheres;
+		std::vector<Frustum> query_frustums;
+		std::vector<Bounds_Ray> query_rays;
+
+		query_aabbs.reserve(query_count);
+		query_spheres.reserve(query_count);
+		query_frustums.reserve(query_count);
+		query_rays.reserve(query_count);
+
+		for (uint32_t i = 0; i < query_count; i++) {
+
+			// AABBs and spheres cover between 1% and 10% of the scene
+			glm::vec3 centre = random_point();
+			float query_extent = scene_extent * (0.01f + 0.09f * unit_distribution(random_engine));
+			query_aabbs.emplace_back(centre - glm::vec3(query_extent * 0.5f), centre + glm::vec3(query_extent * 0.5f));
+			query_spheres.emplace_back(random_point(), query_extent * 0.5f);
+
+			// Camera frustums see half way across the scene
+			glm::vec3 eye = random_point();
+			glm::vec3 forward = random_direction();
+			glm::vec3 up = glm::abs(forward.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+			glm::mat4 projection_matrix = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, scene_extent * 0.5f);
+			query_frustums.emplace_back(projection_matrix * glm::lookAt(eye, eye + forward, up));
+
+			query_rays.emplace_back(random_point(), random_direction());
+		}
+
+		// Move a tenth of the bounds by up to 1% of the scene
+		std::vector<OctreeDataSource<Entity>> moved_data_sources;
+		moved_data_sources.reserve(data_sources.size() / 10 + 1);
+		for (size_t i = 0; i < data_sources.size(); i += 10) {
+			glm::vec3 offset = random_direction() * scene_extent * 0.01f * unit_distribution(random_engine);
+			moved_data_sources.emplace_back(data_sources[i].Data, Bounds_AABB(data_sources[i].Bounds.BoundsMin + offset, data_sources[i].Bounds.BoundsMax + offset));
+		}
+
+		// 2. Time each index against the queries
+		using Clock = std::chrono::high_resolution_clock;
+		auto elapsed_ms = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+		for (SpatialIndexType index_type : { SpatialIndexType::Octree, SpatialIndexType::BVH }) {
+
+			SpatialIndexBenchmarkResult result{};
+			result.IndexType = index_type;
+			result.DataSourceCount = data_sources.size();
+
+			auto start = Clock::now();
+			std::shared_ptr<SpatialIndex<Entity>> spatial_index = Scene::CreateSpatialIndex(index_type, data_sources, &scene->GetJobSystem());
+			result.BuildTime = elapsed_ms(start);
+
+			std::vector<OctreeDataSource<Entity>> query_result;
+
+			start = Clock::now();
+			for (const auto& query : query_aabbs) {
+				spatial_index->Query(query, query_result);
+				result.QueryResultCount += query_result.size();
+			}
+			result.AABBQueryTime = elapsed_ms(start);
+
+			start = Clock::now();
+			for (const auto& query : query_spheres) {
+				spatial_index->Query(query, query_result);
+				result.QueryResultCount += query_result.size();
+			}
+			result.SphereQueryTime = elapsed_ms(start);
+
+			start = Clock::now();
+			for (const auto& query : query_frustums) {
+				spatial_index->Query(query, query_result);
+				result.QueryResultCount += query_result.size();
+			}
+			result.FrustumQueryTime = elapsed_ms(start);
+
+			// Batches of a camera plus a few shadow views, like the renderer submits
+			std::vector<OctreeQueryVolume> query_volumes;
+			std::vector<std::vector<OctreeDataSource<Entity>>> batch_results;
+
+			start = Clock::now();
+			for (uint32_t first = 0; first < query_count; first += 4) {
+
+				query_volumes.clear();
+				for (uint32_t i = first; i < glm::min(first + 4, query_count); i++)
+					query_volumes.emplace_back(query_frustums[i]);
+
+				spatial_index->Query(query_volumes, batch_results);
+				for (const auto& batch_result : batch_results)
+					result.QueryResultCount += batch_result.size();
+			}
+			result.BatchQueryTime = elapsed_ms(start);
+
+			SpatialIndex<Entity>::RayHit ray_hit;
+
+			start = Clock::now();
+			for (const auto& query : query_rays) {
+				if (spatial_index->Raycast(query, scene_extent, ray_hit))
+					result.QueryResultCount++;
+			}
+			result.RaycastTime = elapsed_ms(start);
+
+			start = Clock::now();
+			for (const auto& data_source : moved_data_sources)
+				spatial_index->Update(data_source.Data, data_source.Bounds);
+			spatial_index->PerformMaintenance();
+			result.UpdateTime = elapsed_ms(start);
+
+			L_CORE_INFO("Spatial Index Benchmark - {0}: {1} Bounds, Build {2:.3f}ms, AABB {3:.3f}ms, Sphere {4:.3f}ms, Frustum {5:.3f}ms, Batch {6:.3f}ms, Ray {7:.3f}ms, Update {8:.3f}ms ({9} Queries Each, {10} Results)",
+				index_type == SpatialIndexType::BVH ? "BVH" : "Octree", result.DataSourceCount, result.BuildTime, result.AABBQueryTime, result.SphereQueryTime,
+				result.FrustumQueryTime, result.BatchQueryTime, result.RaycastTime, result.UpdateTime, query_count, result.QueryResultCount);
+
+			results.push_back(result);
+		}
+
+		return results;
+	}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// Louron Core Headers
+#include "../Bounds.h"
+#include "../Spatial Index.h"
+
+// C++ Standard Library Headers
+#include <vector>
+
+// External Vendor Library Headers
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+namespace Louron {
+
+	class Scene;
+
+	/// <summary>
+	/// A mesh entity hit by a scene ray query.
+	/// </summary>
+	struct SceneRaycastHit {
+		entt::entity EntityHandle = entt::null;
+		float Distance = 0.0f;
+		glm::vec3 Point = glm::vec3(0.0f);
+	};
+
+	/// <summary>
+	/// Timings in milliseconds of one spatial index over the bounds of a scene, 
+	/// each query time is the total over every query of that kind.
+	/// </summary>
+	struct SpatialIndexBenchmarkResult {
+
+		SpatialIndexType IndexType = SpatialIndexType::Octree;
+		size_t DataSourceCount = 0;
+
+		double BuildTime = 0.0;
+		double AABBQueryTime = 0.0;
+		double SphereQueryTime = 0.0;
+		double FrustumQueryTime = 0.0;
+		double BatchQueryTime = 0.0;
+		double RaycastTime = 0.0;
+		double UpdateTime = 0.0;
+
+		/// <summary>
+		/// Total data sources returned over every query, this should be the same for each index.
+		/// </summary>
+		size_t QueryResultCount = 0;
+	};
+
+	class BoundsSystem {
+
+	public:
+
+		/// <summary>
+		/// Recompute the world space AABB of every MeshFilterComponent that has 
+		/// AABBNeedsUpdate set, or every MeshFilterComponent when force_update is true.
+		/// Large batches are split across worker threads.
+		/// </summary>
+		static void UpdateTransformedAABBs(Scene* scene, bool force_update = false);
+
+		/// <summary>
+		/// Recompute the world space AABB of the given entities if their 
+		/// MeshFilterComponent has AABBNeedsUpdate set. Invalid entities and 
+		/// entities without a MeshFilterComponent are skipped.
+		/// </summary>
+		static void UpdateTransformedAABBs(Scene* scene, const std::vector<entt::entity>& entities);
+
+		/// <summary>
+		/// Find the nearest mesh entity hit by the ray using the scene Octree, without 
+		/// reading anything back from the GPU. If test_triangles is true the ray is 
+		/// tested against the triangles of each sub mesh, otherwise only the world AABB.
+		/// Call from the main thread, world transforms are rebuilt lazily when read.
+		/// </summary>
+		/// <returns>True if a mesh entity was hit within max_distance.</returns>
+		static bool Raycast(Scene* scene, const Bounds_Ray& ray, float max_distance, SceneRaycastHit& hit, bool test_triangles = true);
+
+		/// <summary>
+		/// Find every mesh entity hit by the ray, sorted nearest first.
+		/// </summary>
+		static void RaycastAll(Scene* scene, const Bounds_Ray& ray, float max_distance, std::vector<SceneRaycastHit>& hits, bool test_triangles = true);
+
+		/// <summary>
+		/// Build every spatial index type over the bounds currently in the scene's spatial 
+		/// index, then time the same randomly placed AABB, sphere, frustum, batched and 
+		/// ray queries against each, followed by moving a tenth of the bounds. Queries 
+		/// are seeded so repeated runs on the same scene are comparable. The scene's 
+		/// own index is left untouched, and the results are also written to the log.
+		/// </summary>
+		static std::vector<SpatialIndexBenchmarkResult> BenchmarkSpatialIndexes(Scene* scene, uint32_t query_count = 1000);
+
+	private:
+
+		BoundsSystem() = delete;
+		BoundsSystem(const BoundsSystem&) = delete;
+		~BoundsSystem() = delete;
+	};
+
+}
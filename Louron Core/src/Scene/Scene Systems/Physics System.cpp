@@ -6,13 +6,16 @@
 #include "../Entity.h"
 #include "../Components/Physics/Rigidbody.h"
 #include "../Components/Physics/Collider.h"
+#include "../Components/Physics/PhysicsWrappers.h"
+
+#include "Transform System.h"
 
 #include "../../Debug/Profiler.h"
 
 #include "../../Core/Time.h"
 
 // C++ Standard Library Headers
-
+#include <algorithm>
 
 // External Vendor Library Headers
 #include <glm/glm.hpp>
@@ -136,7 +139,7 @@ namespace Louron {
 
 				if (auto shape_ref = shape_weak_ref.first.lock(); shape_ref) {
 
-					Entity shape_entity = scene->FindEntityByUUID(shape_weak_ref.second);
+					Entity shape_entity = scene->TryFindEntityByUUID(shape_weak_ref.second, true);
 
 					if (!shape_entity)
 						continue;
@@ -182,6 +185,79 @@ namespace Louron {
 		L_CORE_INFO("Rigidbody Has Been Successfully Removed from Entity ({0}:{1}).", entity.GetName(), entity.GetUUID());
 	}
 
+	void PhysicsSystem::RemoveActorsFromScene(const std::vector<Entity>& entities, Scene* scene) {
+
+		PxScene* phys_scene = scene ? scene->GetPhysScene() : nullptr;
+		if (!phys_scene)
+			return;
+
+		std::vector<PxActor*> actors;
+
+		auto add_actor = [&](const std::shared_ptr<RigidDynamic>& rigidbody) {
+			if (rigidbody && rigidbody->GetActor() && rigidbody->GetActor()->getScene() == phys_scene)
+				actors.push_back(rigidbody->GetActor());
+		};
+
+		for (Entity entity : entities) {
+
+			if (entity.HasComponent<RigidbodyComponent>())
+				add_actor(entity.GetComponent<RigidbodyComponent>().GetActor());
+
+			if (entity.HasComponent<SphereColliderComponent>())
+				if (auto shape = entity.GetComponent<SphereColliderComponent>().GetShape(); shape && shape->IsStatic())
+					add_actor(shape->GetRigidbody());
+
+			if (entity.HasComponent<BoxColliderComponent>())
+				if (auto shape = entity.GetComponent<BoxColliderComponent>().GetShape(); shape && shape->IsStatic())
+					add_actor(shape->GetRigidbody());
+		}
+
+		if (actors.empty())
+			return;
+
+		// Static collider actors can be shared, so drop any duplicates
+		std::sort(actors.begin(), actors.end());
+		actors.erase(std::unique(actors.begin(), actors.end()), actors.end());
+
+		phys_scene->removeActors(actors.data(), static_cast<PxU32>(actors.size()));
+	}
+
+	void PhysicsSystem::AddActorsToScene(const std::vector<Entity>& entities, Scene* scene) {
+
+		PxScene* phys_scene = scene ? scene->GetPhysScene() : nullptr;
+		if (!phys_scene)
+			return;
+
+		std::vector<PxActor*> actors;
+
+		auto add_actor = [&](const std::shared_ptr<RigidDynamic>& rigidbody) {
+			if (rigidbody && rigidbody->GetActor() && !rigidbody->GetActor()->getScene())
+				actors.push_back(rigidbody->GetActor());
+		};
+
+		for (Entity entity : entities) {
+
+			if (entity.HasComponent<RigidbodyComponent>())
+				add_actor(entity.GetComponent<RigidbodyComponent>().GetActor());
+
+			if (entity.HasComponent<SphereColliderComponent>())
+				if (auto shape = entity.GetComponent<SphereColliderComponent>().GetShape(); shape && shape->IsStatic())
+					add_actor(shape->GetRigidbody());
+
+			if (entity.HasComponent<BoxColliderComponent>())
+				if (auto shape = entity.GetComponent<BoxColliderComponent>().GetShape(); shape && shape->IsStatic())
+					add_actor(shape->GetRigidbody());
+		}
+
+		if (actors.empty())
+			return;
+
+		std::sort(actors.begin(), actors.end());
+		actors.erase(std::unique(actors.begin(), actors.end()), actors.end());
+
+		phys_scene->addActors(actors.data(), static_cast<PxU32>(actors.size()));
+	}
+
 #pragma endregion
 
 #pragma region Colliders
@@ -288,7 +364,7 @@ namespace Louron {
 		if (!scene->m_IsPaused) {
 
 			// Process all Deferred forces from last update
-			auto view = scene->GetAllEntitiesWith<RigidbodyComponent>();
+			auto view = scene->m_Registry.view<RigidbodyComponent>(entt::exclude<DespawnedComponent>);
 			for (auto& entity_handle : view) {
 				auto& rb_ref = view.get<RigidbodyComponent>(entity_handle);
 				if(rb_ref.GetActor()) {
@@ -319,8 +395,10 @@ namespace Louron {
 
 	void PhysicsSystem::UpdatePhysicsObjects(std::shared_ptr<Scene> scene) {
 		
+		// Despawned entities keep their flags until they are spawned again
+
 		// 1. Update Sphere Colliders
-		auto sc_view = scene->GetAllEntitiesWith<SphereColliderComponent>();
+		auto sc_view = scene->m_Registry.view<SphereColliderComponent>(entt::exclude<DespawnedComponent>);
 		if (sc_view.begin() != sc_view.end()) {
 			for (const auto& entity_handle : sc_view) {
 
@@ -337,7 +415,7 @@ namespace Louron {
 		}
 
 		// 2. Update Box Colliders
-		auto bc_view = scene->GetAllEntitiesWith<BoxColliderComponent>();
+		auto bc_view = scene->m_Registry.view<BoxColliderComponent>(entt::exclude<DespawnedComponent>);
 		if (bc_view.begin() != bc_view.end()) {
 			for (const auto& entity_handle : bc_view) {
 
@@ -353,7 +431,7 @@ namespace Louron {
 
 		}
 
-		auto rb_view = scene->GetAllEntitiesWith<RigidbodyComponent>();
+		auto rb_view = scene->m_Registry.view<RigidbodyComponent>(entt::exclude<DespawnedComponent>);
 		if (rb_view.begin() != rb_view.end()) {
 			for (const auto& entity_handle : rb_view) {
 
@@ -378,6 +456,33 @@ namespace Louron {
 
 	void PhysicsSystem::UpdateSimulationChanges(std::shared_ptr<Scene> scene) {
 
+		// Write back the poses of this step straight away, so the fixed update scripts and
+		// trigger callbacks after it read where the simulation left each rigidbody. Only
+		// the root subtrees holding a moved actor are walked, the frame's pass does the rest
+		auto rigidbody_view = scene->m_Registry.view<RigidbodyComponent>(entt::exclude<DespawnedComponent>);
+
+		std::vector<entt::entity> moved_entities;
+		for (auto entity_handle : rigidbody_view) {
+
+			auto actor = rigidbody_view.get<RigidbodyComponent>(entity_handle).GetActor();
+
+			// Only update if we haven't manually updated
+			if (actor && !actor->CheckFlag(RigidbodyFlag_TransformUpdated)) {
+				actor->AddFlag(RigidbodyFlag_PoseUpdated);
+				moved_entities.push_back(entity_handle);
+			}
+		}
+
+		if (moved_entities.empty())
+			return;
+
+		TransformSystem::UpdateGlobalTransforms(scene.get(), moved_entities, [&rigidbody_view](entt::entity entity_handle, TransformComponent& transform, const glm::mat4* parent_global_transform) -> bool {
+			return rigidbody_view.contains(entity_handle) && WriteBackRigidbodyPose(rigidbody_view.get<RigidbodyComponent>(entity_handle), transform, parent_global_transform);
+		});
+	}
+
+	void PhysicsSystem::UpdateTransforms(std::shared_ptr<Scene> scene) {
+
 		// 1. Update Rigidbodies
 		// When we have hierarchy relationships of objects that have physics components,
 		// the ordering of updating the GlobalPosition and GlobalRotation MATTERS! We 
@@ -394,50 +499,48 @@ namespace Louron {
 		//					alas, the hail mary thus brought fruit!
 		// --------------------------------------------------------------------------------
 
-		auto root_view = scene->GetAllEntitiesWith<HierarchyComponent>();
-		std::vector<Entity> root_entities;
-
-		if (root_view.begin() != root_view.end()) {
-
-			for (auto& entity_handle : root_view) {
-				if (!root_view.get<HierarchyComponent>(entity_handle).HasParent()) {
-					root_entities.push_back(root_view.get<HierarchyComponent>(entity_handle).GetEntity());
-				}
-			}
+		// The TransformSystem already keeps the hierarchy flattened root down, so the 
+		// physics poses are written back as part of its update, with each parent's
+		// global transform resolved before its children read it. Poses the fixed steps
+		// have already written back are skipped by their cleared RigidbodyFlag_PoseUpdated.
+		auto rigidbody_view = scene->m_Registry.view<RigidbodyComponent>(entt::exclude<DespawnedComponent>);
+		if (rigidbody_view.begin() == rigidbody_view.end()) {
+			TransformSystem::UpdateGlobalTransforms(scene.get());
+			return;
 		}
 
-		std::function<void(Entity)> update_physics = [&](Entity start_entity) -> void {
-			
-			if(start_entity && start_entity.HasComponent<RigidbodyComponent>()) {
+		TransformSystem::UpdateGlobalTransforms(scene.get(), [&rigidbody_view](entt::entity entity_handle, TransformComponent& transform, const glm::mat4* parent_global_transform) -> bool {
+			return rigidbody_view.contains(entity_handle) && WriteBackRigidbodyPose(rigidbody_view.get<RigidbodyComponent>(entity_handle), transform, parent_global_transform);
+		});
+	}
 
-				auto& transform = start_entity.GetComponent<TransformComponent>();
-				auto& rigidbody = start_entity.GetComponent<RigidbodyComponent>();
+	bool PhysicsSystem::WriteBackRigidbodyPose(RigidbodyComponent& rigidbody, TransformComponent& transform, const glm::mat4* parent_global_transform) {
 
-				if(rigidbody.GetActor()) {
-					if (!rigidbody.GetActor()->CheckFlag(RigidbodyFlag_TransformUpdated)) // Only update if we haven't manually updated
-					{
-						PxTransform physics_transform = rigidbody.GetActor()->GetGlobalPose();
-						glm::quat quaternion(physics_transform.q.w, physics_transform.q.x, physics_transform.q.y, physics_transform.q.z);
-						glm::vec3 rotation = glm::degrees(glm::eulerAngles(quaternion));
+		auto actor = rigidbody.GetActor();
 
-						transform.SetGlobalPosition(glm::vec3(physics_transform.p.x, physics_transform.p.y, physics_transform.p.z));
-						transform.SetGlobalRotation(rotation);
-					}
-				}
-			}
-			for (auto& child_uuid : start_entity.GetComponent<HierarchyComponent>().GetChildren()) {
+		// Only actors the simulation has moved since the last pass, and not manually updated since
+		if (!actor || !actor->CheckFlag(RigidbodyFlag_PoseUpdated) || actor->CheckFlag(RigidbodyFlag_TransformUpdated))
+			return false;
 
-				update_physics(scene->FindEntityByUUID(child_uuid));
+		actor->RemoveFlag(RigidbodyFlag_PoseUpdated);
 
-			}
-			
-		};
+		PxTransform physics_transform = actor->GetGlobalPose();
 
-		for (auto& entity : root_entities) {
+		glm::vec3 position = glm::vec3(physics_transform.p.x, physics_transform.p.y, physics_transform.p.z);
+		glm::quat rotation = glm::quat(physics_transform.q.w, physics_transform.q.x, physics_transform.q.y, physics_transform.q.z);
 
-			update_physics(entity);
+		if (parent_global_transform) {
 
+			glm::quat parent_rotation = glm::quat(glm::radians(TransformComponent::GetRotationFromMatrix(*parent_global_transform)));
+
+			position = glm::vec3(glm::inverse(*parent_global_transform) * glm::vec4(position, 1.0f));
+			rotation = glm::inverse(parent_rotation) * rotation;
 		}
+
+		transform.m_Position = position;
+		transform.m_Rotation = glm::degrees(glm::eulerAngles(rotation));
+
+		return true;
 	}
 
 #pragma endregion
@@ -5,8 +5,10 @@
 // C++ Standard Library Headers
 #include <memory>
 #include <optional>
+#include <vector>
 
 // External Vendor Library Headers
+#include <glm/glm.hpp>
 #include <physx/PxPhysicsAPI.h>
 
 using namespace physx;
@@ -17,6 +19,7 @@ namespace Louron {
 	class Entity;
 
 	struct RigidbodyComponent;
+	struct TransformComponent;
 	struct SphereColliderComponent;
 	struct BoxColliderComponent;
 
@@ -32,15 +35,43 @@ namespace Louron {
 		static BoxColliderComponent& AddBoxCollider(Entity entity, Scene* scene);
 		static void RemoveCollider(Entity entity, Scene* scene, PxGeometryType::Enum colliderType);
 
+		/// <summary>
+		/// Pull every rigidbody and static collider actor of these entities out of the
+		/// physics scene in a single call, ahead of the entities being destroyed.
+		/// </summary>
+		static void RemoveActorsFromScene(const std::vector<Entity>& entities, Scene* scene);
+
+		/// <summary>
+		/// Put every rigidbody and static collider actor of these entities back into
+		/// the physics scene in a single call, e.g. when a pooled entity is reused.
+		/// </summary>
+		static void AddActorsToScene(const std::vector<Entity>& entities, Scene* scene);
+
 		static void Update(std::shared_ptr<Scene> scene);
 
 		static void UpdatePhysicsObjects(std::shared_ptr<Scene> scene);
 
+		/// <summary>
+		/// Run the frame's TransformSystem pass, writing back the pose of every
+		/// rigidbody the simulation has moved since the last pass as part of it.
+		/// </summary>
+		static void UpdateTransforms(std::shared_ptr<Scene> scene);
+
 
 	private:
 
+		/// <summary>
+		/// Write back the pose of each rigidbody the last fixed step moved, walking only
+		/// the root subtrees that hold one.
+		/// </summary>
 		static void UpdateSimulationChanges(std::shared_ptr<Scene> scene);
 
+		/// <summary>
+		/// TransformSystem pose callback for one rigidbody. Writes the simulated pose into the
+		/// local transform if RigidbodyFlag_PoseUpdated is set and clears it. Runs on workers.
+		/// </summary>
+		static bool WriteBackRigidbodyPose(RigidbodyComponent& rigidbody, TransformComponent& transform, const glm::mat4* parent_global_transform);
+
 		PhysicsSystem() = delete;
 		PhysicsSystem(const PhysicsSystem&) = delete;
 		~PhysicsSystem() = delete;
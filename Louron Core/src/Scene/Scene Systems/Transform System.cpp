@@ -0,0 +1,327 @@
+#include "Transform System.h"
+
+// Louron Core Headers
+#include "../Scene.h"
+#include "../Entity.h"
+#include "../Components/Components.h"
+#include "../Components/Mesh.h"
+#include "../Components/Physics/Rigidbody.h"
+#include "../Components/Physics/PhysicsWrappers.h"
+
+#include "../../Core/Job System.h"
+#include "../../Core/Logging.h"
+#include "../../Debug/Profiler.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
+// External Vendor Library Headers
+#include <glm/glm.hpp>
+
+namespace Louron {
+
+#pragma region HelperFunctions
+
+	// Below this many nodes the cost of handing work to a worker outweighs the transform work
+	static constexpr size_t s_MinTransformsPerThread = 4096;
+
+	// Smallest chunk of root subtrees handed to a worker at once
+	static constexpr size_t s_MinTransformsPerChunk = 1024;
+
+	// Chunks per worker, so threads that finish early can take another chunk
+	static constexpr size_t s_ChunksPerThread = 4;
+
+	enum TransformNodeUpdateFlags : uint8_t {
+		TransformNodeFlag_None					= 0,
+		TransformNodeFlag_LocalChanged			= 1 << 0,
+		TransformNodeFlag_GlobalChanged			= 1 << 1,
+		TransformNodeFlag_GlobalScaleChanged	= 1 << 2
+	};
+
+	static size_t GetTransformThreadCount(const JobSystem& job_system, size_t node_count) {
+		size_t thread_count = std::min<size_t>(job_system.GetWorkerCount() + 1, node_count / s_MinTransformsPerThread);
+		return std::max<size_t>(thread_count, 1);
+	}
+
+#pragma endregion
+
+	void TransformSystem::RebuildHierarchyOrder(Scene* scene) {
+
+		L_PROFILE_SCOPE("Transform System - Rebuild Hierarchy Order");
+
+		if (!scene)
+			return;
+
+		entt::registry& registry = scene->m_Registry;
+		TransformHierarchy& hierarchy = scene->m_TransformHierarchy;
+
+		auto view = registry.view<TransformComponent>();
+
+		hierarchy.Nodes.clear();
+		hierarchy.Nodes.reserve(view.size());
+		hierarchy.Roots.clear();
+		hierarchy.Chunks.clear();
+		hierarchy.NodeIndices.clear();
+		hierarchy.NeedsRebuild = false;
+
+		std::unordered_set<entt::entity> visited;
+		visited.reserve(view.size());
+		hierarchy.NodeIndices.reserve(view.size());
+
+		std::vector<TransformHierarchyNode> stack;
+
+		// Only entities with a transform can take part in the hierarchy
+		auto transform_entity = [&](Entity entity) -> entt::entity {
+
+			if (!entity || !registry.has<TransformComponent>(entity))
+				return entt::null;
+
+			return entity;
+		};
+
+		for (entt::entity entity_handle : view) {
+
+			// Entities whose parent is missing are treated as roots, the same as GetGlobalTransform
+			if (registry.has<HierarchyComponent>(entity_handle)) {
+				const auto& entity_hierarchy = registry.get<HierarchyComponent>(entity_handle);
+				if (entity_hierarchy.HasParent() && transform_entity(entity_hierarchy.GetParentEntity()) != entt::null)
+					continue;
+			}
+
+			if (visited.count(entity_handle))
+				continue;
+
+			TransformHierarchyRange root_range{};
+			root_range.FirstNode = static_cast<uint32_t>(hierarchy.Nodes.size());
+
+			// Depth first, so every subtree is contiguous and directly follows its root
+			const uint32_t root_index = static_cast<uint32_t>(hierarchy.Roots.size());
+			stack.push_back({ entity_handle, TRANSFORM_NULL_INDEX, root_index });
+
+			while (!stack.empty()) {
+
+				TransformHierarchyNode node = stack.back();
+				stack.pop_back();
+
+				if (!visited.insert(node.EntityHandle).second)
+					continue;
+
+				uint32_t node_index = static_cast<uint32_t>(hierarchy.Nodes.size());
+				hierarchy.Nodes.push_back(node);
+				hierarchy.NodeIndices[node.EntityHandle] = node_index;
+
+				if (!registry.has<HierarchyComponent>(node.EntityHandle))
+					continue;
+
+				// Pushed in reverse so children come out in their hierarchy order
+				const auto& node_hierarchy = registry.get<HierarchyComponent>(node.EntityHandle);
+				for (size_t i = node_hierarchy.GetChildren().size(); i-- > 0;) {
+
+					entt::entity child_handle = transform_entity(node_hierarchy.GetChildEntity(i));
+					if (child_handle != entt::null)
+						stack.push_back({ child_handle, node_index, root_index });
+				}
+			}
+
+			root_range.NodeCount = static_cast<uint32_t>(hierarchy.Nodes.size()) - root_range.FirstNode;
+			hierarchy.Roots.push_back(root_range);
+		}
+
+		// Anything not reached has a parent that does not list it as a child,
+		// these are left for GetGlobalTransform to resolve lazily
+		if (hierarchy.Nodes.size() != view.size())
+			L_CORE_WARN("Transform System - {0} Entities Could Not Be Reached From The Root Of The Scene Hierarchy.", view.size() - hierarchy.Nodes.size());
+
+		// Group roots into chunks, the chunk size follows the scene so a handful of
+		// deep imported models and thousands of single entities both balance well
+		const size_t thread_count = GetTransformThreadCount(scene->GetJobSystem(), hierarchy.Nodes.size());
+		const size_t chunk_target = std::max(s_MinTransformsPerChunk, hierarchy.Nodes.size() / (thread_count * s_ChunksPerThread));
+
+		for (const TransformHierarchyRange& root_range : hierarchy.Roots) {
+
+			if (hierarchy.Chunks.empty() || hierarchy.Chunks.back().NodeCount >= chunk_target)
+				hierarchy.Chunks.push_back({ root_range.FirstNode, 0 });
+
+			hierarchy.Chunks.back().NodeCount += root_range.NodeCount;
+		}
+	}
+
+	void TransformSystem::UpdateGlobalTransforms(Scene* scene, const TransformPoseCallback& pose_callback) {
+
+		L_PROFILE_SCOPE("Transform System - Update Global Transforms");
+
+		if (!scene)
+			return;
+
+		TransformHierarchy& hierarchy = scene->m_TransformHierarchy;
+
+		if (hierarchy.NeedsRebuild)
+			RebuildHierarchyOrder(scene);
+
+		if (hierarchy.Nodes.empty())
+			return;
+
+		UpdateRanges(scene, hierarchy.Chunks, hierarchy.Nodes.size(), pose_callback);
+	}
+
+	void TransformSystem::UpdateGlobalTransforms(Scene* scene, const std::vector<entt::entity>& entities, const TransformPoseCallback& pose_callback) {
+
+		L_PROFILE_SCOPE("Transform System - Update Root Subtree Transforms");
+
+		if (!scene || entities.empty())
+			return;
+
+		TransformHierarchy& hierarchy = scene->m_TransformHierarchy;
+
+		if (hierarchy.NeedsRebuild)
+			RebuildHierarchyOrder(scene);
+
+		if (hierarchy.Nodes.empty())
+			return;
+
+		// Each root subtree once, in flat order
+		std::vector<uint32_t> root_indices;
+		root_indices.reserve(entities.size());
+
+		for (entt::entity entity_handle : entities) {
+
+			auto node_it = hierarchy.NodeIndices.find(entity_handle);
+			if (node_it != hierarchy.NodeIndices.end())
+				root_indices.push_back(hierarchy.Nodes[node_it->second].RootIndex);
+		}
+
+		std::sort(root_indices.begin(), root_indices.end());
+		root_indices.erase(std::unique(root_indices.begin(), root_indices.end()), root_indices.end());
+
+		if (root_indices.empty())
+			return;
+
+		std::vector<TransformHierarchyRange> ranges;
+		ranges.reserve(root_indices.size());
+
+		size_t node_count = 0;
+		for (uint32_t root_index : root_indices) {
+			ranges.push_back(hierarchy.Roots[root_index]);
+			node_count += hierarchy.Roots[root_index].NodeCount;
+		}
+
+		UpdateRanges(scene, ranges, node_count, pose_callback);
+	}
+
+	void TransformSystem::UpdateRanges(Scene* scene, const std::vector<TransformHierarchyRange>& ranges, size_t node_count, const TransformPoseCallback& pose_callback) {
+
+		entt::registry& registry = scene->m_Registry;
+		TransformHierarchy& hierarchy = scene->m_TransformHierarchy;
+
+		// Only the nodes in the ranges are written, the rest keep whatever they held
+		hierarchy.NodeUpdateFlags.resize(hierarchy.Nodes.size());
+		for (const TransformHierarchyRange& range : ranges)
+			std::fill_n(hierarchy.NodeUpdateFlags.begin() + range.FirstNode, range.NodeCount, static_cast<uint8_t>(TransformNodeFlag_None));
+
+		// 1. Resolve the matrices, each range holds whole root subtrees so the
+		//    workers never read a parent another worker is still writing
+		const size_t thread_count = std::min(GetTransformThreadCount(scene->GetJobSystem(), node_count), ranges.size());
+
+		if (thread_count <= 1) {
+			for (const TransformHierarchyRange& range : ranges)
+				UpdateNodeRange(scene, range, pose_callback);
+		}
+		else {
+
+			std::atomic<size_t> next_range = 0;
+
+			auto worker_loop = [&]() {
+				for (size_t range = next_range.fetch_add(1); range < ranges.size(); range = next_range.fetch_add(1))
+					UpdateNodeRange(scene, ranges[range], pose_callback);
+			};
+
+			JobSystem& job_system = scene->GetJobSystem();
+
+			std::vector<JobHandle> workers;
+			workers.reserve(thread_count - 1);
+
+			for (size_t i = 1; i < thread_count; i++)
+				workers.push_back(job_system.Schedule(worker_loop));
+
+			worker_loop();
+
+			for (const auto& worker : workers)
+				job_system.Wait(worker);
+		}
+
+		// 2. Apply the side effects serially, these reach into other systems
+		for (const TransformHierarchyRange& range : ranges) {
+
+			const uint32_t range_end = range.FirstNode + range.NodeCount;
+
+			for (uint32_t i = range.FirstNode; i < range_end; i++) {
+
+				const uint8_t node_flags = hierarchy.NodeUpdateFlags[i];
+				if (!(node_flags & TransformNodeFlag_GlobalChanged))
+					continue;
+
+				entt::entity entity_handle = hierarchy.Nodes[i].EntityHandle;
+
+				if ((node_flags & TransformNodeFlag_LocalChanged) && registry.has<RigidbodyComponent>(entity_handle)) {
+
+					auto actor = registry.get<RigidbodyComponent>(entity_handle).GetActor();
+					if (actor)
+						actor->AddFlag(RigidbodyFlag_TransformUpdated);
+				}
+
+				if (registry.has<MeshFilterComponent>(entity_handle))
+					registry.get<MeshFilterComponent>(entity_handle).MarkDirty();
+
+				registry.get<TransformComponent>(entity_handle).OnGlobalTransformRecalculated({ entity_handle, scene }, node_flags & TransformNodeFlag_GlobalScaleChanged);
+			}
+		}
+	}
+
+	void TransformSystem::UpdateNodeRange(Scene* scene, TransformHierarchyRange range, const TransformPoseCallback& pose_callback) {
+
+		// The transform pool already exists, so these lookups only read the registry
+		entt::registry& registry = scene->m_Registry;
+		TransformHierarchy& hierarchy = scene->m_TransformHierarchy;
+
+		const uint32_t range_end = range.FirstNode + range.NodeCount;
+
+		for (uint32_t i = range.FirstNode; i < range_end; i++) {
+
+			const TransformHierarchyNode& node = hierarchy.Nodes[i];
+			auto& transform = registry.get<TransformComponent>(node.EntityHandle);
+
+			// The parent has already been visited, so its global transform is up to date
+			const glm::mat4* parent_global_transform = nullptr;
+			bool parent_changed = false;
+
+			if (node.ParentIndex != TRANSFORM_NULL_INDEX) {
+				parent_global_transform = &registry.get<TransformComponent>(hierarchy.Nodes[node.ParentIndex].EntityHandle).m_GlobalTransform;
+				parent_changed = hierarchy.NodeUpdateFlags[node.ParentIndex] & TransformNodeFlag_GlobalChanged;
+			}
+
+			uint8_t node_flags = TransformNodeFlag_None;
+
+			// Posed by the caller, e.g. physics, rather than changed by the user
+			bool posed = pose_callback && pose_callback(node.EntityHandle, transform, parent_global_transform);
+
+			if (transform.CheckFlag(TransformFlag_PropertiesUpdated))
+				node_flags |= TransformNodeFlag_LocalChanged;
+
+			if (posed || (node_flags & TransformNodeFlag_LocalChanged))
+				transform.ComputeLocalTransformMatrix();
+
+			if (posed || parent_changed || (node_flags & TransformNodeFlag_LocalChanged) || transform.CheckFlag(TransformFlag_GlobalTransformUpdated)) {
+
+				node_flags |= TransformNodeFlag_GlobalChanged;
+
+				if (transform.ComputeGlobalTransform(parent_global_transform))
+					node_flags |= TransformNodeFlag_GlobalScaleChanged;
+			}
+
+			hierarchy.NodeUpdateFlags[i] = node_flags;
+		}
+	}
+
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+// Louron Core Headers
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// External Vendor Library Headers
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+namespace Louron {
+
+	class Scene;
+	struct TransformComponent;
+
+	constexpr uint32_t TRANSFORM_NULL_INDEX = UINT32_MAX;
+
+	/// <summary>
+	/// One entity in the flattened scene hierarchy, ParentIndex is the
+	/// index of the parent node within the same flat order and RootIndex
+	/// is the index of the subtree it belongs to in TransformHierarchy::Roots.
+	/// </summary>
+	struct TransformHierarchyNode {
+		entt::entity EntityHandle = entt::null;
+		uint32_t ParentIndex = TRANSFORM_NULL_INDEX;
+		uint32_t RootIndex = TRANSFORM_NULL_INDEX;
+	};
+
+	/// <summary>
+	/// A contiguous range of nodes in the flat hierarchy. A range never
+	/// splits a root's subtree, so ranges can be updated independently.
+	/// </summary>
+	struct TransformHierarchyRange {
+		uint32_t FirstNode = 0;
+		uint32_t NodeCount = 0;
+	};
+
+	/// <summary>
+	/// Every entity with a TransformComponent flattened so parents always come
+	/// before their children. Each root is followed by its whole subtree, and
+	/// the order is only rebuilt when the scene hierarchy changes.
+	/// </summary>
+	struct TransformHierarchy {
+
+		std::vector<TransformHierarchyNode> Nodes;
+
+		/// <summary>
+		/// The subtree of each root within Nodes.
+		/// </summary>
+		std::vector<TransformHierarchyRange> Roots;
+
+		/// <summary>
+		/// Consecutive root subtrees grouped into chunks of roughly even size for
+		/// the worker threads. Small roots are batched together, while a large
+		/// subtree becomes a chunk of its own.
+		/// </summary>
+		std::vector<TransformHierarchyRange> Chunks;
+
+		/// <summary>
+		/// Per node scratch for the update pass, recording what changed so the
+		/// node's children follow it and its side effects are applied afterwards.
+		/// </summary>
+		std::vector<uint8_t> NodeUpdateFlags;
+
+		/// <summary>
+		/// Index of each entity's node within Nodes.
+		/// </summary>
+		std::unordered_map<entt::entity, uint32_t> NodeIndices;
+
+		bool NeedsRebuild = true;
+	};
+
+	/// <summary>
+	/// Optional hook run on each node before its global transform is resolved, with
+	/// the parent's global transform already up to date (nullptr for roots). It may
+	/// write the local position, rotation and scale of the transform it is given,
+	/// returning true if it did. It runs on worker threads, so it must only touch
+	/// that entity's own components and never add or remove any.
+	/// </summary>
+	using TransformPoseCallback = std::function<bool(entt::entity entity_handle, TransformComponent& transform, const glm::mat4* parent_global_transform)>;
+
+	class TransformSystem {
+
+	public:
+
+		/// <summary>
+		/// Recompute the global transform of every entity whose transform, or
+		/// any of whose parents' transforms, changed since the last update. This
+		/// is a single pass over the flat hierarchy, so parent matrices are read
+		/// straight from the previous node rather than found by UUID per level.
+		/// Independent root subtrees are split across worker threads when the
+		/// scene is large enough. Call from the main thread before anything
+		/// reads global transforms.
+		/// </summary>
+		static void UpdateGlobalTransforms(Scene* scene, const TransformPoseCallback& pose_callback = {});
+
+		/// <summary>
+		/// Recompute the global transforms of only the root subtrees that hold one of
+		/// the given entities, e.g. the rigidbodies a fixed step has just moved, so
+		/// the rest of the scene waits for the next full UpdateGlobalTransforms.
+		/// Entities without a TransformComponent are ignored.
+		/// </summary>
+		static void UpdateGlobalTransforms(Scene* scene, const std::vector<entt::entity>& entities, const TransformPoseCallback& pose_callback = {});
+
+		/// <summary>
+		/// Rebuild the flat parent before child order of the scene hierarchy.
+		/// UpdateGlobalTransforms does this itself when the hierarchy has changed.
+		/// </summary>
+		static void RebuildHierarchyOrder(Scene* scene);
+
+	private:
+
+		/// <summary>
+		/// Resolve the transforms of each range across the worker threads, then apply
+		/// their side effects. Every range must hold whole root subtrees.
+		/// </summary>
+		static void UpdateRanges(Scene* scene, const std::vector<TransformHierarchyRange>& ranges, size_t node_count, const TransformPoseCallback& pose_callback);
+
+		/// <summary>
+		/// Resolve the transforms of the nodes in the range, which must not split a root subtree.
+		/// </summary>
+		static void UpdateNodeRange(Scene* scene, TransformHierarchyRange range, const TransformPoseCallback& pose_callback);
+
+		TransformSystem() = delete;
+		TransformSystem(const TransformSystem&) = delete;
+		~TransformSystem() = delete;
+	};
+
+}
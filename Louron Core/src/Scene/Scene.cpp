@@ -5,6 +5,7 @@
 #include "Prefab.h"
 #include "Scene Serializer.h"
 #include "OctreeBounds.h"
+#include "BVHBounds.h"
 
 #include "Components/Components.h"
 #include "Components/Light.h"
@@ -18,12 +19,14 @@
 #include "Components/Physics/CollisionCallback.h"
 
 #include "Scene Systems/Physics System.h"
+#include "Scene Systems/Bounds System.h"
 
 #include "../Debug/Profiler.h"
 
 #include "../Renderer/Camera.h"
 #include "../Renderer/Renderer.h"
 #include "../Renderer/RendererPipeline.h"
+#include "../Core/Engine.h"
 
 #include "../Core/Time.h"
 #include "../Core/Input.h"
@@ -37,6 +40,8 @@
 
 // C++ Standard Library Headers
 #include <iomanip>
+#include <span>
+#include <unordered_set>
 
 // External Vendor Library Headers
 #include <glm/gtc/quaternion.hpp>
@@ -54,7 +59,7 @@ namespace Louron {
 		return PxFilterFlag::eDEFAULT;
 	}
 
-	Scene::Scene() {
+	Scene::Scene() : m_JobSystem(&Engine::Get().GetJobSystem()) {
 
 		m_SceneConfig.SceneFilePath = "Scenes/Untitled Scene.lscene";
 
@@ -63,9 +68,29 @@ namespace Louron {
 
 		m_SceneConfig.ScenePipelineType = L_RENDER_PIPELINE::FORWARD_PLUS;
 		m_SceneConfig.ScenePipeline = std::make_shared<ForwardPlusPipeline>();
+
+		m_Registry.on_construct<MeshFilterComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_destroy<MeshFilterComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_update<MeshFilterComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_construct<MeshRendererComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_destroy<MeshRendererComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+
+		m_Registry.on_construct<MeshFilterComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_destroy<MeshFilterComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_update<MeshFilterComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_construct<MeshRendererComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_destroy<MeshRendererComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_update<MeshRendererComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+
+		m_Registry.on_construct<HierarchyComponent>().connect<&Scene::OnHierarchyComponentChanged>(*this);
+		m_Registry.on_destroy<HierarchyComponent>().connect<&Scene::OnHierarchyComponentChanged>(*this);
+		m_Registry.on_update<HierarchyComponent>().connect<&Scene::OnHierarchyComponentChanged>(*this);
+
+		m_Registry.on_construct<TagComponent>().connect<&Scene::OnTagComponentConstructed>(*this);
+		m_Registry.on_destroy<TagComponent>().connect<&Scene::OnTagComponentDestroyed>(*this);
 	}
 
-	Scene::Scene(L_RENDER_PIPELINE pipeline) {
+	Scene::Scene(L_RENDER_PIPELINE pipeline) : m_JobSystem(&Engine::Get().GetJobSystem()) {
 
 		m_SceneConfig.SceneFilePath = "Scenes/Untitled Scene.lscene";
 
@@ -85,6 +110,141 @@ namespace Louron {
 			break;
 		}
 
+		m_Registry.on_construct<MeshFilterComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_destroy<MeshFilterComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_update<MeshFilterComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_construct<MeshRendererComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+		m_Registry.on_destroy<MeshRendererComponent>().connect<&Scene::OnOctreeComponentChanged>(*this);
+
+		m_Registry.on_construct<MeshFilterComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_destroy<MeshFilterComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_update<MeshFilterComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_construct<MeshRendererComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_destroy<MeshRendererComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+		m_Registry.on_update<MeshRendererComponent>().connect<&Scene::OnRenderProxyComponentChanged>(*this);
+
+		m_Registry.on_construct<HierarchyComponent>().connect<&Scene::OnHierarchyComponentChanged>(*this);
+		m_Registry.on_destroy<HierarchyComponent>().connect<&Scene::OnHierarchyComponentChanged>(*this);
+		m_Registry.on_update<HierarchyComponent>().connect<&Scene::OnHierarchyComponentChanged>(*this);
+
+		m_Registry.on_construct<TagComponent>().connect<&Scene::OnTagComponentConstructed>(*this);
+		m_Registry.on_destroy<TagComponent>().connect<&Scene::OnTagComponentDestroyed>(*this);
+	}
+
+	/// <summary>
+	/// Registry listener for components that decide whether an entity lives in the
+	/// octree. Queues the entity so the octree picks up the addition or removal.
+	/// </summary>
+	void Scene::OnOctreeComponentChanged(entt::registry& registry, entt::entity entity_handle) {
+		m_OctreeDirtyQueue.Push(entity_handle);
+	}
+
+	/// <summary>
+	/// Registry listener for components that make up an entity's render proxy.
+	/// Queues the entity so the render pipeline rebuilds or removes its proxy.
+	/// </summary>
+	void Scene::OnRenderProxyComponentChanged(entt::registry& registry, entt::entity entity_handle) {
+		m_RenderProxyDirtyQueue.Push(entity_handle);
+	}
+
+	/// <summary>
+	/// Registry listener for HierarchyComponent, any entity joining or leaving
+	/// the hierarchy invalidates the TransformSystem's flat order.
+	/// </summary>
+	void Scene::OnHierarchyComponentChanged(entt::registry& registry, entt::entity entity_handle) {
+		m_TransformHierarchy.NeedsRebuild = true;
+	}
+
+	/// <summary>
+	/// Registry listeners for TagComponent, keeping the name index in step 
+	/// with entities as they are created and destroyed.
+	/// </summary>
+	void Scene::OnTagComponentConstructed(entt::registry& registry, entt::entity entity_handle) {
+		m_EntityNameMap.emplace(registry.get<TagComponent>(entity_handle).Tag, entity_handle);
+	}
+
+	void Scene::OnTagComponentDestroyed(entt::registry& registry, entt::entity entity_handle) {
+
+		auto [begin, end] = m_EntityNameMap.equal_range(registry.get<TagComponent>(entity_handle).Tag);
+		for (auto it = begin; it != end; ++it) {
+			if (it->second == entity_handle) {
+				m_EntityNameMap.erase(it);
+				return;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Called by TagComponent::SetTag before the tag changes.
+	/// </summary>
+	void Scene::OnEntityRenamed(const TagComponent& tag, const std::string& new_name) {
+
+		// Components copied into prefabs keep their scene pointer, so 
+		// make sure this tag really belongs to this scene's registry
+		if (tag.entity_handle == entt::null || !m_Registry.valid(tag.entity_handle) || m_Registry.try_get<TagComponent>(tag.entity_handle) != &tag)
+			return;
+
+		OnTagComponentDestroyed(m_Registry, tag.entity_handle);
+		m_EntityNameMap.emplace(new_name, tag.entity_handle);
+	}
+
+	std::weak_ptr<OctreeBounds<Entity>> Scene::GetOctree() const {
+		return std::dynamic_pointer_cast<OctreeBounds<Entity>>(GetSpatialIndex().lock());
+	}
+
+	std::shared_ptr<SpatialIndex<Entity>> Scene::CreateSpatialIndex(SpatialIndexType index_type, const std::vector<OctreeDataSource<Entity>>& data_sources, JobSystem* job_system) {
+
+		switch (index_type) {
+
+			case SpatialIndexType::BVH: {
+				return std::make_shared<BVHBounds<Entity>>(BVHBoundsConfig{}, data_sources);
+			}
+
+			case SpatialIndexType::Octree:
+			default: {
+
+				OctreeBoundsConfig octree_config{};
+				octree_config.Looseness = 1.25f;
+				octree_config.PreferredDataSourceLimit = 8;
+
+				return std::make_shared<OctreeBounds<Entity>>(octree_config, data_sources, job_system);
+			}
+		}
+	}
+
+	void Scene::BuildSpatialIndex() {
+
+		// The pipeline's octree update writes mesh bounds, don't recompute them under it
+		if (m_SceneConfig.ScenePipeline)
+			m_SceneConfig.ScenePipeline->WaitForJobs();
+
+		// Ensure every AABB is up to date
+		BoundsSystem::UpdateTransformedAABBs(this, true);
+
+		std::vector<OctreeDataSource<Entity>> data_sources;
+
+		auto bounds_view_mesh = GetAllEntitiesWith<MeshFilterComponent, MeshRendererComponent>();
+		for (const auto& entity_handle : bounds_view_mesh) {
+			auto& mesh_filter = bounds_view_mesh.get<MeshFilterComponent>(entity_handle);
+
+			const auto& aabb = mesh_filter.TransformedAABB;
+
+			data_sources.emplace_back(mesh_filter.GetEntity(), aabb);
+		}
+
+		std::shared_ptr<SpatialIndex<Entity>> spatial_index = CreateSpatialIndex(m_SceneConfig.SceneSpatialIndexType, data_sources, m_JobSystem);
+
+		// Swap under the old index lock so nothing is halfway through using it, the
+		// renderer's update thread may be reading the pointer at the same time. The
+		// old index is held until after the lock is released, as the swap may drop
+		// the last reference to it and its mutex with it
+		std::shared_ptr<SpatialIndex<Entity>> old_index = GetSpatialIndex().lock();
+		std::unique_lock<std::shared_mutex> lock;
+		if (old_index)
+			lock = std::unique_lock<std::shared_mutex>(old_index->GetMutex());
+
+		std::lock_guard pointer_lock(m_SpatialIndexPointerMutex);
+		m_SpatialIndex = spatial_index;
 	}
 
 	/// <summary>
@@ -133,55 +293,66 @@ namespace Louron {
 	/// </summary>
 	Entity Scene::CreateEntity(UUID uuid, const std::string& name) {
 
-		std::unique_lock<std::mutex> lock;
+		std::shared_ptr<SpatialIndex<Entity>> spatial_index = GetSpatialIndex().lock();
+		std::unique_lock<std::shared_mutex> lock;
 
-		if (m_Octree) 
-			lock = std::unique_lock<std::mutex>(m_Octree->GetOctreeMutex());
-		
-		while (true) {
+		if (spatial_index)
+			lock = std::unique_lock<std::shared_mutex>(spatial_index->GetMutex());
+
+		return CreateEntityUnlocked(m_Registry.create(), uuid, name);
+	}
+
+	/// <summary>
+	/// Create many Entities in Scene at once. Storage for the entities and their
+	/// default components is reserved up front and the octree lock is taken once.
+	/// </summary>
+	std::vector<Entity> Scene::CreateEntities(size_t count, const std::string& name) {
+
+		std::vector<Entity> entities;
+		if (count == 0)
+			return entities;
+
+		std::shared_ptr<SpatialIndex<Entity>> spatial_index = GetSpatialIndex().lock();
+		std::unique_lock<std::shared_mutex> lock;
+
+		if (spatial_index)
+			lock = std::unique_lock<std::shared_mutex>(spatial_index->GetMutex());
 
-			if (m_EntityMap->find(uuid) == m_EntityMap->end())
-				break;
+		m_Registry.reserve(m_Registry.size() + count);
+		m_Registry.reserve<IDComponent, TransformComponent, TagComponent, HierarchyComponent>(m_Registry.size<IDComponent>() + count);
+		m_EntityMap.Reserve(m_EntityMap.Size() + count);
+		m_EntityNameMap.reserve(m_EntityNameMap.size() + count);
+
+		std::vector<entt::entity> entity_handles(count);
+		m_Registry.create(entity_handles.begin(), entity_handles.end());
+
+		entities.reserve(count);
+		for (entt::entity entity_handle : entity_handles)
+			entities.push_back(CreateEntityUnlocked(entity_handle, UUID(), name));
+
+		return entities;
+	}
 
+	Entity Scene::CreateEntityUnlocked(entt::entity entity_handle, UUID uuid, const std::string& name) {
+
+		while (m_EntityMap.Contains(uuid))
 			uuid = UUID();
-		}
 
-		Entity entity = { m_Registry.create(), this };
+		Entity entity = { entity_handle, this };
 
 		// 1. Add UUID Component
-		auto& temp = entity.AddComponent<IDComponent>(uuid);
+		entity.AddComponent<IDComponent>(uuid);
 
 		// 2. Add Transform Component
 		entity.AddComponent<TransformComponent>();
 
 		// 3. Add Tag Component
-		std::string uniqueName = name.empty() ? "Untitled Entity" : name;
-		int suffix = 1;
-		std::string baseName = uniqueName;
-
-		// Ensure the name is unique by appending a numeric suffix		
-		auto check_tags = [&](const char* name) -> bool {
-
-			auto view = m_Registry.view<TagComponent>();
-			for (auto entity : view) {
-				const TagComponent& tag = view.get<TagComponent>(entity);
-				if (tag.Tag == name)
-					return true;
-			}
-
-			return false;
-		};
-
-		while (check_tags(uniqueName.c_str())) {
-			uniqueName = baseName + " (" + std::to_string(suffix++) + ")";
-		}
-		auto& tag = entity.AddComponent<TagComponent>();
-		tag.Tag = uniqueName;
+		entity.AddComponent<TagComponent>(GetUniqueEntityName(name));
 
 		// 4. Add Hierarchy Component
 		entity.AddComponent<HierarchyComponent>();
 
-		m_EntityMap->emplace(uuid, entity);
+		m_EntityMap.Insert(uuid, entity);
 
 		return entity;
 	}
@@ -189,44 +360,38 @@ namespace Louron {
 	#pragma region Component Copying
 
 	template<typename... Component>
-	static void CopyComponent(entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, entt::entity>& enttMap, Scene* scene_ref)
+	static void CopyComponentPool(entt::registry& dst, const entt::registry& src, Scene* scene_ref)
 	{
 		([&]()
 			{
-				auto view = src.view<Component>();
-				for (auto srcEntity : view)
-				{
-					UUID dest_id = src.get<IDComponent>(srcEntity).ID;
-					entt::entity dstEntity = enttMap.at(dest_id);
-
-					auto& srcComponent = src.get<Component>(srcEntity);
-					
-					// Store entity uuid and scene of source component
-					UUID source_uuid = srcComponent.entity_uuid;
-					Scene* source_scene = srcComponent.scene;
-
-					// Change source component uuid and scene to new id and scene
-					srcComponent.entity_uuid = dest_id;
-					srcComponent.scene = scene_ref;
-
-					// Copy construct new component with new id and scene
-					auto& dstComponent = dst.emplace_or_replace<Component>(dstEntity, srcComponent);
-					
-					// Ensure new component has the correct id and scene ref
-					dstComponent.entity_uuid = dest_id;
-					dstComponent.scene = scene_ref;
-
-					// Revert source component to its normal state
-					srcComponent.entity_uuid = source_uuid;
-					srcComponent.scene = source_scene;
+				const size_t pool_size = src.size<Component>();
+				if (pool_size == 0)
+					return;
+
+				// Both registries hold the same entities, so each pool is copied
+				// as a whole in one insert, in the same order as the source pool
+				const entt::entity* entities = src.data<Component>();
+				const Component* src_components = src.raw<Component>();
+
+				// The source scene's render jobs may still be reading its components,
+				// so they are copied as they are and only the new components are touched
+				dst.insert<Component>(entities, entities + pool_size, src_components, src_components + pool_size);
+
+				// Copy constructors keep the source scene ref, and not every one copies
+				// the base, so set the id, scene ref and entt handle of the new components
+				Component* dst_components = dst.raw<Component>();
+				for (size_t i = 0; i < pool_size; i++) {
+					dst_components[i].entity_uuid = src_components[i].entity_uuid;
+					dst_components[i].scene = scene_ref;
+					dst_components[i].entity_handle = entities[i];
 				}
 			}(), ...);
 	}
 
 	template<typename... Component>
-	static void CopyComponent(ComponentGroup<Component...>, entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, entt::entity>& enttMap, Scene* scene_ref)
+	static void CopyComponentPool(ComponentGroup<Component...>, entt::registry& dst, const entt::registry& src, Scene* scene_ref)
 	{
-		CopyComponent<Component...>(dst, src, enttMap, scene_ref);
+		CopyComponentPool<Component...>(dst, src, scene_ref);
 	}
 
 	template<typename... Component>
@@ -248,30 +413,42 @@ namespace Louron {
 	/// <summary>
 	/// Copy Constructor and Operator Deleted in ENTT for Registry.
 	/// Have to Manually Copy Over Data.
+	/// 
+	/// The entity list is copied as is, so every entity keeps the same entt handle
+	/// it has in the other scene and cached handles stay valid. Each component 
+	/// pool is then copied in bulk rather than entity by entity.
 	/// </summary>
 	bool Scene::CopyRegistry(std::shared_ptr<Scene> otherScene)
 	{
+		L_PROFILE_SCOPE("Scene - Copy Registry");
+
+		if (m_Registry.size() != 0) {
+			L_CORE_ERROR("Cannot Copy Registry - Destination Scene Already Has Entities!");
+			return false;
+		}
+
 		auto& srcSceneRegistry = otherScene->m_Registry;
 		auto& dstSceneRegistry = m_Registry;
-		std::unordered_map<UUID, entt::entity> enttMap;
 
-		// Create entities in new scene
-		auto idView = srcSceneRegistry.view<IDComponent>();
-		for (auto e : idView)
-		{
-			UUID uuid = srcSceneRegistry.get<IDComponent>(e).ID;
-			const auto& name = srcSceneRegistry.get<TagComponent>(e).Tag;
-			Entity newEntity = CreateEntity(uuid, name);
-			enttMap[uuid] = (entt::entity)newEntity;
-		}
+		dstSceneRegistry.assign(srcSceneRegistry.data(), srcSceneRegistry.data() + srcSceneRegistry.size(), srcSceneRegistry.destroyed());
+
+		// Copy all components, the TagComponent listener fills the name index as the tags are copied
+		CopyComponentPool(AllComponents{}, dstSceneRegistry, srcSceneRegistry, this);
+
+		m_EntityMap = otherScene->m_EntityMap;
+		m_EntityNameSuffixes = otherScene->m_EntityNameSuffixes;
 
-		// Copy components (except IDComponent and TagComponent)
-		CopyComponent(AllComponents{}, dstSceneRegistry, srcSceneRegistry, enttMap, this);
 		return true;
 	}
 
+	/// <summary>
+	/// Copy the scene for play mode. The edit time scene is left untouched, 
+	/// so it can be swapped back in when play mode stops.
+	/// </summary>
 	std::shared_ptr<Scene> Scene::Copy(std::shared_ptr<Scene> source_scene)
 	{
+		L_PROFILE_SCOPE("Scene - Copy");
+
 		L_RENDER_PIPELINE pipeline = source_scene->GetConfig().ScenePipelineType;
 
 		std::shared_ptr<Scene> dest_scene = std::make_shared<Scene>(pipeline);
@@ -285,38 +462,70 @@ namespace Louron {
 		dest_scene->m_SceneConfig.Name = source_scene->m_SceneConfig.Name;
 		dest_scene->m_SceneConfig.SceneFilePath = source_scene->m_SceneConfig.SceneFilePath;
 		dest_scene->m_SceneConfig.ScenePipelineType = source_scene->m_SceneConfig.ScenePipelineType;
+		dest_scene->m_SceneConfig.SceneSpatialIndexType = source_scene->m_SceneConfig.SceneSpatialIndexType;
 
-		dest_scene->CopyRegistry(source_scene);
+		// The source pipeline's octree update writes mesh bounds and index flags while it runs
+		if (source_scene->m_SceneConfig.ScenePipeline)
+			source_scene->m_SceneConfig.ScenePipeline->WaitForJobs();
 
-		// Generate Octree for New Scene
-		{
-			// Calculate Overall Scene Octree
-			OctreeBoundsConfig octree_config{};
+		if (!dest_scene->CopyRegistry(source_scene))
+			return dest_scene;
+
+		std::shared_ptr<SpatialIndex<Entity>> source_index = source_scene->GetSpatialIndex().lock();
 
-			std::vector<OctreeBounds<Entity>::OctreeData> data_sources;
+		if (!source_index || source_index->GetType() != dest_scene->m_SceneConfig.SceneSpatialIndexType) {
+
+			// Generate Spatial Index for New Scene
+			dest_scene->BuildSpatialIndex();
+			return dest_scene;
+		}
 
-			auto bounds_view_mesh = dest_scene->GetAllEntitiesWith<MeshFilterComponent, MeshRendererComponent>();
-			for (const auto& entity_handle : bounds_view_mesh) {
-				auto& mesh_filter = bounds_view_mesh.get<MeshFilterComponent>(entity_handle);
+		// The copied MeshFilterComponents already hold their world AABBs, so clone
+		// the source index instead of recomputing every AABB and rebuilding it
+		{
+			L_PROFILE_SCOPE("Scene - Clone Spatial Index");
 
-				// Ensure the AABB is up to date
-				mesh_filter.UpdateTransformedAABB();
+			// Held until the copy's queue is rebuilt, so nothing can update the source
+			// index part way through the clone
+			std::shared_lock lock(source_index->GetMutex());
 
-				const auto& aabb = mesh_filter.TransformedAABB;
+			Scene* dest_scene_ref = dest_scene.get();
+			std::shared_ptr<SpatialIndex<Entity>> spatial_index = source_index->Clone([dest_scene_ref](const Entity& entity) {
+				return Entity((entt::entity)entity, dest_scene_ref);
+			});
 
-				data_sources.push_back(std::make_shared<OctreeDataSource<Entity>>(mesh_filter.GetEntity(), aabb));
+			{
+				std::lock_guard pointer_lock(dest_scene->m_SpatialIndexPointerMutex);
+				dest_scene->m_SpatialIndex = spatial_index;
 			}
 
-			octree_config.Looseness = 1.25f;
-			octree_config.PreferredDataSourceLimit = 8;
+			// Copying the pools queued every mesh for an index update, only the entities
+			// whose copied flag says they are still waiting on the index need one. The
+			// source queue is left alone, it only has the source pipeline as its consumer
+			dest_scene->m_OctreeDirtyQueue.Clear();
 
-			// Create the octree and insert data sources
-			dest_scene->m_Octree = std::make_shared<OctreeBounds<Entity>>(octree_config, data_sources);
-		}
+			entt::registry& dest_registry = dest_scene->m_Registry;
+
+			// The source queue may still hold removals and additions that were queued by the
+			// component listeners without setting a flag, e.g. destroyed entities or removed
+			// MeshRendererComponents. Reconcile the clone against the copied registry instead
+			auto should_be_indexed = [&dest_registry](entt::entity entity_handle) -> bool {
+				return dest_registry.valid(entity_handle) && dest_registry.has<MeshFilterComponent>(entity_handle) && dest_registry.has<MeshRendererComponent>(entity_handle) &&
+					dest_registry.get<MeshFilterComponent>(entity_handle).MeshFilterAssetHandle != NULL_UUID && !dest_registry.has<DespawnedComponent>(entity_handle);
+			};
 
-		auto view = dest_scene->GetAllEntitiesWith<IDComponent>();
-		for (auto& entity : view) {
-			Entity ent = { entity, dest_scene.get() };
+			for (const auto& data_source : spatial_index->GetAllDataSources()) {
+				if (!should_be_indexed((entt::entity)data_source.Data))
+					spatial_index->Remove(data_source.Data);
+			}
+
+			auto mesh_filter_view = dest_registry.view<MeshFilterComponent>();
+			for (entt::entity entity_handle : mesh_filter_view) {
+
+				if (mesh_filter_view.get<MeshFilterComponent>(entity_handle).OctreeNeedsUpdate.load(std::memory_order_acquire) ||
+					(should_be_indexed(entity_handle) && !spatial_index->HasDataSource(Entity(entity_handle, dest_scene_ref))))
+					dest_scene->m_OctreeDirtyQueue.Push(entity_handle);
+			}
 		}
 
 		return dest_scene;
@@ -353,31 +562,95 @@ namespace Louron {
 	}
 
 	// Destroys Entity in Scene
-	void Scene::DestroyEntity(Entity entity, std::unique_lock<std::mutex>* parent_lock) {
+	void Scene::DestroyEntity(Entity entity, std::unique_lock<std::shared_mutex>* parent_lock) {
+		DestroyEntities(std::span<const Entity>(&entity, 1), parent_lock);
+	}
 
-		// Need to lock the octree because it may be trying to 
-		// get things from scene as it's being deleted!
-		std::unique_lock<std::mutex> octree_lock;
-		if (!parent_lock && m_Octree)
-			octree_lock = std::unique_lock<std::mutex>(m_Octree->GetOctreeMutex());
+	/// <summary>
+	/// Destroys the Entities and all of their children in one batch. Script OnDestroy
+	/// callbacks all run before anything is torn down, every PhysX actor is pulled
+	/// out of the physics scene in one call, and the octree lock is taken once.
+	/// </summary>
+	void Scene::DestroyEntities(std::span<const Entity> entities, std::unique_lock<std::shared_mutex>* parent_lock) {
 
-		// 1. Check if entity is valid
-		if (!entity) {
-			L_CORE_WARN("Attempted to Destroy Null Entity.");
-			return;
-		}
+		// 1. Gather the valid entities and all their children, parents first
+		std::vector<Entity> destroy_list;
+		std::unordered_set<entt::entity> destroy_set;
+
+		auto gather_entities = [&]() {
+
+			destroy_list.clear();
+			destroy_set.clear();
+
+			for (Entity entity : entities) {
+
+				if (!entity) {
+					L_CORE_WARN("Attempted to Destroy Null Entity.");
+					continue;
+				}
+
+				if (entity.GetScene() != this || !HasEntity(entity.GetUUID())) {
+					L_CORE_WARN("Attempted to Destroy an Entity Not In The Scene.");
+					continue;
+				}
+
+				if (destroy_set.insert(entity).second)
+					destroy_list.push_back(entity);
+			}
+
+			for (size_t i = 0; i < destroy_list.size(); i++) {
 
-		// 2. Check If Entity is Part of the Scene
-		if (!HasEntity(entity.GetUUID())) {
-			L_CORE_WARN("Attempted to Destroy an Entity Not In The Scene.");
+				Entity entity = destroy_list[i];
+				if (!entity.HasComponent<HierarchyComponent>())
+					continue;
+
+				const auto& component = entity.GetComponent<HierarchyComponent>();
+				for (size_t child = 0; child < component.GetChildren().size(); child++) {
+
+					Entity child_entity = component.GetChildEntity(child);
+					if (child_entity && destroy_set.insert(child_entity).second)
+						destroy_list.push_back(child_entity);
+				}
+			}
+		};
+
+		gather_entities();
+
+		if (destroy_list.empty())
 			return;
+
+		// 2. Flush Script OnDestroy callbacks before taking the lock, as
+		//    scripts may destroy other entities whilst being destroyed
+		if (m_IsRunning) {
+
+			bool scripts_called = false;
+			for (Entity entity : destroy_list) {
+
+				if (m_Registry.valid(entity) && entity.HasComponent<ScriptComponent>()) {
+					ScriptManager::OnDestroyEntity(entity);
+					scripts_called = true;
+				}
+			}
+
+			// A script may have destroyed or reparented part of the batch
+			if (scripts_called)
+				gather_entities();
 		}
 
-		if (m_IsRunning && entity.HasComponent<ScriptComponent>())
-			ScriptManager::OnDestroyEntity(entity);
+		// Need to lock the octree because it may be trying to 
+		// get things from scene as it's being deleted!
+		std::shared_ptr<SpatialIndex<Entity>> spatial_index = GetSpatialIndex().lock();
+		std::unique_lock<std::shared_mutex> octree_lock;
+		if (!parent_lock && spatial_index)
+			octree_lock = std::unique_lock<std::shared_mutex>(spatial_index->GetMutex());
 
 		// 3. Call Physics System Remove Methods
-		if (entity.HasAnyComponent<RigidbodyComponent, SphereColliderComponent, BoxColliderComponent>()) {
+		PhysicsSystem::RemoveActorsFromScene(destroy_list, this);
+
+		for (Entity& entity : destroy_list) {
+
+			if (!entity.HasAnyComponent<RigidbodyComponent, SphereColliderComponent, BoxColliderComponent>())
+				continue;
 
 			if (entity.HasComponent<RigidbodyComponent>())
 			{
@@ -397,37 +670,76 @@ namespace Louron {
 			}
 		}
 
-		// 4. Remove From Parent and Destroy All Children
-		if (entity.HasComponent<HierarchyComponent>()) {
+		// 4. Remove from parents that are staying in the scene, links 
+		//    between entities that are all being destroyed are left alone
+		for (Entity& entity : destroy_list) {
+
+			if (!entity.HasComponent<HierarchyComponent>())
+				continue;
 
 			auto& component = entity.GetComponent<HierarchyComponent>();
+			if (!component.HasParent())
+				continue;
 
-			if (component.HasParent()) 
+			Entity parent_entity = component.GetParentEntity();
+			if (!parent_entity || !destroy_set.count(parent_entity))
 				component.DetachParent();
-			
-			// Make a copy of the child list so we don't invalidate 
-			// the iterator whilst destroying children
-			std::vector<UUID> children_vec = component.GetChildren();
-			for (const auto& children_uuid : children_vec) 
-				DestroyEntity(FindEntityByUUID(children_uuid), &octree_lock);
 		}
 
-		// 5. Remove the Entity from the Scene Entity Map
-		m_EntityMap->erase(entity.GetUUID());
+		// 5. Remove the Entities from the Scene Entity Map
+		std::vector<entt::entity> entity_handles;
+		entity_handles.reserve(destroy_list.size());
 
-		// 6. Destroy the Entity and Components from the ENTT Registry
-		m_Registry.destroy(entity);
+		for (Entity& entity : destroy_list) {
+			m_EntityMap.Erase(entity.GetUUID());
+			entity_handles.push_back(entity);
+		}
+
+		// 6. Destroy the Entities and Components from the ENTT Registry
+		m_Registry.destroy(entity_handles.begin(), entity_handles.end());
+	}
+
+	void Scene::SubmitCommandBuffer(SceneCommandBuffer&& command_buffer) {
+
+		if (command_buffer.IsEmpty())
+			return;
+
+		m_SubmittedCommandBuffers.Push(std::make_shared<SceneCommandBuffer>(std::move(command_buffer)));
+	}
+
+	void Scene::FlushCommandBuffers() {
+
+		L_PROFILE_SCOPE("Scene - Flush Command Buffers");
+
+		// Playing back can record more changes, e.g. scripts destroying other
+		// entities in OnDestroy, so keep going until nothing new was recorded
+		constexpr int max_flush_passes = 8;
+
+		std::vector<std::shared_ptr<SceneCommandBuffer>> submitted_buffers;
+
+		for (int pass = 0; pass < max_flush_passes; pass++) {
+
+			if (m_CommandBuffer.IsEmpty() && m_SubmittedCommandBuffers.IsEmpty())
+				return;
+
+			m_CommandBuffer.Playback(this);
+
+			submitted_buffers.clear();
+			m_SubmittedCommandBuffers.PopAll(submitted_buffers);
+
+			for (auto& command_buffer : submitted_buffers)
+				command_buffer->Playback(this);
+		}
+
+		if (!m_CommandBuffer.IsEmpty() || !m_SubmittedCommandBuffers.IsEmpty())
+			L_CORE_WARN("Scene Command Buffers Still Recording After {0} Passes - Remaining Commands Deferred To Next Sync Point.", max_flush_passes);
 	}
 
 	// Returns Entity within Scene on Tag Name
 	Entity Scene::FindEntityByName(std::string_view name) {
 
-		auto view = m_Registry.view<TagComponent>();
-		for (auto entity : view) {
-			const TagComponent& tag = view.get<TagComponent>(entity);
-			if (tag.Tag == name)
-				return Entity{ entity, this };
-		}
+		if (Entity entity = FindEntityByNameIndex(std::string(name)))
+			return entity;
 
 		L_CORE_WARN("Scene Does Not Have an Entity Named: {0}", name);
 		return Entity{ entt::null, nullptr };
@@ -435,23 +747,46 @@ namespace Louron {
 
 	bool Scene::HasEntityByUUID(UUID uuid)
 	{
-		return m_EntityMap->find(uuid) != m_EntityMap->end();
+		return m_EntityMap.Contains(uuid);
 	}
 
 	Entity Scene::FindEntityByUUID(UUID uuid)
 	{
-		if (m_EntityMap->find(uuid) != m_EntityMap->end()) {
-			return Entity{ m_EntityMap->at(uuid), this };
-		}
+		if (Entity entity = TryFindEntityByUUID(uuid, true))
+			return entity;
 
 		L_CORE_WARN("Entity UUID not found in scene: {0}", std::to_string(uuid));
 		return Entity{ entt::null, nullptr };
 	}
 
+	Entity Scene::TryFindEntityByUUID(UUID uuid, bool include_despawned)
+	{
+		entt::entity entity_handle = m_EntityMap.TryFind(uuid);
+		if (entity_handle == entt::null)
+			return Entity{ entt::null, nullptr };
+
+		if (!include_despawned && m_Registry.has<DespawnedComponent>(entity_handle))
+			return Entity{ entt::null, nullptr };
+
+		return Entity{ entity_handle, this };
+	}
+
+	Entity Scene::ResolveEntity(entt::entity entity_handle, const UUID& uuid)
+	{
+		if (entity_handle != entt::null && m_Registry.valid(entity_handle)) {
+
+			const IDComponent* id_component = m_Registry.try_get<IDComponent>(entity_handle);
+			if (id_component && id_component->ID == uuid)
+				return Entity{ entity_handle, this };
+		}
+
+		return FindEntityByUUID(uuid);
+	}
+
 	// Returns Primary Camera Entity
 	Entity Scene::GetPrimaryCameraEntity() {
 
-		auto view = m_Registry.view<CameraComponent>();
+		auto view = m_Registry.view<CameraComponent>(entt::exclude<DespawnedComponent>);
 		for (auto entity : view) {
 			const CameraComponent& camera = view.get<CameraComponent>(entity);
 			if (camera.Primary)
@@ -470,11 +805,11 @@ namespace Louron {
 	}
 	bool Scene::HasEntity(const std::string& name)
 	{
-		return (FindEntityByName(name)) ? true : false;
+		return (FindEntityByNameIndex(name)) ? true : false;
 	}
 	bool Scene::HasEntity(const UUID& uuid)
 	{
-		return (FindEntityByUUID(uuid)) ? true : false;
+		return m_EntityMap.Contains(uuid);
 	}
 
 	bool Scene::ValidEntity(const Entity& entity)
@@ -482,204 +817,796 @@ namespace Louron {
 		return m_Registry.valid(entity);
 	}
 
+	std::string Scene::GetUniqueEntityName(const std::string& name)
+	{
+		return MakeUniqueEntityName(name);
+	}
+
+	std::string Scene::GetUniqueSiblingName(Entity entity, const std::string& name)
+	{
+		if (!entity || !entity.HasComponent<HierarchyComponent>())
+			return MakeUniqueEntityName(name);
+
+		const UUID parent_uuid = entity.GetComponent<HierarchyComponent>().GetParentID();
+
+		return MakeUniqueEntityName(name, [&](entt::entity other_handle) -> bool {
+
+			if (other_handle == (entt::entity)entity)
+				return false;
+
+			const HierarchyComponent* other_hierarchy = m_Registry.try_get<HierarchyComponent>(other_handle);
+			return other_hierarchy && other_hierarchy->GetParentID() == parent_uuid;
+		});
+	}
+
+	/// <summary>
+	/// Look up an entity with this exact name through the name index, optionally
+	/// only accepting entities the filter returns true for. Never logs on a miss.
+	/// </summary>
+	Entity Scene::FindEntityByNameIndex(const std::string& name, const std::function<bool(entt::entity)>& name_clashes)
+	{
+		auto [begin, end] = m_EntityNameMap.equal_range(name);
+		for (auto it = begin; it != end; ) {
+
+			// Entries are only left behind if a tag was written directly rather than through SetTag
+			const TagComponent* tag = m_Registry.valid(it->second) ? m_Registry.try_get<TagComponent>(it->second) : nullptr;
+			if (!tag || tag->Tag != name) {
+				it = m_EntityNameMap.erase(it);
+				continue;
+			}
+
+			// Parked prefab copies stay indexed so they need no re-indexing when spawned, but are not found
+			if (m_Registry.has<DespawnedComponent>(it->second)) {
+				++it;
+				continue;
+			}
+
+			if (!name_clashes || name_clashes(it->second))
+				return Entity{ it->second, this };
+
+			++it;
+		}
+
+		return Entity{ entt::null, nullptr };
+	}
+
+	/// <summary>
+	/// Append the next free " (n)" suffix until the name is unique. The suffix
+	/// carries on from the last one handed out for that base name, so creating
+	/// many copies of one name stays constant time per entity.
+	/// </summary>
+	std::string Scene::MakeUniqueEntityName(const std::string& name, const std::function<bool(entt::entity)>& name_clashes)
+	{
+		std::string base_name = name.empty() ? "Untitled Entity" : name;
+
+		if (!FindEntityByNameIndex(base_name, name_clashes))
+			return base_name;
+
+		uint32_t& suffix = m_EntityNameSuffixes[base_name];
+		if (suffix == 0)
+			suffix = 1;
+
+		std::string unique_name;
+		do {
+			unique_name = base_name + " (" + std::to_string(suffix++) + ")";
+		} while (FindEntityByNameIndex(unique_name, name_clashes));
+
+		return unique_name;
+	}
+
 	Entity Scene::InstantiatePrefab(std::shared_ptr<Prefab> prefab, std::optional<TransformComponent> transform, const UUID& parent_uuid)
 	{
 		if (!prefab)
 			return {};
 
-		entt::registry* prefab_registry = &prefab->m_PrefabRegistry;
-		entt::entity prefab_root_entity = prefab->m_RootEntity;
-		std::string prefab_name = prefab->m_PrefabName;
+		const PrefabTemplate& prefab_template = prefab->GetTemplate();
+		if (prefab_template.IsEmpty())
+			return {};
+
+		// If no transform is passed, the root keeps the transform it has in the prefab
+		if (!transform.has_value()) {
+
+			const PrefabTemplate::TemplateEntity& template_root = prefab_template.Entities.front();
+
+			transform.emplace();
+			transform->m_Position = template_root.Position;
+			transform->m_Rotation = template_root.Rotation;
+			transform->m_Scale = template_root.Scale;
+		}
+
+		std::vector<Entity> root_entities = InstantiatePrefab(prefab, std::span<const TransformComponent>(&transform.value(), 1), parent_uuid);
+
+		return root_entities.empty() ? Entity{} : root_entities.front();
+	}
+
+	/// <summary>
+	/// Insert components for a range of entities in one go, then give each new 
+	/// component the id, scene ref and handle of its entity.
+	/// </summary>
+	template<typename T, typename It>
+	static void InsertPrefabComponents(entt::registry& registry, Scene* scene_ref, const entt::entity* entity_handles, const UUID* entity_uuids, size_t count, It components) {
+
+		const size_t pool_size = registry.size<T>();
+
+		registry.insert<T>(entity_handles, entity_handles + count, components, components + count);
+
+		T* inserted_components = registry.raw<T>() + pool_size;
+		for (size_t i = 0; i < count; i++) {
+			inserted_components[i].entity_uuid = entity_uuids[i];
+			inserted_components[i].scene = scene_ref;
+			inserted_components[i].entity_handle = entity_handles[i];
+		}
+	}
+
+	std::vector<Entity> Scene::InstantiatePrefab(std::shared_ptr<Prefab> prefab, std::span<const TransformComponent> transforms, const UUID& parent_uuid)
+	{
+		std::vector<Entity> root_entities;
+
+		if (!prefab || transforms.empty())
+			return root_entities;
+
+		L_PROFILE_SCOPE("Scene - Instantiate Prefab");
+
+		const PrefabTemplate& prefab_template = prefab->GetTemplate();
+		if (prefab_template.IsEmpty())
+			return root_entities;
+
+		// Template entity i of copy c is entity c * template_size + i
+		const size_t template_size = prefab_template.Entities.size();
+		const size_t copy_count = transforms.size();
+		const size_t entity_count = template_size * copy_count;
+
+		std::vector<entt::entity> entity_handles(entity_count);
+		std::vector<UUID> entity_uuids(entity_count);
+
+		{
+			std::shared_ptr<SpatialIndex<Entity>> spatial_index = GetSpatialIndex().lock();
+			std::unique_lock<std::shared_mutex> lock;
 
-		std::vector<Entity> LODMeshEntities; // So we can easily resolve the prefab handles to entity UUIDs
-		std::unordered_map<Louron::UUID, Louron::UUID> PrefabUUID_To_EntityUUID{}; // Key == Prefab entt::entity, Value == instantiated_entity.GetUUID()
+			if (spatial_index)
+				lock = std::unique_lock<std::shared_mutex>(spatial_index->GetMutex());
 
-		std::function<Entity(entt::entity, const UUID&)> copy_prefab_entity = [&](entt::entity start_prefab_entity, const UUID& parent_uuid) -> Entity {
+			m_Registry.reserve(m_Registry.size() + entity_count);
+			m_Registry.reserve<IDComponent, TransformComponent, TagComponent, HierarchyComponent>(m_Registry.size<IDComponent>() + entity_count);
+			m_EntityMap.Reserve(m_EntityMap.Size() + entity_count);
+			m_EntityNameMap.reserve(m_EntityNameMap.size() + entity_count);
 
-			Entity instantiated_entity = this->CreateEntity("");
+			m_Registry.create(entity_handles.begin(), entity_handles.end());
 
-			PrefabUUID_To_EntityUUID[(uint32_t)start_prefab_entity] = instantiated_entity.GetUUID();
+			for (size_t i = 0; i < entity_count; i++) {
+				while (!m_EntityMap.Insert(entity_uuids[i], entity_handles[i]))
+					entity_uuids[i] = UUID();
+			}
 
-			// 1. Copy Data in All Components
+			// 1. Core Components, every entity has these
 			{
-				// 1.a. Tag Component
-				if (prefab_registry->has<TagComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<TagComponent>(start_prefab_entity);
-					instantiated_entity.GetComponent<TagComponent>().Tag = component.Tag;
-				}
+				std::vector<IDComponent> id_components;
+				std::vector<TagComponent> tag_components;
+				std::vector<TransformComponent> transform_components;
+				std::vector<HierarchyComponent> hierarchy_components;
 
-				// 1.b. Hierarchy Component
-				if (prefab_registry->has<HierarchyComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<HierarchyComponent>(start_prefab_entity);
-					instantiated_entity.GetComponent<HierarchyComponent>().AttachParent(parent_uuid);
-				}
+				id_components.reserve(entity_count);
+				tag_components.reserve(entity_count);
+				transform_components.reserve(entity_count);
+				hierarchy_components.reserve(entity_count);
 
-				// 1.c. Camera Component
-				if (prefab_registry->has<CameraComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<CameraComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<CameraComponent>(component);
-				}
+				for (size_t copy_index = 0; copy_index < copy_count; copy_index++) {
 
-				// 1.d. Audio Listener
-				if (prefab_registry->has<AudioListener>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<AudioListener>(start_prefab_entity);
-					instantiated_entity.AddComponent<AudioListener>(component);
-				}
+					const size_t copy_offset = copy_index * template_size;
+
+					for (size_t template_index = 0; template_index < template_size; template_index++) {
+
+						const PrefabTemplate::TemplateEntity& template_entity = prefab_template.Entities[template_index];
+						const size_t entity_index = copy_offset + template_index;
 
-				// 1.e. Audio Emitter
-				if (prefab_registry->has<AudioEmitter>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<AudioEmitter>(start_prefab_entity);
-					instantiated_entity.AddComponent<AudioEmitter>(component);
+						id_components.emplace_back(entity_uuids[entity_index]);
+						tag_components.emplace_back(template_entity.Tag);
+
+						// The root of each copy takes the transform passed in
+						TransformComponent& transform_component = transform_components.emplace_back();
+						if (template_index == 0) {
+							transform_component.m_Position = transforms[copy_index].GetLocalPosition();
+							transform_component.m_Rotation = transforms[copy_index].GetLocalRotation();
+							transform_component.m_Scale = transforms[copy_index].GetLocalScale();
+						}
+						else {
+							transform_component.m_Position = template_entity.Position;
+							transform_component.m_Rotation = template_entity.Rotation;
+							transform_component.m_Scale = template_entity.Scale;
+						}
+						transform_component.AddFlag(TransformFlag_PropertiesUpdated);
+
+						// Parent and children links are remapped to the entities of this copy
+						HierarchyComponent& hierarchy_component = hierarchy_components.emplace_back();
+						if (template_entity.ParentIndex != PREFAB_TEMPLATE_NULL_INDEX) {
+							hierarchy_component.m_Parent = entity_uuids[copy_offset + template_entity.ParentIndex];
+							hierarchy_component.m_ParentHandle = entity_handles[copy_offset + template_entity.ParentIndex];
+						}
+
+						hierarchy_component.m_Children.reserve(template_entity.ChildIndices.size());
+						hierarchy_component.m_ChildHandles.reserve(template_entity.ChildIndices.size());
+						for (uint32_t child_index : template_entity.ChildIndices) {
+							hierarchy_component.m_Children.push_back(entity_uuids[copy_offset + child_index]);
+							hierarchy_component.m_ChildHandles.push_back(entity_handles[copy_offset + child_index]);
+						}
+					}
 				}
 
-				// 1.f. Transform Component
-				if (prefab_registry->has<TransformComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<TransformComponent>(start_prefab_entity);
-					auto& transform_component = instantiated_entity.GetComponent<TransformComponent>();
-					
-					if (parent_uuid == NULL_UUID) { 
-						// If we are the root entity, we check if the transform 
-						// passed has a value, if not, standard copy from prefab
-						if (transform.has_value())
+				InsertPrefabComponents<IDComponent>(m_Registry, this, entity_handles.data(), entity_uuids.data(), entity_count, id_components.begin());
+				InsertPrefabComponents<TransformComponent>(m_Registry, this, entity_handles.data(), entity_uuids.data(), entity_count, transform_components.begin());
+				InsertPrefabComponents<TagComponent>(m_Registry, this, entity_handles.data(), entity_uuids.data(), entity_count, tag_components.begin());
+				InsertPrefabComponents<HierarchyComponent>(m_Registry, this, entity_handles.data(), entity_uuids.data(), entity_count, hierarchy_components.begin());
+			}
+
+			// 2. Component Blobs, each blob is inserted once per copy
+			{
+				std::vector<entt::entity> blob_handles;
+				std::vector<UUID> blob_uuids;
+
+				std::apply([&](const auto&... blob) {
+					([&]()
 						{
-							transform_component.SetPosition(transform.value().GetLocalPosition());
-							transform_component.SetRotation(transform.value().GetLocalRotation());
-							transform_component.SetScale(transform.value().GetLocalScale());
-						}
-						else
+							using ComponentType = typename std::decay_t<decltype(blob.Components)>::value_type;
+
+							const size_t blob_size = blob.Components.size();
+							if (blob_size == 0)
+								return;
+
+							m_Registry.reserve<ComponentType>(m_Registry.size<ComponentType>() + blob_size * copy_count);
+
+							blob_handles.resize(blob_size);
+							blob_uuids.resize(blob_size);
+
+							for (size_t copy_index = 0; copy_index < copy_count; copy_index++) {
+
+								for (size_t i = 0; i < blob_size; i++) {
+									const size_t entity_index = copy_index * template_size + blob.EntityIndices[i];
+									blob_handles[i] = entity_handles[entity_index];
+									blob_uuids[i] = entity_uuids[entity_index];
+								}
+
+								InsertPrefabComponents<ComponentType>(m_Registry, this, blob_handles.data(), blob_uuids.data(), blob_size, blob.Components.begin());
+							}
+						}(), ...);
+				}, prefab_template.Blobs);
+			}
+
+			// 3. Resolve prefab handles to scene uuids
+			const auto& lod_blob = std::get<PrefabComponentBlob<LODMeshComponent>>(prefab_template.Blobs);
+			for (size_t copy_index = 0; copy_index < copy_count; copy_index++) {
+
+				for (uint32_t template_index : lod_blob.EntityIndices) {
+
+					auto& component = m_Registry.get<LODMeshComponent>(entity_handles[copy_index * template_size + template_index]);
+					for (auto& element : component.LOD_Elements)
+					{
+						for (auto& entity_handle : element.MeshRendererEntities)
 						{
-							transform_component.SetPosition(component.GetLocalPosition());
-							transform_component.SetRotation(component.GetLocalRotation());
-							transform_component.SetScale(component.GetLocalScale());
+							auto it = prefab_template.PrefabUUIDIndices.find(entity_handle);
+							entity_handle = it != prefab_template.PrefabUUIDIndices.end() ? entity_uuids[copy_index * template_size + it->second] : (UUID)NULL_UUID;
 						}
 					}
-					else {
-						transform_component.SetPosition(component.GetLocalPosition());
-						transform_component.SetRotation(component.GetLocalRotation());
-						transform_component.SetScale(component.GetLocalScale());
-					}
 				}
+			}
+		}
 
-				// 1.g. MeshFilter
-				if (prefab_registry->has<MeshFilterComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<MeshFilterComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<MeshFilterComponent>(component);
-				}
+		root_entities.reserve(copy_count);
 
-				// 1.h. MeshRenderer
-				if (prefab_registry->has<MeshRendererComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<MeshRendererComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<MeshRendererComponent>(component);
-				}
+		for (size_t copy_index = 0; copy_index < copy_count; copy_index++) {
 
-				// 1.i. PointLight Component
-				if (prefab_registry->has<PointLightComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<PointLightComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<PointLightComponent>(component);
-				}
+			const size_t copy_offset = copy_index * template_size;
 
-				// 1.j. SpotLight Component
-				if (prefab_registry->has<SpotLightComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<SpotLightComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<SpotLightComponent>(component);
-				}
+			Entity root_entity = { entity_handles[copy_offset], this };
+			root_entities.push_back(root_entity);
 
-				// 1.k. DirectionalLight Component
-				if (prefab_registry->has<DirectionalLightComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<DirectionalLightComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<DirectionalLightComponent>(component);
-				}
+			if (parent_uuid != NULL_UUID) {
 
-				// 1.l. Skybox Component
-				if (prefab_registry->has<SkyboxComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<SkyboxComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<SkyboxComponent>(component);
-				}
+				root_entity.GetComponent<HierarchyComponent>().AttachParent(parent_uuid);
 
-				// 1.m. Rigidbody Component
-				if (prefab_registry->has<RigidbodyComponent>(start_prefab_entity)) {
-					RigidbodyComponent component = prefab_registry->get<RigidbodyComponent>(start_prefab_entity);
-					auto& ent_rb_component = instantiated_entity.AddComponent<RigidbodyComponent>(); 
-					ent_rb_component = component;
+				// Attaching keeps the world transform, the root should keep its local transform instead
+				auto& transform_component = root_entity.GetComponent<TransformComponent>();
+				transform_component.SetPosition(transforms[copy_index].GetLocalPosition());
+				transform_component.SetRotation(transforms[copy_index].GetLocalRotation());
+				transform_component.SetScale(transforms[copy_index].GetLocalScale());
+			}
 
-					if (IsRunning() || IsSimulating())
-						instantiated_entity.GetComponent<RigidbodyComponent>().Init(&instantiated_entity.GetComponent<TransformComponent>(), m_PhysxScene);
-				}
+			// 4. Physics and script components are initialised against the scene, so they are added one at a time
+			for (size_t template_index = 0; template_index < template_size; template_index++) {
 
-				// 1.n. Sphere Collider
-				if (prefab_registry->has<SphereColliderComponent>(start_prefab_entity)) {
-					SphereColliderComponent component = prefab_registry->get<SphereColliderComponent>(start_prefab_entity);
-					auto& ent_sc_component = instantiated_entity.AddComponent<SphereColliderComponent>();
-					ent_sc_component = component;
+				const PrefabTemplate::TemplateEntity& template_entity = prefab_template.Entities[template_index];
+				if (!template_entity.HasSceneBoundComponents)
+					continue;
 
+				InstantiatePrefabSceneBoundComponents(prefab, template_entity.PrefabEntity, { entity_handles[copy_offset + template_index], this });
+			}
+		}
 
-					if (IsRunning() || IsSimulating())
-						instantiated_entity.GetComponent<SphereColliderComponent>().Init();
-				}
+		return root_entities;
+	}
 
-				// 1.o. Box Collider
-				if (prefab_registry->has<BoxColliderComponent>(start_prefab_entity)) {
-					BoxColliderComponent component = prefab_registry->get<BoxColliderComponent>(start_prefab_entity);
-					auto& ent_bc_component = instantiated_entity.AddComponent<BoxColliderComponent>();
-					ent_bc_component = std::move(component);
+	void Scene::InstantiatePrefabSceneBoundComponents(std::shared_ptr<Prefab> prefab, entt::entity prefab_entity, Entity instantiated_entity)
+	{
+		entt::registry* prefab_registry = &prefab->m_PrefabRegistry;
 
-					if (IsRunning() || IsSimulating())
-						instantiated_entity.GetComponent<BoxColliderComponent>().Init();
-				}
+		// 1. Rigidbody Component
+		if (prefab_registry->has<RigidbodyComponent>(prefab_entity)) {
+			RigidbodyComponent component = prefab_registry->get<RigidbodyComponent>(prefab_entity);
+			auto& ent_rb_component = instantiated_entity.AddComponent<RigidbodyComponent>(); 
+			ent_rb_component = component;
 
-				// 1.p. Script Component
-				if (prefab_registry->has<ScriptComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<ScriptComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<ScriptComponent>(component);
+			if (IsRunning() || IsSimulating())
+				instantiated_entity.GetComponent<RigidbodyComponent>().Init(&instantiated_entity.GetComponent<TransformComponent>(), m_PhysxScene);
+		}
 
-					// TODO: Add functionality to move script and script fields from prefabs into new components
-					// basically just need to copy the ScriptFieldInstances from the prefabs entries in the scriptmanager
-					// to this new entity! easy peasy...
+		// 2. Sphere Collider
+		if (prefab_registry->has<SphereColliderComponent>(prefab_entity)) {
+			SphereColliderComponent component = prefab_registry->get<SphereColliderComponent>(prefab_entity);
+			auto& ent_sc_component = instantiated_entity.AddComponent<SphereColliderComponent>();
+			ent_sc_component = component;
 
-				}
+			if (IsRunning() || IsSimulating())
+				instantiated_entity.GetComponent<SphereColliderComponent>().Init();
+		}
 
-				// 1.q. LOD Component
-				if (prefab_registry->has<LODMeshComponent>(start_prefab_entity)) {
-					auto& component = prefab_registry->get<LODMeshComponent>(start_prefab_entity);
-					instantiated_entity.AddComponent<LODMeshComponent>(component);
-					LODMeshEntities.push_back(instantiated_entity);
-				}
+		// 3. Box Collider
+		if (prefab_registry->has<BoxColliderComponent>(prefab_entity)) {
+			BoxColliderComponent component = prefab_registry->get<BoxColliderComponent>(prefab_entity);
+			auto& ent_bc_component = instantiated_entity.AddComponent<BoxColliderComponent>();
+			ent_bc_component = std::move(component);
+
+			if (IsRunning() || IsSimulating())
+				instantiated_entity.GetComponent<BoxColliderComponent>().Init();
+		}
+
+		// 4. Script Component
+		if (prefab_registry->has<ScriptComponent>(prefab_entity)) {
+			auto& component = prefab_registry->get<ScriptComponent>(prefab_entity);
+			instantiated_entity.AddComponent<ScriptComponent>(component);
+
+			// TODO: Add functionality to move script and script fields from prefabs into new components
+			// basically just need to copy the ScriptFieldInstances from the prefabs entries in the scriptmanager
+			// to this new entity! easy peasy...
+
+		}
+	}
+
+	void Scene::SetPrefabPooling(AssetHandle prefab_handle, bool enabled)
+	{
+		if (prefab_handle == NULL_UUID)
+			return;
+
+		if (enabled) {
+			m_PrefabPools.try_emplace(prefab_handle);
+			return;
+		}
+
+		auto it = m_PrefabPools.find(prefab_handle);
+		if (it == m_PrefabPools.end())
+			return;
+
+		std::vector<UUID> pooled_roots = std::move(it->second);
+		m_PrefabPools.erase(it);
+
+		// Deferred, scripts can disable pooling part way through the scene iterating them
+		if (IsRunning()) {
+			for (const UUID& root_uuid : pooled_roots)
+				GetCommandBuffer().DestroyEntity(root_uuid);
+			return;
+		}
+
+		std::vector<Entity> pooled_entities;
+		pooled_entities.reserve(pooled_roots.size());
+
+		for (const UUID& root_uuid : pooled_roots)
+			if (Entity root_entity = TryFindEntityByUUID(root_uuid, true))
+				pooled_entities.push_back(root_entity);
+
+		DestroyEntities(pooled_entities);
+	}
+
+	bool Scene::IsPrefabPooled(AssetHandle prefab_handle) const
+	{
+		return m_PrefabPools.find(prefab_handle) != m_PrefabPools.end();
+	}
+
+	/// <summary>
+	/// Collect the entities of a prefab copy in the order of the prefab's template,
+	/// which is the same preorder walk of the hierarchy the template was compiled with.
+	/// </summary>
+	static std::vector<UUID> GatherPrefabInstanceEntities(Entity root_entity)
+	{
+		std::vector<UUID> instance_entities;
+		std::vector<Entity> stack = { root_entity };
+
+		while (!stack.empty()) {
+
+			Entity entity = stack.back();
+			stack.pop_back();
+
+			instance_entities.push_back(entity.GetUUID());
+
+			const auto& component = entity.GetComponent<HierarchyComponent>();
+			for (size_t child = component.GetChildren().size(); child-- > 0;)
+				if (Entity child_entity = component.GetChildEntity(child))
+					stack.push_back(child_entity);
+		}
+
+		return instance_entities;
+	}
+
+	Entity Scene::SpawnPrefab(std::shared_ptr<Prefab> prefab, std::optional<TransformComponent> transform, const UUID& parent_uuid)
+	{
+		if (!prefab)
+			return {};
+
+		auto pool_it = m_PrefabPools.find(prefab->Handle);
+		if (pool_it == m_PrefabPools.end())
+			return InstantiatePrefab(prefab, transform, parent_uuid);
+
+		L_PROFILE_SCOPE("Scene - Spawn Prefab");
+
+		const PrefabTemplate& prefab_template = prefab->GetTemplate();
+
+		// 1. Take the most recently despawned copy, skipping any destroyed since, and
+		//    destroying any parked before the prefab changed shape
+		Entity root_entity;
+		while (!pool_it->second.empty() && !root_entity) {
+
+			root_entity = TryFindEntityByUUID(pool_it->second.back(), true);
+			pool_it->second.pop_back();
+
+			if (root_entity && !root_entity.HasComponent<PrefabInstanceComponent>())
+				root_entity = {};
+
+			if (root_entity && root_entity.GetComponent<PrefabInstanceComponent>().InstanceEntities.size() != prefab_template.Entities.size()) {
+				DestroyEntity(root_entity);
+				root_entity = {};
 			}
+		}
 
-			// 2. Recurse Children
-			if (prefab_registry->has<HierarchyComponent>(start_prefab_entity)) {
+		// 2. Nothing to reuse, instantiate a new copy that can be despawned later
+		if (!root_entity) {
 
-				for (const auto& child_uuid : prefab_registry->get<HierarchyComponent>(start_prefab_entity).GetChildren())
-				{
-					Entity child_entity = copy_prefab_entity(prefab->FindEntityByUUID(child_uuid), instantiated_entity.GetUUID());
+			root_entity = InstantiatePrefab(prefab, transform, parent_uuid);
+			if (!root_entity)
+				return {};
+
+			auto& instance_component = root_entity.AddComponent<PrefabInstanceComponent>();
+			instance_component.PrefabHandle = prefab->Handle;
+			instance_component.InstanceEntities = GatherPrefabInstanceEntities(root_entity);
+
+			return root_entity;
+		}
+
+		// Index matched with the template, any entity destroyed while the copy was live is null
+		const std::vector<UUID>& instance_uuids = root_entity.GetComponent<PrefabInstanceComponent>().InstanceEntities;
+		const size_t template_size = prefab_template.Entities.size();
+
+		std::vector<Entity> template_entities(template_size);
+		std::vector<Entity> instance_entities;
+		instance_entities.reserve(template_size);
+
+		for (size_t i = 0; i < template_size; i++) {
+			if (Entity entity = TryFindEntityByUUID(instance_uuids[i], true)) {
+				template_entities[i] = entity;
+				instance_entities.push_back(entity);
+			}
+		}
+
+		// 3. Put back the prefab's data components, so whatever the last spawn changed
+		//    or added at runtime does not carry over
+		{
+			std::shared_ptr<SpatialIndex<Entity>> spatial_index = GetSpatialIndex().lock();
+			std::unique_lock<std::shared_mutex> lock;
+			if (spatial_index)
+				lock = std::unique_lock<std::shared_mutex>(spatial_index->GetMutex());
+
+			for (Entity entity : instance_entities)
+				m_Registry.remove_if_exists<DespawnedComponent>(entity);
+
+			std::vector<entt::entity> blob_handles;
+			std::vector<UUID> blob_uuids;
+
+			std::apply([&](const auto&... blob) {
+				([&]()
+					{
+						using ComponentType = typename std::decay_t<decltype(blob.Components)>::value_type;
+
+						for (Entity entity : instance_entities)
+							m_Registry.remove_if_exists<ComponentType>(entity);
+
+						blob_handles.clear();
+						blob_uuids.clear();
 
+						std::vector<ComponentType> components;
+						for (size_t i = 0; i < blob.Components.size(); i++) {
+
+							Entity entity = template_entities[blob.EntityIndices[i]];
+							if (!entity)
+								continue;
+
+							blob_handles.push_back(entity);
+							blob_uuids.push_back(entity.GetUUID());
+							components.push_back(blob.Components[i]);
+						}
+
+						if (!components.empty())
+							InsertPrefabComponents<ComponentType>(m_Registry, this, blob_handles.data(), blob_uuids.data(), components.size(), components.begin());
+					}(), ...);
+			}, prefab_template.Blobs);
+
+			// Resolve prefab handles to the uuids of this copy
+			const auto& lod_blob = std::get<PrefabComponentBlob<LODMeshComponent>>(prefab_template.Blobs);
+			for (uint32_t template_index : lod_blob.EntityIndices) {
+
+				Entity entity = template_entities[template_index];
+				if (!entity)
+					continue;
+
+				for (auto& element : entity.GetComponent<LODMeshComponent>().LOD_Elements) {
+					for (auto& entity_handle : element.MeshRendererEntities) {
+						auto it = prefab_template.PrefabUUIDIndices.find(entity_handle);
+						entity_handle = it != prefab_template.PrefabUUIDIndices.end() ? instance_uuids[it->second] : (UUID)NULL_UUID;
+					}
 				}
+			}
+		}
+
+		// 4. Reset names, parents and transforms to the ones they have in the prefab, the root takes the transform passed in
+		for (size_t i = 0; i < template_size; i++) {
+
+			Entity entity = template_entities[i];
+			if (!entity)
+				continue;
+
+			const PrefabTemplate::TemplateEntity& template_entity = prefab_template.Entities[i];
+
+			if (entity.GetComponent<TagComponent>().Tag != template_entity.Tag)
+				entity.GetComponent<TagComponent>().SetTag(template_entity.Tag);
 
+			// Entities moved elsewhere in the hierarchy while the copy was live go back under their prefab parent
+			if (template_entity.ParentIndex != PREFAB_TEMPLATE_NULL_INDEX) {
+
+				auto& hierarchy_component = entity.GetComponent<HierarchyComponent>();
+				const UUID& template_parent_uuid = instance_uuids[template_entity.ParentIndex];
+
+				if (hierarchy_component.GetParentID() != template_parent_uuid && template_entities[template_entity.ParentIndex])
+					hierarchy_component.AttachParent(template_parent_uuid);
+			}
+
+			auto& transform_component = entity.GetComponent<TransformComponent>();
+			if (i == 0 && transform.has_value()) {
+				transform_component.SetPosition(transform->GetLocalPosition());
+				transform_component.SetRotation(transform->GetLocalRotation());
+				transform_component.SetScale(transform->GetLocalScale());
 			}
+			else {
+				transform_component.SetPosition(template_entity.Position);
+				transform_component.SetRotation(template_entity.Rotation);
+				transform_component.SetScale(template_entity.Scale);
+			}
+		}
 
-			return instantiated_entity;
+		if (parent_uuid != NULL_UUID) {
 
-		};
+			const glm::vec3 position = root_entity.GetComponent<TransformComponent>().GetLocalPosition();
+			const glm::vec3 rotation = root_entity.GetComponent<TransformComponent>().GetLocalRotation();
+			const glm::vec3 scale = root_entity.GetComponent<TransformComponent>().GetLocalScale();
 
-		Entity instantiated_entity = copy_prefab_entity(prefab_root_entity, parent_uuid);
+			root_entity.GetComponent<HierarchyComponent>().AttachParent(parent_uuid);
 
-		// Resolve prefab handles to scene uuids
-		for (auto& entity : LODMeshEntities)
-		{
-			if (!entity || !entity.HasComponent<LODMeshComponent>())
+			// Attaching keeps the world transform, the root should keep its local transform instead
+			auto& transform_component = root_entity.GetComponent<TransformComponent>();
+			transform_component.SetPosition(position);
+			transform_component.SetRotation(rotation);
+			transform_component.SetScale(scale);
+		}
+
+		// 5. Put the physics actors back, reset their settings to the prefab's and clear any motion they had when despawned
+		PhysicsSystem::AddActorsToScene(instance_entities, this);
+
+		for (size_t i = 0; i < template_size; i++)
+			if (template_entities[i])
+				ResetPrefabSceneBoundComponents(prefab, prefab_template.Entities[i].PrefabEntity, template_entities[i]);
+
+		for (Entity entity : instance_entities) {
+
+			if (!entity.HasComponent<RigidbodyComponent>())
 				continue;
 
-			auto& component = entity.GetComponent<LODMeshComponent>();
-			for (auto& element : component.LOD_Elements)
-			{
-				for (auto& entity_handle : element.MeshRendererEntities)
-				{
-					entity_handle = PrefabUUID_To_EntityUUID[entity_handle];
-				}
+			auto& rigidbody_component = entity.GetComponent<RigidbodyComponent>();
+			if (rigidbody_component.IsKinematicEnabled())
+				continue;
+
+			if (auto rigidbody = rigidbody_component.GetActor(); rigidbody && rigidbody->GetActor()) {
+				rigidbody->SetLinearVelocity(glm::vec3(0.0f));
+				rigidbody->SetAngularVelocity(PxVec3(0.0f));
 			}
 		}
 
-		return instantiated_entity;
+		// 6. Meshes go back into the spatial index, and scripts start again from OnCreate
+		for (Entity entity : instance_entities) {
+
+			if (entity.HasComponent<MeshFilterComponent>()) {
+				MarkOctreeDirty(entity);
+				MarkRenderProxyDirty(entity);
+			}
+
+			if (m_IsRunning && entity.HasComponent<ScriptComponent>())
+				ScriptManager::OnCreateEntity(entity);
+		}
+
+		return root_entity;
+	}
+
+	void Scene::ResetPrefabSceneBoundComponents(std::shared_ptr<Prefab> prefab, entt::entity prefab_entity, Entity pooled_entity)
+	{
+		entt::registry* prefab_registry = &prefab->m_PrefabRegistry;
+
+		// 1. Rigidbody Component, the actor is kept and only its settings are reset
+		if (!prefab_registry->has<RigidbodyComponent>(prefab_entity)) {
+			pooled_entity.RemoveComponent<RigidbodyComponent>();
+		}
+		else if (pooled_entity.HasComponent<RigidbodyComponent>()) {
+
+			const auto& component = prefab_registry->get<RigidbodyComponent>(prefab_entity);
+			auto& rigidbody_component = pooled_entity.GetComponent<RigidbodyComponent>();
+
+			rigidbody_component.SetMass(component.GetMass());
+			rigidbody_component.SetDrag(component.GetDrag());
+			rigidbody_component.SetAngularDrag(component.GetAngularDrag());
+			rigidbody_component.SetAutomaticCentreOfMass(component.IsAutomaticCentreOfMassEnabled());
+			rigidbody_component.SetGravity(component.IsGravityEnabled());
+			rigidbody_component.SetKinematic(component.IsKinematicEnabled());
+			rigidbody_component.SetPositionConstraint(component.GetPositionConstraint());
+			rigidbody_component.SetRotationConstraint(component.GetRotationConstraint());
+		}
+		else {
+			pooled_entity.AddComponent<RigidbodyComponent>() = prefab_registry->get<RigidbodyComponent>(prefab_entity);
+
+			if (IsRunning() || IsSimulating())
+				pooled_entity.GetComponent<RigidbodyComponent>().Init(&pooled_entity.GetComponent<TransformComponent>(), m_PhysxScene);
+		}
+
+		// 2. Sphere Collider
+		if (!prefab_registry->has<SphereColliderComponent>(prefab_entity)) {
+			pooled_entity.RemoveComponent<SphereColliderComponent>();
+		}
+		else if (pooled_entity.HasComponent<SphereColliderComponent>()) {
+
+			const auto& component = prefab_registry->get<SphereColliderComponent>(prefab_entity);
+			auto& collider_component = pooled_entity.GetComponent<SphereColliderComponent>();
+
+			collider_component.SetIsTrigger(component.IsTrigger());
+			collider_component.SetMaterial(component.GetMaterial());
+			collider_component.SetCentre(component.GetCentre());
+			collider_component.SetRadius(component.GetRadius());
+		}
+		else {
+			pooled_entity.AddComponent<SphereColliderComponent>() = prefab_registry->get<SphereColliderComponent>(prefab_entity);
+
+			if (IsRunning() || IsSimulating())
+				pooled_entity.GetComponent<SphereColliderComponent>().Init();
+		}
+
+		// 3. Box Collider
+		if (!prefab_registry->has<BoxColliderComponent>(prefab_entity)) {
+			pooled_entity.RemoveComponent<BoxColliderComponent>();
+		}
+		else if (pooled_entity.HasComponent<BoxColliderComponent>()) {
+
+			const auto& component = prefab_registry->get<BoxColliderComponent>(prefab_entity);
+			auto& collider_component = pooled_entity.GetComponent<BoxColliderComponent>();
+
+			collider_component.SetIsTrigger(component.IsTrigger());
+			collider_component.SetMaterial(component.GetMaterial());
+			collider_component.SetCentre(component.GetCentre());
+			collider_component.SetSize(component.GetSize());
+		}
+		else {
+			pooled_entity.AddComponent<BoxColliderComponent>() = prefab_registry->get<BoxColliderComponent>(prefab_entity);
+
+			if (IsRunning() || IsSimulating())
+				pooled_entity.GetComponent<BoxColliderComponent>().Init();
+		}
+
+		// 4. Script Component, added straight to the registry as SpawnPrefab calls OnCreate for the whole copy
+		if (!prefab_registry->has<ScriptComponent>(prefab_entity)) {
+			m_Registry.remove_if_exists<ScriptComponent>(pooled_entity);
+		}
+		else if (pooled_entity.HasComponent<ScriptComponent>()) {
+			pooled_entity.GetComponent<ScriptComponent>().Scripts = prefab_registry->get<ScriptComponent>(prefab_entity).Scripts;
+		}
+		else {
+			auto& script_component = m_Registry.emplace<ScriptComponent>(pooled_entity, prefab_registry->get<ScriptComponent>(prefab_entity));
+			script_component.scene = this;
+			script_component.entity_uuid = pooled_entity.GetUUID();
+			script_component.entity_handle = pooled_entity;
+		}
+	}
+
+	void Scene::DespawnEntity(Entity entity)
+	{
+		if (!entity || entity.GetScene() != this)
+			return;
+
+		if (!entity.HasComponent<PrefabInstanceComponent>()) {
+			DestroyEntity(entity);
+			return;
+		}
+
+		const PrefabInstanceComponent& instance_component = entity.GetComponent<PrefabInstanceComponent>();
+
+		auto pool_it = m_PrefabPools.find(instance_component.PrefabHandle);
+		if (pool_it == m_PrefabPools.end()) {
+			DestroyEntity(entity);
+			return;
+		}
+
+		if (entity.HasComponent<DespawnedComponent>())
+			return;
+
+		L_PROFILE_SCOPE("Scene - Despawn Entity");
+
+		std::vector<Entity> instance_entities;
+		instance_entities.reserve(instance_component.InstanceEntities.size());
+
+		for (const UUID& entity_uuid : instance_component.InstanceEntities)
+			if (Entity instance_entity = TryFindEntityByUUID(entity_uuid, true))
+				instance_entities.push_back(instance_entity);
+
+		// 1. Scripts are torn down as if destroyed, so the copy starts fresh when spawned again
+		if (m_IsRunning) {
+			for (Entity instance_entity : instance_entities)
+				if (instance_entity.HasComponent<ScriptComponent>())
+					ScriptManager::OnDestroyEntity(instance_entity);
+		}
+
+		// 2. Physics actors are pulled out of the physics scene but kept alive
+		PhysicsSystem::RemoveActorsFromScene(instance_entities, this);
+
+		auto& hierarchy_component = entity.GetComponent<HierarchyComponent>();
+		if (hierarchy_component.HasParent())
+			hierarchy_component.DetachParent();
+
+		// Entities attached to the copy at runtime are not part of it, they stay live in the scene
+		std::unordered_set<UUID> instance_uuids(instance_component.InstanceEntities.begin(), instance_component.InstanceEntities.end());
+		for (Entity instance_entity : instance_entities) {
+
+			std::vector<Entity> foreign_children;
+
+			const auto& instance_hierarchy = instance_entity.GetComponent<HierarchyComponent>();
+			for (size_t child = 0; child < instance_hierarchy.GetChildren().size(); child++) {
+				if (!instance_uuids.count(instance_hierarchy.GetChildren()[child]))
+					if (Entity child_entity = instance_hierarchy.GetChildEntity(child))
+						foreign_children.push_back(child_entity);
+			}
+
+			for (Entity child_entity : foreign_children)
+				child_entity.GetComponent<HierarchyComponent>().DetachParent();
+		}
+
+		// 3. Flag the copy as despawned and take its meshes out of the spatial index straight away
+		{
+			std::shared_ptr<SpatialIndex<Entity>> spatial_index = GetSpatialIndex().lock();
+			std::unique_lock<std::shared_mutex> lock;
+			if (spatial_index)
+				lock = std::unique_lock<std::shared_mutex>(spatial_index->GetMutex());
+
+			for (Entity instance_entity : instance_entities) {
+
+				if (!instance_entity.HasComponent<DespawnedComponent>())
+					instance_entity.AddComponent<DespawnedComponent>();
+
+				if (spatial_index && spatial_index->HasDataSource(instance_entity))
+					spatial_index->Remove(instance_entity);
+
+				if (instance_entity.HasComponent<MeshFilterComponent>())
+					MarkRenderProxyDirty(instance_entity);
+			}
+		}
+
+		pool_it->second.push_back(entity.GetUUID());
 	}
 
 #pragma endregion
@@ -725,6 +1652,8 @@ namespace Louron {
 				Entity entity = { e, this };
 				ScriptManager::OnCreateEntity(entity);
 			}
+
+			FlushCommandBuffers();
 		}
 
 		OnPhysicsStart();
@@ -735,6 +1664,20 @@ namespace Louron {
 		m_IsRunning = false;
 		m_IsSimulating = false;
 
+		// Pooled copies only exist at runtime
+		for (auto& [prefab_handle, pooled_entities] : m_PrefabPools) {
+
+			std::vector<Entity> root_entities;
+			root_entities.reserve(pooled_entities.size());
+
+			for (const UUID& root_uuid : pooled_entities)
+				if (Entity root_entity = TryFindEntityByUUID(root_uuid, true))
+					root_entities.push_back(root_entity);
+
+			pooled_entities.clear();
+			DestroyEntities(root_entities);
+		}
+
 		ScriptManager::OnRuntimeStop();
 		OnPhysicsStop();
 	}
@@ -869,6 +1812,14 @@ namespace Louron {
 	void Scene::OnUpdate(EditorCamera* editor_camera) {
 
 		L_PROFILE_SCOPE("Scene - OnUpdate");
+
+		// Transforms - the one full pass of the frame, resolving global transforms before physics 
+		// and rendering read them. The fixed steps have already written back their own poses
+		if (!m_IsPaused && (m_IsRunning || m_IsSimulating))
+			PhysicsSystem::UpdateTransforms(std::static_pointer_cast<Scene>(shared_from_this()));
+		else
+			TransformSystem::UpdateGlobalTransforms(this);
+
 		// Physics
 		if (!m_IsPaused && (m_IsRunning || m_IsSimulating)) {
 			PhysicsSystem::UpdatePhysicsObjects(std::static_pointer_cast<Scene>(shared_from_this()));
@@ -880,10 +1831,15 @@ namespace Louron {
 			// See if any entities that have inactive scripts have recently become active
 			ScriptManager::CheckInactiveScriptsOnEntities();
 
-			auto script_entities = m_Registry.view<ScriptComponent>();
+			auto script_entities = m_Registry.view<ScriptComponent>(entt::exclude<DespawnedComponent>);
 			for (auto script_entity : script_entities)
 				ScriptManager::OnUpdateEntity({ script_entity, this });
-			
+
+			// Sync point - apply the structural changes scripts requested
+			FlushCommandBuffers();
+
+			// Anything the scripts moved has already flagged itself and its children, so
+			// rendering resolves it through GetGlobalTransform until the next frame's pass
 		}
 
 		CameraBase* camera = nullptr;
@@ -961,10 +1917,12 @@ namespace Louron {
 		// Scripts - only if running
 		if (!m_IsPaused && m_IsRunning) {
 
-			auto script_entities = m_Registry.view<ScriptComponent>();
+			auto script_entities = m_Registry.view<ScriptComponent>(entt::exclude<DespawnedComponent>);
 			for (auto script_entity : script_entities)
 				ScriptManager::OnFixedUpdateEntity({ script_entity, this });
 
+			// Sync point - apply the structural changes scripts requested
+			FlushCommandBuffers();
 		}
 
 		// Physics
@@ -976,8 +1934,8 @@ namespace Louron {
 
 			// Handle persistent collision triggers as trigger callback is not called when contact is persistent
 			for (const auto& pair : CollisionCallback::s_ActiveTriggers) {
-				Entity triggerEntity = FindEntityByUUID(pair.first);
-				Entity otherEntity = FindEntityByUUID(pair.second);
+				Entity triggerEntity = TryFindEntityByUUID(pair.first);
+				Entity otherEntity = TryFindEntityByUUID(pair.second);
 
 				if (triggerEntity && otherEntity && triggerEntity.HasComponent<ScriptComponent>()) {
 					ScriptManager::OnCollideEntity(triggerEntity, otherEntity, _Collision_Type::TriggerStay);
@@ -985,6 +1943,9 @@ namespace Louron {
 			}
 
 			m_IsPhysicsCalculating = false;
+
+			// Sync point - apply anything requested by collision and trigger callbacks
+			FlushCommandBuffers();
 		}
 
 	}
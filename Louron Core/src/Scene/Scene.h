@@ -2,10 +2,17 @@
 
 // Louron Core Headers
 #include "OctreeBounds.h"
+#include "Spatial Index.h"
+#include "Entity Map.h"
+#include "Scene Command Buffer.h"
+
+#include "Scene Systems/Transform System.h"
 
 #include "../Asset/Asset.h"
 
+#include "../Core/Job System.h"
 #include "../Core/Logging.h"
+#include "../Core/Lock Free Queue.h"
 
 #include "Components/Components.h"
 #include "Components/Physics/CollisionCallback.h"
@@ -19,6 +26,11 @@
 #include <optional>
 #include <string>
 #include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <functional>
+#include <unordered_map>
 
 // External Vendor Library Headers
 #include <entt/entt.hpp>
@@ -52,6 +64,11 @@ namespace Louron {
 
 		L_RENDER_PIPELINE ScenePipelineType;
 
+		/// <summary>
+		/// Which spatial index the scene culls and queries its mesh bounds with.
+		/// </summary>
+		SpatialIndexType SceneSpatialIndexType = SpatialIndexType::Octree;
+
 	};
 
 	class Scene : public Asset {
@@ -69,13 +86,89 @@ namespace Louron {
 		Entity CreateEntity(const std::string& name = "");
 		Entity CreateEntity(UUID uuid, const std::string& name = "");
 
+		/// <summary>
+		/// Create count entities with new UUIDs, taking the octree lock once and
+		/// reserving registry storage for all of them up front.
+		/// </summary>
+		std::vector<Entity> CreateEntities(size_t count, const std::string& name = "");
+
 		Entity InstantiatePrefab(std::shared_ptr<Prefab> prefab, std::optional<TransformComponent> transform = std::nullopt, const UUID& parent_uuid = NULL_UUID);
 
+		/// <summary>
+		/// Instantiate a copy of the prefab for each transform, using the transform as 
+		/// the local transform of the copy's root. All copies are created from the 
+		/// prefab's compiled template in one batch under a single octree lock.
+		/// </summary>
+		/// <returns>The root entity of each copy, in the same order as transforms.</returns>
+		std::vector<Entity> InstantiatePrefab(std::shared_ptr<Prefab> prefab, std::span<const TransformComponent> transforms, const UUID& parent_uuid = NULL_UUID);
+
+		/// <summary>
+		/// Enable or disable pooling of this prefab's instances. While enabled, 
+		/// DespawnEntity parks a copy of the prefab instead of destroying it, and 
+		/// SpawnPrefab reuses parked copies before instantiating new ones. 
+		/// Disabling destroys every parked copy, at the next command buffer
+		/// playback while the scene is running.
+		/// </summary>
+		void SetPrefabPooling(AssetHandle prefab_handle, bool enabled);
+		bool IsPrefabPooled(AssetHandle prefab_handle) const;
+
+		/// <summary>
+		/// Same as InstantiatePrefab, but reuses a despawned copy of the prefab
+		/// if the prefab is pooled and one is available. A reused copy has its 
+		/// names, hierarchy, transforms and components reset to the prefab's.
+		/// </summary>
+		Entity SpawnPrefab(std::shared_ptr<Prefab> prefab, std::optional<TransformComponent> transform = std::nullopt, const UUID& parent_uuid = NULL_UUID);
+
+		/// <summary>
+		/// Return a spawned copy of a pooled prefab to its pool, taking it out of 
+		/// rendering, physics and scripting. Entities attached to the copy at runtime
+		/// are detached and left in the scene. Any other entity is destroyed. Parked
+		/// copies are not returned by name, UUID or primary camera lookups.
+		/// </summary>
+		void DespawnEntity(Entity entity);
+
 		Entity DuplicateEntity(Entity entity);
-		void DestroyEntity(Entity entity, std::unique_lock<std::mutex>* parent_lock = nullptr);
+		void DestroyEntity(Entity entity, std::unique_lock<std::shared_mutex>* parent_lock = nullptr);
+
+		/// <summary>
+		/// Destroy the entities and their children together. Scripts receive OnDestroy 
+		/// for the whole batch first, then physics actors are released in one flush.
+		/// </summary>
+		void DestroyEntities(std::span<const Entity> entities, std::unique_lock<std::shared_mutex>* parent_lock = nullptr);
+
+		/// <summary>
+		/// The main thread's command buffer, for structural changes requested while 
+		/// the registry is being iterated, e.g. by scripts. Applied at the next sync point.
+		/// </summary>
+		SceneCommandBuffer& GetCommandBuffer() { return m_CommandBuffer; }
+
+		/// <summary>
+		/// Hand over a command buffer recorded on another thread, to be applied at
+		/// the next sync point after the main thread's buffer. Safe from any thread.
+		/// </summary>
+		void SubmitCommandBuffer(SceneCommandBuffer&& command_buffer);
+
+		/// <summary>
+		/// Sync point, apply every recorded structural change. Called by the scene 
+		/// after scripts and systems have run, and must only be called from the main thread.
+		/// </summary>
+		void FlushCommandBuffers();
 		
 		Entity FindEntityByName(std::string_view name);
 		Entity FindEntityByUUID(UUID uuid);
+
+		/// <summary>
+		/// Same as FindEntityByUUID but without logging a warning on a miss, for
+		/// callers where a missing entity is expected, e.g. stale references.
+		/// Despawned prefab copies are treated as missing unless include_despawned is true.
+		/// </summary>
+		Entity TryFindEntityByUUID(UUID uuid, bool include_despawned = false);
+
+		/// <summary>
+		/// Find an entity through a cached registry handle, only falling back to the
+		/// UUID lookup if the handle is null or no longer belongs to that UUID.
+		/// </summary>
+		Entity ResolveEntity(entt::entity entity_handle, const UUID& uuid);
 		bool HasEntityByUUID(UUID uuid);
 
 		bool HasEntity(const Entity& entity);
@@ -84,6 +177,18 @@ namespace Louron {
 
 		bool ValidEntity(const Entity& entity);
 
+		/// <summary>
+		/// The name, or the name with the next free " (n)" suffix, that no other
+		/// entity in the scene is using.
+		/// </summary>
+		std::string GetUniqueEntityName(const std::string& name);
+
+		/// <summary>
+		/// As GetUniqueEntityName, but only the entity's siblings, or other root
+		/// entities if it has no parent, count as a clash.
+		/// </summary>
+		std::string GetUniqueSiblingName(Entity entity, const std::string& name);
+
 	public:
 
 		bool IsRunning() const { return m_IsRunning; }
@@ -126,6 +231,11 @@ namespace Louron {
 		PxScene* GetPhysScene() const { return m_PhysxScene; }
 		void SetPhysScene(PxScene* physScene);
 
+		/// <summary>
+		/// The job system the scene systems and spatial index builds split their work across.
+		/// </summary>
+		JobSystem& GetJobSystem() const { return *m_JobSystem; }
+
 		virtual AssetType GetType() const override { return AssetType::Scene; }
 
 		void CreateSceneFrameBuffer(const FrameBufferConfig& framebuffer_config);
@@ -138,18 +248,103 @@ namespace Louron {
 		void SetDisplayOctree(bool display) { m_DisplayOctree = display; }
 		const bool& GetDisplayOctree() const { return m_DisplayOctree; }
 
-		std::weak_ptr<OctreeBounds<Entity>> GetOctree() const { return m_Octree; }
+		std::weak_ptr<SpatialIndex<Entity>> GetSpatialIndex() const { std::lock_guard lock(m_SpatialIndexPointerMutex); return m_SpatialIndex; }
+
+		/// <summary>
+		/// The spatial index as an Octree, this is empty if the scene uses a different index type.
+		/// </summary>
+		std::weak_ptr<OctreeBounds<Entity>> GetOctree() const;
+
+		/// <summary>
+		/// Rebuild the spatial index from every mesh renderer in the scene, using
+		/// the SceneSpatialIndexType of the scene config. Call this after changing
+		/// the index type, or once a scene has been loaded or copied.
+		/// </summary>
+		void BuildSpatialIndex();
+
+		/// <summary>
+		/// Create a spatial index of the given type over the data sources, with the
+		/// same configuration BuildSpatialIndex uses for scenes. If a job system is
+		/// given, an Octree builds across its workers.
+		/// </summary>
+		static std::shared_ptr<SpatialIndex<Entity>> CreateSpatialIndex(SpatialIndexType index_type, const std::vector<OctreeDataSource<Entity>>& data_sources, JobSystem* job_system = nullptr);
+
+		/// <summary>
+		/// Queue an entity for octree maintenance on the next octree update.
+		/// Safe to call from any thread.
+		/// </summary>
+		void MarkOctreeDirty(entt::entity entity_handle) { m_OctreeDirtyQueue.Push(entity_handle); }
+
+		/// <summary>
+		/// Entities whose bounds, mesh or renderer changed since the octree was last updated.
+		/// </summary>
+		LockFreeQueue<entt::entity>& GetOctreeDirtyQueue() { return m_OctreeDirtyQueue; }
+
+		/// <summary>
+		/// Queue an entity for its render proxy to be rebuilt before the next frame is drawn.
+		/// Safe to call from any thread.
+		/// </summary>
+		void MarkRenderProxyDirty(entt::entity entity_handle) { m_RenderProxyDirtyQueue.Push(entity_handle); }
+
+		/// <summary>
+		/// Entities whose transform, mesh or renderer changed since their render proxies were last synced.
+		/// </summary>
+		LockFreeQueue<entt::entity>& GetRenderProxyDirtyQueue() { return m_RenderProxyDirtyQueue; }
+
+		/// <summary>
+		/// Flag the flat transform hierarchy order for a rebuild on the next
+		/// TransformSystem update, call this whenever a parent changes.
+		/// </summary>
+		void MarkTransformHierarchyDirty() { m_TransformHierarchy.NeedsRebuild = true; }
 
 		static std::shared_ptr<Scene> Copy(std::shared_ptr<Scene> source_scene);
 
 	private:
 
+		void OnOctreeComponentChanged(entt::registry& registry, entt::entity entity_handle);
+		void OnRenderProxyComponentChanged(entt::registry& registry, entt::entity entity_handle);
+		void OnHierarchyComponentChanged(entt::registry& registry, entt::entity entity_handle);
+		void OnTagComponentConstructed(entt::registry& registry, entt::entity entity_handle);
+		void OnTagComponentDestroyed(entt::registry& registry, entt::entity entity_handle);
+
+		void OnEntityRenamed(const TagComponent& tag, const std::string& new_name);
+
+		Entity CreateEntityUnlocked(entt::entity entity_handle, UUID uuid, const std::string& name);
+
+		void InstantiatePrefabSceneBoundComponents(std::shared_ptr<Prefab> prefab, entt::entity prefab_entity, Entity instantiated_entity);
+		void ResetPrefabSceneBoundComponents(std::shared_ptr<Prefab> prefab, entt::entity prefab_entity, Entity pooled_entity);
+
+		Entity FindEntityByNameIndex(const std::string& name, const std::function<bool(entt::entity)>& name_clashes = {});
+		std::string MakeUniqueEntityName(const std::string& name, const std::function<bool(entt::entity)>& name_clashes = {});
+
+	private:
+
+		// Declared before the registry so it outlives any destroy signals
+		LockFreeQueue<entt::entity> m_OctreeDirtyQueue;
+		LockFreeQueue<entt::entity> m_RenderProxyDirtyQueue;
+
+		SceneCommandBuffer m_CommandBuffer;
+		LockFreeQueue<std::shared_ptr<SceneCommandBuffer>> m_SubmittedCommandBuffers;
+		TransformHierarchy m_TransformHierarchy;
+
+		// Tag name to every entity using it, kept in sync by TagComponent::SetTag
+		std::unordered_multimap<std::string, entt::entity> m_EntityNameMap;
+
+		// Next " (n)" suffix to try per base name, so unique names are found 
+		// without counting up from 1 past every existing copy
+		std::unordered_map<std::string, uint32_t> m_EntityNameSuffixes;
+
 		entt::registry m_Registry;
-		std::shared_ptr<std::map<UUID, entt::entity>> m_EntityMap = std::make_shared<std::map<UUID, entt::entity>>();
+		EntityMap m_EntityMap;
+
+		// Pooled prefab handle to the root UUIDs of its despawned copies
+		std::unordered_map<AssetHandle, std::vector<UUID>> m_PrefabPools;
 
 		PxScene* m_PhysxScene = nullptr;
 		std::unique_ptr<CollisionCallback> m_CollisionCallback = nullptr;
 
+		JobSystem* m_JobSystem = nullptr;
+
 		std::shared_ptr<FrameBuffer> m_SceneFrameBuffer = nullptr;
 
 		bool m_IsRunning = false;
@@ -159,7 +354,8 @@ namespace Louron {
 
 		SceneConfig m_SceneConfig;
 
-		std::shared_ptr<OctreeBounds<Entity>> m_Octree = nullptr;
+		std::shared_ptr<SpatialIndex<Entity>> m_SpatialIndex = nullptr;
+		mutable std::mutex m_SpatialIndexPointerMutex;
 		bool m_DisplayOctree = false;
 
 		friend class Entity;
@@ -168,5 +364,7 @@ namespace Louron {
 
 		friend class TransformSystem;
 		friend class PhysicsSystem;
+
+		friend struct TagComponent;
 	};
 }
\ No newline at end of file
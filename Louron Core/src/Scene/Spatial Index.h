@@ -0,0 +1,269 @@
+#pragma once
+
+// Louron Core Headers
+#include "Bounds.h"
+#include "Frustum.h"
+
+// C++ Standard Library Headers
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+// External Vendor Library Headers
+#include <glm/glm.hpp>
+
+namespace Louron {
+
+	/// <summary>
+	/// The spatial index a Scene uses to cull and query its renderable bounds.
+	/// </summary>
+	enum class SpatialIndexType : uint8_t {
+
+		/// <summary>
+		/// Loose Octree, cheap to update when things move around a lot.
+		/// </summary>
+		Octree = 0,
+
+		/// <summary>
+		/// SAH built Bounding Volume Hierarchy, tighter bounds for faster
+		/// queries in mostly static scenes. Moving bounds are refit in place.
+		/// </summary>
+		BVH = 1
+	};
+
+	template <typename DataType>
+	struct OctreeDataSource {
+
+		DataType Data{};
+		Bounds_AABB Bounds{};
+
+		OctreeDataSource() = default;
+		OctreeDataSource(DataType data, Bounds_AABB bounds) : Data(data), Bounds(bounds) { }
+
+		OctreeDataSource(const OctreeDataSource& other) = default;
+		OctreeDataSource& operator=(const OctreeDataSource& other) = default;
+
+		OctreeDataSource(OctreeDataSource&& other) = default;
+		OctreeDataSource& operator=(OctreeDataSource&& other) = default;
+	};
+
+	/// <summary>
+	/// A single view for a batched Octree query. This can be a frustum,
+	/// an AABB or a sphere, and each view gets its own result list.
+	/// </summary>
+	struct OctreeQueryVolume {
+
+		enum class VolumeType : uint8_t {
+			Frustum,
+			AABB,
+			Sphere
+		};
+
+		VolumeType Type = VolumeType::Frustum;
+
+		Frustum QueryFrustum{};
+		Bounds_AABB QueryAABB{};
+		Bounds_Sphere QuerySphere{};
+
+		OctreeQueryVolume() = default;
+		OctreeQueryVolume(const Frustum& frustum) : Type(VolumeType::Frustum), QueryFrustum(frustum) { }
+		OctreeQueryVolume(const Bounds_AABB& aabb) : Type(VolumeType::AABB), QueryAABB(aabb) { }
+		OctreeQueryVolume(const Bounds_Sphere& sphere) : Type(VolumeType::Sphere), QuerySphere(sphere) { }
+	};
+
+	/// <summary>
+	/// Most bounds the spatial indexes classify per batched SIMD test.
+	/// </summary>
+	constexpr uint32_t SPATIAL_INDEX_TEST_BATCH_SIZE = 8;
+
+	/// <summary>
+	/// Batched bounds tests shared by the spatial indexes.
+	/// </summary>
+	namespace SpatialIndexTests {
+
+		inline BoundsContainResult ToBoundsContainResult(FrustumContainResult result) {
+			switch (result) {
+				case FrustumContainResult::Contains:		return BoundsContainResult::Contains;
+				case FrustumContainResult::Intersects:		return BoundsContainResult::Intersects;
+				default:									return BoundsContainResult::DoesNotContain;
+			}
+		}
+
+		/// <summary>
+		/// Classify up to SPATIAL_INDEX_TEST_BATCH_SIZE bounds against the query in one call.
+		/// </summary>
+		inline void TestBounds(const Bounds_AABB& query, const Bounds_AABB* bounds, uint32_t count, BoundsContainResult* results) {
+			for (uint32_t i = 0; i < count; i++)
+				results[i] = query.Contains(bounds[i]);
+		}
+
+		inline void TestBounds(const Bounds_Sphere& query, const Bounds_AABB* bounds, uint32_t count, BoundsContainResult* results) {
+			query.Contains(bounds, count, results);
+		}
+
+		inline void TestBounds(const Frustum& query, const Bounds_AABB* bounds, uint32_t count, BoundsContainResult* results) {
+			std::array<FrustumContainResult, SPATIAL_INDEX_TEST_BATCH_SIZE> frustum_results;
+			query.Contains(bounds, count, frustum_results.data());
+
+			for (uint32_t i = 0; i < count; i++)
+				results[i] = ToBoundsContainResult(frustum_results[i]);
+		}
+
+		/// <summary>
+		/// Classify up to SPATIAL_INDEX_TEST_BATCH_SIZE bounds against a single view of a batched query.
+		/// Frustum views only test the planes in plane_mask, result_plane_masks (optional)
+		/// receives the planes each of the bounds still needs its children to test.
+		/// </summary>
+		inline void TestVolume(const OctreeQueryVolume& volume, const Bounds_AABB* bounds, uint32_t count, uint8_t plane_mask, BoundsContainResult* results, uint8_t* result_plane_masks) {
+
+			switch (volume.Type) {
+
+				case OctreeQueryVolume::VolumeType::Frustum: {
+
+					std::array<FrustumContainResult, SPATIAL_INDEX_TEST_BATCH_SIZE> frustum_results;
+					volume.QueryFrustum.Contains(bounds, count, frustum_results.data(), plane_mask, result_plane_masks);
+
+					for (uint32_t i = 0; i < count; i++)
+						results[i] = ToBoundsContainResult(frustum_results[i]);
+					return;
+				}
+
+				case OctreeQueryVolume::VolumeType::AABB:	TestBounds(volume.QueryAABB, bounds, count, results); break;
+				case OctreeQueryVolume::VolumeType::Sphere:	TestBounds(volume.QuerySphere, bounds, count, results); break;
+			}
+
+			if (result_plane_masks) {
+				for (uint32_t i = 0; i < count; i++)
+					result_plane_masks[i] = plane_mask;
+			}
+		}
+
+	}
+
+	/// <summary>
+	/// Common query surface of the Scene's spatial indexes (OctreeBounds and
+	/// BVHBounds), so the renderer and scene systems do not need to know which
+	/// one a Scene was configured to use.
+	///
+	/// Queries do not modify the index, so any number of threads may query at
+	/// once while holding a std::shared_lock on GetMutex(). Take a
+	/// std::unique_lock when inserting, removing, updating or maintaining.
+	/// </summary>
+	template <typename DataType>
+	class SpatialIndex {
+
+	public:
+
+		using IndexData = OctreeDataSource<DataType>;
+
+		/// <summary>
+		/// A data source hit by a ray query, and how far along the ray it was hit.
+		/// </summary>
+		struct RayHit {
+			IndexData DataSource{};
+			float Distance = FLT_MAX;
+		};
+
+		/// <summary>
+		/// Optional narrow phase for ray queries. This is called for each data source
+		/// whose AABB the ray hits, with distance set to where the ray enters the AABB.
+		/// It may move distance further along the ray, e.g. to the nearest triangle,
+		/// and returns false to reject the data source.
+		/// </summary>
+		using RayFilter = std::function<bool(const IndexData& data_source, float& distance)>;
+
+		virtual ~SpatialIndex() = default;
+
+		virtual SpatialIndexType GetType() const = 0;
+
+		/// <summary>
+		/// Insert a data source, if the data is already within the index its bounds will be updated.
+		/// </summary>
+		virtual bool Insert(const DataType& data, const Bounds_AABB& bounds) = 0;
+		virtual bool Remove(const DataType& data) = 0;
+
+		/// <summary>
+		/// Update the bounds of a data source, inserting it if it is not within the index.
+		/// </summary>
+		virtual bool Update(const DataType& data, const Bounds_AABB& bounds) = 0;
+
+		virtual bool HasDataSource(const DataType& data) const = 0;
+		virtual size_t TotalCount() const = 0;
+		virtual bool IsEmpty() const = 0;
+
+		/// <summary>
+		/// Query for all data sources that intersect the volume, writing them
+		/// into the caller owned result vector. The result is cleared first.
+		/// </summary>
+		virtual void Query(const Bounds_AABB& bounds, std::vector<IndexData>& result) const = 0;
+		virtual void Query(const Bounds_Sphere& bounds, std::vector<IndexData>& result) const = 0;
+		virtual void Query(const Frustum& frustum, std::vector<IndexData>& result) const = 0;
+
+		/// <summary>
+		/// Query many views in a single traversal. results is resized to match volumes,
+		/// results[i] is the same set of data sources Query(volumes[i]) would return.
+		/// </summary>
+		virtual void Query(const std::vector<OctreeQueryVolume>& volumes, std::vector<std::vector<IndexData>>& results) const = 0;
+
+		/// <summary>
+		/// Find the nearest data source hit by the ray.
+		/// </summary>
+		/// <returns>True if a data source was hit, hit is only written if something was hit.</returns>
+		virtual bool Raycast(const Bounds_Ray& ray, float max_distance, RayHit& hit, const RayFilter& filter = {}) const = 0;
+
+		/// <summary>
+		/// Find every data source hit by the ray, sorted nearest first. The result is cleared first.
+		/// </summary>
+		virtual void RaycastAll(const Bounds_Ray& ray, float max_distance, std::vector<RayHit>& hits, const RayFilter& filter = {}) const = 0;
+
+		/// <summary>
+		/// Find the nearest data source hit by the segment from start to end.
+		/// </summary>
+		bool Linecast(const glm::vec3& start, const glm::vec3& end, RayHit& hit, const RayFilter& filter = {}) const {
+			return Raycast(Bounds_Ray(start, end - start), glm::length(end - start), hit, filter);
+		}
+
+		/// <summary>
+		/// Find every data source hit by the segment from start to end, sorted nearest first.
+		/// </summary>
+		void LinecastAll(const glm::vec3& start, const glm::vec3& end, std::vector<RayHit>& hits, const RayFilter& filter = {}) const {
+			RaycastAll(Bounds_Ray(start, end - start), glm::length(end - start), hits, filter);
+		}
+
+		/// <summary>
+		/// Housekeeping after a batch of updates, e.g. pruning empty Octree nodes
+		/// or rebuilding a BVH that has degraded from refitting. Call it from the
+		/// thread that updates the index while holding a std::unique_lock.
+		/// </summary>
+		virtual void PerformMaintenance() = 0;
+
+		/// <summary>
+		/// This will return a copy of all data sources within the index.
+		/// </summary>
+		virtual std::vector<IndexData> GetAllDataSources() const = 0;
+
+		/// <summary>
+		/// This will return the bounds of every node of the index as glm::mat4 matricies for debug drawing.
+		/// </summary>
+		virtual std::vector<glm::mat4> GetAllBoundsMat4() const = 0;
+
+		/// <summary>
+		/// Copy the index as it is, nodes and all, passing every data source
+		/// through remap. This is much cheaper than building a new index over the
+		/// same bounds. Hold a std::shared_lock on GetMutex() while cloning.
+		/// </summary>
+		virtual std::shared_ptr<SpatialIndex<DataType>> Clone(const std::function<DataType(const DataType&)>& remap = {}) const = 0;
+
+		/// <summary>
+		/// Reader/writer lock for the index. Take a std::unique_lock when
+		/// inserting, removing or updating, and a std::shared_lock to Query.
+		/// </summary>
+		virtual std::shared_mutex& GetMutex() = 0;
+
+	};
+
+}
@@ -2,6 +2,7 @@
 
 // Louron Core Headers
 #include "../Asset/Asset Manager API.h"
+#include "../Scene/Scene Systems/Bounds System.h"
 
 // C++ Standard Library Headers
 
@@ -38,6 +39,9 @@ namespace Louron {
 
 		mono_add_internal_call("Louron.EngineCallbacks::Entity_GetParent", Entity_GetParent);
 		mono_add_internal_call("Louron.EngineCallbacks::Entity_SetParent", Entity_SetParent);
+
+		mono_add_internal_call("Louron.EngineCallbacks::Prefab_SetPooled", Prefab_SetPooled);
+		mono_add_internal_call("Louron.EngineCallbacks::Prefab_IsPooled", Prefab_IsPooled);
 		
 		mono_add_internal_call("Louron.EngineCallbacks::Input_GetKey", Input_GetKey);
 		mono_add_internal_call("Louron.EngineCallbacks::Input_GetKeyDown", Input_GetKeyDown);
@@ -50,6 +54,8 @@ namespace Louron {
 		mono_add_internal_call("Louron.EngineCallbacks::Time_GetDeltaTime", Time_GetDeltaTime);
 		mono_add_internal_call("Louron.EngineCallbacks::Time_GetCurrentTime", Time_GetCurrentTime);
 
+		mono_add_internal_call("Louron.EngineCallbacks::Scene_Raycast", Scene_Raycast);
+
 		mono_add_internal_call("Louron.EngineCallbacks::TransformComponent_GetTransform", TransformComponent_GetTransform);
 		mono_add_internal_call("Louron.EngineCallbacks::TransformComponent_SetTransform", TransformComponent_SetTransform);
 
@@ -199,7 +205,17 @@ namespace Louron {
 		Entity entity = scene->FindEntityByUUID(entityID);
 		if (!entity) return;
 
-		scene->DestroyEntity(entity);
+		// Deferred, the scene may be part way through iterating its scripts
+		if (scene->IsRunning()) {
+
+			// Copies of pooled prefabs go back to their pool instead
+			if (entity.HasComponent<PrefabInstanceComponent>() && scene->IsPrefabPooled(entity.GetComponent<PrefabInstanceComponent>().PrefabHandle))
+				scene->GetCommandBuffer().Record(entityID, [](Entity entity) { entity.GetScene()->DespawnEntity(entity); });
+			else
+				scene->GetCommandBuffer().DestroyEntity(entityID);
+		}
+		else
+			scene->DestroyEntity(entity);
 	}
 
 	void ScriptConnector::Entity_AddComponent(UUID entityID, MonoReflectionType* componentType)
@@ -255,33 +271,42 @@ namespace Louron {
 
 		std::string component_name = mono_type_get_name(managedType);
 
-		if (component_name == "Louron.TransformComponent") {
-			entity.RemoveComponent<TransformComponent>();
-		}
-		if (component_name == "Louron.TagComponent") {
-			entity.RemoveComponent<TagComponent>();
-		}
-		if (component_name == "Louron.ScriptComponent") {
-			entity.RemoveComponent<ScriptComponent>();
-		}
-		if (component_name == "Louron.PointLightComponent") {
-			entity.RemoveComponent<PointLightComponent>();
-		}
-		if (component_name == "Louron.SpotLightComponent") {
-			entity.RemoveComponent<SpotLightComponent>();
-		}
-		if (component_name == "Louron.DirectionalLightComponent") {
-			entity.RemoveComponent<DirectionalLightComponent>();
-		}
-		if (component_name == "Louron.Rigidbody") {
-			entity.RemoveComponent<RigidbodyComponent>();
-		}
-		if (component_name == "Louron.BoxCollider") {
-			entity.RemoveComponent<BoxColliderComponent>();
-		}
-		if (component_name == "Louron.SphereCollider") {
-			entity.RemoveComponent<SphereColliderComponent>();
-		}
+		auto remove_component = [component_name](Entity target_entity) {
+
+			if (component_name == "Louron.TransformComponent") {
+				target_entity.RemoveComponent<TransformComponent>();
+			}
+			if (component_name == "Louron.TagComponent") {
+				target_entity.RemoveComponent<TagComponent>();
+			}
+			if (component_name == "Louron.ScriptComponent") {
+				target_entity.RemoveComponent<ScriptComponent>();
+			}
+			if (component_name == "Louron.PointLightComponent") {
+				target_entity.RemoveComponent<PointLightComponent>();
+			}
+			if (component_name == "Louron.SpotLightComponent") {
+				target_entity.RemoveComponent<SpotLightComponent>();
+			}
+			if (component_name == "Louron.DirectionalLightComponent") {
+				target_entity.RemoveComponent<DirectionalLightComponent>();
+			}
+			if (component_name == "Louron.Rigidbody") {
+				target_entity.RemoveComponent<RigidbodyComponent>();
+			}
+			if (component_name == "Louron.BoxCollider") {
+				target_entity.RemoveComponent<BoxColliderComponent>();
+			}
+			if (component_name == "Louron.SphereCollider") {
+				target_entity.RemoveComponent<SphereColliderComponent>();
+			}
+		};
+
+		// Deferred, removing a ScriptComponent mid update would invalidate the script view
+		if (scene->IsRunning())
+			scene->GetCommandBuffer().Record(entityID, remove_component);
+		else
+			remove_component(entity);
 	}
 
 	bool ScriptConnector::Entity_HasComponent(UUID entityID, MonoReflectionType* componentType)
@@ -306,13 +331,30 @@ namespace Louron {
 
 		auto prefab_asset = AssetManager::GetAsset<Prefab>(*handle);
 
-		Entity prefab_clone = scene->InstantiatePrefab(prefab_asset);
+		// Reuses a despawned copy if the prefab is pooled
+		Entity prefab_clone = scene->SpawnPrefab(prefab_asset);
 		if (prefab_clone) {
 			prefab_clone.GetComponent<TagComponent>().SetUniqueName(prefab_asset->GetPrefabName());
 			*prefab_clone_uuid = prefab_clone.GetUUID();
 		}
 	}
 
+	void ScriptConnector::Prefab_SetPooled(uint32_t* handle, bool pooled) {
+
+		Scene* scene = ScriptManager::GetSceneContext();
+		L_CORE_ASSERT(scene, "Scene Not Valid.");
+
+		scene->SetPrefabPooling(*handle, pooled);
+	}
+
+	bool ScriptConnector::Prefab_IsPooled(uint32_t* handle) {
+
+		Scene* scene = ScriptManager::GetSceneContext();
+		L_CORE_ASSERT(scene, "Scene Not Valid.");
+
+		return scene->IsPrefabPooled(*handle);
+	}
+
 	UUID ScriptConnector::Entity_GetParent(UUID entityID) {
 
 		Scene* scene = ScriptManager::GetSceneContext();
@@ -382,6 +424,33 @@ namespace Louron {
 
 #pragma endregion
 
+#pragma region Raycast
+
+	bool ScriptConnector::Scene_Raycast(glm::vec3* origin, glm::vec3* direction, float max_distance, uint32_t* out_entity_id, float* out_distance, glm::vec3* out_point) {
+
+		Scene* scene = ScriptManager::GetSceneContext();
+		L_CORE_ASSERT(scene, "Scene Not Valid.");
+
+		*out_entity_id = NULL_UUID;
+		*out_distance = 0.0f;
+		*out_point = glm::vec3(0.0f);
+
+		SceneRaycastHit hit;
+		if (!BoundsSystem::Raycast(scene, Bounds_Ray(*origin, *direction), max_distance, hit))
+			return false;
+
+		Entity entity = { hit.EntityHandle, scene };
+		if (!entity)
+			return false;
+
+		*out_entity_id = entity.GetUUID();
+		*out_distance = hit.Distance;
+		*out_point = hit.Point;
+		return true;
+	}
+
+#pragma endregion
+
 #pragma region TransformComponent
 
 	void ScriptConnector::TransformComponent_GetTransform(UUID entityID, _Transform* out_transform)
@@ -601,7 +670,7 @@ namespace Louron {
 			return;
 
 		auto& component = entity.GetComponent<TagComponent>();
-		component.Tag = ScriptingUtils::MonoStringToString(ref);
+		component.SetTag(ScriptingUtils::MonoStringToString(ref));
 	}
 
 #pragma endregion
@@ -1687,6 +1756,8 @@ namespace Louron {
 
 			material_pair.second.reset();   // Clear Material Uniform Block
 			material_pair.second = nullptr; // Clear Material Uniform Block
+
+			entity.GetComponent<MeshRendererComponent>().MarkDirty();
 		}
 
 		return;
@@ -1747,6 +1818,7 @@ namespace Louron {
 		}
 
 		component.MeshRendererMaterialHandles = std::move(new_handle_vector);
+		component.MarkDirty();
 	}
 
 	void ScriptConnector::MeshRenderer_EnableUniformBlock(UUID entityID, uint32_t material_index)
@@ -1777,6 +1849,7 @@ namespace Louron {
 		{
 			material_handle_vector[material_index].second = std::make_shared<MaterialUniformBlock>(*material_asset->GetUniformBlock());
 			material_handle_vector[material_index].second->GenerateNewBlockID();
+			entity.GetComponent<MeshRendererComponent>().MarkDirty();
 		}
 
 		return;
@@ -1825,6 +1898,8 @@ namespace Louron {
 		
 		material_handle_vector[material_index].second.reset();
 		material_handle_vector[material_index].second = nullptr;
+
+		entity.GetComponent<MeshRendererComponent>().MarkDirty();
 	}
 
 	void ScriptConnector::MeshRenderer_EnableAllUniformBlocks(UUID entityID)
@@ -1851,6 +1926,8 @@ namespace Louron {
 				uniform_block = std::make_shared<MaterialUniformBlock>(*material_asset->GetUniformBlock());
 		}
 
+		entity.GetComponent<MeshRendererComponent>().MarkDirty();
+
 		return;
 	}
 
@@ -1873,6 +1950,8 @@ namespace Louron {
 			uniform_block = nullptr;
 		}
 
+		entity.GetComponent<MeshRendererComponent>().MarkDirty();
+
 		return;
 	}
 
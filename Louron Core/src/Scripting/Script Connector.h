@@ -52,6 +52,9 @@ namespace Louron {
 		static UUID Entity_GetParent(UUID entityID);
 		static void Entity_SetParent(UUID entityID, UUID parentID);
 
+		static void Prefab_SetPooled(uint32_t* handle, bool pooled);
+		static bool Prefab_IsPooled(uint32_t* handle);
+
 #pragma endregion
 
 #pragma region Input
@@ -73,6 +76,12 @@ namespace Louron {
 
 #pragma endregion
 
+#pragma region Raycast
+
+		static bool Scene_Raycast(glm::vec3* origin, glm::vec3* direction, float max_distance, uint32_t* out_entity_id, float* out_distance, glm::vec3* out_point);
+
+#pragma endregion
+
 #pragma region TransformComponent
 
 		struct _Transform {
@@ -805,7 +805,7 @@ namespace Louron {
 		if (!scene_ref)
 			return;
 
-		auto view = scene_ref->GetAllEntitiesWith<ScriptComponent>();
+		auto view = scene_ref->GetRegistry()->view<ScriptComponent>(entt::exclude<DespawnedComponent>);
 		for (auto& entity_handle : view) {
 			Entity entity = { entity_handle, scene_ref.get() };
 			ScriptComponent& component = entity.GetComponent<ScriptComponent>();
@@ -823,7 +823,7 @@ namespace Louron {
 		// Per Entity
 		for (auto it = s_Data->InactiveEntityScripts.begin(); it != s_Data->InactiveEntityScripts.end(); ) {
 
-			Entity entity = scene_ref->FindEntityByUUID(it->first);
+			Entity entity = scene_ref->TryFindEntityByUUID(it->first);
 
 			if (!scene_ref->HasEntity(entity))
 			{
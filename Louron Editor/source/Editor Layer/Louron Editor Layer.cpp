@@ -1066,8 +1066,21 @@ void LouronEditorLayer::DisplaySceneViewportWindow() {
 		{
 			if(ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !ImGui::IsMouseDragging(ImGuiMouseButton_Left) && !ImGui::IsPopupOpen(nullptr, ImGuiPopupFlags_AnyPopup)) {
 				m_GizmoType = ImGuizmo::OPERATION::TRANSLATE;
-				uint32_t pixelData = Project::GetActiveScene()->GetSceneFrameBuffer()->ReadEntityPixelData({ mouseX, mouseY });
-				m_SelectedEntity = pixelData == NULL_UUID ? Entity() : Project::GetActiveScene()->FindEntityByUUID(pixelData);
+
+				// Unproject the mouse onto the near and far planes and pick on the CPU, this avoids reading back the entity buffer
+				glm::vec2 mouse_ndc = glm::vec2(mx / viewportSize.x, my / viewportSize.y) * 2.0f - 1.0f;
+				glm::mat4 inverse_view_projection = glm::inverse(m_EditorCamera->GetProjection() * m_EditorCamera->GetViewMatrix());
+
+				glm::vec4 near_point = inverse_view_projection * glm::vec4(mouse_ndc, -1.0f, 1.0f);
+				glm::vec4 far_point = inverse_view_projection * glm::vec4(mouse_ndc, 1.0f, 1.0f);
+				near_point /= near_point.w;
+				far_point /= far_point.w;
+
+				auto scene_ref = Project::GetActiveScene();
+
+				SceneRaycastHit hit;
+				Bounds_Ray mouse_ray(glm::vec3(near_point), glm::vec3(far_point - near_point));
+				m_SelectedEntity = BoundsSystem::Raycast(scene_ref.get(), mouse_ray, glm::length(glm::vec3(far_point - near_point)), hit) ? Entity(hit.EntityHandle, scene_ref.get()) : Entity();
 			}
 		}
 
@@ -1966,22 +1979,72 @@ void LouronEditorLayer::DisplayRenderStatsWindow() {
 		}
 
 		if (ImGui::TreeNodeEx("Octree Query Stats")) {
-			bool octree_display_toggle = Project::GetActiveScene()->GetDisplayOctree();
-			if (ImGui::Checkbox("View Octree", &octree_display_toggle))
-				Project::GetActiveScene()->SetDisplayOctree(octree_display_toggle);
+			auto scene_ref = Project::GetActiveScene();
 
-			ImGui::Text("Octree Data Sources: %i", (int)Project::GetActiveScene()->GetOctree().lock()->GetAllOctreeDataSources().size());
+			bool octree_display_toggle = scene_ref->GetDisplayOctree();
+			if (ImGui::Checkbox("View Spatial Index", &octree_display_toggle))
+				scene_ref->SetDisplayOctree(octree_display_toggle);
+
+			// Combo Box for Spatial Index Type
+			const char* spatial_index_types[] = { "Octree", "BVH" };
+			int selected_spatial_index = static_cast<int>(scene_ref->GetConfig().SceneSpatialIndexType);
+
+			if (ImGui::Combo("Spatial Index", &selected_spatial_index, spatial_index_types, IM_ARRAYSIZE(spatial_index_types))) {
+				L_PROFILE_SCOPE("Rebuild Spatial Index");
+
+				SceneConfig scene_config = scene_ref->GetConfig();
+				scene_config.SceneSpatialIndexType = static_cast<SpatialIndexType>(selected_spatial_index);
+				scene_ref->SetConfig(scene_config);
+				scene_ref->BuildSpatialIndex();
+			}
 
-			static OctreeBoundsConfig config = Project::GetActiveScene()->GetOctree().lock()->GetConfig();
+			if (auto index_ref = scene_ref->GetSpatialIndex().lock(); index_ref)
+				ImGui::Text("Spatial Index Data Sources: %i", (int)index_ref->TotalCount());
 
-			ImGui::DragFloat("Looseness", &config.Looseness, 0.001f, 1.0f, 2.0f);
-			ImGui::DragInt("PreferredDataSourceLimit", &config.PreferredDataSourceLimit, 0.25f, 1);
+			if (auto oct_ref = scene_ref->GetOctree().lock(); oct_ref) {
+
+				static OctreeBoundsConfig config = oct_ref->GetConfig();
+
+				ImGui::DragFloat("Looseness", &config.Looseness, 0.001f, 1.0f, 2.0f);
+				ImGui::DragInt("PreferredDataSourceLimit", &config.PreferredDataSourceLimit, 0.25f, 1);
+
+				if (ImGui::Button("Rebuild Octree")) {
+					L_PROFILE_SCOPE("Rebuild Octree");
+					oct_ref->RebuildOctree(config);
+				}
+			}
+
+			// Compare both index types over the bounds of the loaded scene
+			static std::vector<SpatialIndexBenchmarkResult> benchmark_results;
+			if (ImGui::Button("Benchmark Spatial Indexes"))
+				benchmark_results = BoundsSystem::BenchmarkSpatialIndexes(scene_ref.get());
+
+			if (!benchmark_results.empty() && ImGui::BeginTable("SpatialIndexBenchmark", 1 + (int)benchmark_results.size(), ImGuiTableFlags_Borders | ImGuiTableFlags_NoSavedSettings)) {
+
+				ImGui::TableSetupColumn("(ms)");
+				for (const auto& result : benchmark_results)
+					ImGui::TableSetupColumn(result.IndexType == SpatialIndexType::BVH ? "BVH" : "Octree");
+				ImGui::TableHeadersRow();
+
+				auto benchmark_row = [&](const char* label, double SpatialIndexBenchmarkResult::* time) {
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::Text("%s", label);
+					for (const auto& result : benchmark_results) {
+						ImGui::TableNextColumn();
+						ImGui::Text("%.3f", result.*time);
+					}
+				};
 
-			if (ImGui::Button("Rebuild Octree")) {
-				L_PROFILE_SCOPE("Rebuild Octree");
-				auto oct_ref = Project::GetActiveScene()->GetOctree().lock();
-				oct_ref->RebuildOctree(config);
+				benchmark_row("Build", &SpatialIndexBenchmarkResult::BuildTime);
+				benchmark_row("AABB Queries", &SpatialIndexBenchmarkResult::AABBQueryTime);
+				benchmark_row("Sphere Queries", &SpatialIndexBenchmarkResult::SphereQueryTime);
+				benchmark_row("Frustum Queries", &SpatialIndexBenchmarkResult::FrustumQueryTime);
+				benchmark_row("Batched Queries", &SpatialIndexBenchmarkResult::BatchQueryTime);
+				benchmark_row("Raycasts", &SpatialIndexBenchmarkResult::RaycastTime);
+				benchmark_row("Update", &SpatialIndexBenchmarkResult::UpdateTime);
 
+				ImGui::EndTable();
 			}
 
 			// Length of interval in seconds we gather new results
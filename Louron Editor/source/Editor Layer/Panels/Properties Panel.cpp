@@ -120,7 +120,7 @@ void PropertiesPanel::OnImGuiRender(const std::shared_ptr<Scene>& scene_ref, Ent
 
 		if (ImGui::IsItemDeactivatedAfterEdit()) {
 			// Update the tag if the input box is deactivated (Enter pressed or box loses focus)
-			component.Tag = std::string(tag_buffer);
+			component.SetTag(std::string(tag_buffer));
 		}
 
 		ImGui::NextColumn();
@@ -838,8 +838,7 @@ void PropertiesPanel::OnImGuiRender(const std::shared_ptr<Scene>& scene_ref, Ent
 
 					if (Project::GetStaticEditorAssetManager()->IsAssetHandleValid(dropped_asset_handle) && Project::GetStaticEditorAssetManager()->GetAssetType(dropped_asset_handle) == AssetType::Mesh) {
 						component.MeshFilterAssetHandle = dropped_asset_handle;
-						component.AABBNeedsUpdate = true;
-						component.OctreeNeedsUpdate = true;
+						component.MarkDirty();
 						AssetManager::GetAsset<AssetMesh>(component.MeshFilterAssetHandle); // Force load the Asset on the main thread/GL context
 					}
 					else {
@@ -1033,6 +1032,9 @@ void PropertiesPanel::OnImGuiRender(const std::shared_ptr<Scene>& scene_ref, Ent
 				ImGui::TreePop();
 			}
 
+			// The widgets above write straight into the component
+			component.MarkDirty();
+
 			ImGui::TreePop();
 		}
 
@@ -28,4 +28,42 @@ namespace Louron
         }
 
     }
+
+    public struct RaycastHit
+    {
+        public Entity entity;
+        public float distance;
+        public Vector3 point;
+    }
+
+    public static class Physics
+    {
+        /// <summary>
+        /// Cast a ray against every mesh in the scene and return the nearest hit.
+        /// This tests mesh triangles on the CPU, not physics colliders.
+        /// </summary>
+        /// <param name="max_distance">Hits further along the ray than this are ignored.</param>
+        public static bool Raycast(Vector3 origin, Vector3 direction, out RaycastHit hit, float max_distance = float.MaxValue)
+        {
+            hit = new RaycastHit();
+
+            if (!EngineCallbacks.Scene_Raycast(ref origin, ref direction, max_distance, out uint entity_id, out float distance, out Vector3 point))
+                return false;
+
+            hit.entity = new Entity(entity_id);
+            hit.distance = distance;
+            hit.point = point;
+            return true;
+        }
+
+        /// <summary>
+        /// Return the nearest mesh in the scene hit by the segment from start to end.
+        /// </summary>
+        public static bool Linecast(Vector3 start, Vector3 end, out RaycastHit hit)
+        {
+            Vector3 direction = end - start;
+            float length = MathF.Sqrt(direction.X * direction.X + direction.Y * direction.Y + direction.Z * direction.Z);
+            return Raycast(start, direction, out hit, length);
+        }
+    }
 }
@@ -31,6 +31,12 @@ namespace Louron
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         internal extern static void Entity_SetParent(uint entityID, uint parentID);
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Prefab_SetPooled(ref uint prefab_asset_handle, bool pooled);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static bool Prefab_IsPooled(ref uint prefab_asset_handle);
+
         #endregion
 
         #region Compute Shaders
@@ -389,6 +395,13 @@ namespace Louron
 
         #endregion
 
+        #region Raycast
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static bool Scene_Raycast(ref Vector3 origin, ref Vector3 direction, float max_distance, out uint entity_id, out float distance, out Vector3 point);
+
+        #endregion
+
         #region Material
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
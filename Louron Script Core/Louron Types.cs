@@ -121,6 +121,16 @@ namespace Louron
         {
             get { return Asset_Handle; }
         }
+
+        /// <summary>
+        /// While pooled, destroying an instance of this prefab parks it so the
+        /// next Instantiate can reuse it instead of creating a new one.
+        /// </summary>
+        public bool Pooled
+        {
+            get { return EngineCallbacks.Prefab_IsPooled(ref Asset_Handle); }
+            set { EngineCallbacks.Prefab_SetPooled(ref Asset_Handle, value); }
+        }
     }
 
     public enum ForceMode : uint